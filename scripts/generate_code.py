@@ -362,6 +362,28 @@ def _mako_info_hpp(path, namespace, tags, version, specs, meta):
     )
 
 
+def _mako_trace_hpp(path, namespace, tags, version, specs, meta):
+    """
+    Entry-point:
+        generates the function tables of the trace collector
+    """
+    fin = os.path.join(templates_dir, "tools-trace.hpp.mako")
+    name = f"{namespace}trace_params"
+    filename = f"{name}.hpp"
+    fout = os.path.join(path, filename)
+    print("Generating %s..." % fout)
+    return util.makoWrite(
+        fin,
+        fout,
+        name=name,
+        ver=version,
+        namespace=namespace,
+        tags=tags,
+        specs=specs,
+        meta=meta,
+    )
+
+
 def _mako_linker_scripts(path, name, ext, namespace, tags, version, specs, meta):
     """
     Entry-point:
@@ -554,6 +576,10 @@ def generate_tools(path, section, namespace, tags, version, specs, meta):
     os.makedirs(infodir, exist_ok=True)
     loc += _mako_info_hpp(infodir, namespace, tags, version, specs, meta)
 
+    tracedir = os.path.join(path, f"{namespace}trace")
+    os.makedirs(tracedir, exist_ok=True)
+    loc += _mako_trace_hpp(tracedir, namespace, tags, version, specs, meta)
+
     print("TOOLS Generated %s lines of code.\n" % loc)
 
 
@@ -50,43 +50,10 @@ namespace ur_loader
         %if func_basename == "AdapterGet":
         auto context = getContext();
 
-        uint32_t numAdapters = 0;
-        for (auto &platform : context->platforms) {
-            if (platform.initStatus != ${X}_RESULT_SUCCESS)
-                continue;
-
-            auto *${th.make_pfn_name(n, tags, obj)} = platform.dditable.${th.get_table_name(n, tags, obj)}.${th.make_pfn_name(n, tags, obj)};
-            if (*${th.make_pfn_name(n, tags, obj)} == nullptr)
-                return ${X}_RESULT_ERROR_UNINITIALIZED;
-
-            // Count adapters without writing handles when the caller did not request
-            // them or its output array is already full.
-            if (${obj['params'][1]['name']} == nullptr || numAdapters >= NumEntries) {
-                uint32_t adapter = 0;
-                auto result = ${th.make_pfn_name(n, tags, obj)}( 0, nullptr, &adapter );
-                if (result == ${X}_RESULT_SUCCESS)
-                    numAdapters += adapter;
-                continue;
-            }
-
-            // Query single adapter into a temporary handle and copy it to output array
-            // if the query was successful.
-            uint32_t adapter = 0;
-            ur_adapter_handle_t adapterHandle = nullptr;
-            auto result = ${th.make_pfn_name(n, tags, obj)}( 1, &adapterHandle, &adapter );
-            if (result != ${X}_RESULT_SUCCESS || adapterHandle == nullptr)
-                continue;
-
-            ${obj['params'][1]['name']}[numAdapters] = adapterHandle;
-            numAdapters += adapter;
-        }
-
-        if( ${obj['params'][2]['name']} != nullptr )
-        {
-            *${obj['params'][2]['name']} = numAdapters;
-        }
+        if (context->lazyAdapters)
+            return context->lazyAdapters->get(context->platforms, ${", ".join(th.make_param_lines(n, tags, obj, format=["name"]))});
 
-        return ${X}_RESULT_SUCCESS;
+        return context->getAdapters(${", ".join(th.make_param_lines(n, tags, obj, format=["name"]))});
         %else:
         auto *dditable = *reinterpret_cast<${x}_dditable_t **>(${th.get_dditable_field(obj)});
 
@@ -94,9 +61,33 @@ namespace ur_loader
         if( nullptr == ${th.make_pfn_name(n, tags, obj)} )
             return ${X}_RESULT_ERROR_UNINITIALIZED;
 
+        %if func_basename == "PlatformGetInfo":
+        // forward to device-platform
+        auto result = ${th.make_pfn_name(n, tags, obj)}( ${", ".join(th.make_param_lines(n, tags, obj, format=["name"]))} );
+
+        // The application knows lazy adapters by the handles of the loader.
+        auto context = getContext();
+        if (result == ${X}_RESULT_SUCCESS && context->lazyAdapters &&
+            propName == ${X}_PLATFORM_INFO_ADAPTER && pPropValue != nullptr) {
+            auto *phAdapter = static_cast<${x}_adapter_handle_t *>(pPropValue);
+            *phAdapter = context->lazyAdapters->getHandle(*phAdapter);
+        }
+
+        return result;
+        %elif func_basename == "PlatformGet":
+        // forward to device-platform
+        auto result = ${th.make_pfn_name(n, tags, obj)}( ${", ".join(th.make_param_lines(n, tags, obj, format=["name"]))} );
+
+        // Remember whether the adapter has platforms for the next processes.
+        if (result == ${X}_RESULT_SUCCESS && pNumPlatforms != nullptr)
+            getContext()->recordPlatforms(hAdapter, *pNumPlatforms);
+
+        return result;
+        %else:
         // forward to device-platform
         return ${th.make_pfn_name(n, tags, obj)}( ${", ".join(th.make_param_lines(n, tags, obj, format=["name"]))} );
         %endif
+        %endif
     }
     %if 'condition' in obj:
     #endif // ${th.subt(n, tags, obj['condition'])}
@@ -0,0 +1,76 @@
+<%!
+import re
+from templates import helper as th
+%><%
+    n=namespace
+    N=n.upper()
+
+    x=tags['$x']
+    X=x.upper()
+
+    functions = [obj for obj in th.extract_objs(specs, r"enum") if obj['name'] == '$x_function_t'][0]
+    function_id_limit = max(int(etor['value']) for etor in th.get_etors(functions)) + 1
+%>/*
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file ${name}.hpp
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <unified-runtime/${x}_api.h>
+
+namespace ${x}trace {
+
+/// @brief One past the highest ${x}_function_t value.
+constexpr size_t FUNCTION_ID_LIMIT = ${function_id_limit};
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Returns the name of a function, or nullptr if it is unknown.
+inline const char *getFunctionName(${x}_function_t function) {
+    switch (function) {
+%for tbl in th.get_pfncbtables(specs, meta, n, tags):
+%for obj in tbl['functions']:
+    case ${th.make_func_etor(n, tags, obj)}:
+        return "${th.make_func_name(n, tags, obj)}";
+%endfor
+%endfor
+    default:
+        return nullptr;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Calls visitor(name, member) for each parameter of a function, in
+///        order, where member is the pointer to the member of the params
+///        struct of the function that points to the parameter.
+/// @returns false if the function is unknown.
+template <typename V>
+inline bool visitFunctionParams(${x}_function_t function, V &&visitor) {
+    switch (function) {
+%for tbl in th.get_pfncbtables(specs, meta, n, tags):
+%for obj in tbl['functions']:
+    case ${th.make_func_etor(n, tags, obj)}: {
+%if obj['params']:
+        using P = ${th.make_pfncb_param_type(n, tags, obj)};
+%endif
+%for item in obj['params']:
+        visitor("${th._get_param_name(n, tags, item)}", &P::p${th._get_param_name(n, tags, item)});
+%endfor
+    } break;
+%endfor
+%endfor
+    default:
+        return false;
+    }
+    return true;
+}
+
+} // namespace ${x}trace
@@ -6,6 +6,9 @@ from templates import helper as th
     N=n.upper()
     x=tags['$x']
     X=x.upper()
+
+    functions = [obj for obj in th.extract_objs(specs, r"enum") if obj['name'] == '$x_function_t'][0]
+    function_id_limit = max(int(etor['value']) for etor in th.get_etors(functions)) + 1
 %>/*
  *
  *
@@ -25,6 +28,9 @@ from templates import helper as th
 
 namespace ur_tracing_layer
 {
+    /// @brief One past the highest ${x}_function_t value.
+    const uint32_t context_t::FUNCTION_ID_LIMIT = ${function_id_limit};
+
     %for obj in th.get_adapter_functions(specs):
 %if 'guard' in obj:
 #if ${obj['guard']}
@@ -111,7 +117,9 @@ namespace ur_tracing_layer
 #if ${obj['guard']}
 %endif
         dditable.${th.append_ws(th.make_pfn_name(n, tags, obj), 43)} = pDdiTable->${th.make_pfn_name(n, tags, obj)};
-        pDdiTable->${th.append_ws(th.make_pfn_name(n, tags, obj), 41)} = ur_tracing_layer::${th.make_func_name(n, tags, obj)};
+        if (ur_tracing_layer::getContext()->isTraced("${th.make_func_name(n, tags, obj)}")) {
+            pDdiTable->${th.append_ws(th.make_pfn_name(n, tags, obj), 41)} = ur_tracing_layer::${th.make_func_name(n, tags, obj)};
+        }
         %if 'condition' in obj:
     #else
         dditable.${th.append_ws(th.make_pfn_name(n, tags, obj), 43)} = nullptr;
@@ -146,6 +154,9 @@ namespace ur_tracing_layer
 
         ur_tracing_layer::getContext()->codelocData = codelocData;
 
+        // Untraced functions are left pointing to the next layer
+        ur_tracing_layer::getContext()->initFunctionFilter();
+
     %for tbl in th.get_pfntables(specs, meta, n, tags):
 %if 'guard' in tbl:
 #if ${tbl['guard']}
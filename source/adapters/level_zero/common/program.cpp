@@ -1071,7 +1071,7 @@ ur_result_t urProgramSetSpecializationConstant(
     const void * /*SpecValue*/) {
   UR_LOG_LEGACY(ERR,
                 logger::LegacyMessage("[UR][L0] {} function not implemented!"),
-                "{} function not implemented!");
+                "{} function not implemented!", __FUNCTION__);
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
 }
 
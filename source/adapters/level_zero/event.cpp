@@ -31,7 +31,7 @@ void printZeEventList(const ur_ze_event_list_t &UrZeEventList) {
     for (uint32_t I = 0; I < UrZeEventList.Length; I++) {
       ss << " " << ur_cast<std::uintptr_t>(UrZeEventList.ZeEventList[I]);
     }
-    UR_LOG(DEBUG, ss.str().c_str());
+    UR_LOG(DEBUG, "{}", ss.str());
   }
 }
 
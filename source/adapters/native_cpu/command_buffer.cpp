@@ -7,184 +7,475 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "command_buffer.hpp"
 #include "common.hpp"
+#include "device.hpp"
+#include "enqueue.hpp"
+#include "event.hpp"
+#include "kernel.hpp"
+#include "memory.hpp"
+#include "queue.hpp"
+#include "threadpool.hpp"
 
-/// Stub implementations of UR experimental feature command-buffers
-/// Taken almost unchanged from another adapter. Perhaps going forward
-/// these stubs could be defined in core UR as the default which would
-/// reduce code duplication. Adapters could then "override" these defaults.
-/// Issue raised for this comment in
-/// https://github.com/oneapi-src/unified-runtime/issues/1064
-
-UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferCreateExp(
-    ur_context_handle_t, ur_device_handle_t,
-    const ur_exp_command_buffer_desc_t *, ur_exp_command_buffer_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+ur_result_t ur_exp_command_buffer_handle_t_::appendCommand(
+    std::vector<native_cpu::task_t> &&tasks, uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint) {
+  UR_ASSERT(!IsFinalized, UR_RESULT_ERROR_INVALID_OPERATION);
+  const auto index = static_cast<uint32_t>(Commands.size());
+
+  std::vector<uint32_t> deps;
+  if (Desc.isInOrder) {
+    if (index > 0) {
+      deps.push_back(index - 1);
+    }
+  } else {
+    deps.assign(pSyncPointWaitList,
+                pSyncPointWaitList + numSyncPointsInWaitList);
+    std::sort(deps.begin(), deps.end());
+    deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+    if (!deps.empty() && deps.back() >= index) {
+      return UR_RESULT_ERROR_INVALID_COMMAND_BUFFER_SYNC_POINT_WAIT_LIST_EXP;
+    }
+  }
+
+  for (auto dep : deps) {
+    Commands[dep].Successors.push_back(index);
+  }
+  Commands.push_back(
+      {std::move(tasks), {}, static_cast<uint32_t>(deps.size())});
+  if (pSyncPoint) {
+    *pSyncPoint = index;
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+namespace {
+// Checks for the parts of the append entry points that aren't supported:
+// command handles and events, which are only needed for updates.
+ur_result_t
+checkAppend(uint32_t numEventsInWaitList, ur_event_handle_t *phEvent,
+            ur_exp_command_buffer_command_handle_t *phCommand) {
+  if (numEventsInWaitList || phEvent || phCommand) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+  return UR_RESULT_SUCCESS;
 }
 
+ur_result_t
+appendFill(ur_exp_command_buffer_handle_t hCommandBuffer, void *ptr,
+           const void *pPattern, size_t patternSize, size_t size,
+           uint32_t numSyncPointsInWaitList,
+           const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+           ur_exp_command_buffer_sync_point_t *pSyncPoint) {
+  UR_ASSERT(ptr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pPattern, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(patternSize != 0, UR_RESULT_ERROR_INVALID_SIZE);
+  UR_ASSERT(size % patternSize == 0, UR_RESULT_ERROR_INVALID_SIZE);
+  std::vector<uint8_t> Pattern(static_cast<const uint8_t *>(pPattern),
+                               static_cast<const uint8_t *>(pPattern) +
+                                   patternSize);
+  std::vector<native_cpu::task_t> tasks;
+  native_cpu::appendFillTasks(tasks, hCommandBuffer->hDevice->tp, ptr,
+                              std::move(Pattern), size);
+  return hCommandBuffer->appendCommand(std::move(tasks),
+                                       numSyncPointsInWaitList,
+                                       pSyncPointWaitList, pSyncPoint);
+}
+
+ur_result_t
+appendCopy(ur_exp_command_buffer_handle_t hCommandBuffer, void *pDst,
+           const void *pSrc, size_t size, uint32_t numSyncPointsInWaitList,
+           const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+           ur_exp_command_buffer_sync_point_t *pSyncPoint) {
+  UR_ASSERT(pDst, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pSrc, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  std::vector<native_cpu::task_t> tasks;
+  native_cpu::appendCopyTasks(tasks, hCommandBuffer->hDevice->tp, pDst, pSrc,
+                              size);
+  return hCommandBuffer->appendCommand(std::move(tasks),
+                                       numSyncPointsInWaitList,
+                                       pSyncPointWaitList, pSyncPoint);
+}
+
+ur_result_t
+appendRect(ur_exp_command_buffer_handle_t hCommandBuffer, void *pDst,
+           const native_cpu::RectT &DstRect, const void *pSrc,
+           const native_cpu::RectT &SrcRect, ur_rect_region_t region,
+           uint32_t numSyncPointsInWaitList,
+           const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+           ur_exp_command_buffer_sync_point_t *pSyncPoint) {
+  UR_ASSERT(pDst, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pSrc, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  std::vector<native_cpu::task_t> tasks;
+  native_cpu::appendRectTasks(tasks, hCommandBuffer->hDevice->tp, pDst,
+                              DstRect, pSrc, SrcRect, region);
+  return hCommandBuffer->appendCommand(std::move(tasks),
+                                       numSyncPointsInWaitList,
+                                       pSyncPointWaitList, pSyncPoint);
+}
+
+// The state of a single submission of a command-buffer.
+struct Submission {
+  Submission(ur_exp_command_buffer_handle_t hCommandBuffer,
+             ur_event_handle_t event)
+      : CommandBuffer(hCommandBuffer), Event(event),
+        NumPending(new std::atomic<uint32_t>[hCommandBuffer->Commands.size()]),
+        NumRemaining(hCommandBuffer->Commands.size()) {
+    for (size_t i = 0; i < hCommandBuffer->Commands.size(); i++) {
+      NumPending[i] = hCommandBuffer->Commands[i].NumDeps;
+    }
+  }
+  ur_exp_command_buffer_handle_t CommandBuffer;
+  ur_event_handle_t Event;
+  // The number of unfinished dependencies of each command.
+  std::unique_ptr<std::atomic<uint32_t>[]> NumPending;
+  // The number of unfinished commands.
+  std::atomic<size_t> NumRemaining;
+};
+
+// Runs the command at index and, once it has finished, the commands that
+// were only waiting for it.
+void runCommand(const std::shared_ptr<Submission> &submission,
+                uint32_t index) {
+  const auto &command = submission->CommandBuffer->Commands[index];
+  native_cpu::scheduleTasks(
+      submission->CommandBuffer->hDevice->tp, command.Tasks,
+      [submission, &command]() {
+        for (auto successor : command.Successors) {
+          if (--submission->NumPending[successor] == 0) {
+            runCommand(submission, successor);
+          }
+        }
+        if (--submission->NumRemaining == 0) {
+          submission->Event->set_complete();
+        }
+      });
+}
+} // namespace
+
 UR_APIEXPORT ur_result_t UR_APICALL
-urCommandBufferRetainExp(ur_exp_command_buffer_handle_t) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+urCommandBufferCreateExp(ur_context_handle_t hContext,
+                         ur_device_handle_t hDevice,
+                         const ur_exp_command_buffer_desc_t *pCommandBufferDesc,
+                         ur_exp_command_buffer_handle_t *phCommandBuffer) {
+  UR_ASSERT(pCommandBufferDesc, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  if (pCommandBufferDesc->isUpdatable) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+  *phCommandBuffer = new ur_exp_command_buffer_handle_t_(hContext, hDevice,
+                                                         *pCommandBufferDesc);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urCommandBufferReleaseExp(ur_exp_command_buffer_handle_t) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+urCommandBufferRetainExp(ur_exp_command_buffer_handle_t hCommandBuffer) {
+  hCommandBuffer->incrementReferenceCount();
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urCommandBufferFinalizeExp(ur_exp_command_buffer_handle_t) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+urCommandBufferReleaseExp(ur_exp_command_buffer_handle_t hCommandBuffer) {
+  decrementOrDelete(hCommandBuffer);
+  return UR_RESULT_SUCCESS;
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL
+urCommandBufferFinalizeExp(ur_exp_command_buffer_handle_t hCommandBuffer) {
+  UR_ASSERT(!hCommandBuffer->IsFinalized, UR_RESULT_ERROR_INVALID_OPERATION);
+  for (uint32_t i = 0; i < hCommandBuffer->Commands.size(); i++) {
+    if (hCommandBuffer->Commands[i].NumDeps == 0) {
+      hCommandBuffer->Roots.push_back(i);
+    }
+  }
+  hCommandBuffer->IsFinalized = true;
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendKernelLaunchExp(
-    ur_exp_command_buffer_handle_t, ur_kernel_handle_t, uint32_t,
-    const size_t *, const size_t *, const size_t *, uint32_t,
-    ur_kernel_handle_t *, uint32_t, const ur_exp_command_buffer_sync_point_t *,
-    uint32_t, const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_kernel_handle_t hKernel,
+    uint32_t workDim, const size_t *pGlobalWorkOffset,
+    const size_t *pGlobalWorkSize, const size_t *pLocalWorkSize,
+    uint32_t numKernelAlternatives, ur_kernel_handle_t *,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_ASSERT(!hCommandBuffer->IsFinalized, UR_RESULT_ERROR_INVALID_OPERATION);
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  if (numKernelAlternatives) {
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+  UR_CALL(native_cpu::checkKernelLaunch(hKernel, workDim, pGlobalWorkSize,
+                                        pLocalWorkSize));
+
+  native_cpu::NDRDescT ndr(workDim, pGlobalWorkOffset, pGlobalWorkSize,
+                           pLocalWorkSize);
+  auto &tp = hCommandBuffer->hDevice->tp;
+  const size_t numParallelThreads = tp.num_threads();
+  auto launchArgs =
+      std::make_unique<native_cpu::launch_args>(*hKernel, numParallelThreads);
+  std::vector<native_cpu::task_t> Tasks;
+  native_cpu::appendWGRangeTasks(
+      Tasks, ndr, *hKernel, *launchArgs,
+      numParallelThreads *
+          native_cpu::Scheduler<native_cpu::threadpool_t>::TasksPerThread());
+  UR_CALL(hCommandBuffer->appendCommand(std::move(Tasks),
+                                        numSyncPointsInWaitList,
+                                        pSyncPointWaitList, pSyncPoint));
+
+  hKernel->incrementReferenceCount();
+  hCommandBuffer->Kernels.push_back(hKernel);
+  hCommandBuffer->LaunchArgs.push_back(std::move(launchArgs));
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urCommandBufferAppendKernelLaunchWithArgsExp(
-    ur_exp_command_buffer_handle_t, ur_kernel_handle_t, uint32_t,
-    const size_t *, const size_t *, const size_t *, uint32_t,
-    const ur_exp_kernel_arg_properties_t *, uint32_t, ur_kernel_handle_t *,
-    uint32_t, const ur_exp_command_buffer_sync_point_t *, uint32_t,
-    const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_kernel_handle_t hKernel,
+    uint32_t workDim, const size_t *pGlobalWorkOffset,
+    const size_t *pGlobalWorkSize, const size_t *pLocalWorkSize,
+    uint32_t numArgs, const ur_exp_kernel_arg_properties_t *pArgs,
+    uint32_t numKernelAlternatives, ur_kernel_handle_t *phKernelAlternatives,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(native_cpu::setKernelArgs(hKernel, numArgs, pArgs));
+  return urCommandBufferAppendKernelLaunchExp(
+      hCommandBuffer, hKernel, workDim, pGlobalWorkOffset, pGlobalWorkSize,
+      pLocalWorkSize, numKernelAlternatives, phKernelAlternatives,
+      numSyncPointsInWaitList, pSyncPointWaitList, numEventsInWaitList,
+      phEventWaitList, pSyncPoint, phEvent, phCommand);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMMemcpyExp(
-    ur_exp_command_buffer_handle_t, void *, const void *, size_t, uint32_t,
-    const ur_exp_command_buffer_sync_point_t *, uint32_t,
-    const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, void *pDst, const void *pSrc,
+    size_t size, uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendCopy(hCommandBuffer, pDst, pSrc, size, numSyncPointsInWaitList,
+                    pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferCopyExp(
-    ur_exp_command_buffer_handle_t, ur_mem_handle_t, ur_mem_handle_t, size_t,
-    size_t, size_t, uint32_t, const ur_exp_command_buffer_sync_point_t *,
-    uint32_t, const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hSrcMem,
+    ur_mem_handle_t hDstMem, size_t srcOffset, size_t dstOffset, size_t size,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendCopy(hCommandBuffer, hDstMem->_mem + dstOffset,
+                    hSrcMem->_mem + srcOffset, size, numSyncPointsInWaitList,
+                    pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferCopyRectExp(
-    ur_exp_command_buffer_handle_t, ur_mem_handle_t, ur_mem_handle_t,
-    ur_rect_offset_t, ur_rect_offset_t, ur_rect_region_t, size_t, size_t,
-    size_t, size_t, uint32_t, const ur_exp_command_buffer_sync_point_t *,
-    uint32_t, const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hSrcMem,
+    ur_mem_handle_t hDstMem, ur_rect_offset_t srcOrigin,
+    ur_rect_offset_t dstOrigin, ur_rect_region_t region, size_t srcRowPitch,
+    size_t srcSlicePitch, size_t dstRowPitch, size_t dstSlicePitch,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendRect(
+      hCommandBuffer, hDstMem->_mem,
+      native_cpu::RectT(dstOrigin, region, dstRowPitch, dstSlicePitch),
+      hSrcMem->_mem,
+      native_cpu::RectT(srcOrigin, region, srcRowPitch, srcSlicePitch),
+      region, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT
 ur_result_t UR_APICALL urCommandBufferAppendMemBufferWriteExp(
-    ur_exp_command_buffer_handle_t, ur_mem_handle_t, size_t, size_t,
-    const void *, uint32_t, const ur_exp_command_buffer_sync_point_t *,
-    uint32_t, const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    size_t offset, size_t size, const void *pSrc,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendCopy(hCommandBuffer, hBuffer->_mem + offset, pSrc, size,
+                    numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT
 ur_result_t UR_APICALL urCommandBufferAppendMemBufferReadExp(
-    ur_exp_command_buffer_handle_t, ur_mem_handle_t, size_t, size_t, void *,
-    uint32_t, const ur_exp_command_buffer_sync_point_t *, uint32_t,
-    const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    size_t offset, size_t size, void *pDst, uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendCopy(hCommandBuffer, pDst, hBuffer->_mem + offset, size,
+                    numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT
 ur_result_t UR_APICALL urCommandBufferAppendMemBufferWriteRectExp(
-    ur_exp_command_buffer_handle_t, ur_mem_handle_t, ur_rect_offset_t,
-    ur_rect_offset_t, ur_rect_region_t, size_t, size_t, size_t, size_t, void *,
-    uint32_t, const ur_exp_command_buffer_sync_point_t *, uint32_t,
-    const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    ur_rect_offset_t bufferOffset, ur_rect_offset_t hostOffset,
+    ur_rect_region_t region, size_t bufferRowPitch, size_t bufferSlicePitch,
+    size_t hostRowPitch, size_t hostSlicePitch, void *pSrc,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendRect(
+      hCommandBuffer, hBuffer->_mem,
+      native_cpu::RectT(bufferOffset, region, bufferRowPitch,
+                        bufferSlicePitch),
+      pSrc, native_cpu::RectT(hostOffset, region, hostRowPitch, hostSlicePitch),
+      region, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT
 ur_result_t UR_APICALL urCommandBufferAppendMemBufferReadRectExp(
-    ur_exp_command_buffer_handle_t, ur_mem_handle_t, ur_rect_offset_t,
-    ur_rect_offset_t, ur_rect_region_t, size_t, size_t, size_t, size_t, void *,
-    uint32_t, const ur_exp_command_buffer_sync_point_t *, uint32_t,
-    const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    ur_rect_offset_t bufferOffset, ur_rect_offset_t hostOffset,
+    ur_rect_region_t region, size_t bufferRowPitch, size_t bufferSlicePitch,
+    size_t hostRowPitch, size_t hostSlicePitch, void *pDst,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendRect(
+      hCommandBuffer, pDst,
+      native_cpu::RectT(hostOffset, region, hostRowPitch, hostSlicePitch),
+      hBuffer->_mem,
+      native_cpu::RectT(bufferOffset, region, bufferRowPitch,
+                        bufferSlicePitch),
+      region, numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueCommandBufferExp(
-    ur_queue_handle_t, ur_exp_command_buffer_handle_t, uint32_t,
-    const ur_event_handle_t *, ur_event_handle_t *) {
-  die("Experimental Command-buffer feature is not "
-      "implemented for the NativeCPU adapter.");
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_queue_handle_t hQueue, ur_exp_command_buffer_handle_t hCommandBuffer,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  UR_ASSERT(hCommandBuffer->IsFinalized, UR_RESULT_ERROR_INVALID_OPERATION);
+  auto submissionLock = hQueue->lockSubmission();
+  ur_event_handle_t prevEvent = native_cpu::getPrevEvent(hQueue);
+  auto event =
+      new ur_event_handle_t_(hQueue, UR_COMMAND_ENQUEUE_COMMAND_BUFFER_EXP);
+  event->tick_start();
+
+  // The command-buffer is released once the submission has completed rather
+  // than in the callback, as dropping the last reference to it releases the
+  // event of its last submission, which may be this one.
+  hCommandBuffer->incrementReferenceCount();
+  event->incrementReferenceCount();
+  ur_event_handle_t lastSubmission = hCommandBuffer->swapLastSubmission(event);
+  event->set_callback([prevEvent, lastSubmission]() {
+    if (prevEvent) {
+      decrementOrDelete(prevEvent);
+    }
+    if (lastSubmission) {
+      decrementOrDelete(lastSubmission);
+    }
+  });
+  event->on_complete(
+      [hCommandBuffer]() { decrementOrDelete(hCommandBuffer); });
+
+  auto submission = std::make_shared<Submission>(hCommandBuffer, event);
+  // The previous submission counts as one more dependency, it is dropped by
+  // the callback only once this submission has completed.
+  std::vector<ur_event_handle_t> waitList(
+      phEventWaitList, phEventWaitList + numEventsInWaitList);
+  if (lastSubmission) {
+    waitList.push_back(lastSubmission);
+  }
+  native_cpu::whenComplete(
+      static_cast<uint32_t>(waitList.size()), waitList.data(), prevEvent,
+      [submission]() {
+        const auto &Roots = submission->CommandBuffer->Roots;
+        if (Roots.empty()) {
+          submission->Event->set_complete();
+          return;
+        }
+        for (auto root : Roots) {
+          runCommand(submission, root);
+        }
+      });
+
+  if (phEvent) {
+    *phEvent = event;
+  }
+  native_cpu::setPrevEvent(hQueue, event, phEvent != nullptr);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendMemBufferFillExp(
-    ur_exp_command_buffer_handle_t, ur_mem_handle_t, const void *, size_t,
-    size_t, size_t, uint32_t, const ur_exp_command_buffer_sync_point_t *,
-    uint32_t, const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, ur_mem_handle_t hBuffer,
+    const void *pPattern, size_t patternSize, size_t offset, size_t size,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendFill(hCommandBuffer, hBuffer->_mem + offset, pPattern,
+                    patternSize, size, numSyncPointsInWaitList,
+                    pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMFillExp(
-    ur_exp_command_buffer_handle_t, void *, const void *, size_t, size_t,
-    uint32_t, const ur_exp_command_buffer_sync_point_t *, uint32_t,
-    const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, void *pMemory,
+    const void *pPattern, size_t patternSize, size_t size,
+    uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return appendFill(hCommandBuffer, pMemory, pPattern, patternSize, size,
+                    numSyncPointsInWaitList, pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMPrefetchExp(
-    ur_exp_command_buffer_handle_t, const void *, size_t,
-    ur_usm_migration_flags_t, uint32_t,
-    const ur_exp_command_buffer_sync_point_t *, uint32_t,
-    const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, const void *, size_t,
+    ur_usm_migration_flags_t, uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  // Host memory doesn't need to be migrated, but the command still orders
+  // the commands around it.
+  return hCommandBuffer->appendCommand({}, numSyncPointsInWaitList,
+                                       pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferAppendUSMAdviseExp(
-    ur_exp_command_buffer_handle_t, const void *, size_t, ur_usm_advice_flags_t,
-    uint32_t, const ur_exp_command_buffer_sync_point_t *, uint32_t,
-    const ur_event_handle_t *, ur_exp_command_buffer_sync_point_t *,
-    ur_event_handle_t *, ur_exp_command_buffer_command_handle_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer, const void *, size_t,
+    ur_usm_advice_flags_t, uint32_t numSyncPointsInWaitList,
+    const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *,
+    ur_exp_command_buffer_sync_point_t *pSyncPoint, ur_event_handle_t *phEvent,
+    ur_exp_command_buffer_command_handle_t *phCommand) {
+  UR_CALL(checkAppend(numEventsInWaitList, phEvent, phCommand));
+  return hCommandBuffer->appendCommand({}, numSyncPointsInWaitList,
+                                       pSyncPointWaitList, pSyncPoint);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferUpdateKernelLaunchExp(
@@ -205,9 +496,20 @@ urCommandBufferUpdateWaitEventsExp(ur_exp_command_buffer_command_handle_t,
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferGetInfoExp(
-    ur_exp_command_buffer_handle_t, ur_exp_command_buffer_info_t, size_t,
-    void *, size_t *) {
-  return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    ur_exp_command_buffer_handle_t hCommandBuffer,
+    ur_exp_command_buffer_info_t propName, size_t propSize, void *pPropValue,
+    size_t *pPropSizeRet) {
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+
+  switch (propName) {
+  case UR_EXP_COMMAND_BUFFER_INFO_REFERENCE_COUNT:
+    return ReturnValue(hCommandBuffer->getReferenceCount());
+  case UR_EXP_COMMAND_BUFFER_INFO_DESCRIPTOR:
+    return ReturnValue(hCommandBuffer->Desc);
+  default:
+    break;
+  }
+  return UR_RESULT_ERROR_INVALID_ENUMERATION;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urCommandBufferCommandGetInfoExp(
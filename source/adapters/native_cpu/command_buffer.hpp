@@ -0,0 +1,84 @@
+//===--------- command_buffer.hpp - Native CPU Adapter --------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "common.hpp"
+#include "enqueue.hpp"
+#include "kernel.hpp"
+#include "unified-runtime/ur_api.h"
+
+// A command-buffer is recorded into a graph of commands whose tasks are built
+// up front: the work-groups of kernel launches are already partitioned and
+// their arguments snapshotted, so that enqueuing the command-buffer only has
+// to hand the tasks of each command to the thread pool once the commands it
+// depends on have finished.
+struct ur_exp_command_buffer_handle_t_ : RefCounted {
+  ur_exp_command_buffer_handle_t_(ur_context_handle_t hContext,
+                                  ur_device_handle_t hDevice,
+                                  const ur_exp_command_buffer_desc_t &desc)
+      : hContext(hContext), hDevice(hDevice), Desc(desc) {
+    Desc.pNext = nullptr;
+  }
+
+  ~ur_exp_command_buffer_handle_t_() {
+    if (LastSubmission) {
+      decrementOrDelete(LastSubmission);
+    }
+    for (auto hKernel : Kernels) {
+      decrementOrDelete(hKernel);
+    }
+  }
+
+  struct command_t {
+    std::vector<native_cpu::task_t> Tasks;
+    // The commands that depend on this one.
+    std::vector<uint32_t> Successors;
+    // The number of commands this one depends on.
+    uint32_t NumDeps = 0;
+  };
+
+  // Adds a command running tasks once the commands in pSyncPointWaitList have
+  // finished, or the previous command for in-order command-buffers.
+  ur_result_t
+  appendCommand(std::vector<native_cpu::task_t> &&tasks,
+                uint32_t numSyncPointsInWaitList,
+                const ur_exp_command_buffer_sync_point_t *pSyncPointWaitList,
+                ur_exp_command_buffer_sync_point_t *pSyncPoint);
+
+  // Takes over the reference to the event of a submission of the
+  // command-buffer and returns the previous one, which it has to wait for.
+  ur_event_handle_t swapLastSubmission(ur_event_handle_t event) {
+    std::lock_guard<std::mutex> lock(Mutex);
+    std::swap(LastSubmission, event);
+    return event;
+  }
+
+  ur_context_handle_t hContext;
+  ur_device_handle_t hDevice;
+  ur_exp_command_buffer_desc_t Desc;
+  bool IsFinalized = false;
+  std::vector<command_t> Commands;
+  // The commands without dependencies, which start off a submission.
+  std::vector<uint32_t> Roots;
+  // The kernels launched by the command-buffer and their argument snapshots,
+  // which are shared by all submissions.
+  std::vector<ur_kernel_handle_t> Kernels;
+  std::vector<std::unique_ptr<native_cpu::launch_args>> LaunchArgs;
+
+private:
+  std::mutex Mutex;
+  // Submissions of a command-buffer run one after the other, as they share
+  // the local memory of the argument snapshots.
+  ur_event_handle_t LastSubmission = nullptr;
+};
@@ -9,13 +9,16 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <map>
 #include <mutex>
-#include <set>
 #include <unified-runtime/ur_api.h>
 
 #include "common.hpp"
 #include "device.hpp"
 #include "ur/ur.hpp"
+#include "usm.hpp"
 
 namespace native_cpu {
 struct usm_alloc_info {
@@ -28,11 +31,14 @@ struct usm_alloc_info {
   // We store a pointer to the actual allocation because it is needed when
   // freeing memory.
   void *base_alloc_ptr;
+  // Whether the allocation has to be returned to the buckets of pool.
+  bool pooled;
   constexpr usm_alloc_info(ur_usm_type_t type, const void *base_ptr,
                            size_t size, ur_device_handle_t device,
-                           ur_usm_pool_handle_t pool, void *base_alloc_ptr)
+                           ur_usm_pool_handle_t pool, void *base_alloc_ptr,
+                           bool pooled = false)
       : type(type), base_ptr(base_ptr), size(size), device(device), pool(pool),
-        base_alloc_ptr(base_alloc_ptr) {}
+        base_alloc_ptr(base_alloc_ptr), pooled(pooled) {}
 };
 
 constexpr usm_alloc_info usm_alloc_info_null_entry(UR_USM_TYPE_UNKNOWN, nullptr,
@@ -62,11 +68,16 @@ static size_t get_padding(uint32_t alignment) {
 // To satisfy the alignment requirements we "pad" the memory
 // allocation so that the pointer returned to the user
 // always satisfies (ptr % align) == 0.
-static inline void *malloc_impl(uint32_t alignment, size_t size) {
+static inline size_t get_alloc_size(uint32_t alignment, size_t size) {
   assert(alignment >= alignof(usm_alloc_info) &&
          "memory not aligned to usm_alloc_info");
-  void *ptr = native_cpu::aligned_malloc(
-      alignment, alloc_header_size + get_padding(alignment) + size);
+  return alloc_header_size + get_padding(alignment) + size;
+}
+
+static inline void *malloc_impl(uint32_t alignment, size_t size) {
+  // aligned_malloc requires size to be a multiple of alignment; round up.
+  size = (get_alloc_size(alignment, size) + alignment - 1) & ~(alignment - 1);
+  void *ptr = native_cpu::aligned_malloc(alignment, size);
   return ptr;
 }
 
@@ -76,9 +87,102 @@ static inline uint8_t *get_alloc_info_addr(const void *ptr) {
   return (uint8_t *)const_cast<void *>(ptr) - alloc_header_size;
 }
 
-static usm_alloc_info get_alloc_info(void *ptr) {
-  return *(usm_alloc_info *)get_alloc_info_addr(ptr);
-}
+// Tracks the USM allocations of a context. The allocations are spread over
+// shards by the granule of their base address, each shard with its own lock,
+// so that threads allocating and freeing concurrently rarely contend. Each
+// shard is ordered by base address, so that the allocation containing an
+// arbitrary pointer can still be found with one ordered lookup per shard.
+class usm_alloc_registry {
+public:
+  void insert(const usm_alloc_info *info) {
+    auto key = reinterpret_cast<uintptr_t>(info->base_ptr);
+    auto &shard = get_shard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.allocations.emplace(key, info);
+  }
+
+  // Removes the allocation starting at ptr and returns its info, or nullptr
+  // if there is none.
+  const usm_alloc_info *erase(const void *ptr) {
+    auto key = reinterpret_cast<uintptr_t>(ptr);
+    auto &shard = get_shard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.allocations.find(key);
+    if (it == shard.allocations.end()) {
+      return nullptr;
+    }
+    const usm_alloc_info *info = it->second;
+    shard.allocations.erase(it);
+    return info;
+  }
+
+  // Returns the info of the allocation starting at ptr, or nullptr if there
+  // is none.
+  const usm_alloc_info *find(const void *ptr) {
+    auto key = reinterpret_cast<uintptr_t>(ptr);
+    auto &shard = get_shard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.allocations.find(key);
+    return it == shard.allocations.end() ? nullptr : it->second;
+  }
+
+  // Returns the info of the allocation ptr points into, or nullptr if there
+  // is none.
+  const usm_alloc_info *find_containing(const void *ptr) {
+    auto key = reinterpret_cast<uintptr_t>(ptr);
+    // Most pointers into an allocation are in the same granule as its base,
+    // so its shard is looked at first.
+    auto &owner = get_shard(key);
+    if (auto info = find_containing(owner, key)) {
+      return info;
+    }
+    // The base of an allocation spanning several granules may be in any
+    // shard.
+    for (auto &shard : shards) {
+      if (&shard == &owner) {
+        continue;
+      }
+      if (auto info = find_containing(shard, key)) {
+        return info;
+      }
+    }
+    return nullptr;
+  }
+
+private:
+  static constexpr unsigned NumShardsLog2 = 4;
+
+  struct alignas(64) shard_t {
+    std::mutex mutex;
+    std::map<uintptr_t, const usm_alloc_info *> allocations;
+  };
+
+  // Allocations are assigned to shards by the granule their base is in.
+  static constexpr unsigned GranuleSizeLog2 = 16;
+
+  shard_t &get_shard(uintptr_t key) {
+    // Mix the granule index so that neighbouring granules use different
+    // shards.
+    uint64_t hash =
+        static_cast<uint64_t>(key >> GranuleSizeLog2) * 0x9E3779B97F4A7C15ull;
+    return shards[hash >> (64 - NumShardsLog2)];
+  }
+
+  static const usm_alloc_info *find_containing(shard_t &shard,
+                                               uintptr_t key) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    // Allocations don't overlap, so only the last one starting at or before
+    // key can contain it.
+    auto it = shard.allocations.upper_bound(key);
+    if (it == shard.allocations.begin()) {
+      return nullptr;
+    }
+    --it;
+    return key - it->first < it->second->size ? it->second : nullptr;
+  }
+
+  std::array<shard_t, size_t{1} << NumShardsLog2> shards;
+};
 
 } // namespace native_cpu
 
@@ -88,35 +192,44 @@ struct ur_context_handle_t_ : RefCounted {
   ur_device_handle_t _device;
 
   ur_result_t remove_alloc(void *ptr) {
-    std::lock_guard<std::mutex> lock(alloc_mutex);
-    const native_cpu::usm_alloc_info &info = native_cpu::get_alloc_info(ptr);
-    UR_ASSERT(info.type != UR_USM_TYPE_UNKNOWN,
-              UR_RESULT_ERROR_INVALID_MEM_OBJECT);
+    const native_cpu::usm_alloc_info *info = allocations.erase(ptr);
+    UR_ASSERT(info, UR_RESULT_ERROR_INVALID_MEM_OBJECT);
 
-    native_cpu::aligned_free(info.base_alloc_ptr);
-    allocations.erase(ptr);
+    if (ur_usm_pool_handle_t pool = info->pool) {
+      size_t allocSize =
+          static_cast<const uint8_t *>(info->base_ptr) -
+          static_cast<const uint8_t *>(info->base_alloc_ptr) + info->size;
+      pool->deallocate(info->base_alloc_ptr, allocSize, info->size,
+                       info->pooled);
+      // Drop the reference of the allocation, the pool may have been
+      // released by the application already.
+      decrementOrDelete(pool);
+    } else {
+      native_cpu::aligned_free(info->base_alloc_ptr);
+    }
     return UR_RESULT_SUCCESS;
   }
 
-  // Note this is made non-const to access the mutex
+  // Returns the info of the allocation ptr points into.
   const native_cpu::usm_alloc_info &get_alloc_info_entry(const void *ptr) {
-    std::lock_guard<std::mutex> lock(alloc_mutex);
-    auto it = allocations.find(ptr);
-    if (it == allocations.end()) {
-      return native_cpu::usm_alloc_info_null_entry;
+    const native_cpu::usm_alloc_info *info = allocations.find(ptr);
+    if (!info) {
+      info = allocations.find_containing(ptr);
     }
-
-    return *(native_cpu::usm_alloc_info *)native_cpu::get_alloc_info_addr(ptr);
+    return info ? *info : native_cpu::usm_alloc_info_null_entry;
   }
 
   void *add_alloc(uint32_t alignment, ur_usm_type_t type, size_t size,
                   ur_usm_pool_handle_t pool) {
-    std::lock_guard<std::mutex> lock(alloc_mutex);
     // We need to ensure that we align to at least alignof(usm_alloc_info),
     // otherwise its start address may be unaligned.
     alignment =
         std::max<size_t>(alignment, alignof(native_cpu::usm_alloc_info));
-    void *alloc = native_cpu::malloc_impl(alignment, size);
+    bool pooled = false;
+    void *alloc =
+        pool ? pool->allocate(native_cpu::get_alloc_size(alignment, size),
+                              alignment, size, pooled)
+             : native_cpu::malloc_impl(alignment, size);
     if (!alloc)
       return nullptr;
     // Compute the address of the pointer that we'll return to the user.
@@ -126,15 +239,19 @@ struct ur_context_handle_t_ : RefCounted {
     if (!info_addr)
       return nullptr;
     // Do a placement new of the alloc_info to avoid allocation and copy
-    auto info = new (info_addr)
-        native_cpu::usm_alloc_info(type, ptr, size, this->_device, pool, alloc);
+    auto info = new (info_addr) native_cpu::usm_alloc_info(
+        type, ptr, size, this->_device, pool, alloc, pooled);
     if (!info)
       return nullptr;
-    allocations.insert(ptr);
+    if (pool) {
+      // Keep the pool alive for as long as the allocation is, so that it
+      // can still be freed after the pool was released.
+      pool->incrementReferenceCount();
+    }
+    allocations.insert(info);
     return ptr;
   }
 
 private:
-  std::mutex alloc_mutex;
-  std::set<const void *> allocations;
+  native_cpu::usm_alloc_registry allocations;
 };
@@ -5,87 +5,142 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
 //===----------------------------------------------------------------------===//
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "unified-runtime/ur_api.h"
 
 #include "common.hpp"
+#include "enqueue.hpp"
 #include "event.hpp"
 #include "kernel.hpp"
 #include "memory.hpp"
+#include "partitioning.hpp"
 #include "queue.hpp"
 #include "threadpool.hpp"
 
 namespace native_cpu {
-struct NDRDescT {
-  using RangeT = std::array<size_t, 3>;
-  uint32_t WorkDim;
-  RangeT GlobalOffset;
-  RangeT GlobalSize;
-  RangeT LocalSize;
-  NDRDescT(uint32_t WorkDim, const size_t *GlobalWorkOffset,
-           const size_t *GlobalWorkSize, const size_t *LocalWorkSize)
-      : WorkDim(WorkDim) {
-    for (uint32_t I = 0; I < WorkDim; I++) {
-      GlobalOffset[I] = GlobalWorkOffset ? GlobalWorkOffset[I] : 0;
-      GlobalSize[I] = GlobalWorkSize[I];
-      LocalSize[I] = LocalWorkSize ? LocalWorkSize[I] : 1;
-    }
-    for (uint32_t I = WorkDim; I < 3; I++) {
-      GlobalSize[I] = 1;
-      LocalSize[I] = LocalSize[0] ? 1 : 0;
-      GlobalOffset[I] = 0;
-    }
-  }
+namespace {
+// Tasks handed to the thread pool together by scheduleTasks.
+struct TaskGroup {
+  TaskGroup(size_t numPending, std::function<void()> &&done)
+      : numPending(numPending), done(std::move(done)) {}
+  std::atomic<size_t> numPending;
+  std::function<void()> done;
+};
 
-  void dump(std::ostream &os) const {
-    os << "GlobalSize: " << GlobalSize[0] << " " << GlobalSize[1] << " "
-       << GlobalSize[2] << "\n";
-    os << "LocalSize: " << LocalSize[0] << " " << LocalSize[1] << " "
-       << LocalSize[2] << "\n";
-    os << "GlobalOffset: " << GlobalOffset[0] << " " << GlobalOffset[1] << " "
-       << GlobalOffset[2] << "\n";
-  }
+// A callback waiting for the completion of a set of events.
+struct PendingDeps {
+  PendingDeps(size_t numPending, std::function<void()> &&f)
+      : numPending(numPending), f(std::move(f)) {}
+  std::atomic<size_t> numPending;
+  std::function<void()> f;
 };
+} // namespace
 
-namespace {
-class WaitInfo {
-  std::vector<ur_event_handle_t> *const events;
-  static_assert(std::is_pointer_v<ur_event_handle_t>);
-
-public:
-  WaitInfo(uint32_t numEvents, const ur_event_handle_t *WaitList)
-      : events(numEvents ? new std::vector<ur_event_handle_t>(
-                               WaitList, WaitList + numEvents)
-                         : nullptr) {}
-  void wait() const {
-    if (events)
-      urEventWait(events->size(), events->data());
+void scheduleTasks(threadpool_t &tp, const std::vector<task_t> &tasks,
+                   std::function<void()> &&done) {
+  if (tasks.empty()) {
+    done();
+    return;
   }
-  std::unique_ptr<std::vector<ur_event_handle_t>> getUniquePtr() {
-    return std::unique_ptr<std::vector<ur_event_handle_t>>(events);
+  auto group = std::make_shared<TaskGroup>(tasks.size(), std::move(done));
+  auto Tasks = getScheduler(tp);
+  for (const auto &task : tasks) {
+    Tasks.schedule([group, &task](size_t threadId) {
+      task(threadId);
+      if (--group->numPending == 0) {
+        group->done();
+      }
+    });
   }
-};
+}
 
-template <class T>
-inline static WaitInfo getWaitInfo(uint32_t numEventsInWaitList,
-                                   const ur_event_handle_t *phEventWaitList,
-                                   const T &scheduler) {
-  if (numEventsInWaitList && !scheduler.CanWaitInThread()) {
-    // Waiting for dependent events in threads launched by the enqueue may
-    // not work correctly for some backend/schedulers, so we have the safe
-    // option here to wait in the main thread instead (potentially at the
-    // expense of performance).
-    urEventWait(numEventsInWaitList, phEventWaitList);
-    numEventsInWaitList = 0;
+void scheduleTasks(threadpool_t &tp, std::vector<task_t> &&tasks,
+                   std::function<void()> &&done) {
+  auto owned = std::make_shared<std::vector<task_t>>(std::move(tasks));
+  scheduleTasks(tp, *owned,
+                [owned, done = std::move(done)]() { done(); });
+}
+
+void whenComplete(uint32_t numEvents, const ur_event_handle_t *phEvents,
+                  ur_event_handle_t prevEvent, std::function<void()> &&f) {
+  // The extra count is dropped once all the completion callbacks are
+  // registered, so that f can't be called before that.
+  auto pending = std::make_shared<PendingDeps>(
+      numEvents + (prevEvent ? 1 : 0) + 1, std::move(f));
+  auto onComplete = [pending]() {
+    if (--pending->numPending == 0) {
+      pending->f();
+    }
+  };
+  for (uint32_t i = 0; i < numEvents; i++) {
+    phEvents[i]->on_complete(onComplete);
+  }
+  if (prevEvent) {
+    prevEvent->on_complete(onComplete);
   }
-  return native_cpu::WaitInfo(numEventsInWaitList, phEventWaitList);
+  onComplete();
+}
+
+// Submits the tasks of the command signalled by event. Rather than having
+// the tasks wait for the dependencies of the command, which parks a thread
+// of the pool per task, the tasks are only submitted once the completion
+// callback of the last dependency has run. The last task to finish completes
+// the event.
+static void submit(ur_event_handle_t event, std::vector<task_t> &&tasks,
+                   uint32_t numEventsInWaitList,
+                   const ur_event_handle_t *phEventWaitList,
+                   ur_event_handle_t prevEvent) {
+  whenComplete(numEventsInWaitList, phEventWaitList, prevEvent,
+               [event, tasks = std::move(tasks)]() mutable {
+                 scheduleTasks(event->getQueue()->getDevice()->tp,
+                               std::move(tasks),
+                               [event]() { event->set_complete(); });
+               });
+}
+
+ur_event_handle_t getPrevEvent(ur_queue_handle_t hQueue) {
+  return hQueue->isInOrder() ? hQueue->getLastEvent() : nullptr;
+}
+
+void setPrevEvent(ur_queue_handle_t hQueue, ur_event_handle_t event,
+                  bool isUserEvent) {
+  if (!hQueue->isInOrder())
+    return;
+  if (isUserEvent)
+    event->incrementReferenceCount();
+  hQueue->setLastEvent(event);
+}
+
+// Returns whether a blocking command of hQueue has to be chained after its
+// dependencies rather than run right away, and drops prevEvent if it doesn't.
+// Must be called with the submission lock held.
+static bool hasPendingDeps(ur_queue_handle_t hQueue,
+                           uint32_t numEventsInWaitList,
+                           ur_event_handle_t prevEvent) {
+  if (!prevEvent) {
+    // The dependencies of a command of an out-of-order queue are waited for
+    // on the calling thread, which holds no lock.
+    return hQueue->isInOrder() && numEventsInWaitList;
+  }
+  if (prevEvent->getExecutionStatus() != UR_EVENT_STATUS_COMPLETE) {
+    return true;
+  }
+  // Every command of the queue has completed already.
+  hQueue->setLastEvent(nullptr);
+  decrementOrDelete(prevEvent);
+  return numEventsInWaitList;
 }
 
-} // namespace
 } // namespace native_cpu
 
 static inline native_cpu::state getState(const native_cpu::NDRDescT &ndr) {
@@ -96,32 +151,57 @@ static inline native_cpu::state getState(const native_cpu::NDRDescT &ndr) {
   return resized_state;
 }
 
-static ur_result_t urEnqueueKernelLaunch(
-    ur_queue_handle_t hQueue, ur_kernel_handle_t hKernel, uint32_t workDim,
-    const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
-    const size_t *pLocalWorkSize,
-    const ur_kernel_launch_ext_properties_t *launchPropList,
-    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
-    ur_event_handle_t *phEvent) {
-
-  ur_kernel_launch_ext_properties_t *_launchPropList =
-      const_cast<ur_kernel_launch_ext_properties_t *>(launchPropList);
-  if (_launchPropList && _launchPropList->flags) {
-    // We don't support any flags.
-    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
-  }
+// Runs the work-groups in the linearized range [rangeStart, rangeEnd).
+static inline void runWGRange(const native_cpu::NDRDescT &ndr,
+                              const ur_kernel_handle_t_ &kernel,
+                              const native_cpu::launch_args &launchArgs,
+                              native_cpu::state &state, size_t threadId,
+                              size_t rangeStart, size_t rangeEnd) {
+  void *const *args = launchArgs.get(threadId);
+  const size_t numWG0 = ndr.GlobalSize[0] / ndr.LocalSize[0];
+  const size_t numWG1 = ndr.GlobalSize[1] / ndr.LocalSize[1];
+  native_cpu::forEachWG(
+      numWG0, numWG1, rangeStart, rangeEnd,
+      [&](size_t g0, size_t g1, size_t g2) {
+#ifdef NATIVECPU_USE_OCK
+        state.update(g0, g1, g2);
+        kernel._subhandler(args, &state);
+#else
+        for (size_t local2 = 0; local2 < ndr.LocalSize[2]; ++local2) {
+          for (size_t local1 = 0; local1 < ndr.LocalSize[1]; ++local1) {
+            for (size_t local0 = 0; local0 < ndr.LocalSize[0]; ++local0) {
+              state.update(g0, g1, g2, local0, local1, local2);
+              kernel._subhandler(args, &state);
+            }
+          }
+        }
+#endif
+      });
+}
 
-  while (_launchPropList != nullptr) {
-    if (_launchPropList->stype !=
-        as_stype<ur_kernel_launch_ext_properties_t>()) {
-      // We don't support any launch properties.
-      return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
-    }
-    _launchPropList = static_cast<ur_kernel_launch_ext_properties_t *>(
-        _launchPropList->pNext);
-  }
+void native_cpu::appendWGRangeTasks(std::vector<task_t> &Tasks,
+                                    const NDRDescT &ndr,
+                                    const ur_kernel_handle_t_ &kernel,
+                                    const launch_args &launchArgs,
+                                    size_t numTasks) {
+  const size_t numWG = (ndr.GlobalSize[0] / ndr.LocalSize[0]) *
+                       (ndr.GlobalSize[1] / ndr.LocalSize[1]) *
+                       (ndr.GlobalSize[2] / ndr.LocalSize[2]);
+  forEachStaticWGRange(numWG, numTasks, [&](size_t rangeStart,
+                                             size_t rangeEnd) {
+    Tasks.emplace_back([ndr, &kernel, &launchArgs, rangeStart,
+                        rangeEnd](size_t threadId) {
+      auto state = getState(ndr);
+      runWGRange(ndr, kernel, launchArgs, state, threadId, rangeStart,
+                 rangeEnd);
+    });
+  });
+}
 
-  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+ur_result_t native_cpu::checkKernelLaunch(ur_kernel_handle_t hKernel,
+                                          uint32_t workDim,
+                                          const size_t *pGlobalWorkSize,
+                                          const size_t *pLocalWorkSize) {
   UR_ASSERT(hKernel, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
   UR_ASSERT(workDim > 0, UR_RESULT_ERROR_INVALID_WORK_DIMENSION);
   UR_ASSERT(workDim < 4, UR_RESULT_ERROR_INVALID_WORK_DIMENSION);
@@ -152,8 +232,7 @@ static ur_result_t urEnqueueKernelLaunch(
   }
 
   // TODO: add proper error checking
-  native_cpu::NDRDescT ndr(workDim, pGlobalWorkOffset, pGlobalWorkSize,
-                           pLocalWorkSize);
+  native_cpu::NDRDescT ndr(workDim, nullptr, pGlobalWorkSize, pLocalWorkSize);
   unsigned long long numWI;
   auto umulll_overflow = [](unsigned long long a, unsigned long long b,
                             unsigned long long *c) -> bool {
@@ -168,139 +247,264 @@ static ur_result_t urEnqueueKernelLaunch(
       umulll_overflow(numWI, ndr.GlobalSize[2], &numWI) || numWI > SIZE_MAX) {
     return UR_RESULT_ERROR_OUT_OF_RESOURCES;
   }
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t urEnqueueKernelLaunch(
+    ur_queue_handle_t hQueue, ur_kernel_handle_t hKernel, uint32_t workDim,
+    const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
+    const size_t *pLocalWorkSize,
+    const ur_kernel_launch_ext_properties_t *launchPropList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+
+  ur_kernel_launch_ext_properties_t *_launchPropList =
+      const_cast<ur_kernel_launch_ext_properties_t *>(launchPropList);
+  if (_launchPropList && _launchPropList->flags) {
+    // We don't support any flags.
+    return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+  }
+
+  while (_launchPropList != nullptr) {
+    if (_launchPropList->stype !=
+        as_stype<ur_kernel_launch_ext_properties_t>()) {
+      // We don't support any launch properties.
+      return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
+    }
+    _launchPropList = static_cast<ur_kernel_launch_ext_properties_t *>(
+        _launchPropList->pNext);
+  }
+
+  UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  UR_CALL(native_cpu::checkKernelLaunch(hKernel, workDim, pGlobalWorkSize,
+                                        pLocalWorkSize));
 
+  native_cpu::NDRDescT ndr(workDim, pGlobalWorkOffset, pGlobalWorkSize,
+                           pLocalWorkSize);
+  auto submissionLock = hQueue->lockSubmission();
   auto &tp = hQueue->getDevice()->tp;
   const size_t numParallelThreads = tp.num_threads();
-  auto Tasks = native_cpu::getScheduler(tp);
+  std::vector<native_cpu::task_t> Tasks;
   auto numWG0 = ndr.GlobalSize[0] / ndr.LocalSize[0];
   auto numWG1 = ndr.GlobalSize[1] / ndr.LocalSize[1];
   auto numWG2 = ndr.GlobalSize[2] / ndr.LocalSize[2];
   auto event = new ur_event_handle_t_(hQueue, UR_COMMAND_KERNEL_LAUNCH);
   event->tick_start();
 
-  // Create a copy of the kernel and its arguments.
-  auto kernel = std::make_unique<ur_kernel_handle_t_>(*hKernel);
-  kernel->updateMemPool(numParallelThreads);
-
-  auto InEvents =
-      native_cpu::getWaitInfo(numEventsInWaitList, phEventWaitList, Tasks);
+  // Keep the kernel alive and take a snapshot of its arguments, so that they
+  // can be modified while the launch is in flight.
+  hKernel->incrementReferenceCount();
+  auto launchArgs =
+      std::make_unique<native_cpu::launch_args>(*hKernel, numParallelThreads);
 
   const size_t numWG = numWG0 * numWG1 * numWG2;
-  const size_t numWGPerThread = numWG / numParallelThreads;
-  const size_t remainderWG = numWG - numWGPerThread * numParallelThreads;
-  // The fourth value is the linearized value.
-  std::array<size_t, 4> rangeStart = {0, 0, 0, 0};
-  for (unsigned t = 0; t < numParallelThreads; ++t) {
-    auto rangeEnd = rangeStart;
-    rangeEnd[3] += numWGPerThread + (t < remainderWG);
-    if (rangeEnd[3] == rangeStart[3])
-      break;
-    rangeEnd[0] = rangeEnd[3] % numWG0;
-    rangeEnd[1] = (rangeEnd[3] / numWG0) % numWG1;
-    rangeEnd[2] = rangeEnd[3] / (numWG0 * numWG1);
-    Tasks.schedule([ndr, InEvents, &kernel = *kernel, rangeStart,
-                    rangeEnd = rangeEnd[3], numWG0, numWG1,
-                    numParallelThreads](size_t threadId) {
-      auto state = getState(ndr);
-      InEvents.wait();
-      for (size_t g0 = rangeStart[0], g1 = rangeStart[1], g2 = rangeStart[2],
-                  g3 = rangeStart[3];
-           g3 < rangeEnd; ++g3) {
-#ifdef NATIVECPU_USE_OCK
-        state.update(g0, g1, g2);
-        kernel._subhandler(kernel.getArgs(numParallelThreads, threadId).data(),
-                           &state);
-#else
-        for (size_t local2 = 0; local2 < ndr.LocalSize[2]; ++local2) {
-          for (size_t local1 = 0; local1 < ndr.LocalSize[1]; ++local1) {
-            for (size_t local0 = 0; local0 < ndr.LocalSize[0]; ++local0) {
-              state.update(g0, g1, g2, local0, local1, local2);
-              kernel._subhandler(
-                  kernel.getArgs(numParallelThreads, threadId).data(), &state);
-            }
-          }
-        }
-#endif
-        if (++g0 == numWG0) {
-          g0 = 0;
-          if (++g1 == numWG1) {
-            g1 = 0;
-            ++g2;
-          }
+  auto partitioning = native_cpu::getPartitioning();
+  auto launchInfo = std::make_unique<native_cpu::LaunchInfo>();
+  if (partitioning == native_cpu::Partitioning::Static) {
+    // Schedulers that balance load by stealing get finer grained tasks.
+    native_cpu::appendWGRangeTasks(
+        Tasks, ndr, *hKernel, *launchArgs,
+        numParallelThreads *
+            native_cpu::Scheduler<native_cpu::threadpool_t>::TasksPerThread());
+  } else {
+    // Every thread keeps claiming batches of work-groups until none are
+    // left, so a slow range no longer dictates the latency of the launch.
+    launchInfo->Cursor.init(numWG, numParallelThreads,
+                            hKernel->getWGCostHint(),
+                            partitioning == native_cpu::Partitioning::Guided);
+    const size_t numTasks = std::min(numWG, numParallelThreads);
+    for (size_t t = 0; t < numTasks; ++t) {
+      Tasks.emplace_back([ndr, &kernel = *hKernel, &launchArgs = *launchArgs,
+                          &launchInfo = *launchInfo](size_t threadId) {
+        auto state = getState(ndr);
+        const uint64_t start = get_timestamp();
+        size_t rangeStart, rangeEnd;
+        while (launchInfo.Cursor.claim(rangeStart, rangeEnd)) {
+          runWGRange(ndr, kernel, launchArgs, state, threadId, rangeStart,
+                     rangeEnd);
         }
-      }
-    });
-    rangeStart = rangeEnd;
+        launchInfo.BusyTime += get_timestamp() - start;
+      });
+    }
   }
-  event->set_tasksinfo(Tasks.getMovedTaskInfo());
 
   if (phEvent) {
     *phEvent = event;
   }
-  event->set_callback([kernel = std::move(kernel), hKernel, event,
-                       InEvents = InEvents.getUniquePtr()]() {
-    event->tick_end();
-    // TODO: avoid calling clear() here.
-    hKernel->_localArgInfo.clear();
+  ur_event_handle_t prevEvent = native_cpu::getPrevEvent(hQueue);
+  event->set_callback([launchArgs = std::move(launchArgs), hKernel, prevEvent,
+                       launchInfo = std::move(launchInfo), numWG]() {
+    if (uint64_t busyTime = launchInfo->BusyTime.load()) {
+      hKernel->updateWGCostHint(busyTime / numWG);
+    }
+    decrementOrDelete(hKernel);
+    // Drop the previous command as soon as this one has completed, so that
+    // a long in-order chain is released as it goes rather than recursively.
+    if (prevEvent) {
+      decrementOrDelete(prevEvent);
+    }
   });
+  native_cpu::submit(event, std::move(Tasks), numEventsInWaitList,
+                     phEventWaitList, prevEvent);
+  native_cpu::setPrevEvent(hQueue, event, phEvent != nullptr);
+
+  return UR_RESULT_SUCCESS;
+}
 
-  if (hQueue->isInOrder()) {
-    urEventWait(1, &event);
+// Submits Tasks as a command of hQueue that runs asynchronously once its
+// dependencies have completed. Must be called with the submission lock held.
+static void submitAsync(ur_command_t command_type, ur_queue_handle_t hQueue,
+                        ur_event_handle_t prevEvent,
+                        uint32_t numEventsInWaitList,
+                        const ur_event_handle_t *phEventWaitList,
+                        ur_event_handle_t *phEvent,
+                        std::vector<native_cpu::task_t> &&Tasks) {
+  ur_event_handle_t event = new ur_event_handle_t_(hQueue, command_type);
+  event->tick_start();
+  event->set_callback([prevEvent]() {
+    if (prevEvent) {
+      decrementOrDelete(prevEvent);
+    }
+  });
+  native_cpu::submit(event, std::move(Tasks), numEventsInWaitList,
+                     phEventWaitList, prevEvent);
+  if (phEvent) {
+    *phEvent = event;
   }
+  native_cpu::setPrevEvent(hQueue, event, phEvent != nullptr);
+}
+
+// Submits Tasks like submitAsync, then releases the submission lock and waits
+// for them to finish. Waiting without the lock keeps other threads from
+// stalling on it, and lets them complete the user events the command may
+// depend on.
+static void submitAndWait(ur_command_t command_type, ur_queue_handle_t hQueue,
+                          std::unique_lock<std::mutex> &submissionLock,
+                          ur_event_handle_t prevEvent,
+                          uint32_t numEventsInWaitList,
+                          const ur_event_handle_t *phEventWaitList,
+                          ur_event_handle_t *phEvent,
+                          std::vector<native_cpu::task_t> &&Tasks) {
+  ur_event_handle_t event;
+  submitAsync(command_type, hQueue, prevEvent, numEventsInWaitList,
+              phEventWaitList, &event, std::move(Tasks));
+  submissionLock.unlock();
+  event->wait();
+  if (phEvent) {
+    *phEvent = event;
+  } else {
+    decrementOrDelete(event);
+  }
+}
 
-  return UR_RESULT_SUCCESS;
+// Runs Tasks on tp and the calling thread, and returns once all of them have
+// finished.
+static void runTasks(native_cpu::threadpool_t &tp,
+                     std::vector<native_cpu::task_t> &Tasks) {
+  auto Scheduler = native_cpu::getScheduler(tp);
+  for (size_t i = 1; i < Tasks.size(); i++) {
+    Scheduler.schedule(
+        [&task = Tasks[i]](size_t threadId) { task(threadId); });
+  }
+  if (!Tasks.empty()) {
+    Tasks[0](0);
+  }
+  Scheduler.getMovedTaskInfo().wait_all();
 }
 
+// Runs f as a command of hQueue. Non-blocking commands run asynchronously on
+// the device's thread pool if they are part of an in-order queue's dependency
+// chain or an event is requested. Blocking commands of an in-order queue that
+// still has to wait for something run there too, all others run right away on
+// the calling thread.
 template <class T>
 static inline ur_result_t
 withTimingEvent(ur_command_t command_type, ur_queue_handle_t hQueue,
                 uint32_t numEventsInWaitList,
                 const ur_event_handle_t *phEventWaitList,
                 ur_event_handle_t *phEvent, T &&f, bool blocking = true) {
+  auto submissionLock = hQueue->lockSubmission();
+  ur_event_handle_t prevEvent = native_cpu::getPrevEvent(hQueue);
+  if (!blocking && (phEvent || hQueue->isInOrder())) {
+    std::vector<native_cpu::task_t> Tasks;
+    Tasks.emplace_back([f](size_t) { f(); });
+    submitAsync(command_type, hQueue, prevEvent, numEventsInWaitList,
+                phEventWaitList, phEvent, std::move(Tasks));
+    return UR_RESULT_SUCCESS;
+  }
+  if (native_cpu::hasPendingDeps(hQueue, numEventsInWaitList, prevEvent)) {
+    ur_result_t result = UR_RESULT_SUCCESS;
+    std::vector<native_cpu::task_t> Tasks;
+    Tasks.emplace_back([&result, &f](size_t) { result = f(); });
+    submitAndWait(command_type, hQueue, submissionLock, prevEvent,
+                  numEventsInWaitList, phEventWaitList, phEvent,
+                  std::move(Tasks));
+    return result;
+  }
+  urEventWait(numEventsInWaitList, phEventWaitList);
   if (phEvent) {
     ur_event_handle_t event = new ur_event_handle_t_(hQueue, command_type);
     *phEvent = event;
     event->tick_start();
-    if (blocking || hQueue->isInOrder()) {
-      urEventWait(numEventsInWaitList, phEventWaitList);
-      ur_result_t result = f();
-      event->tick_end();
-      return result;
-    }
-    auto &tp = hQueue->getDevice()->tp;
-    auto Tasks = native_cpu::getScheduler(tp);
-    auto InEvents =
-        native_cpu::getWaitInfo(numEventsInWaitList, phEventWaitList, Tasks);
-    Tasks.schedule([f, InEvents](size_t) {
-      InEvents.wait();
-      f();
-    });
-    event->set_tasksinfo(Tasks.getMovedTaskInfo());
-    event->set_callback(
-        [event, InEvents = InEvents.getUniquePtr()]() { event->tick_end(); });
-    return UR_RESULT_SUCCESS;
+    ur_result_t result = f();
+    event->set_complete();
+    return result;
   }
-  urEventWait(numEventsInWaitList, phEventWaitList);
   ur_result_t result = f();
   return result;
 }
 
+// Like withTimingEvent, but runs Tasks, which may be spread over the device's
+// thread pool even when the command runs right away.
+static ur_result_t enqueueTasks(ur_command_t command_type,
+                                ur_queue_handle_t hQueue,
+                                uint32_t numEventsInWaitList,
+                                const ur_event_handle_t *phEventWaitList,
+                                ur_event_handle_t *phEvent,
+                                std::vector<native_cpu::task_t> &&Tasks,
+                                bool blocking) {
+  auto submissionLock = hQueue->lockSubmission();
+  ur_event_handle_t prevEvent = native_cpu::getPrevEvent(hQueue);
+  if (!blocking && (phEvent || hQueue->isInOrder())) {
+    submitAsync(command_type, hQueue, prevEvent, numEventsInWaitList,
+                phEventWaitList, phEvent, std::move(Tasks));
+    return UR_RESULT_SUCCESS;
+  }
+  if (native_cpu::hasPendingDeps(hQueue, numEventsInWaitList, prevEvent)) {
+    submitAndWait(command_type, hQueue, submissionLock, prevEvent,
+                  numEventsInWaitList, phEventWaitList, phEvent,
+                  std::move(Tasks));
+    return UR_RESULT_SUCCESS;
+  }
+  urEventWait(numEventsInWaitList, phEventWaitList);
+  ur_event_handle_t event = nullptr;
+  if (phEvent) {
+    event = new ur_event_handle_t_(hQueue, command_type);
+    *phEvent = event;
+    event->tick_start();
+  }
+  runTasks(hQueue->getDevice()->tp, Tasks);
+  if (event) {
+    event->set_complete();
+  }
+  return UR_RESULT_SUCCESS;
+}
+
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWait(
     ur_queue_handle_t hQueue, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
 
-  // TODO: the wait here should be async
-  return withTimingEvent(UR_COMMAND_EVENTS_WAIT, hQueue, numEventsInWaitList,
-                         phEventWaitList, phEvent,
-                         []() { return UR_RESULT_SUCCESS; });
+  return withTimingEvent(
+      UR_COMMAND_EVENTS_WAIT, hQueue, numEventsInWaitList, phEventWaitList,
+      phEvent, []() { return UR_RESULT_SUCCESS; }, false);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueEventsWaitWithBarrier(
     ur_queue_handle_t hQueue, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  return withTimingEvent(UR_COMMAND_EVENTS_WAIT_WITH_BARRIER, hQueue,
-                         numEventsInWaitList, phEventWaitList, phEvent,
-                         []() { return UR_RESULT_SUCCESS; });
+  return withTimingEvent(
+      UR_COMMAND_EVENTS_WAIT_WITH_BARRIER, hQueue, numEventsInWaitList,
+      phEventWaitList, phEvent, []() { return UR_RESULT_SUCCESS; }, false);
 }
 
 UR_APIEXPORT ur_result_t urEnqueueEventsWaitWithBarrierExt(
@@ -311,38 +515,23 @@ UR_APIEXPORT ur_result_t urEnqueueEventsWaitWithBarrierExt(
                                         phEventWaitList, phEvent);
 }
 
-template <bool IsRead>
-static inline void MemBufferReadWriteRect_impl(
-    ur_mem_handle_t Buff, ur_rect_offset_t BufferOffset,
-    ur_rect_offset_t HostOffset, ur_rect_region_t region, size_t BufferRowPitch,
-    size_t BufferSlicePitch, size_t HostRowPitch, size_t HostSlicePitch,
-    typename std::conditional<IsRead, void *, const void *>::type DstMem) {
-  // TODO: check other constraints, performance optimizations
-  //       More sharing with level_zero where possible
-
-  if (BufferRowPitch == 0)
-    BufferRowPitch = region.width;
-  if (BufferSlicePitch == 0)
-    BufferSlicePitch = BufferRowPitch * region.height;
-  if (HostRowPitch == 0)
-    HostRowPitch = region.width;
-  if (HostSlicePitch == 0)
-    HostSlicePitch = HostRowPitch * region.height;
-  for (size_t w = 0; w < region.width; w++)
-    for (size_t h = 0; h < region.height; h++)
-      for (size_t d = 0; d < region.depth; d++) {
-        size_t buff_orign = (d + BufferOffset.z) * BufferSlicePitch +
-                            (h + BufferOffset.y) * BufferRowPitch + w +
-                            BufferOffset.x;
-        size_t host_origin = (d + HostOffset.z) * HostSlicePitch +
-                             (h + HostOffset.y) * HostRowPitch + w +
-                             HostOffset.x;
-        int8_t &buff_mem = ur_cast<int8_t *>(Buff->_mem)[buff_orign];
-        if constexpr (IsRead)
-          ur_cast<int8_t *>(DstMem)[host_origin] = buff_mem;
-        else
-          buff_mem = ur_cast<const int8_t *>(DstMem)[host_origin];
-      }
+void native_cpu::appendRectTasks(std::vector<task_t> &Tasks, threadpool_t &tp,
+                                 void *Dst, const RectT &DstRect,
+                                 const void *Src, const RectT &SrcRect,
+                                 ur_rect_region_t region) {
+  const size_t numRows = region.height * region.depth;
+  appendRangeTasks(
+      Tasks, tp, numRows, MinBytesPerTask / std::max<size_t>(region.width, 1),
+      [Dst, DstRect, Src, SrcRect, region](size_t rowStart, size_t rowEnd) {
+        for (size_t row = rowStart; row < rowEnd; row++) {
+          const size_t h = row % region.height;
+          const size_t d = row / region.height;
+          std::memcpy(static_cast<int8_t *>(Dst) + DstRect.rowOffset(h, d),
+                      static_cast<const int8_t *>(Src) +
+                          SrcRect.rowOffset(h, d),
+                      region.width);
+        }
+      });
 }
 
 template <bool IsRead>
@@ -359,19 +548,22 @@ static inline ur_result_t enqueueMemBufferReadWriteRect_impl(
     command_t = UR_COMMAND_MEM_BUFFER_READ_RECT;
   else
     command_t = UR_COMMAND_MEM_BUFFER_WRITE_RECT;
-  return withTimingEvent(
-      command_t, hQueue, NumEventsInWaitList, phEventWaitList, phEvent,
-      [BufferRowPitch, region, BufferSlicePitch, HostRowPitch, HostSlicePitch,
-       BufferOffset, HostOffset, Buff, DstMem]() {
-        MemBufferReadWriteRect_impl<IsRead>(
-            Buff, BufferOffset, HostOffset, region, BufferRowPitch,
-            BufferSlicePitch, HostRowPitch, HostSlicePitch, DstMem);
-        return UR_RESULT_SUCCESS;
-      },
-      blocking);
-}
-
-template <bool AllowPartialOverlap = true>
+  const native_cpu::RectT BufferRect(BufferOffset, region, BufferRowPitch,
+                                     BufferSlicePitch);
+  const native_cpu::RectT HostRect(HostOffset, region, HostRowPitch,
+                                   HostSlicePitch);
+  std::vector<native_cpu::task_t> Tasks;
+  auto &tp = hQueue->getDevice()->tp;
+  if constexpr (IsRead)
+    native_cpu::appendRectTasks(Tasks, tp, DstMem, HostRect, Buff->_mem,
+                                BufferRect, region);
+  else
+    native_cpu::appendRectTasks(Tasks, tp, Buff->_mem, BufferRect, DstMem,
+                                HostRect, region);
+  return enqueueTasks(command_t, hQueue, NumEventsInWaitList, phEventWaitList,
+                      phEvent, std::move(Tasks), blocking);
+}
+
 static inline ur_result_t doCopy_impl(
     ur_queue_handle_t hQueue, void *DstPtr, const void *SrcPtr, size_t Size,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
@@ -380,20 +572,15 @@ static inline ur_result_t doCopy_impl(
     bool hasInEvents = numEventsInWaitList && phEventWaitList;
     return withTimingEvent(
         command_type, hQueue, numEventsInWaitList, phEventWaitList, phEvent,
-        []() { return UR_RESULT_SUCCESS; }, blocking || !hasInEvents);
+        []() { return UR_RESULT_SUCCESS; },
+        blocking || (!hasInEvents && !hQueue->isInOrder()));
   }
 
-  return withTimingEvent(
-      command_type, hQueue, numEventsInWaitList, phEventWaitList, phEvent,
-      [DstPtr, SrcPtr, Size]() {
-        if constexpr (AllowPartialOverlap) {
-          memmove(DstPtr, SrcPtr, Size);
-        } else {
-          memcpy(DstPtr, SrcPtr, Size);
-        }
-        return UR_RESULT_SUCCESS;
-      },
-      blocking);
+  std::vector<native_cpu::task_t> Tasks;
+  native_cpu::appendCopyTasks(Tasks, hQueue->getDevice()->tp, DstPtr, SrcPtr,
+                              Size);
+  return enqueueTasks(command_type, hQueue, numEventsInWaitList,
+                      phEventWaitList, phEvent, std::move(Tasks), blocking);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferRead(
@@ -455,7 +642,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopy(
   void *DstPtr = hBufferDst->_mem + dstOffset;
   return doCopy_impl(hQueue, DstPtr, SrcPtr, size, numEventsInWaitList,
                      phEventWaitList, phEvent, UR_COMMAND_MEM_BUFFER_COPY,
-                     true /*TODO: check false for non-blocking*/);
+                     false);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopyRect(
@@ -466,8 +653,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferCopyRect(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
   return enqueueMemBufferReadWriteRect_impl<true /*read*/>(
-      hQueue, hBufferSrc, true /*todo: check false for non-blocking*/,
-      srcOrigin,
+      hQueue, hBufferSrc, false, srcOrigin,
       /*HostOffset*/ dstOrigin, region, srcRowPitch, srcSlicePitch, dstRowPitch,
       dstSlicePitch, hBufferDst->_mem, numEventsInWaitList, phEventWaitList,
       phEvent);
@@ -479,20 +665,17 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferFill(
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
   UR_ASSERT(hQueue, UR_RESULT_ERROR_INVALID_NULL_HANDLE);
-  return withTimingEvent(
-      UR_COMMAND_MEM_BUFFER_FILL, hQueue, numEventsInWaitList, phEventWaitList,
-      phEvent, [hBuffer, offset, size, patternSize, pPattern]() {
-        // TODO: error checking
-        // TODO: handle async
-        void *startingPtr = hBuffer->_mem + offset;
-        size_t steps = size / patternSize;
-        for (unsigned i = 0; i < steps; i++) {
-          memcpy(static_cast<int8_t *>(startingPtr) + i * patternSize, pPattern,
-                 patternSize);
-        }
-
-        return UR_RESULT_SUCCESS;
-      });
+  // TODO: error checking
+  // The pattern may be gone by the time the fill runs.
+  std::vector<uint8_t> Pattern(static_cast<const uint8_t *>(pPattern),
+                               static_cast<const uint8_t *>(pPattern) +
+                                   patternSize);
+  std::vector<native_cpu::task_t> Tasks;
+  native_cpu::appendFillTasks(Tasks, hQueue->getDevice()->tp,
+                              hBuffer->_mem + offset, std::move(Pattern),
+                              size - size % patternSize);
+  return enqueueTasks(UR_COMMAND_MEM_BUFFER_FILL, hQueue, numEventsInWaitList,
+                      phEventWaitList, phEvent, std::move(Tasks), false);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageRead(
@@ -529,81 +712,123 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemImageCopy(
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemBufferMap(
-    ur_queue_handle_t hQueue, ur_mem_handle_t hBuffer, bool /*blockingMap*/,
+    ur_queue_handle_t hQueue, ur_mem_handle_t hBuffer, bool blockingMap,
     ur_map_flags_t /*mapFlags*/, size_t offset, size_t /*size*/,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent, void **ppRetMap) {
 
-  return withTimingEvent(UR_COMMAND_MEM_BUFFER_MAP, hQueue, numEventsInWaitList,
-                         phEventWaitList, phEvent,
-                         [ppRetMap, hBuffer, offset]() {
-                           *ppRetMap = hBuffer->_mem + offset;
-                           return UR_RESULT_SUCCESS;
-                         });
+  // The buffer is mapped in place, so the pointer is known right away and
+  // only the synchronization is enqueued.
+  *ppRetMap = hBuffer->_mem + offset;
+  return withTimingEvent(
+      UR_COMMAND_MEM_BUFFER_MAP, hQueue, numEventsInWaitList, phEventWaitList,
+      phEvent, []() { return UR_RESULT_SUCCESS; }, blockingMap);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueMemUnmap(
     ur_queue_handle_t hQueue, ur_mem_handle_t /*hMem*/, void * /*pMappedPtr*/,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  return withTimingEvent(UR_COMMAND_MEM_UNMAP, hQueue, numEventsInWaitList,
-                         phEventWaitList, phEvent,
-                         []() { return UR_RESULT_SUCCESS; });
+  return withTimingEvent(
+      UR_COMMAND_MEM_UNMAP, hQueue, numEventsInWaitList, phEventWaitList,
+      phEvent, []() { return UR_RESULT_SUCCESS; }, false);
+}
+
+void native_cpu::fillPattern(void *ptr, const void *pPattern,
+                             size_t patternSize, size_t size) {
+  if (patternSize == 1) {
+    memset(ptr, *static_cast<const uint8_t *>(pPattern), size);
+    return;
+  }
+  // Write the pattern once, then copy what has been filled so far over the
+  // rest, doubling it each time, so that the fill is done by a few large
+  // memcpys with wide stores rather than one store per pattern. The copies
+  // are capped so that their source stays in cache.
+  auto *dest = static_cast<uint8_t *>(ptr);
+  memcpy(dest, pPattern, std::min(patternSize, size));
+  const size_t maxCopySize =
+      std::max(patternSize, MaxFillCopySize - MaxFillCopySize % patternSize);
+  for (size_t filled = patternSize; filled < size;) {
+    const size_t copySize = std::min({filled, maxCopySize, size - filled});
+    memcpy(dest + filled, dest, copySize);
+    filled += copySize;
+  }
+}
+
+void native_cpu::appendRangeTasks(std::vector<task_t> &Tasks,
+                                  threadpool_t &tp, size_t numUnits,
+                                  size_t minUnitsPerTask,
+                                  std::function<void(size_t, size_t)> &&f) {
+  const size_t numTasks = std::clamp<size_t>(
+      numUnits / std::max<size_t>(minUnitsPerTask, 1), 1, tp.num_threads());
+  if (numTasks == 1) {
+    Tasks.emplace_back(
+        [f = std::move(f), numUnits](size_t) { f(0, numUnits); });
+    return;
+  }
+  auto sharedF =
+      std::make_shared<std::function<void(size_t, size_t)>>(std::move(f));
+  const size_t numUnitsPerTask = numUnits / numTasks;
+  const size_t remainder = numUnits - numUnitsPerTask * numTasks;
+  size_t rangeStart = 0;
+  for (size_t t = 0; t < numTasks; ++t) {
+    size_t rangeEnd = rangeStart + numUnitsPerTask + (t < remainder);
+    Tasks.emplace_back([sharedF, rangeStart, rangeEnd](size_t) {
+      (*sharedF)(rangeStart, rangeEnd);
+    });
+    rangeStart = rangeEnd;
+  }
+}
+
+void native_cpu::appendFillTasks(std::vector<task_t> &Tasks, threadpool_t &tp,
+                                 void *ptr, std::vector<uint8_t> &&Pattern,
+                                 size_t size) {
+  const size_t patternSize = Pattern.size();
+  appendRangeTasks(
+      Tasks, tp, size / patternSize, MinBytesPerTask / patternSize,
+      [ptr, Pattern = std::move(Pattern)](size_t rangeStart, size_t rangeEnd) {
+        fillPattern(static_cast<uint8_t *>(ptr) + rangeStart * Pattern.size(),
+                    Pattern.data(), Pattern.size(),
+                    (rangeEnd - rangeStart) * Pattern.size());
+      });
+}
+
+void native_cpu::appendCopyTasks(std::vector<task_t> &Tasks, threadpool_t &tp,
+                                 void *pDst, const void *pSrc, size_t size) {
+  const auto dst = reinterpret_cast<uintptr_t>(pDst);
+  const auto src = reinterpret_cast<uintptr_t>(pSrc);
+  // The parts of an overlapping copy can't run concurrently, as each of them
+  // could overwrite the source of another.
+  const bool overlaps = (dst < src ? src - dst : dst - src) < size;
+  appendRangeTasks(Tasks, tp, size, overlaps ? size : MinBytesPerTask,
+                   [pDst, pSrc](size_t rangeStart, size_t rangeEnd) {
+                     memmove(static_cast<uint8_t *>(pDst) + rangeStart,
+                             static_cast<const uint8_t *>(pSrc) + rangeStart,
+                             rangeEnd - rangeStart);
+                   });
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMFill(
     ur_queue_handle_t hQueue, void *ptr, size_t patternSize,
     const void *pPattern, size_t size, uint32_t numEventsInWaitList,
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
-  return withTimingEvent(
-      UR_COMMAND_USM_FILL, hQueue, numEventsInWaitList, phEventWaitList,
-      phEvent, [ptr, pPattern, patternSize, size]() {
-        UR_ASSERT(ptr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
-        UR_ASSERT(pPattern, UR_RESULT_ERROR_INVALID_NULL_POINTER);
-        UR_ASSERT(patternSize != 0, UR_RESULT_ERROR_INVALID_SIZE)
-        UR_ASSERT(size != 0, UR_RESULT_ERROR_INVALID_SIZE)
-        UR_ASSERT(patternSize <= size, UR_RESULT_ERROR_INVALID_SIZE)
-        UR_ASSERT(size % patternSize == 0, UR_RESULT_ERROR_INVALID_SIZE)
-        // TODO: add check for allocation size once the query is supported
-
-        switch (patternSize) {
-        case 1:
-          memset(ptr, *static_cast<const uint8_t *>(pPattern), size);
-          break;
-        case 2: {
-          const auto pattern = *static_cast<const uint16_t *>(pPattern);
-          auto *start = reinterpret_cast<uint16_t *>(ptr);
-          auto *end = reinterpret_cast<uint16_t *>(
-              reinterpret_cast<uint8_t *>(ptr) + size);
-          std::fill(start, end, pattern);
-          break;
-        }
-        case 4: {
-          const auto pattern = *static_cast<const uint32_t *>(pPattern);
-          auto *start = reinterpret_cast<uint32_t *>(ptr);
-          auto *end = reinterpret_cast<uint32_t *>(
-              reinterpret_cast<uint8_t *>(ptr) + size);
-          std::fill(start, end, pattern);
-          break;
-        }
-        case 8: {
-          const auto pattern = *static_cast<const uint64_t *>(pPattern);
-          auto *start = reinterpret_cast<uint64_t *>(ptr);
-          auto *end = reinterpret_cast<uint64_t *>(
-              reinterpret_cast<uint8_t *>(ptr) + size);
-          std::fill(start, end, pattern);
-          break;
-        }
-        default: {
-          for (size_t step{0}; step < size; step += patternSize) {
-            auto *dest = reinterpret_cast<void *>(
-                reinterpret_cast<uint8_t *>(ptr) + step);
-            memcpy(dest, pPattern, patternSize);
-          }
-        }
-        }
-        return UR_RESULT_SUCCESS;
-      });
+  UR_ASSERT(ptr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(pPattern, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(patternSize != 0, UR_RESULT_ERROR_INVALID_SIZE)
+  UR_ASSERT(size != 0, UR_RESULT_ERROR_INVALID_SIZE)
+  UR_ASSERT(patternSize <= size, UR_RESULT_ERROR_INVALID_SIZE)
+  UR_ASSERT(size % patternSize == 0, UR_RESULT_ERROR_INVALID_SIZE)
+  // TODO: add check for allocation size once the query is supported
+
+  // The pattern may be gone by the time the fill runs.
+  std::vector<uint8_t> Pattern(static_cast<const uint8_t *>(pPattern),
+                               static_cast<const uint8_t *>(pPattern) +
+                                   patternSize);
+  std::vector<native_cpu::task_t> Tasks;
+  native_cpu::appendFillTasks(Tasks, hQueue->getDevice()->tp, ptr,
+                              std::move(Pattern), size);
+  return enqueueTasks(UR_COMMAND_USM_FILL, hQueue, numEventsInWaitList,
+                      phEventWaitList, phEvent, std::move(Tasks), false);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy(
@@ -614,7 +839,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy(
   UR_ASSERT(pDst, UR_RESULT_ERROR_INVALID_NULL_POINTER);
   UR_ASSERT(pSrc, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-  return doCopy_impl<false /*use memcpy*/>(
+  return doCopy_impl(
       hQueue, pDst, pSrc, size, numEventsInWaitList, phEventWaitList, phEvent,
       UR_COMMAND_USM_MEMCPY, blocking);
 }
@@ -625,9 +850,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMPrefetch(
     const ur_event_handle_t *phEventWaitList, ur_event_handle_t *phEvent) {
 
   // TODO: properly implement USM prefetch
-  return withTimingEvent(UR_COMMAND_USM_PREFETCH, hQueue, numEventsInWaitList,
-                         phEventWaitList, phEvent,
-                         []() { return UR_RESULT_SUCCESS; });
+  return withTimingEvent(
+      UR_COMMAND_USM_PREFETCH, hQueue, numEventsInWaitList, phEventWaitList,
+      phEvent, []() { return UR_RESULT_SUCCESS; }, false);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMAdvise(
@@ -653,19 +878,14 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueUSMMemcpy2D(
     const void *pSrc, size_t srcPitch, size_t width, size_t height,
     uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
     ur_event_handle_t *phEvent) {
-  return withTimingEvent(
-      UR_COMMAND_USM_MEMCPY_2D, hQueue, numEventsInWaitList, phEventWaitList,
-      phEvent,
-      [width, height, srcPitch, dstPitch, pDst, pSrc]() {
-        for (size_t h = 0, Src_ind = 0, Dst_ind = 0; h < height;
-             h++, Src_ind += srcPitch, Dst_ind += dstPitch) {
-          int8_t &d_mem = ur_cast<int8_t *>(pDst)[Dst_ind];
-          const int8_t &s_mem = ur_cast<const int8_t *>(pSrc)[Src_ind];
-          std::memcpy(&d_mem, &s_mem, width);
-        }
-        return UR_RESULT_SUCCESS;
-      },
-      blocking);
+  const ur_rect_region_t region{width, height, 1};
+  std::vector<native_cpu::task_t> Tasks;
+  native_cpu::appendRectTasks(
+      Tasks, hQueue->getDevice()->tp, pDst,
+      native_cpu::RectT({0, 0, 0}, region, dstPitch, 0), pSrc,
+      native_cpu::RectT({0, 0, 0}, region, srcPitch, 0), region);
+  return enqueueTasks(UR_COMMAND_USM_MEMCPY_2D, hQueue, numEventsInWaitList,
+                      phEventWaitList, phEvent, std::move(Tasks), blocking);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urEnqueueDeviceGlobalVariableWrite(
@@ -716,14 +936,9 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueNativeCommandExp(
   return UR_RESULT_ERROR_UNSUPPORTED_FEATURE;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunchWithArgsExp(
-    ur_queue_handle_t hQueue, ur_kernel_handle_t hKernel, uint32_t workDim,
-    const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
-    const size_t *pLocalWorkSize, uint32_t numArgs,
-    const ur_exp_kernel_arg_properties_t *pArgs,
-    const ur_kernel_launch_ext_properties_t *launchPropList,
-    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
-    ur_event_handle_t *phEvent) {
+ur_result_t
+native_cpu::setKernelArgs(ur_kernel_handle_t hKernel, uint32_t numArgs,
+                          const ur_exp_kernel_arg_properties_t *pArgs) {
   for (uint32_t argIndex = 0; argIndex < numArgs; argIndex++) {
     switch (pArgs[argIndex].type) {
     case UR_EXP_KERNEL_ARG_TYPE_VALUE:
@@ -751,6 +966,18 @@ UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunchWithArgsExp(
       return UR_RESULT_ERROR_INVALID_ENUMERATION;
     }
   }
+  return UR_RESULT_SUCCESS;
+}
+
+UR_APIEXPORT ur_result_t UR_APICALL urEnqueueKernelLaunchWithArgsExp(
+    ur_queue_handle_t hQueue, ur_kernel_handle_t hKernel, uint32_t workDim,
+    const size_t *pGlobalWorkOffset, const size_t *pGlobalWorkSize,
+    const size_t *pLocalWorkSize, uint32_t numArgs,
+    const ur_exp_kernel_arg_properties_t *pArgs,
+    const ur_kernel_launch_ext_properties_t *launchPropList,
+    uint32_t numEventsInWaitList, const ur_event_handle_t *phEventWaitList,
+    ur_event_handle_t *phEvent) {
+  UR_CALL(native_cpu::setKernelArgs(hKernel, numArgs, pArgs));
   return urEnqueueKernelLaunch(hQueue, hKernel, workDim, pGlobalWorkOffset,
                                pGlobalWorkSize, pLocalWorkSize, launchPropList,
                                numEventsInWaitList, phEventWaitList, phEvent);
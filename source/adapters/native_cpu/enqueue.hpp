@@ -0,0 +1,151 @@
+//===----------- enqueue.hpp - Native CPU Adapter -------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+#include "common.hpp"
+#include "kernel.hpp"
+#include "threadpool.hpp"
+#include "unified-runtime/ur_api.h"
+
+namespace native_cpu {
+struct NDRDescT {
+  using RangeT = std::array<size_t, 3>;
+  uint32_t WorkDim;
+  RangeT GlobalOffset{};
+  RangeT GlobalSize{};
+  RangeT LocalSize{};
+  NDRDescT(uint32_t WorkDim, const size_t *GlobalWorkOffset,
+           const size_t *GlobalWorkSize, const size_t *LocalWorkSize)
+      : WorkDim(WorkDim) {
+    for (uint32_t I = 0; I < WorkDim; I++) {
+      GlobalOffset[I] = GlobalWorkOffset ? GlobalWorkOffset[I] : 0;
+      GlobalSize[I] = GlobalWorkSize[I];
+      LocalSize[I] = LocalWorkSize ? LocalWorkSize[I] : 1;
+    }
+    for (uint32_t I = WorkDim; I < 3; I++) {
+      GlobalSize[I] = 1;
+      LocalSize[I] = LocalSize[0] ? 1 : 0;
+      GlobalOffset[I] = 0;
+    }
+  }
+
+  void dump(std::ostream &os) const {
+    os << "GlobalSize: " << GlobalSize[0] << " " << GlobalSize[1] << " "
+       << GlobalSize[2] << "\n";
+    os << "LocalSize: " << LocalSize[0] << " " << LocalSize[1] << " "
+       << LocalSize[2] << "\n";
+    os << "GlobalOffset: " << GlobalOffset[0] << " " << GlobalOffset[1] << " "
+       << GlobalOffset[2] << "\n";
+  }
+};
+
+
+// A unit of work run on a thread of the device's pool, which is passed the
+// index of that thread.
+using task_t = std::function<void(size_t)>;
+
+// Runs tasks on tp and calls done once all of them have finished. The tasks
+// are referenced rather than copied, so they must outlive the call to done.
+void scheduleTasks(threadpool_t &tp, const std::vector<task_t> &tasks,
+                   std::function<void()> &&done);
+
+// Like the above, but keeps the tasks alive until they have all finished.
+void scheduleTasks(threadpool_t &tp, std::vector<task_t> &&tasks,
+                   std::function<void()> &&done);
+
+// Calls f once all of phEvents and prevEvent, if any, have completed. f is
+// run by the thread that completes the last of them, or by the calling
+// thread if they already have.
+void whenComplete(uint32_t numEvents, const ur_event_handle_t *phEvents,
+                  ur_event_handle_t prevEvent, std::function<void()> &&f);
+
+// Returns the event an in-order queue's next command has to wait for, with a
+// reference owned by the caller. Must be called with the submission lock
+// held.
+ur_event_handle_t getPrevEvent(ur_queue_handle_t hQueue);
+
+// Makes event the tail of an in-order queue once it has been submitted. Must
+// be called with the submission lock held.
+void setPrevEvent(ur_queue_handle_t hQueue, ur_event_handle_t event,
+                  bool isUserEvent);
+
+// Checks the work sizes of a launch of hKernel.
+ur_result_t checkKernelLaunch(ur_kernel_handle_t hKernel, uint32_t workDim,
+                              const size_t *pGlobalWorkSize,
+                              const size_t *pLocalWorkSize);
+
+// Sets the arguments passed to urEnqueueKernelLaunchWithArgsExp and friends.
+ur_result_t setKernelArgs(ur_kernel_handle_t hKernel, uint32_t numArgs,
+                          const ur_exp_kernel_arg_properties_t *pArgs);
+
+// Splits the work-groups of ndr into at most numTasks contiguous ranges and
+// appends a task running each of them. kernel and launchArgs must outlive
+// the tasks.
+void appendWGRangeTasks(std::vector<task_t> &Tasks, const NDRDescT &ndr,
+                        const ur_kernel_handle_t_ &kernel,
+                        const launch_args &launchArgs, size_t numTasks);
+
+// Memory operations are only split over threads in parts of at least this
+// many bytes, smaller ones aren't worth the cost of scheduling.
+constexpr size_t MinBytesPerTask = 256 * 1024;
+
+// The largest copy a fill with a pattern of an odd size is done with.
+constexpr size_t MaxFillCopySize = 16 * 1024;
+
+// Fills size bytes at ptr with the patternSize bytes at pPattern. size must
+// be a multiple of patternSize.
+void fillPattern(void *ptr, const void *pPattern, size_t patternSize,
+                 size_t size);
+
+// Splits numUnits units of work into contiguous ranges of at least
+// minUnitsPerTask units, at most one per thread of tp, and appends a task
+// calling f(rangeStart, rangeEnd) for each of them. Small amounts of work get
+// a single task.
+void appendRangeTasks(std::vector<task_t> &Tasks, threadpool_t &tp,
+                      size_t numUnits, size_t minUnitsPerTask,
+                      std::function<void(size_t, size_t)> &&f);
+
+// Appends tasks filling size bytes at ptr with Pattern, see fillPattern.
+void appendFillTasks(std::vector<task_t> &Tasks, threadpool_t &tp, void *ptr,
+                     std::vector<uint8_t> &&Pattern, size_t size);
+
+// Appends tasks copying size bytes from pSrc to pDst, which may overlap.
+void appendCopyTasks(std::vector<task_t> &Tasks, threadpool_t &tp, void *pDst,
+                     const void *pSrc, size_t size);
+
+// The layout of a region of memory accessed by a rect operation.
+struct RectT {
+  ur_rect_offset_t Offset;
+  size_t RowPitch;
+  size_t SlicePitch;
+
+  RectT(ur_rect_offset_t Offset, ur_rect_region_t region, size_t RowPitch,
+        size_t SlicePitch)
+      : Offset(Offset), RowPitch(RowPitch ? RowPitch : region.width),
+        SlicePitch(SlicePitch ? SlicePitch : this->RowPitch * region.height) {}
+
+  // The offset of row h of slice d of the region.
+  size_t rowOffset(size_t h, size_t d) const {
+    return (d + Offset.z) * SlicePitch + (h + Offset.y) * RowPitch + Offset.x;
+  }
+};
+
+// Appends tasks copying region from Src to Dst, split on rows.
+void appendRectTasks(std::vector<task_t> &Tasks, threadpool_t &tp, void *Dst,
+                     const RectT &DstRect, const void *Src,
+                     const RectT &SrcRect, ur_rect_region_t region);
+
+} // namespace native_cpu
@@ -118,7 +118,7 @@ UR_APIEXPORT ur_result_t UR_APICALL urEventCreateExp(
 ur_event_handle_t_::ur_event_handle_t_(ur_queue_handle_t queue,
                                        ur_command_t command_type)
     : queue(queue), context(queue->getContext()), command_type(command_type),
-      done(false), tasksinfo(queue->getDevice()->tp) {
+      done(false) {
   this->queue->addEvent(this);
 }
 
@@ -130,17 +130,12 @@ ur_event_handle_t_::~ur_event_handle_t_() {
 
 void ur_event_handle_t_::wait() {
   std::unique_lock<std::mutex> lock(mutex);
+  completedCondition.wait(lock, [this] { return completed; });
   if (done) {
     return;
   }
-  this->tasksinfo.wait_all();
   queue->removeEvent(this);
   done = true;
-  // The callback may need to acquire the lock, so we unlock it here
-  lock.unlock();
-
-  if (callback.valid())
-    callback();
 }
 
 void ur_event_handle_t_::tick_start() {
@@ -150,9 +145,28 @@ void ur_event_handle_t_::tick_start() {
   timestamp_start = get_timestamp();
 }
 
-void ur_event_handle_t_::tick_end() {
-  if (!queue->isProfiling())
-    return;
-  std::lock_guard<std::mutex> lock(mutex);
-  timestamp_end = get_timestamp();
+void ur_event_handle_t_::set_complete() {
+  if (queue->isProfiling()) {
+    std::lock_guard<std::mutex> lock(mutex);
+    timestamp_end = get_timestamp();
+  }
+  // The callback releases what the command held on to, which may include
+  // other events, so it runs here rather than in wait(): nothing can destroy
+  // the event before it is marked completed below.
+  if (callback.valid())
+    callback();
+
+  std::vector<std::function<void()>> callbacks;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    completed = true;
+    callbacks.swap(completionCallbacks);
+    // Notify with the lock held, the event may be destroyed as soon as a
+    // waiter sees it completed.
+    completedCondition.notify_all();
+  }
+  // The event must not be accessed from here on.
+  for (auto &cb : callbacks) {
+    cb();
+  }
 }
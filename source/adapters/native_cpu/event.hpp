@@ -8,9 +8,10 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 #include "common.hpp"
-#include "threadpool.hpp"
 #include "unified-runtime/ur_api.h"
+#include <condition_variable>
 #include <cstdint>
+#include <functional>
 #include <future>
 #include <mutex>
 #include <vector>
@@ -21,6 +22,8 @@ struct ur_event_handle_t_ : RefCounted {
 
   ~ur_event_handle_t_();
 
+  // Sets the callback that is called once the work of the command has
+  // finished, before the event is marked completed.
   template <typename T> auto set_callback(T &&cb) {
     callback = std::packaged_task<void()>(std::forward<T>(cb));
   }
@@ -30,7 +33,7 @@ struct ur_event_handle_t_ : RefCounted {
   uint32_t getExecutionStatus() {
     // TODO: add support for UR_EVENT_STATUS_RUNNING
     std::lock_guard<std::mutex> lock(mutex);
-    if (done) {
+    if (completed) {
       return UR_EVENT_STATUS_COMPLETE;
     }
     return UR_EVENT_STATUS_SUBMITTED;
@@ -42,14 +45,25 @@ struct ur_event_handle_t_ : RefCounted {
 
   ur_command_t getCommandType() const { return command_type; }
 
-  void set_tasksinfo(native_cpu::tasksinfo_t &&fs) {
-    std::lock_guard<std::mutex> lock(mutex);
-    tasksinfo = std::move(fs);
+  // Registers cb to be called once the command has completed, or calls it
+  // right away if it already has. cb is called on the thread that completes
+  // the command, so it must not block.
+  template <typename T> void on_complete(T &&cb) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!completed) {
+        completionCallbacks.emplace_back(std::forward<T>(cb));
+        return;
+      }
+    }
+    cb();
   }
 
-  void tick_start();
+  // Marks the command as completed, which wakes up the threads waiting for
+  // the event and calls the completion callbacks.
+  void set_complete();
 
-  void tick_end();
+  void tick_start();
 
   uint64_t get_start_timestamp() const { return timestamp_start; }
 
@@ -59,9 +73,13 @@ private:
   ur_queue_handle_t queue;
   ur_context_handle_t context;
   ur_command_t command_type;
+  // Set once the event has been waited on and removed from its queue.
   bool done;
+  // Set once all the work of the command has finished.
+  bool completed = false;
   std::mutex mutex;
-  native_cpu::tasksinfo_t tasksinfo;
+  std::condition_variable completedCondition;
+  std::vector<std::function<void()>> completionCallbacks;
   std::packaged_task<void()> callback;
   uint64_t timestamp_start = 0;
   uint64_t timestamp_end = 0;
@@ -12,7 +12,11 @@
 #include "memory.hpp"
 #include "nativecpu_state.hpp"
 #include "program.hpp"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <unified-runtime/ur_api.h>
 #include <utility>
 
@@ -31,19 +35,10 @@ struct ur_kernel_handle_t_ : RefCounted {
 
   ur_kernel_handle_t_(ur_program_handle_t hProgram, const char *name,
                       nativecpu_task_t subhandler)
-      : hProgram(hProgram), _name{name}, _subhandler{std::move(subhandler)} {}
-
-  ur_kernel_handle_t_(const ur_kernel_handle_t_ &other)
-      : Args(other.Args), hProgram(other.hProgram), _name(other._name),
-        _subhandler(other._subhandler), _localArgInfo(other._localArgInfo),
-        ReqdWGSize(other.ReqdWGSize) {
-    takeArgReferences(other);
-  }
+      : hProgram(hProgram), _name{name}, _subhandler{std::move(subhandler)},
+        Args(std::make_shared<arguments>()) {}
 
-  ~ur_kernel_handle_t_() {
-    removeArgReferences();
-    native_cpu::aligned_free(_localMemPool);
-  }
+  ur_kernel_handle_t_(const ur_kernel_handle_t_ &other) = delete;
 
   ur_kernel_handle_t_(ur_program_handle_t hProgram, const char *name,
                       nativecpu_task_t subhandler,
@@ -51,21 +46,29 @@ struct ur_kernel_handle_t_ : RefCounted {
                       std::optional<native_cpu::WGSize_t> MaxWGSize,
                       std::optional<uint64_t> MaxLinearWGSize)
       : hProgram(hProgram), _name{name}, _subhandler{std::move(subhandler)},
-        ReqdWGSize(ReqdWGSize), MaxWGSize(MaxWGSize),
-        MaxLinearWGSize(MaxLinearWGSize) {}
+        Args(std::make_shared<arguments>()), ReqdWGSize(ReqdWGSize),
+        MaxWGSize(MaxWGSize), MaxLinearWGSize(MaxLinearWGSize) {}
 
   struct arguments {
     using args_index_t = std::vector<void *>;
     args_index_t Indices;
     std::vector<size_t> ParamSizes;
     std::vector<bool> OwnsMem;
+    // Memory objects referenced by the arguments, retained for as long as
+    // this set of arguments is alive. Same size as Indices.
+    std::vector<ur_mem_handle_t> MemObjs;
+    std::vector<local_arg_info_t> LocalArgInfo;
 
     arguments() = default;
 
     arguments(const arguments &Other)
         : Indices(Other.Indices), ParamSizes(Other.ParamSizes),
-          OwnsMem(Other.OwnsMem.size(), false) {
+          OwnsMem(Other.OwnsMem.size(), false), MemObjs(Other.MemObjs),
+          LocalArgInfo(Other.LocalArgInfo) {
       for (size_t Index = 0; Index < Indices.size(); Index++) {
+        if (MemObjs[Index]) {
+          MemObjs[Index]->incrementReferenceCount();
+        }
         if (!Other.OwnsMem[Index]) {
           continue;
         }
@@ -77,11 +80,16 @@ struct ur_kernel_handle_t_ : RefCounted {
       std::swap(Indices, Other.Indices);
       std::swap(ParamSizes, Other.ParamSizes);
       std::swap(OwnsMem, Other.OwnsMem);
+      std::swap(MemObjs, Other.MemObjs);
+      std::swap(LocalArgInfo, Other.LocalArgInfo);
     }
 
     ~arguments() {
       assert(OwnsMem.size() == Indices.size() && "Size mismatch");
       for (size_t Index = 0; Index < Indices.size(); Index++) {
+        if (MemObjs[Index]) {
+          decrementOrDelete(MemObjs[Index]);
+        }
         if (!OwnsMem[Index]) {
           continue;
         }
@@ -97,14 +105,15 @@ struct ur_kernel_handle_t_ : RefCounted {
     void addArg(size_t Index, size_t Size, const void *Arg) {
       bool NeedAlloc = true;
       if (Index + 1 > Indices.size()) {
-        Indices.resize(Index + 1);
-        OwnsMem.resize(Index + 1);
-        ParamSizes.resize(Index + 1);
-      } else if (OwnsMem[Index]) {
-        if (ParamSizes[Index] == Size) {
-          NeedAlloc = false;
-        } else {
-          native_cpu::aligned_free(Indices[Index]);
+        resize(Index + 1);
+      } else {
+        clearArg(Index);
+        if (OwnsMem[Index]) {
+          if (ParamSizes[Index] == Size) {
+            NeedAlloc = false;
+          } else {
+            native_cpu::aligned_free(Indices[Index]);
+          }
         }
       }
       if (NeedAlloc) {
@@ -117,24 +126,63 @@ struct ur_kernel_handle_t_ : RefCounted {
 
     void addPtrArg(size_t Index, void *Arg) {
       if (Index + 1 > Indices.size()) {
-        Indices.resize(Index + 1);
-        OwnsMem.resize(Index + 1);
-        ParamSizes.resize(Index + 1);
+        resize(Index + 1);
 
         OwnsMem[Index] = false;
         ParamSizes[Index] = sizeof(uint8_t *);
+      } else {
+        clearArg(Index);
+        if (OwnsMem[Index]) {
+          native_cpu::aligned_free(Indices[Index]);
+          OwnsMem[Index] = false;
+          ParamSizes[Index] = sizeof(uint8_t *);
+        }
       }
       Indices[Index] = Arg;
     }
 
+    void addMemObjArg(size_t Index, ur_mem_handle_t MemObj) {
+      addPtrArg(Index, MemObj->_mem);
+      MemObj->incrementReferenceCount();
+      MemObjs[Index] = MemObj;
+    }
+
+    void addLocalArg(size_t Index, size_t Size) {
+      // emplace a placeholder kernel arg, gets replaced with a pointer to the
+      // memory pool before enqueueing the kernel.
+      addPtrArg(Index, nullptr);
+      LocalArgInfo.emplace_back(Index, Size);
+    }
+
     const args_index_t &getIndices() const noexcept { return Indices; }
 
-  } Args;
+  private:
+    void resize(size_t Size) {
+      Indices.resize(Size);
+      OwnsMem.resize(Size);
+      ParamSizes.resize(Size);
+      MemObjs.resize(Size);
+    }
+
+    // Drops what a previous argument at Index referenced, apart from owned
+    // memory which may be reused.
+    void clearArg(size_t Index) {
+      if (MemObjs[Index]) {
+        decrementOrDelete(MemObjs[Index]);
+        MemObjs[Index] = nullptr;
+      }
+      LocalArgInfo.erase(
+          std::remove_if(LocalArgInfo.begin(), LocalArgInfo.end(),
+                         [Index](const local_arg_info_t &Info) {
+                           return Info.argIndex == Index;
+                         }),
+          LocalArgInfo.end());
+    }
+  };
 
   ur_program_handle_t hProgram;
   std::string _name;
   nativecpu_task_t _subhandler;
-  std::vector<local_arg_info_t> _localArgInfo;
 
   std::optional<native_cpu::WGSize_t> getReqdWGSize() const {
     return ReqdWGSize;
@@ -144,96 +192,138 @@ struct ur_kernel_handle_t_ : RefCounted {
 
   std::optional<uint64_t> getMaxLinearWGSize() const { return MaxLinearWGSize; }
 
-  void updateMemPool(size_t numParallelThreads) {
-    // compute requested size.
-    size_t reqSize = 0;
-    for (auto &entry : _localArgInfo) {
-      reqSize += entry.argSize * numParallelThreads;
-    }
-    if (reqSize == 0 || reqSize == _localMemPoolSize) {
-      return;
-    }
-    native_cpu::aligned_free(_localMemPool);
-    _localMemPool = static_cast<char *>(native_cpu::aligned_malloc(reqSize));
-    _localMemPoolSize = reqSize;
+  // Estimated time in ns to run one work-group, measured by previous
+  // launches that used dynamic partitioning. 0 if unknown.
+  uint64_t getWGCostHint() const {
+    return WGCostHint.load(std::memory_order_relaxed);
   }
 
-  bool hasLocalArgs() const { return !_localArgInfo.empty(); }
-
-  const std::vector<void *> &getArgs() const {
-    assert(!hasLocalArgs() && "For kernels with local arguments, thread "
-                              "information must be supplied.");
-    return Args.getIndices();
+  void updateWGCostHint(uint64_t Cost) {
+    // Smooth out the noise of individual launches.
+    const uint64_t Old = WGCostHint.load(std::memory_order_relaxed);
+    WGCostHint.store(Old ? (3 * Old + Cost) / 4 : Cost,
+                     std::memory_order_relaxed);
   }
 
-  std::vector<void *> getArgs(size_t numThreads, size_t threadId) const {
-    auto Result = Args.getIndices();
-
-    // For each local argument we have size*numthreads
-    size_t offset = 0;
-    for (auto &entry : _localArgInfo) {
-      Result[entry.argIndex] =
-          _localMemPool + offset + (entry.argSize * threadId);
-      // update offset in the memory pool
-      offset += entry.argSize * numThreads;
-    }
-
-    return Result;
+  // Returns the current arguments. Launches hold on to the returned snapshot,
+  // which is never modified: an argument set while a launch still holds it
+  // copies the arguments first.
+  std::shared_ptr<const arguments> getArgsSnapshot() const {
+    std::lock_guard<std::mutex> Lock(ArgsMutex);
+    return Args;
   }
 
+  const std::vector<void *> &getArgs() const { return Args->getIndices(); }
+
   inline ur_result_t addArg(const void *Ptr, size_t Index, size_t Size) {
     UR_ASSERT(Size, UR_RESULT_ERROR_INVALID_KERNEL_ARGUMENT_SIZE);
-    Args.addArg(Index, Size, Ptr);
+    std::lock_guard<std::mutex> Lock(ArgsMutex);
+    getMutableArgs().addArg(Index, Size, Ptr);
     return UR_RESULT_SUCCESS;
   }
 
   inline ur_result_t addPtrArg(void *Ptr, size_t Index) {
     UR_ASSERT(Ptr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
-    Args.addPtrArg(Index, Ptr);
+    std::lock_guard<std::mutex> Lock(ArgsMutex);
+    getMutableArgs().addPtrArg(Index, Ptr);
     return UR_RESULT_SUCCESS;
   }
 
-  void addArgReference(ur_mem_handle_t Arg) {
-    Arg->incrementReferenceCount();
-    ReferencedArgs.push_back(Arg);
-  }
-
   inline ur_result_t addMemObjArg(ur_mem_handle_t ArgValue, size_t Index) {
     // Taken from ur/adapters/cuda/kernel.cpp
     // zero-sized buffers are expected to be null.
+    std::lock_guard<std::mutex> Lock(ArgsMutex);
     if (ArgValue == nullptr) {
-      addPtrArg(nullptr, Index);
+      getMutableArgs().addPtrArg(Index, nullptr);
       return UR_RESULT_SUCCESS;
     }
 
-    addArgReference(ArgValue);
-    addPtrArg(ArgValue->_mem, Index);
+    getMutableArgs().addMemObjArg(Index, ArgValue);
     return UR_RESULT_SUCCESS;
   }
 
   inline ur_result_t addLocalArg(size_t Index, size_t Size) {
-    // emplace a placeholder kernel arg, gets replaced with a pointer to the
-    // memory pool before enqueueing the kernel.
-    Args.addPtrArg(Index, nullptr);
-    _localArgInfo.emplace_back(Index, Size);
+    std::lock_guard<std::mutex> Lock(ArgsMutex);
+    getMutableArgs().addLocalArg(Index, Size);
     return UR_RESULT_SUCCESS;
   }
 
 private:
-  void removeArgReferences() {
-    for (auto arg : ReferencedArgs)
-      decrementOrDelete(arg);
-  }
-  void takeArgReferences(const ur_kernel_handle_t_ &other) {
-    for (auto arg : other.ReferencedArgs)
-      addArgReference(arg);
+  // Must be called with ArgsMutex held, so that no launch takes a snapshot
+  // meanwhile. Launches only drop their snapshots concurrently, so a count of
+  // one means that none holds Args anymore.
+  arguments &getMutableArgs() {
+    if (Args.use_count() > 1) {
+      Args = std::make_shared<arguments>(*Args);
+    } else {
+      // Pairs with the release of the last launch dropping its snapshot
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *Args;
   }
 
-private:
-  char *_localMemPool = nullptr;
-  size_t _localMemPoolSize = 0;
+  mutable std::mutex ArgsMutex;
+  std::shared_ptr<arguments> Args;
   std::optional<native_cpu::WGSize_t> ReqdWGSize = std::nullopt;
   std::optional<native_cpu::WGSize_t> MaxWGSize = std::nullopt;
   std::optional<uint64_t> MaxLinearWGSize = std::nullopt;
-  std::vector<ur_mem_handle_t> ReferencedArgs;
+  std::atomic<uint64_t> WGCostHint = 0;
+};
+
+namespace native_cpu {
+
+// The arguments of a single kernel launch: a snapshot of the kernel arguments
+// together with the local memory of the launch and the argument array of
+// every thread.
+class launch_args {
+public:
+  launch_args(const ur_kernel_handle_t_ &Kernel, size_t numThreads)
+      : Args(Kernel.getArgsSnapshot()) {
+    if (Args->LocalArgInfo.empty()) {
+      return;
+    }
+    size_t reqSize = 0;
+    for (auto &entry : Args->LocalArgInfo) {
+      reqSize += entry.argSize * numThreads;
+    }
+    LocalMemPool = static_cast<char *>(aligned_malloc(reqSize));
+
+    // Materialize the argument array of every thread once, with the local
+    // arguments pointing into that thread's slice of the memory pool, so
+    // that launching a work-item only has to index into it.
+    const auto &Indices = Args->getIndices();
+    const size_t numArgs = Indices.size();
+    ThreadArgs.resize(numArgs * numThreads);
+    for (size_t threadId = 0; threadId < numThreads; threadId++) {
+      void **Result = ThreadArgs.data() + threadId * numArgs;
+      std::copy(Indices.begin(), Indices.end(), Result);
+      // For each local argument we have size*numthreads
+      size_t offset = 0;
+      for (auto &entry : Args->LocalArgInfo) {
+        Result[entry.argIndex] =
+            LocalMemPool + offset + (entry.argSize * threadId);
+        // update offset in the memory pool
+        offset += entry.argSize * numThreads;
+      }
+    }
+  }
+
+  launch_args(const launch_args &) = delete;
+  launch_args &operator=(const launch_args &) = delete;
+
+  ~launch_args() { aligned_free(LocalMemPool); }
+
+  void *const *get(size_t threadId) const {
+    if (ThreadArgs.empty()) {
+      return Args->getIndices().data();
+    }
+    return ThreadArgs.data() + threadId * Args->getIndices().size();
+  }
+
+private:
+  std::shared_ptr<const ur_kernel_handle_t_::arguments> Args;
+  char *LocalMemPool = nullptr;
+  std::vector<void *> ThreadArgs;
 };
+
+} // namespace native_cpu
@@ -0,0 +1,148 @@
+//===----------- partitioning.hpp - Native CPU Adapter --------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "logger/ur_logger.hpp"
+
+namespace native_cpu {
+
+// How the work-groups of a kernel launch are distributed over the threads.
+// Selected with SYCL_NATIVE_CPU_PARTITIONING=static|dynamic|guided.
+enum class Partitioning {
+  // Each task gets a fixed, contiguous range of work-groups.
+  Static,
+  // Threads claim fixed-size batches of work-groups from a shared cursor.
+  Dynamic,
+  // Like Dynamic, but batches shrink as the launch nears completion.
+  Guided
+};
+
+inline Partitioning parsePartitioning(const char *envVar) {
+  if (!envVar || std::strcmp(envVar, "static") == 0) {
+    return Partitioning::Static;
+  }
+  if (std::strcmp(envVar, "dynamic") == 0) {
+    return Partitioning::Dynamic;
+  }
+  if (std::strcmp(envVar, "guided") == 0) {
+    return Partitioning::Guided;
+  }
+  UR_LOG(WARN,
+         "Invalid value for SYCL_NATIVE_CPU_PARTITIONING: {}, using static",
+         envVar);
+  return Partitioning::Static;
+}
+
+inline Partitioning getPartitioning() {
+  static const Partitioning Result =
+      parsePartitioning(std::getenv("SYCL_NATIVE_CPU_PARTITIONING"));
+  return Result;
+}
+
+// Splits numWG work-groups into at most numTasks contiguous ranges whose
+// sizes differ by at most one, and calls f(rangeStart, rangeEnd) for each.
+template <typename F>
+inline void forEachStaticWGRange(size_t numWG, size_t numTasks, F &&f) {
+  const size_t numWGPerTask = numWG / numTasks;
+  const size_t remainderWG = numWG - numWGPerTask * numTasks;
+  size_t rangeStart = 0;
+  for (size_t t = 0; t < numTasks; ++t) {
+    size_t rangeEnd = rangeStart + numWGPerTask + (t < remainderWG);
+    if (rangeEnd == rangeStart)
+      break;
+    f(rangeStart, rangeEnd);
+    rangeStart = rangeEnd;
+  }
+}
+
+// Calls f(g0, g1, g2) for every work-group in the linearized range
+// [rangeStart, rangeEnd), where dimension 0 varies fastest.
+template <typename F>
+inline void forEachWG(size_t numWG0, size_t numWG1, size_t rangeStart,
+                      size_t rangeEnd, F &&f) {
+  for (size_t g0 = rangeStart % numWG0, g1 = (rangeStart / numWG0) % numWG1,
+              g2 = rangeStart / (numWG0 * numWG1), g3 = rangeStart;
+       g3 < rangeEnd; ++g3) {
+    f(g0, g1, g2);
+    if (++g0 == numWG0) {
+      g0 = 0;
+      if (++g1 == numWG1) {
+        g1 = 0;
+        ++g2;
+      }
+    }
+  }
+}
+
+// Shared cursor from which the threads of a launch claim work-group batches.
+class WGCursor {
+  // Batches are sized to take roughly this long, so that claiming stays
+  // cheap compared to running the work-groups.
+  static constexpr uint64_t TargetBatchTime = 20000; // ns
+
+  std::atomic<size_t> Next{0};
+  size_t NumWG = 0;
+  size_t NumThreads = 1;
+  size_t Grain = 1;
+  bool Guided = false;
+
+public:
+  // WGCost is the estimated time per work-group in ns, or 0 if unknown.
+  void init(size_t numWG, size_t numThreads, uint64_t WGCost, bool guided) {
+    NumWG = numWG;
+    NumThreads = numThreads;
+    Guided = guided;
+    // Never hand out so much that the threads can't be balanced.
+    const size_t MaxGrain = std::max<size_t>(1, numWG / (4 * numThreads));
+    if (WGCost == 0) {
+      Grain = std::max<size_t>(1, numWG / (8 * numThreads));
+    } else {
+      Grain = std::max<uint64_t>(1, TargetBatchTime / WGCost);
+    }
+    Grain = std::min(Grain, MaxGrain);
+  }
+
+  bool claim(size_t &rangeStart, size_t &rangeEnd) {
+    if (!Guided) {
+      rangeStart = Next.fetch_add(Grain, std::memory_order_relaxed);
+      if (rangeStart >= NumWG) {
+        return false;
+      }
+      rangeEnd = std::min(NumWG, rangeStart + Grain);
+      return true;
+    }
+    size_t Cur = Next.load(std::memory_order_relaxed);
+    do {
+      if (Cur >= NumWG) {
+        return false;
+      }
+      const size_t Batch = std::max(Grain, (NumWG - Cur) / (2 * NumThreads));
+      rangeEnd = std::min(NumWG, Cur + Batch);
+    } while (!Next.compare_exchange_weak(Cur, rangeEnd,
+                                         std::memory_order_relaxed));
+    rangeStart = Cur;
+    return true;
+  }
+};
+
+// State shared by the tasks of a single kernel launch.
+struct LaunchInfo {
+  WGCursor Cursor;
+  // Accumulated time the threads spent running work-groups, in ns.
+  std::atomic<uint64_t> BusyTime{0};
+};
+
+} // namespace native_cpu
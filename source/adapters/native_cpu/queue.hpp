@@ -52,7 +52,45 @@ struct ur_queue_handle_t_ : RefCounted {
     }
   }
 
-  ~ur_queue_handle_t_() { finish(); }
+  ~ur_queue_handle_t_() {
+    finish();
+    if (lastEvent) {
+      decrementOrDelete(lastEvent);
+    }
+  }
+
+  // Serializes submissions to in-order queues, so that every command is
+  // chained on the command submitted right before it.
+  std::unique_lock<std::mutex> lockSubmission() {
+    if (!inOrder) {
+      return std::unique_lock<std::mutex>();
+    }
+    return std::unique_lock<std::mutex>(submissionMutex);
+  }
+
+  // Returns the event of the last command submitted to an in-order queue,
+  // with a reference owned by the caller, or nullptr if there is none.
+  ur_event_handle_t getLastEvent() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (lastEvent) {
+      lastEvent->incrementReferenceCount();
+    }
+    return lastEvent;
+  }
+
+  // Makes event the last command of an in-order queue, taking over the
+  // caller's reference to it.
+  void setLastEvent(ur_event_handle_t event) {
+    ur_event_handle_t prev;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      prev = lastEvent;
+      lastEvent = event;
+    }
+    if (prev) {
+      decrementOrDelete(prev);
+    }
+  }
 
   bool isInOrder() const { return inOrder; }
 
@@ -70,4 +108,7 @@ private:
   const bool inOrder;
   const bool profilingEnabled;
   std::mutex mutex;
+  std::mutex submissionMutex;
+  // Tail of the dependency chain of an in-order queue.
+  ur_event_handle_t lastEvent = nullptr;
 };
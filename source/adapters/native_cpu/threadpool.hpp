@@ -10,10 +10,12 @@
 #include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <cstdlib>
 #include <forward_list>
 #include <future>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <numeric>
 #include <queue>
@@ -145,6 +147,8 @@ public:
 
   inline size_t num_threads() const noexcept { return m_numThreads; }
 
+  static constexpr size_t tasks_per_thread() { return 1; }
+
   inline size_t num_pending_tasks() const noexcept {
     return std::accumulate(std::begin(m_workers), std::end(m_workers),
                            size_t(0),
@@ -190,6 +194,257 @@ private:
 
   const size_t m_numThreads;
 };
+
+// Fixed-capacity Chase-Lev deque (Le et al., "Correct and Efficient
+// Work-Stealing for Weak Memory Models"). Only the owning worker may push and
+// pop at the bottom, any other worker may steal from the top.
+template <typename T> class ws_deque {
+public:
+  static constexpr int64_t capacity = 256;
+  static_assert((capacity & (capacity - 1)) == 0,
+                "capacity must be a power of two");
+
+  ws_deque() noexcept : m_top(0), m_bottom(0) {
+    for (auto &slot : m_buffer) {
+      slot.store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns false if the deque is full; owner only.
+  bool push(T *item) noexcept {
+    const int64_t b = m_bottom.load(std::memory_order_relaxed);
+    const int64_t t = m_top.load(std::memory_order_acquire);
+    if (b - t >= capacity) {
+      return false;
+    }
+    m_buffer[b & (capacity - 1)].store(item, std::memory_order_relaxed);
+    // Publishes the item to thieves, which load m_bottom with acquire.
+    m_bottom.store(b + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Owner only.
+  T *pop() noexcept {
+    const int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = m_top.load(std::memory_order_relaxed);
+    if (t > b) {
+      // Empty
+      m_bottom.store(b + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *item = m_buffer[b & (capacity - 1)].load(std::memory_order_relaxed);
+    if (t == b) {
+      // Last element, race against thieves for it
+      if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // Can be called from any thread.
+  T *steal() noexcept {
+    int64_t t = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = m_bottom.load(std::memory_order_acquire);
+    if (t >= b) {
+      return nullptr;
+    }
+    T *item = m_buffer[t & (capacity - 1)].load(std::memory_order_relaxed);
+    if (!m_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return item;
+  }
+
+  size_t free_slots() const noexcept {
+    const int64_t size = m_bottom.load(std::memory_order_relaxed) -
+                         m_top.load(std::memory_order_relaxed);
+    return size >= capacity ? 0 : static_cast<size_t>(capacity - size);
+  }
+
+private:
+  std::atomic<int64_t> m_top;
+  std::atomic<int64_t> m_bottom;
+  std::atomic<T *> m_buffer[capacity];
+};
+
+// Thread pool where every worker owns a lock-free deque. Tasks submitted from
+// outside the pool go to a shared injection queue; a worker that runs out of
+// local work moves a batch of them into its own deque, and workers that find
+// both empty steal from their peers. This keeps all cores busy when the tasks
+// of a launch are unbalanced. Idle workers sleep until some task is queued,
+// whether in the injection queue or in a deque they can steal from.
+class work_stealing_thread_pool {
+public:
+  work_stealing_thread_pool() noexcept
+      : m_isRunning(true), m_numThreads(get_num_threads()),
+        m_numQueuedTasks(0), m_numPendingTasks(0) {
+    for (size_t i = 0; i < m_numThreads; i++) {
+      m_deques.emplace_back(std::make_unique<ws_deque<worker_task_t>>());
+    }
+    for (size_t i = 0; i < m_numThreads; i++) {
+      m_workers.emplace_back([this, i]() { this->run(i); });
+    }
+  }
+
+  ~work_stealing_thread_pool() {
+    {
+      std::lock_guard<std::mutex> lock(m_injectMutex);
+      m_isRunning.store(false, std::memory_order_release);
+    }
+    m_injectCondition.notify_all();
+    for (auto &t : m_workers) {
+      if (t.joinable()) {
+        t.join();
+      }
+    }
+  }
+
+  inline void schedule(worker_task_t &&task) {
+    ++m_numPendingTasks;
+    {
+      std::lock_guard<std::mutex> lock(m_injectMutex);
+      m_injected.push(new worker_task_t(std::move(task)));
+      // Updated under the lock so that a worker going to sleep sees it
+      ++m_numQueuedTasks;
+    }
+    m_injectCondition.notify_one();
+  }
+
+  inline bool is_running() const noexcept {
+    return m_isRunning.load(std::memory_order_acquire);
+  }
+
+  inline size_t num_threads() const noexcept { return m_numThreads; }
+
+  inline size_t num_pending_tasks() const noexcept {
+    return m_numPendingTasks.load(std::memory_order_acquire);
+  }
+
+  void wait_for_all_pending_tasks() {
+    std::unique_lock<std::mutex> lock(m_injectMutex);
+    m_doneCondition.wait(lock, [this]() { return num_pending_tasks() == 0; });
+  }
+
+  // Kernel launches are split into this many chunks per worker so that idle
+  // workers have something to steal.
+  static constexpr size_t tasks_per_thread() { return 4; }
+
+private:
+  void run(size_t threadId) {
+    auto &local = *m_deques[threadId];
+    while (true) {
+      worker_task_t *task = local.pop();
+      if (!task) {
+        task = take_injected(threadId);
+      }
+      if (!task) {
+        task = steal(threadId);
+      }
+      if (task) {
+        --m_numQueuedTasks;
+        (*task)(threadId);
+        delete task;
+        if (--m_numPendingTasks == 0) {
+          // Taking the lock orders this with the check in
+          // wait_for_all_pending_tasks, so its notification isn't lost
+          std::lock_guard<std::mutex> lock(m_injectMutex);
+          m_doneCondition.notify_all();
+        }
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(m_injectMutex);
+      m_injectCondition.wait(lock, [this]() {
+        return !this->is_running() || num_queued_tasks() > 0;
+      });
+      if (!this->is_running() && num_queued_tasks() == 0) {
+        // No deque has work left and no more work can reach them.
+        break;
+      }
+    }
+  }
+
+  // Tasks that were scheduled but no worker has started yet
+  size_t num_queued_tasks() const noexcept {
+    return m_numQueuedTasks.load(std::memory_order_acquire);
+  }
+
+  // Moves a fair share of the injection queue into the local deque and
+  // returns one task to run right away.
+  worker_task_t *take_injected(size_t threadId) {
+    auto &local = *m_deques[threadId];
+    worker_task_t *first = nullptr;
+    bool moved = false;
+    {
+      std::lock_guard<std::mutex> lock(m_injectMutex);
+      if (m_injected.empty()) {
+        return nullptr;
+      }
+      first = m_injected.front();
+      m_injected.pop();
+      size_t share = std::min(m_injected.size() / m_numThreads + 1,
+                              local.free_slots());
+      for (; share > 0 && !m_injected.empty(); --share) {
+        local.push(m_injected.front());
+        m_injected.pop();
+        moved = true;
+      }
+    }
+    if (moved) {
+      // Wake up a sleeping worker so it can steal from us.
+      m_injectCondition.notify_one();
+    }
+    return first;
+  }
+
+  worker_task_t *steal(size_t threadId) {
+    for (size_t i = 1; i < m_numThreads; i++) {
+      auto &victim = *m_deques[(threadId + i) % m_numThreads];
+      if (worker_task_t *task = victim.steal()) {
+        return task;
+      }
+    }
+    return nullptr;
+  }
+
+  static size_t get_num_threads() {
+    size_t numThreads;
+    char *envVar = std::getenv("SYCL_NATIVE_CPU_HOST_THREADS");
+    if (envVar) {
+      numThreads = std::stoul(envVar);
+    } else {
+      numThreads = std::thread::hardware_concurrency();
+    }
+    return std::max<size_t>(numThreads, 1);
+  }
+
+  std::vector<std::unique_ptr<ws_deque<worker_task_t>>> m_deques;
+
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_injectMutex;
+
+  std::condition_variable m_injectCondition;
+
+  std::condition_variable m_doneCondition;
+
+  std::queue<worker_task_t *> m_injected;
+
+  std::atomic<bool> m_isRunning;
+
+  const size_t m_numThreads;
+
+  std::atomic<size_t> m_numQueuedTasks;
+
+  std::atomic<size_t> m_numPendingTasks;
+};
 } // namespace detail
 
 template <typename ThreadPoolT> class threadpool_interface {
@@ -200,6 +455,10 @@ public:
 
   threadpool_interface() : threadpool() {}
 
+  static constexpr size_t tasks_per_thread() {
+    return ThreadPoolT::tasks_per_thread();
+  }
+
   template <class T> std::future<void> schedule_task(T &&task) {
     auto workerTask = std::packaged_task<void(size_t)>(std::forward<T>(task));
     auto ret = workerTask.get_future();
@@ -208,6 +467,8 @@ public:
   }
 };
 using simple_threadpool_t = threadpool_interface<detail::simple_thread_pool>;
+using work_stealing_threadpool_t =
+    threadpool_interface<detail::work_stealing_thread_pool>;
 
 class TasksInfo_TP {
   using FType = std::future<void>;
@@ -219,7 +480,7 @@ public:
     for (auto &f : futures)
       f.wait();
   }
-  TasksInfo_TP(simple_threadpool_t &) {}
+  template <class TP> TasksInfo_TP(TP &) {}
 };
 
 template <class TP, class TaskInfo> struct Scheduler_base {
@@ -227,7 +488,8 @@ template <class TP, class TaskInfo> struct Scheduler_base {
   TaskInfo ti;
   Scheduler_base(TP &ref_) : ref(ref_), ti(ref_) {}
   TaskInfo getMovedTaskInfo() { return std::move(ti); }
-  static constexpr bool CanWaitInThread() { return true; }
+  // Number of tasks a kernel launch should be split into per thread.
+  static constexpr size_t TasksPerThread() { return 1; }
 };
 
 template <class TP> struct Scheduler : Scheduler_base<TP, TasksInfo_TP> {
@@ -236,6 +498,8 @@ template <class TP> struct Scheduler : Scheduler_base<TP, TasksInfo_TP> {
   template <class T> void schedule(T &&task) {
     this->ti.schedule(this->ref.schedule_task(std::forward<T>(task)));
   }
+
+  static constexpr size_t TasksPerThread() { return TP::tasks_per_thread(); }
 };
 
 template <class TPType> inline Scheduler<TPType> getScheduler(TPType &tp) {
@@ -280,7 +544,6 @@ struct Scheduler<TBB_threadpool>
       task(thread_id);
     });
   }
-  static constexpr bool CanWaitInThread() { return false; }
 };
 
 using tasksinfo_t = TBB_TasksInfo;
@@ -291,6 +554,10 @@ using threadpool_t = TBB_threadpool;
 // The default backend
 namespace native_cpu {
 using tasksinfo_t = TasksInfo_TP;
+#ifdef NATIVECPU_WITH_WORK_STEALING
+using threadpool_t = work_stealing_threadpool_t;
+#else
 using threadpool_t = simple_threadpool_t;
+#endif
 } // namespace native_cpu
 #endif
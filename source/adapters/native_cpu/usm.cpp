@@ -12,10 +12,180 @@
 
 #include "common.hpp"
 #include "context.hpp"
+#include "usm.hpp"
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+
+ur_usm_pool_handle_t_::ur_usm_pool_handle_t_(
+    ur_context_handle_t hContext, const ur_usm_pool_desc_t *pPoolDesc)
+    : hContext(hContext),
+      ZeroInit(pPoolDesc->flags & UR_USM_POOL_FLAG_ZERO_INITIALIZE_BLOCK) {
+  const void *pNext = pPoolDesc->pNext;
+  while (pNext) {
+    auto *BaseDesc = static_cast<const ur_base_desc_t *>(pNext);
+    if (BaseDesc->stype == UR_STRUCTURE_TYPE_USM_POOL_LIMITS_DESC) {
+      auto *Limits = static_cast<const ur_usm_pool_limits_desc_t *>(pNext);
+      MaxPoolableSize = Limits->maxPoolableSize;
+    }
+    pNext = BaseDesc->pNext;
+  }
+  MaxPoolableSize =
+      std::min(MaxPoolableSize, getBucketSize(Buckets.size() - 1));
+}
+
+ur_usm_pool_handle_t_::~ur_usm_pool_handle_t_() { trim(0); }
+
+unsigned ur_usm_pool_handle_t_::getBucket(size_t blockSize) {
+  unsigned bucket = 0;
+  while (getBucketSize(bucket) < blockSize) {
+    bucket++;
+  }
+  return bucket;
+}
+
+void ur_usm_pool_handle_t_::addReserved(size_t size) {
+  size_t current = Reserved += size;
+  size_t high = ReservedHigh.load(std::memory_order_relaxed);
+  while (current > high && !ReservedHigh.compare_exchange_weak(high, current))
+    ;
+}
+
+void ur_usm_pool_handle_t_::addUsed(size_t size) {
+  size_t current = Used += size;
+  size_t high = UsedHigh.load(std::memory_order_relaxed);
+  while (current > high && !UsedHigh.compare_exchange_weak(high, current))
+    ;
+}
+
+void *ur_usm_pool_handle_t_::allocate(size_t blockSize, size_t alignment,
+                                      size_t userSize, bool &pooled) {
+  pooled = blockSize <= MaxPoolableSize && alignment <= BlockAlignment;
+  const size_t requestedSize = blockSize;
+  void *block = nullptr;
+  if (pooled) {
+    auto &bucket = Buckets[getBucket(blockSize)];
+    {
+      std::lock_guard<std::mutex> lock(bucket.mutex);
+      if (!bucket.blocks.empty()) {
+        block = bucket.blocks.back();
+        bucket.blocks.pop_back();
+      }
+    }
+    blockSize = getBucketSize(getBucket(blockSize));
+    if (block) {
+      Cached -= blockSize;
+      if (ZeroInit) {
+        // The block still holds the data of its previous allocation.
+        std::memset(block, 0, requestedSize);
+      }
+      addUsed(userSize);
+      return block;
+    }
+    alignment = BlockAlignment;
+  }
+  // aligned_malloc requires size to be a multiple of alignment; round up.
+  block = native_cpu::aligned_malloc(
+      alignment, (blockSize + alignment - 1) & ~(alignment - 1));
+  if (!block) {
+    return nullptr;
+  }
+  if (ZeroInit) {
+    std::memset(block, 0, blockSize);
+  }
+  addReserved(blockSize);
+  addUsed(userSize);
+  return block;
+}
+
+void ur_usm_pool_handle_t_::deallocate(void *block, size_t blockSize,
+                                       size_t userSize, bool pooled) {
+  Used -= userSize;
+  if (pooled) {
+    const unsigned bucketIdx = getBucket(blockSize);
+    blockSize = getBucketSize(bucketIdx);
+    if (Cached + blockSize <= ReleaseThreshold) {
+      Cached += blockSize;
+      auto &bucket = Buckets[bucketIdx];
+      std::lock_guard<std::mutex> lock(bucket.mutex);
+      bucket.blocks.push_back(block);
+      return;
+    }
+  }
+  native_cpu::aligned_free(block);
+  Reserved -= blockSize;
+}
+
+void ur_usm_pool_handle_t_::trim(size_t minBytesToKeep) {
+  // Release the biggest blocks first, they are the most expensive to keep.
+  for (unsigned i = Buckets.size(); i-- > 0 && Reserved > minBytesToKeep;) {
+    auto &bucket = Buckets[i];
+    std::lock_guard<std::mutex> lock(bucket.mutex);
+    while (!bucket.blocks.empty() && Reserved > minBytesToKeep) {
+      native_cpu::aligned_free(bucket.blocks.back());
+      bucket.blocks.pop_back();
+      Cached -= getBucketSize(i);
+      Reserved -= getBucketSize(i);
+    }
+  }
+}
+
+ur_result_t ur_usm_pool_handle_t_::getInfo(ur_usm_pool_info_t propName,
+                                           size_t propSize, void *pPropValue,
+                                           size_t *pPropSizeRet) {
+  UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
+
+  switch (propName) {
+  case UR_USM_POOL_INFO_REFERENCE_COUNT:
+    return ReturnValue(getReferenceCount());
+  case UR_USM_POOL_INFO_CONTEXT:
+    return ReturnValue(hContext);
+  case UR_USM_POOL_INFO_RELEASE_THRESHOLD_EXP:
+    return ReturnValue(ReleaseThreshold.load());
+  case UR_USM_POOL_INFO_MAXIMUM_SIZE_EXP:
+    // The pool can grow as much as the system allows.
+    return ReturnValue(size_t{0});
+  case UR_USM_POOL_INFO_RESERVED_CURRENT_EXP:
+    return ReturnValue(Reserved.load());
+  case UR_USM_POOL_INFO_RESERVED_HIGH_EXP:
+    return ReturnValue(ReservedHigh.load());
+  case UR_USM_POOL_INFO_USED_CURRENT_EXP:
+    return ReturnValue(Used.load());
+  case UR_USM_POOL_INFO_USED_HIGH_EXP:
+    return ReturnValue(UsedHigh.load());
+  default:
+    return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+  }
+}
+
+ur_result_t ur_usm_pool_handle_t_::setInfo(ur_usm_pool_info_t propName,
+                                           const void *pPropValue,
+                                           size_t propSize) {
+  UR_ASSERT(propSize == sizeof(size_t), UR_RESULT_ERROR_INVALID_SIZE);
+  size_t value;
+  std::memcpy(&value, pPropValue, sizeof(value));
+
+  switch (propName) {
+  case UR_USM_POOL_INFO_RELEASE_THRESHOLD_EXP:
+    ReleaseThreshold = value;
+    return UR_RESULT_SUCCESS;
+  case UR_USM_POOL_INFO_RESERVED_HIGH_EXP:
+    // The high watermarks can only be reset.
+    UR_ASSERT(value == 0, UR_RESULT_ERROR_INVALID_VALUE);
+    ReservedHigh = Reserved.load();
+    return UR_RESULT_SUCCESS;
+  case UR_USM_POOL_INFO_USED_HIGH_EXP:
+    UR_ASSERT(value == 0, UR_RESULT_ERROR_INVALID_VALUE);
+    UsedHigh = Used.load();
+    return UR_RESULT_SUCCESS;
+  default:
+    return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+  }
+}
 
 static ur_result_t alloc_helper(ur_context_handle_t hContext,
-                                const ur_usm_desc_t *pUSMDesc, size_t size,
+                                const ur_usm_desc_t *pUSMDesc,
+                                ur_usm_pool_handle_t pool, size_t size,
                                 void **ppMem, ur_usm_type_t type) {
   auto alignment = (pUSMDesc && pUSMDesc->align) ? pUSMDesc->align : 1u;
   UR_ASSERT(isPowerOf2(alignment), UR_RESULT_ERROR_UNSUPPORTED_ALIGNMENT);
@@ -23,7 +193,7 @@ static ur_result_t alloc_helper(ur_context_handle_t hContext,
   // TODO: Check Max size when UR_DEVICE_INFO_MAX_MEM_ALLOC_SIZE is implemented
   UR_ASSERT(size > 0, UR_RESULT_ERROR_INVALID_USM_SIZE);
 
-  auto *ptr = hContext->add_alloc(alignment, type, size, nullptr);
+  auto *ptr = hContext->add_alloc(alignment, type, size, pool);
   UR_ASSERT(ptr != nullptr, UR_RESULT_ERROR_OUT_OF_RESOURCES);
   *ppMem = ptr;
 
@@ -32,25 +202,27 @@ static ur_result_t alloc_helper(ur_context_handle_t hContext,
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urUSMHostAlloc(ur_context_handle_t hContext, const ur_usm_desc_t *pUSMDesc,
-               ur_usm_pool_handle_t /*pool*/, size_t size, void **ppMem) {
+               ur_usm_pool_handle_t pool, size_t size, void **ppMem) {
 
-  return alloc_helper(hContext, pUSMDesc, size, ppMem, UR_USM_TYPE_HOST);
+  return alloc_helper(hContext, pUSMDesc, pool, size, ppMem, UR_USM_TYPE_HOST);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urUSMDeviceAlloc(ur_context_handle_t hContext, ur_device_handle_t /*hDevice*/,
-                 const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t /*pool*/,
+                 const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t pool,
                  size_t size, void **ppMem) {
 
-  return alloc_helper(hContext, pUSMDesc, size, ppMem, UR_USM_TYPE_DEVICE);
+  return alloc_helper(hContext, pUSMDesc, pool, size, ppMem,
+                      UR_USM_TYPE_DEVICE);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
 urUSMSharedAlloc(ur_context_handle_t hContext, ur_device_handle_t /*hDevice*/,
-                 const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t /*pool*/,
+                 const ur_usm_desc_t *pUSMDesc, ur_usm_pool_handle_t pool,
                  size_t size, void **ppMem) {
 
-  return alloc_helper(hContext, pUSMDesc, size, ppMem, UR_USM_TYPE_SHARED);
+  return alloc_helper(hContext, pUSMDesc, pool, size, ppMem,
+                      UR_USM_TYPE_SHARED);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urUSMFree(ur_context_handle_t hContext,
@@ -71,16 +243,13 @@ urUSMGetMemAllocInfo(ur_context_handle_t hContext, const void *pMem,
 
   UR_ASSERT(pMem != nullptr, UR_RESULT_ERROR_INVALID_NULL_POINTER);
   UrReturnHelper ReturnValue(propSize, pPropValue, pPropSizeRet);
-  if (propName == UR_USM_ALLOC_INFO_BASE_PTR) {
-    // TODO: logic to compute base ptr given ptr
-    DIE_NO_IMPLEMENTATION;
-  }
-
   const native_cpu::usm_alloc_info &alloc_info =
       hContext->get_alloc_info_entry(pMem);
   switch (propName) {
   case UR_USM_ALLOC_INFO_TYPE:
     return ReturnValue(alloc_info.type);
+  case UR_USM_ALLOC_INFO_BASE_PTR:
+    return ReturnValue(alloc_info.base_ptr);
   case UR_USM_ALLOC_INFO_SIZE:
     return ReturnValue(alloc_info.size);
   case UR_USM_ALLOC_INFO_DEVICE:
@@ -93,30 +262,32 @@ urUSMGetMemAllocInfo(ur_context_handle_t hContext, const void *pMem,
   return UR_RESULT_ERROR_INVALID_VALUE;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolCreate(
-    ur_context_handle_t /*hContext*/, ur_usm_pool_desc_t * /*pPoolDesc*/,
-    ur_usm_pool_handle_t * /*ppPool*/) {
+UR_APIEXPORT ur_result_t UR_APICALL
+urUSMPoolCreate(ur_context_handle_t hContext, ur_usm_pool_desc_t *pPoolDesc,
+                ur_usm_pool_handle_t *ppPool) {
+  UR_ASSERT(pPoolDesc, UR_RESULT_ERROR_INVALID_NULL_POINTER);
+  UR_ASSERT(ppPool, UR_RESULT_ERROR_INVALID_NULL_POINTER);
 
-  DIE_NO_IMPLEMENTATION;
+  *ppPool = new ur_usm_pool_handle_t_(hContext, pPoolDesc);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urUSMPoolRetain(ur_usm_pool_handle_t /*pPool*/) {
-
-  DIE_NO_IMPLEMENTATION;
+urUSMPoolRetain(ur_usm_pool_handle_t pPool) {
+  pPool->incrementReferenceCount();
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL
-urUSMPoolRelease(ur_usm_pool_handle_t /*pPool*/) {
-
-  DIE_NO_IMPLEMENTATION;
+urUSMPoolRelease(ur_usm_pool_handle_t pPool) {
+  decrementOrDelete(pPool);
+  return UR_RESULT_SUCCESS;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolGetInfo(
-    ur_usm_pool_handle_t /*hPool*/, ur_usm_pool_info_t /*propName*/,
-    size_t /*propSize*/, void * /*pPropValue*/, size_t * /*pPropSizeRet*/) {
-
-  DIE_NO_IMPLEMENTATION;
+UR_APIEXPORT ur_result_t UR_APICALL
+urUSMPoolGetInfo(ur_usm_pool_handle_t hPool, ur_usm_pool_info_t propName,
+                 size_t propSize, void *pPropValue, size_t *pPropSizeRet) {
+  return hPool->getInfo(propName, propSize, pPropValue, pPropSizeRet);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urUSMImportExp(
@@ -142,10 +313,10 @@ UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolDestroyExp(ur_context_handle_t,
   DIE_NO_IMPLEMENTATION;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolSetInfoExp(ur_usm_pool_handle_t,
-                                                        ur_usm_pool_info_t,
-                                                        void *, size_t) {
-  DIE_NO_IMPLEMENTATION;
+UR_APIEXPORT ur_result_t UR_APICALL
+urUSMPoolSetInfoExp(ur_usm_pool_handle_t hPool, ur_usm_pool_info_t propName,
+                    void *pPropValue, size_t propSize) {
+  return hPool->setInfo(propName, pPropValue, propSize);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolGetDefaultDevicePoolExp(
@@ -153,10 +324,12 @@ UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolGetDefaultDevicePoolExp(
   DIE_NO_IMPLEMENTATION;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolGetInfoExp(ur_usm_pool_handle_t,
-                                                        ur_usm_pool_info_t,
-                                                        void *, size_t *) {
-  DIE_NO_IMPLEMENTATION;
+UR_APIEXPORT ur_result_t UR_APICALL
+urUSMPoolGetInfoExp(ur_usm_pool_handle_t hPool, ur_usm_pool_info_t propName,
+                    void *pPropValue, size_t *pPropSizeRet) {
+  // All the pool usage values are size_t.
+  return hPool->getInfo(propName, pPropValue ? sizeof(size_t) : 0, pPropValue,
+                        pPropSizeRet);
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolGetDevicePoolExp(
@@ -169,11 +342,11 @@ UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolSetDevicePoolExp(
   DIE_NO_IMPLEMENTATION;
 }
 
-UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolTrimToExp(ur_context_handle_t,
-                                                       ur_device_handle_t,
-                                                       ur_usm_pool_handle_t,
-                                                       size_t) {
-  DIE_NO_IMPLEMENTATION;
+UR_APIEXPORT ur_result_t UR_APICALL urUSMPoolTrimToExp(
+    ur_context_handle_t, ur_device_handle_t, ur_usm_pool_handle_t hPool,
+    size_t minBytesToKeep) {
+  hPool->trim(minBytesToKeep);
+  return UR_RESULT_SUCCESS;
 }
 
 UR_APIEXPORT ur_result_t UR_APICALL urUSMContextMemcpyExp(ur_context_handle_t,
@@ -0,0 +1,91 @@
+//===--------- usm.hpp - Native CPU Adapter -------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "common.hpp"
+#include "unified-runtime/ur_api.h"
+
+// A USM pool keeps the blocks freed by the application in buckets of
+// power-of-two sizes, so that later allocations which fit in a bucket reuse
+// them rather than going back to the system allocator. Each bucket has its
+// own lock. Allocations that are too big or too strictly aligned to be pooled
+// are still accounted for, but bypass the buckets.
+struct ur_usm_pool_handle_t_ : RefCounted {
+  ur_usm_pool_handle_t_(ur_context_handle_t hContext,
+                        const ur_usm_pool_desc_t *pPoolDesc);
+
+  ~ur_usm_pool_handle_t_();
+
+  // Returns a block of at least blockSize bytes aligned to alignment, of
+  // which userSize bytes are handed out to the application, or nullptr if
+  // the allocation failed. pooled is set if the block has to be returned to
+  // the buckets.
+  void *allocate(size_t blockSize, size_t alignment, size_t userSize,
+                 bool &pooled);
+
+  // Returns a block obtained from allocate with the same sizes.
+  void deallocate(void *block, size_t blockSize, size_t userSize, bool pooled);
+
+  // Frees cached blocks until at most minBytesToKeep bytes are reserved.
+  void trim(size_t minBytesToKeep);
+
+  ur_result_t getInfo(ur_usm_pool_info_t propName, size_t propSize,
+                      void *pPropValue, size_t *pPropSizeRet);
+
+  ur_result_t setInfo(ur_usm_pool_info_t propName, const void *pPropValue,
+                      size_t propSize);
+
+  ur_context_handle_t hContext;
+
+private:
+  // Blocks are aligned to a cache line, so that they can serve any
+  // allocation that isn't aligned more strictly.
+  static constexpr size_t BlockAlignment = 64;
+  static constexpr unsigned MinBucketSizeLog2 = 6;
+  static constexpr unsigned MaxBucketSizeLog2 = 31;
+  // Allocations up to this size are pooled by default.
+  static constexpr size_t DefaultMaxPoolableSize = 2 * 1024 * 1024;
+  // Freed blocks are kept until the cached memory exceeds this by default.
+  static constexpr size_t DefaultReleaseThreshold = 16 * 1024 * 1024;
+
+  struct alignas(64) bucket_t {
+    std::mutex mutex;
+    std::vector<void *> blocks;
+  };
+
+  static unsigned getBucket(size_t blockSize);
+
+  static size_t getBucketSize(unsigned bucket) {
+    return size_t{1} << (bucket + MinBucketSizeLog2);
+  }
+
+  void addReserved(size_t size);
+  void addUsed(size_t size);
+
+  bool ZeroInit;
+  size_t MaxPoolableSize = DefaultMaxPoolableSize;
+  std::atomic<size_t> ReleaseThreshold{DefaultReleaseThreshold};
+  std::array<bucket_t, MaxBucketSizeLog2 - MinBucketSizeLog2 + 1> Buckets;
+
+  // Memory obtained from the system, including the cached blocks.
+  std::atomic<size_t> Reserved{0};
+  std::atomic<size_t> ReservedHigh{0};
+  // Memory handed out to the application.
+  std::atomic<size_t> Used{0};
+  std::atomic<size_t> UsedHigh{0};
+  // Memory held by the cached blocks.
+  std::atomic<size_t> Cached{0};
+};
@@ -15,6 +15,14 @@ static constexpr int MaxBacktraceFrames = 64;
 using BacktraceLine = std::string;
 std::vector<BacktraceLine> getCurrentBacktrace();
 
+// Capturing the return addresses of a call stack is much cheaper than
+// symbolizing them, so backtraces that are printed only in some cases are
+// captured with captureBacktrace and symbolized when they are printed.
+using BacktraceFrame = void *;
+size_t captureBacktrace(BacktraceFrame *frames, size_t maxFrames);
+std::vector<BacktraceLine> symbolizeBacktrace(const BacktraceFrame *frames,
+                                              size_t frameCount);
+
 } // namespace ur
 
 #endif /* UR_BACKTRACE_H */
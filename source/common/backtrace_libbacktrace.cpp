@@ -74,8 +74,15 @@ int backtrace_cb(void *data, uintptr_t pc, const char *filename, int lineno,
   return 0;
 }
 
+// The state holds the debug info read so far, so it is shared by all the
+// backtraces, and can't be freed.
+static backtrace_state *getBacktraceState() {
+  static backtrace_state *state = backtrace_create_state(NULL, 1, NULL, NULL);
+  return state;
+}
+
 std::vector<BacktraceLine> getCurrentBacktrace() {
-  backtrace_state *state = backtrace_create_state(NULL, 0, NULL, NULL);
+  backtrace_state *state = getBacktraceState();
   if (state == NULL) {
     return std::vector<std::string>(1, "Failed to acquire a backtrace");
   }
@@ -91,4 +98,49 @@ std::vector<BacktraceLine> getCurrentBacktrace() {
   return backtrace;
 }
 
+struct captured_frames {
+  BacktraceFrame *frames;
+  size_t maxFrames;
+  size_t frameCount;
+};
+
+int capture_cb(void *data, uintptr_t pc) {
+  auto captured = reinterpret_cast<captured_frames *>(data);
+  captured->frames[captured->frameCount++] =
+      reinterpret_cast<BacktraceFrame>(pc);
+  return captured->frameCount == captured->maxFrames;
+}
+
+size_t captureBacktrace(BacktraceFrame *frames, size_t maxFrames) {
+  backtrace_state *state = getBacktraceState();
+  if (state == NULL || maxFrames == 0) {
+    return 0;
+  }
+
+  captured_frames captured{frames, maxFrames, 0};
+  backtrace_simple(state, 0, capture_cb, NULL, &captured);
+  return captured.frameCount;
+}
+
+std::vector<BacktraceLine> symbolizeBacktrace(const BacktraceFrame *frames,
+                                              size_t frameCount) {
+  backtrace_state *state = getBacktraceState();
+  if (state == NULL) {
+    return std::vector<std::string>(1, "Failed to acquire a backtrace");
+  }
+
+  std::vector<BacktraceLine> backtrace;
+  for (size_t i = 0; i < frameCount; i++) {
+    backtrace_pcinfo(state, reinterpret_cast<uintptr_t>(frames[i]),
+                     backtrace_cb, NULL, &backtrace);
+  }
+  if (backtrace.empty()) {
+    return std::vector<std::string>(1, "Failed to acquire a backtrace");
+  }
+
+  filter_after_occurence(backtrace, "ur_libapi.cpp");
+
+  return backtrace;
+}
+
 } // namespace ur
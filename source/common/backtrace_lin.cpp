@@ -13,9 +13,20 @@
 namespace ur {
 
 std::vector<BacktraceLine> getCurrentBacktrace() {
-  void *backtraceFrames[MaxBacktraceFrames];
-  int frameCount = ::backtrace(backtraceFrames, MaxBacktraceFrames);
-  char **backtraceStr = ::backtrace_symbols(backtraceFrames, frameCount);
+  BacktraceFrame backtraceFrames[MaxBacktraceFrames];
+  size_t frameCount = captureBacktrace(backtraceFrames, MaxBacktraceFrames);
+  return symbolizeBacktrace(backtraceFrames, frameCount);
+}
+
+size_t captureBacktrace(BacktraceFrame *frames, size_t maxFrames) {
+  int frameCount = ::backtrace(frames, static_cast<int>(maxFrames));
+  return frameCount > 0 ? static_cast<size_t>(frameCount) : 0;
+}
+
+std::vector<BacktraceLine> symbolizeBacktrace(const BacktraceFrame *frames,
+                                              size_t frameCount) {
+  char **backtraceStr =
+      ::backtrace_symbols(frames, static_cast<int>(frameCount));
   // TODO: implement getting demangled symbols using abi::__cxa_demangle
   if (backtraceStr == nullptr) {
     return std::vector<BacktraceLine>(1, "Failed to acquire a backtrace");
@@ -23,7 +34,7 @@ std::vector<BacktraceLine> getCurrentBacktrace() {
 
   std::vector<BacktraceLine> backtrace;
   try {
-    for (int i = 0; i < frameCount; i++) {
+    for (size_t i = 0; i < frameCount; i++) {
       backtrace.emplace_back(backtraceStr[i]);
     }
   } catch (std::bad_alloc &) {
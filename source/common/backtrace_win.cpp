@@ -17,12 +17,20 @@
 namespace ur {
 
 std::vector<BacktraceLine> getCurrentBacktrace() {
+  BacktraceFrame frames[MaxBacktraceFrames];
+  size_t frameCount = captureBacktrace(frames, MaxBacktraceFrames);
+  return symbolizeBacktrace(frames, frameCount);
+}
+
+size_t captureBacktrace(BacktraceFrame *frames, size_t maxFrames) {
+  return CaptureStackBackTrace(0, static_cast<DWORD>(maxFrames), frames, NULL);
+}
+
+std::vector<BacktraceLine> symbolizeBacktrace(const BacktraceFrame *frames,
+                                              size_t frameCount) {
   HANDLE process = GetCurrentProcess();
   SymInitialize(process, nullptr, true);
 
-  PVOID frames[MaxBacktraceFrames];
-  WORD frameCount = CaptureStackBackTrace(0, MaxBacktraceFrames, frames, NULL);
-
   if (frameCount == 0) {
     SymCleanup(process);
     return std::vector<BacktraceLine>(1, "Failed to acquire a backtrace");
@@ -34,7 +42,7 @@ std::vector<BacktraceLine> getCurrentBacktrace() {
 
   std::vector<BacktraceLine> backtrace;
   try {
-    for (int i = 0; i < frameCount; i++) {
+    for (size_t i = 0; i < frameCount; i++) {
       if (SymGetLineFromAddr64(process, (DWORD64)frames[i], &displacement,
                                &line)) {
         backtrace.push_back(std::string(line.FileName) + ":" +
@@ -18,8 +18,24 @@
 
 #if defined(UR_ENABLE_LATENCY_HISTOGRAM)
 
+#include <atomic>
+#include <csignal>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
 #include <hdr/hdr_histogram.h>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define UR_LATENCY_HAS_TSC 1
+#endif
+
 static inline bool trackLatency = []() {
   try {
     auto map = getenv_to_map("UR_LOG_LATENCY");
@@ -36,6 +52,91 @@ static inline bool trackLatency = []() {
   }
 }();
 
+// UR_LATENCY_HISTOGRAM_OPTIONS tunes the tracking enabled by UR_LOG_LATENCY:
+// - clock:steady|tsc is the clock the scopes are timed with. The TSC is
+//   cheaper to read than steady_clock, and its ticks are converted to
+//   nanoseconds when the histograms are printed.
+// - dump_signal:<number> is a signal on which the histograms collected so far
+//   are printed, by the next tracked scope that ends.
+struct latency_options {
+  bool useTsc = false;
+  int dumpSignal = 0;
+};
+
+static inline latency_options latencyOptions = []() {
+  latency_options options;
+  try {
+    auto map = getenv_to_map("UR_LATENCY_HISTOGRAM_OPTIONS");
+    if (!map.has_value()) {
+      return options;
+    }
+
+    auto it = map->find("clock");
+    if (it != map->end()) {
+#ifdef UR_LATENCY_HAS_TSC
+      options.useTsc = it->second.front() == "tsc";
+#else
+      if (it->second.front() == "tsc") {
+        UR_LOG(WARN, "TSC is not available, timing latency with steady_clock");
+      }
+#endif
+    }
+
+    it = map->find("dump_signal");
+    if (it != map->end()) {
+      options.dumpSignal = std::stoi(it->second.front());
+    }
+  } catch (...) {
+    UR_LOG(ERR, "Failed to parse UR_LATENCY_HISTOGRAM_OPTIONS");
+  }
+  return options;
+}();
+
+// Returns the current time, in ticks of the clock chosen in the options.
+static inline int64_t latencyClockNow() {
+#ifdef UR_LATENCY_HAS_TSC
+  if (latencyOptions.useTsc) {
+    return static_cast<int64_t>(__rdtsc());
+  }
+#endif
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// When the tracking started, to convert ticks of the clock to nanoseconds by
+// comparing the ticks since then with the time that passed.
+static inline const int64_t latencyStartTicks = latencyClockNow();
+static inline const auto latencyStart = std::chrono::steady_clock::now();
+
+static inline double latencyNanosPerTick() {
+  if (!latencyOptions.useTsc) {
+    return 1.0;
+  }
+  auto ticks = latencyClockNow() - latencyStartTicks;
+  auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - latencyStart)
+                   .count();
+  return ticks > 0 ? static_cast<double>(nanos) / ticks : 1.0;
+}
+
+// Set by the dump signal. The libraries are built with hidden symbols, so each
+// library using the tracker has its own flag and its own handler.
+inline std::atomic<bool> latencyDumpRequested{false};
+inline void (*previousLatencySignalHandler)(int) = nullptr;
+
+inline void latencySignalHandler(int signal) {
+  latencyDumpRequested.store(true, std::memory_order_relaxed);
+  // Each library using the tracker installs its handler, which calls the
+  // handler it replaced, so that all the libraries print their histograms.
+  if (previousLatencySignalHandler != SIG_DFL &&
+      previousLatencySignalHandler != SIG_IGN &&
+      previousLatencySignalHandler != SIG_ERR &&
+      previousLatencySignalHandler != nullptr) {
+    previousLatencySignalHandler(signal);
+  }
+}
+
 static constexpr size_t numPercentiles = 7;
 static constexpr double percentiles[numPercentiles] = {
     50.0, 90.0, 99.0, 99.9, 99.99, 99.999, 99.9999};
@@ -52,28 +153,74 @@ struct latencyValues {
 using histogram_ptr =
     std::unique_ptr<struct hdr_histogram, decltype(&hdr_close)>;
 
-static inline latencyValues getValues(const struct hdr_histogram *histogram) {
+static inline latencyValues getValues(const struct hdr_histogram *histogram,
+                                      double nanosPerTick) {
+  auto toNanos = [&](double ticks) {
+    return static_cast<int64_t>(ticks * nanosPerTick);
+  };
+
   latencyValues values;
   values.count = histogram->total_count;
-  values.max = hdr_max(histogram);
-  values.min = hdr_min(histogram);
-  values.mean = static_cast<int64_t>(hdr_mean(histogram));
-  values.stddev = static_cast<int64_t>(hdr_stddev(histogram));
+  values.max = toNanos(hdr_max(histogram));
+  values.min = toNanos(hdr_min(histogram));
+  values.mean = toNanos(hdr_mean(histogram));
+  values.stddev = toNanos(hdr_stddev(histogram));
 
   auto ret = hdr_value_at_percentiles(histogram, percentiles,
                                       values.percentileValues, numPercentiles);
   if (ret != 0) {
     UR_LOG(ERR, "Failed to get percentiles from latency histogram");
   }
+  for (auto &value : values.percentileValues) {
+    value = toNanos(value);
+  }
 
   return values;
 }
 
+static inline histogram_ptr copyHistogram(const struct hdr_histogram *from) {
+  struct hdr_histogram *cHistogram = nullptr;
+  if (hdr_init(from->lowest_discernible_value, from->highest_trackable_value,
+               from->significant_figures, &cHistogram) != 0) {
+    return histogram_ptr(nullptr, &hdr_close);
+  }
+  hdr_add(cHistogram, from);
+  return histogram_ptr(cHistogram, &hdr_close);
+}
+
+class latency_histogram;
+
+// Collects the histograms of all the threads. The histogram of a thread is
+// merged into the values of its scope when the thread exits, and the histograms
+// of the running threads are merged into a copy of those when printing.
 class latency_printer {
 public:
-  latency_printer() : logger(logger::create_logger("latency", true, false)) {}
+  latency_printer() : logger(logger::create_logger("latency", true, false)) {
+    // Only one printer of the library installs the handler.
+    if (trackLatency && latencyOptions.dumpSignal != 0 &&
+        !latencySignalHandlerInstalled.exchange(true)) {
+      installedSignalHandler = true;
+      previousLatencySignalHandler =
+          std::signal(latencyOptions.dumpSignal, latencySignalHandler);
+    }
+  }
+
+  latency_printer(const latency_printer &) = delete;
+  latency_printer &operator=(const latency_printer &) = delete;
+
+  inline void addHistogram(latency_histogram *histogram) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    liveHistograms.insert(histogram);
+  }
 
-  inline void publishLatency(const std::string &name, histogram_ptr histogram) {
+  inline void publishLatency(latency_histogram *liveHistogram,
+                             const std::string &name,
+                             histogram_ptr histogram) {
+    std::scoped_lock<std::mutex> lock(mutex);
+    liveHistograms.erase(liveHistogram);
+    if (!histogram) {
+      return;
+    }
     auto [it, inserted] = values.try_emplace(name, std::move(histogram));
     if (!inserted) {
       // combine histograms
@@ -85,25 +232,35 @@ public:
     if (trackLatency) {
       print();
     }
+    if (installedSignalHandler) {
+      restoreSignalHandler();
+    }
   }
 
-  inline void print() {
-    printHeader();
+  inline void print();
 
-    for (auto &[name, histogram] : values) {
-      auto value = getValues(histogram.get());
-      auto f = groupDigits<int64_t>;
-      UR_LOG_L(logger, INFO, "{},{},{},{},{},{},{},{},{},{},{},{},{},{},ns",
-               name, f(value.mean), f(value.percentileValues[0]),
-               f(value.percentileValues[1]), f(value.percentileValues[2]),
-               f(value.percentileValues[3]), f(value.percentileValues[4]),
-               f(value.percentileValues[5]), f(value.percentileValues[6]),
-               f(value.count), f(value.count * value.mean), f(value.min),
-               f(value.max), value.stddev);
+  // Prints the histograms if the dump signal was received since the last call.
+  inline void printIfRequested() {
+    if (latencyDumpRequested.load(std::memory_order_relaxed) &&
+        latencyDumpRequested.exchange(false)) {
+      print();
     }
   }
 
 private:
+  // Puts back the handler replaced by the constructor, unless another handler
+  // replaced ours since, as that one may call ours.
+  inline void restoreSignalHandler() {
+    auto current = std::signal(latencyOptions.dumpSignal,
+                               previousLatencySignalHandler);
+    if (current != latencySignalHandler) {
+      std::signal(latencyOptions.dumpSignal, current);
+      return;
+    }
+    previousLatencySignalHandler = nullptr;
+    latencySignalHandlerInstalled = false;
+  }
+
   inline void printHeader() {
     UR_LOG_L(logger, INFO, "Latency histogram:");
     UR_LOG_L(logger, INFO,
@@ -113,8 +270,13 @@ private:
              percentiles[4], percentiles[5], percentiles[6]);
   }
 
+  std::mutex mutex;
   std::map<std::string, histogram_ptr> values;
+  std::set<latency_histogram *> liveHistograms;
   logger::Logger logger;
+  bool installedSignalHandler = false;
+
+  static inline std::atomic<bool> latencySignalHandlerInstalled{false};
 };
 
 inline latency_printer &globalLatencyPrinter() {
@@ -122,6 +284,9 @@ inline latency_printer &globalLatencyPrinter() {
   return printer;
 }
 
+// The histogram of a scope on one thread. Only its thread records values in
+// it, but they are recorded atomically so that it can be printed while the
+// thread is running.
 class latency_histogram {
 public:
   inline latency_histogram(const char *name,
@@ -136,9 +301,11 @@ public:
                           significantFigures, &cHistogram);
       if (ret != 0) {
         UR_LOG(ERR, "Failed to initialize latency histogram");
+        return;
       }
       histogram = std::unique_ptr<struct hdr_histogram, decltype(&hdr_close)>(
           cHistogram, &hdr_close);
+      printer.addHistogram(this);
     }
   }
 
@@ -152,38 +319,75 @@ public:
 
     if (hdr_min(histogram.get()) == std::numeric_limits<int64_t>::max()) {
       UR_LOG(INFO, "[{}] latency: no data", name);
+      printer.publishLatency(this, name, histogram_ptr(nullptr, &hdr_close));
       return;
     }
 
-    printer.publishLatency(name, std::move(histogram));
+    printer.publishLatency(this, name, std::move(histogram));
   }
 
   inline void trackValue(int64_t value) {
-    hdr_record_value(histogram.get(), value);
+    hdr_record_value_atomic(histogram.get(), value);
+    printer.printIfRequested();
   }
 
+  const char *getName() const { return name; }
+  const struct hdr_histogram *get() const { return histogram.get(); }
+
 private:
   const char *name;
   histogram_ptr histogram;
   latency_printer &printer;
 };
 
+// Prints the values of the exited threads combined with the values recorded so
+// far by the running threads. May be called at any time.
+inline void latency_printer::print() {
+  std::scoped_lock<std::mutex> lock(mutex);
+
+  std::map<std::string, histogram_ptr> combined;
+  for (auto &[name, histogram] : values) {
+    combined.try_emplace(name, copyHistogram(histogram.get()));
+  }
+  for (auto *liveHistogram : liveHistograms) {
+    auto [it, inserted] = combined.try_emplace(
+        liveHistogram->getName(), copyHistogram(liveHistogram->get()));
+    if (!inserted && it->second) {
+      hdr_add(it->second.get(), liveHistogram->get());
+    }
+  }
+
+  printHeader();
+
+  auto nanosPerTick = latencyNanosPerTick();
+  for (auto &[name, histogram] : combined) {
+    if (!histogram || histogram->total_count == 0) {
+      continue;
+    }
+    auto value = getValues(histogram.get(), nanosPerTick);
+    auto f = groupDigits<int64_t>;
+    UR_LOG_L(logger, INFO, "{},{},{},{},{},{},{},{},{},{},{},{},{},{},ns",
+             name, f(value.mean), f(value.percentileValues[0]),
+             f(value.percentileValues[1]), f(value.percentileValues[2]),
+             f(value.percentileValues[3]), f(value.percentileValues[4]),
+             f(value.percentileValues[5]), f(value.percentileValues[6]),
+             f(value.count), f(value.count * value.mean), f(value.min),
+             f(value.max), value.stddev);
+  }
+}
+
 class latency_tracker {
 public:
   inline explicit latency_tracker(latency_histogram &stats)
       : stats(trackLatency ? &stats : nullptr), begin() {
     if (trackLatency) {
-      begin = std::chrono::steady_clock::now();
+      begin = latencyClockNow();
     }
   }
   inline latency_tracker() {}
   inline ~latency_tracker() {
     if (stats) {
-      auto tp = std::chrono::steady_clock::now();
-      auto diffNanos =
-          std::chrono::duration_cast<std::chrono::nanoseconds>(tp - begin)
-              .count();
-      stats->trackValue(static_cast<int64_t>(diffNanos));
+      stats->trackValue(latencyClockNow() - begin);
     }
   }
 
@@ -205,15 +409,16 @@ public:
 
 private:
   latency_histogram *stats{nullptr};
-  std::chrono::time_point<std::chrono::steady_clock> begin;
+  // In ticks of the clock chosen in the options.
+  int64_t begin{0};
 };
 
 // To resolve __COUNTER__
 #define CONCAT(a, b) a##b
 
 // Each tracker has it's own thread-local histogram.
-// At program exit, all histograms for the same scope are
-// aggregated.
+// At thread exit, the histogram is merged with the others for the same scope,
+// and all histograms are printed at program exit or on the dump signal.
 #define TRACK_SCOPE_LATENCY_CNT(name, cnt)                                     \
   static thread_local latency_histogram CONCAT(histogram, cnt)(name);          \
   latency_tracker CONCAT(tracker, cnt)(CONCAT(histogram, cnt));
@@ -13,6 +13,8 @@
 #define ADD_FULL_PATH_LOG
 #endif
 
+#include <algorithm>
+
 #include "logger/ur_logger.hpp"
 #include "ur_lib_loader.hpp"
 
@@ -89,4 +91,62 @@ void *LibLoader::getFunctionPtr(HMODULE handle, const char *func_name) {
   return ptr;
 }
 
+std::string LibLoader::getLibraryPath(HMODULE handle) {
+#if defined(ADD_FULL_PATH_LOG)
+  struct link_map *dlinfo_map;
+  if (dlinfo(handle, RTLD_DI_LINKMAP, &dlinfo_map) == 0 &&
+      dlinfo_map->l_name != nullptr) {
+    return dlinfo_map->l_name;
+  }
+#else
+  (void)handle;
+#endif
+  return {};
+}
+
+std::vector<std::string> LibLoader::getDependencyPaths(HMODULE handle) {
+  std::vector<std::string> paths;
+#if defined(ADD_FULL_PATH_LOG)
+  struct link_map *dlinfo_map;
+  if (dlinfo(handle, RTLD_DI_LINKMAP, &dlinfo_map) != 0) {
+    return paths;
+  }
+
+  // The dynamic section is relocated on most targets, but not all of them.
+  auto address = [dlinfo_map](ElfW(Addr) ptr) {
+    return ptr < dlinfo_map->l_addr ? ptr + dlinfo_map->l_addr : ptr;
+  };
+  const char *strtab = nullptr;
+  for (auto *dyn = dlinfo_map->l_ld; dyn->d_tag != DT_NULL; dyn++) {
+    if (dyn->d_tag == DT_STRTAB) {
+      strtab = reinterpret_cast<const char *>(address(dyn->d_un.d_ptr));
+    }
+  }
+  // The direct dependencies are already loaded, so they're only looked up.
+  for (auto *dyn = dlinfo_map->l_ld; strtab && dyn->d_tag != DT_NULL; dyn++) {
+    if (dyn->d_tag != DT_NEEDED) {
+      continue;
+    }
+    if (HMODULE dependency =
+            dlopen(strtab + dyn->d_un.d_val, RTLD_LAZY | RTLD_NOLOAD)) {
+      paths.push_back(getLibraryPath(dependency));
+      dlclose(dependency);
+    }
+  }
+
+  for (auto *map = dlinfo_map->l_next; map; map = map->l_next) {
+    if (map->l_name && *map->l_name) {
+      paths.push_back(map->l_name);
+    }
+  }
+#else
+  (void)handle;
+#endif
+  std::sort(paths.begin(), paths.end());
+  paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+  paths.erase(std::remove(paths.begin(), paths.end(), std::string()),
+              paths.end());
+  return paths;
+}
+
 } // namespace ur_loader
@@ -0,0 +1,289 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef UR_ASYNC_QUEUE_HPP
+#define UR_ASYNC_QUEUE_HPP 1
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace logger {
+
+// What an asynchronous sink does with a message when the calling thread's
+// ring is full.
+enum class AsyncPolicy {
+  // Drop the message, the writer reports how many were dropped.
+  Drop,
+  // Wait for the writer to make room.
+  Block
+};
+
+inline AsyncPolicy str_to_async_policy(const std::string &name) {
+  if (name == "drop") {
+    return AsyncPolicy::Drop;
+  }
+  if (name == "block") {
+    return AsyncPolicy::Block;
+  }
+  throw std::invalid_argument(
+      std::string("Parsing error: no valid async policy for string '") +
+      name + std::string("'.") +
+      std::string("\nValid async policy names are: drop and block"));
+}
+
+// A message recorded by a thread, which the writer thread formats and
+// outputs.
+struct AsyncRecord {
+  virtual ~AsyncRecord() = default;
+  virtual void write() = 0;
+};
+
+// Hands messages from the logging threads over to a writer thread. Every
+// thread that logs gets its own single-producer ring of fixed-size slots, in
+// which it constructs its records without taking any lock. The writer drains
+// the rings in turn, so the messages of a thread stay in order but those of
+// different threads may be interleaved differently than they were logged.
+class AsyncQueue {
+public:
+  static constexpr size_t SlotSize = 256;
+  static constexpr size_t DefaultCapacity = 256;
+
+  struct alignas(64) Slot {
+    AsyncRecord *record;
+    bool waitForWrite;
+    // The space for the record of a message and its format string.
+    alignas(alignof(std::max_align_t)) unsigned char
+        data[SlotSize - alignof(std::max_align_t)];
+  };
+  static_assert(sizeof(Slot) == SlotSize);
+
+  // onDropped is called by the writer with the number of messages dropped
+  // since the last call.
+  AsyncQueue(AsyncPolicy policy, size_t capacity,
+             std::function<void(size_t)> onDropped)
+      : policy(policy), capacity(capacity), onDropped(std::move(onDropped)),
+        id(nextId()) {
+    writer = std::thread([this]() { run(); });
+  }
+
+  ~AsyncQueue() {
+    {
+      std::scoped_lock<std::mutex> lock(wakeMutex);
+      stopping = true;
+    }
+    wakeCondition.notify_one();
+    writer.join();
+  }
+
+  AsyncQueue(const AsyncQueue &) = delete;
+  AsyncQueue &operator=(const AsyncQueue &) = delete;
+
+  bool isWriterThread() const {
+    return std::this_thread::get_id() == writer.get_id();
+  }
+
+  // Returns the slot the calling thread has to construct its next record in,
+  // or nullptr if the message has to be dropped. Messages that mustn't be
+  // dropped wait for room whatever the policy.
+  Slot *reserve(bool mayDrop = true) {
+    Ring &ring = getRing();
+    const size_t head = ring.head.load(std::memory_order_relaxed);
+    while (head - ring.tail.load(std::memory_order_acquire) == capacity) {
+      if (policy == AsyncPolicy::Drop && mayDrop) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      wake();
+      std::this_thread::yield();
+    }
+    return &ring.slots[head % capacity];
+  }
+
+  // Publishes the record constructed in the slot returned by the last call
+  // to reserve. With waitForWrite, returns once the writer has output it.
+  void commit(AsyncRecord *record, bool waitForWrite) {
+    Ring &ring = getRing();
+    const size_t head = ring.head.load(std::memory_order_relaxed);
+    Slot &slot = ring.slots[head % capacity];
+    slot.record = record;
+    slot.waitForWrite = waitForWrite;
+    ring.head.store(head + 1, std::memory_order_seq_cst);
+    if (waitForWrite) {
+      wake();
+      std::unique_lock<std::mutex> lock(writtenMutex);
+      writtenCondition.wait(lock, [&]() {
+        return ring.tail.load(std::memory_order_acquire) > head;
+      });
+    } else if (sleeping.load(std::memory_order_seq_cst)) {
+      wake();
+    }
+  }
+
+private:
+  struct Ring {
+    explicit Ring(size_t capacity) : slots(capacity) {}
+    std::vector<Slot> slots;
+    // Only written by the thread owning the ring.
+    alignas(64) std::atomic<size_t> head{0};
+    // Only written by the writer thread.
+    alignas(64) std::atomic<size_t> tail{0};
+    std::atomic<size_t> dropped{0};
+    // Set once the owning thread has exited.
+    std::atomic<bool> abandoned{false};
+  };
+
+  // The rings of the calling thread, for every queue it logged to.
+  struct ThreadRings {
+    std::vector<std::pair<uint64_t, std::shared_ptr<Ring>>> rings;
+    ~ThreadRings() {
+      for (auto &ring : rings) {
+        ring.second->abandoned = true;
+      }
+    }
+  };
+
+  static uint64_t nextId() {
+    static std::atomic<uint64_t> Id{0};
+    return Id++;
+  }
+
+  Ring &getRing() {
+    thread_local ThreadRings threadRings;
+    for (auto &[ringId, ring] : threadRings.rings) {
+      if (ringId == id) {
+        return *ring;
+      }
+    }
+    auto ring = std::make_shared<Ring>(capacity);
+    {
+      std::scoped_lock<std::mutex> lock(ringsMutex);
+      rings.push_back(ring);
+    }
+    threadRings.rings.emplace_back(id, ring);
+    return *ring;
+  }
+
+  void wake() {
+    {
+      std::scoped_lock<std::mutex> lock(wakeMutex);
+      wakeRequested = true;
+    }
+    wakeCondition.notify_one();
+  }
+
+  bool hasPending() {
+    std::scoped_lock<std::mutex> lock(ringsMutex);
+    return std::any_of(rings.begin(), rings.end(), [](const auto &ring) {
+      return ring->head.load(std::memory_order_seq_cst) !=
+             ring->tail.load(std::memory_order_relaxed);
+    });
+  }
+
+  // Writes out everything the rings hold, returns whether there was
+  // anything.
+  bool drain() {
+    bool written = false;
+    std::scoped_lock<std::mutex> lock(ringsMutex);
+    for (auto it = rings.begin(); it != rings.end();) {
+      Ring &ring = **it;
+      const bool abandoned = ring.abandoned.load(std::memory_order_acquire);
+      const size_t head = ring.head.load(std::memory_order_acquire);
+      for (size_t tail = ring.tail.load(std::memory_order_relaxed);
+           tail != head; tail++) {
+        Slot &slot = ring.slots[tail % capacity];
+        try {
+          slot.record->write();
+        } catch (...) {
+          // Losing a message is better than losing the writer.
+        }
+        slot.record->~AsyncRecord();
+        // The slot can be reused as soon as the tail moves past it.
+        const bool waitForWrite = slot.waitForWrite;
+        ring.tail.store(tail + 1, std::memory_order_release);
+        if (waitForWrite) {
+          { std::scoped_lock<std::mutex> writtenLock(writtenMutex); }
+          writtenCondition.notify_all();
+        }
+        written = true;
+      }
+      if (size_t dropped = ring.dropped.exchange(0)) {
+        onDropped(dropped);
+      }
+      if (abandoned) {
+        it = rings.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return written;
+  }
+
+  void run() {
+    // How long the writer waits for more messages once it ran out of them,
+    // before it has the threads wake it up for their next one.
+    constexpr auto LingerTime = std::chrono::milliseconds(1);
+    while (true) {
+      if (drain()) {
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(wakeMutex);
+      if (stopping) {
+        break;
+      }
+      if (!wakeCondition.wait_for(lock, LingerTime,
+                                  [this]() { return wakeRequested; })) {
+        // The rings are checked again after setting the flag, as a thread
+        // might have published a message without seeing it.
+        sleeping.store(true, std::memory_order_seq_cst);
+        lock.unlock();
+        const bool pending = hasPending();
+        lock.lock();
+        if (!pending) {
+          wakeCondition.wait(lock,
+                             [this]() { return wakeRequested || stopping; });
+        }
+        sleeping.store(false, std::memory_order_relaxed);
+      }
+      wakeRequested = false;
+    }
+    drain();
+  }
+
+  const AsyncPolicy policy;
+  const size_t capacity;
+  const std::function<void(size_t)> onDropped;
+  // Tells the rings of different queues apart in ThreadRings.
+  const uint64_t id;
+
+  std::mutex ringsMutex;
+  std::vector<std::shared_ptr<Ring>> rings;
+
+  std::mutex wakeMutex;
+  std::condition_variable wakeCondition;
+  bool wakeRequested = false;
+  bool stopping = false;
+  std::atomic<bool> sleeping{false};
+
+  std::mutex writtenMutex;
+  std::condition_variable writtenCondition;
+
+  std::thread writer;
+};
+
+} // namespace logger
+
+#endif /* UR_ASYNC_QUEUE_HPP */
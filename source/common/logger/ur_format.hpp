@@ -0,0 +1,201 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef UR_FORMAT_HPP
+#define UR_FORMAT_HPP 1
+
+#include <charconv>
+#include <cstddef>
+#include <ios>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace logger {
+namespace detail {
+
+struct FormatInfo {
+  // The size of the text, once the escaped braces are unescaped.
+  size_t size;
+  // The number of {} placeholders.
+  size_t args;
+  bool valid;
+};
+
+constexpr FormatInfo scan_format(const char *fmt) {
+  FormatInfo info{0, 0, true};
+  for (size_t i = 0; fmt[i] != '\0'; i++) {
+    if (fmt[i] == '{' && fmt[i + 1] == '}') {
+      info.args++;
+      i++;
+    } else if (fmt[i] == '{' || fmt[i] == '}') {
+      if (fmt[i + 1] == fmt[i]) {
+        i++;
+      } else {
+        info.valid = false;
+      }
+      info.size++;
+    } else {
+      info.size++;
+    }
+  }
+  return info;
+}
+
+// A format string split at compile time into the text around its {}
+// placeholders.
+template <size_t Size, size_t Args> struct CompiledFormat {
+  static constexpr size_t size = Size;
+  static constexpr size_t args = Args;
+  // The text with the escaped braces unescaped.
+  char text[Size + 1];
+  // Where each argument goes in text.
+  size_t offsets[Args + 1];
+};
+
+template <typename T> struct is_compiled_format : std::false_type {};
+template <size_t Size, size_t Args>
+struct is_compiled_format<CompiledFormat<Size, Args>> : std::true_type {};
+template <typename T>
+constexpr bool is_compiled_format_v = is_compiled_format<T>::value;
+
+template <size_t Size, size_t Args>
+constexpr CompiledFormat<Size, Args> split_format(const char *fmt) {
+  CompiledFormat<Size, Args> result{};
+  size_t size = 0;
+  size_t arg = 0;
+  for (size_t i = 0; fmt[i] != '\0'; i++) {
+    if (fmt[i] == '{' && fmt[i + 1] == '}') {
+      result.offsets[arg++] = size;
+      i++;
+      continue;
+    }
+    if ((fmt[i] == '{' || fmt[i] == '}') && fmt[i + 1] == fmt[i]) {
+      i++;
+    }
+    result.text[size++] = fmt[i];
+  }
+  return result;
+}
+
+// Compiles the format string returned by fmt, which has to be a constexpr
+// lambda returning a literal so that the string can be parsed at compile
+// time.
+template <typename F> constexpr auto compile_format(F fmt) {
+  constexpr FormatInfo info = scan_format(fmt());
+  static_assert(info.valid, "Log message syntax error: only empty braces are "
+                            "allowed, other braces have to be escaped");
+  return split_format<info.size, info.args>(fmt());
+}
+
+template <typename T>
+constexpr bool is_int_v =
+    std::is_same_v<T, short> || std::is_same_v<T, unsigned short> ||
+    std::is_same_v<T, int> || std::is_same_v<T, unsigned int> ||
+    std::is_same_v<T, long> || std::is_same_v<T, unsigned long> ||
+    std::is_same_v<T, long long> || std::is_same_v<T, unsigned long long>;
+
+// The buffer a message is formatted in. It lends the calling thread a
+// buffer and a stream that keep their capacity from one message to the next,
+// unless they are already lent, when an operator<< of an argument logs for
+// instance.
+class FormatBuffer {
+public:
+  FormatBuffer() {
+    Storage &shared = threadStorage();
+    if (shared.inUse) {
+      own = std::make_unique<Storage>();
+      storage = own.get();
+    } else {
+      storage = &shared;
+    }
+    storage->inUse = true;
+    storage->buffer.clear();
+    std::ostringstream &stream = storage->stream;
+    stream.flags(storage->flags);
+    stream.precision(storage->precision);
+    stream.fill(storage->fill);
+  }
+
+  ~FormatBuffer() { storage->inUse = false; }
+
+  FormatBuffer(const FormatBuffer &) = delete;
+  FormatBuffer &operator=(const FormatBuffer &) = delete;
+
+  std::string &str() { return storage->buffer; }
+
+  void append(const char *text, size_t size) {
+    storage->buffer.append(text, size);
+  }
+
+  void append(std::string_view text) { storage->buffer.append(text); }
+
+  void append(char c) { storage->buffer.push_back(c); }
+
+  // Appends arg the way operator<< would print it, bypassing the stream for
+  // strings, and for integers unless an earlier argument of the message
+  // changed the formatting state of the stream.
+  template <typename T> void appendArg(const T &arg) {
+    using D = std::decay_t<T>;
+    if constexpr (std::is_array_v<T>) {
+      appendArg(static_cast<const std::remove_extent_t<T> *>(arg));
+    } else if constexpr (std::is_same_v<D, const char *> ||
+                         std::is_same_v<D, char *>) {
+      if (arg) {
+        append(std::string_view(arg));
+      }
+    } else if constexpr (std::is_same_v<D, std::string> ||
+                         std::is_same_v<D, std::string_view>) {
+      append(std::string_view(arg));
+    } else if constexpr (std::is_same_v<D, char>) {
+      append(arg);
+    } else if constexpr (is_int_v<D>) {
+      if (storage->stream.flags() == storage->flags) {
+        char digits[24];
+        auto result = std::to_chars(digits, digits + sizeof(digits), arg);
+        append(digits, result.ptr - digits);
+      } else {
+        appendStreamed(arg);
+      }
+    } else {
+      appendStreamed(arg);
+    }
+  }
+
+private:
+  template <typename T> void appendStreamed(const T &arg) {
+    std::ostringstream &stream = storage->stream;
+    stream.str(std::string());
+    stream.clear();
+    stream << arg;
+    append(stream.str());
+  }
+
+  struct Storage {
+    std::string buffer;
+    std::ostringstream stream;
+    // The formatting state of a new stream, operator<< of an argument may
+    // change it.
+    std::ios_base::fmtflags flags = stream.flags();
+    std::streamsize precision = stream.precision();
+    char fill = stream.fill();
+    bool inUse = false;
+  };
+
+  static Storage &threadStorage() {
+    thread_local Storage storage;
+    return storage;
+  }
+
+  Storage *storage;
+  std::unique_ptr<Storage> own;
+};
+
+} // namespace detail
+} // namespace logger
+
+#endif /* UR_FORMAT_HPP */
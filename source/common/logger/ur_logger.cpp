@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <limits>
 
 #include "../backtrace.hpp"
 #include "ur_logger.hpp"
@@ -34,6 +35,25 @@ static bool str_to_bool(const std::string &str) {
   return false;
 }
 
+static size_t str_to_async_capacity(const std::string &str) {
+  size_t pos = 0;
+  unsigned long long capacity = 0;
+  try {
+    capacity = std::stoull(str, &pos);
+  } catch (const std::exception &) {
+    pos = 0;
+  }
+  if (pos == 0 || pos != str.size() || capacity == 0 ||
+      capacity > std::numeric_limits<uint32_t>::max()) {
+    throw std::invalid_argument(
+        std::string("Parsing error: no valid async capacity for string '") +
+        str + std::string("'.") +
+        std::string("\nThe capacity has to be a positive number of "
+                    "messages"));
+  }
+  return static_cast<size_t>(capacity);
+}
+
 Logger create_logger(std::string logger_name, bool skip_prefix,
                      bool skip_linebreak, ur_logger_level_t default_log_level) {
   std::transform(logger_name.begin(), logger_name.end(), logger_name.begin(),
@@ -46,6 +66,9 @@ Logger create_logger(std::string logger_name, bool skip_prefix,
   auto flush_level = default_flush_level;
   ur_logger_level_t level = default_log_level;
   bool fileline = default_fileline;
+  bool async = false;
+  auto async_policy = AsyncPolicy::Drop;
+  size_t async_capacity = AsyncQueue::DefaultCapacity;
   std::unique_ptr<Sink> sink;
 
   try {
@@ -77,6 +100,21 @@ Logger create_logger(std::string logger_name, bool skip_prefix,
       map->erase(kv);
     }
 
+    kv = map->find("async");
+    if (kv != map->end()) {
+      auto values = kv->second;
+      if (values.size() > 2) {
+        throw std::invalid_argument(
+            "Parsing error: async takes a policy and optionally a capacity");
+      }
+      async_policy = str_to_async_policy(values[0]);
+      if (values.size() == 2) {
+        async_capacity = str_to_async_capacity(values[1]);
+      }
+      async = true;
+      map->erase(kv);
+    }
+
     std::vector<std::string> values = {default_output};
     kv = map->find("output");
     if (kv != map->end()) {
@@ -107,6 +145,9 @@ Logger create_logger(std::string logger_name, bool skip_prefix,
 
   sink->setFlushLevel(flush_level);
   sink->setFileLine(fileline);
+  if (async) {
+    sink->setAsync(async_policy, async_capacity);
+  }
 
   return Logger(level, std::move(sink));
 }
@@ -53,34 +53,42 @@ public:
   void log(const logger::LegacyMessage &p, ur_logger_level_t level,
            const char *filename, const char *lineno, const char *format,
            Args &&...args) {
-    // During process/library teardown this logger's owned sinks may already
-    // have been destroyed. Use a temporary stack sink instead.
-    if (isTearDowned) {
-      if (!isLegacySink && level < this->standardSinkLevel) {
-        return;
-      }
-      StderrSink(/*logger_name*/ "", /*skip_prefix*/ false,
-                 /*skip_linebreak*/ false)
-          .log(level, filename, lineno, isLegacySink ? p.message : format,
-               std::forward<Args>(args)...);
+    if (isFiltered(level)) {
       return;
     }
+    dispatch(p.message, level, filename, lineno, format,
+             std::forward<Args>(args)...);
+  }
 
-    if (callbackSink && level >= this->callbackSinkLevel) {
-      callbackSink->log(level, filename, lineno, format, args...);
+  // The overloads used by the UR_LOG macros, format is the format string
+  // they compiled into compiledFormat.
+  template <size_t Size, size_t NArgs, typename... Args>
+  void log(const detail::CompiledFormat<Size, NArgs> &compiledFormat,
+           ur_logger_level_t level, const char *filename, const char *lineno,
+           [[maybe_unused]] const char *format, Args &&...args) {
+    static_assert(NArgs == sizeof...(Args),
+                  "The number of arguments doesn't match the number of {} in "
+                  "the log message");
+    if (isFiltered(level)) {
+      return;
     }
+    dispatch(compiledFormat, level, filename, lineno, compiledFormat,
+             std::forward<Args>(args)...);
+  }
 
-    if (standardSink) {
-      if (isLegacySink) {
-        standardSink->log(level, filename, lineno, p.message, args...);
-        return;
-      }
-
-      if (level < this->standardSinkLevel) {
-        return;
-      }
-      standardSink->log(level, filename, lineno, format, args...);
+  template <size_t Size, size_t NArgs, typename... Args>
+  void log(const detail::CompiledFormat<Size, NArgs> &compiledFormat,
+           const logger::LegacyMessage &p, ur_logger_level_t level,
+           const char *filename, const char *lineno,
+           [[maybe_unused]] const char *format, Args &&...args) {
+    static_assert(NArgs == sizeof...(Args),
+                  "The number of arguments doesn't match the number of {} in "
+                  "the log message");
+    if (isFiltered(level)) {
+      return;
     }
+    dispatch(p.message, level, filename, lineno, compiledFormat,
+             std::forward<Args>(args)...);
   }
 
   void setLegacySink(std::unique_ptr<Sink> legacySink) {
@@ -105,6 +113,51 @@ public:
   }
 
 private:
+  // Whether no sink outputs messages at level, checked inline so that
+  // disabled messages cost as little as possible.
+  bool isFiltered(ur_logger_level_t level) const {
+    return !isLegacySink && level < this->standardSinkLevel &&
+           (isTearDowned || !callbackSink || level < this->callbackSinkLevel);
+  }
+
+  template <typename LegacyT, typename FormatT, typename... Args>
+  void dispatch(const LegacyT &legacyMessage, ur_logger_level_t level,
+                const char *filename, const char *lineno,
+                const FormatT &format, Args &&...args) {
+    // During process/library teardown this logger's owned sinks may already
+    // have been destroyed. Use a temporary stack sink instead.
+    if (isTearDowned) {
+      if (!isLegacySink && level < this->standardSinkLevel) {
+        return;
+      }
+      StderrSink sink(/*logger_name*/ "", /*skip_prefix*/ false,
+                      /*skip_linebreak*/ false);
+      if (isLegacySink) {
+        sink.log(level, filename, lineno, legacyMessage,
+                 std::forward<Args>(args)...);
+      } else {
+        sink.log(level, filename, lineno, format, std::forward<Args>(args)...);
+      }
+      return;
+    }
+
+    if (callbackSink && level >= this->callbackSinkLevel) {
+      callbackSink->log(level, filename, lineno, format, args...);
+    }
+
+    if (standardSink) {
+      if (isLegacySink) {
+        standardSink->log(level, filename, lineno, legacyMessage, args...);
+        return;
+      }
+
+      if (level < this->standardSinkLevel) {
+        return;
+      }
+      standardSink->log(level, filename, lineno, format, args...);
+    }
+  }
+
   ur_logger_level_t standardSinkLevel;
   std::unique_ptr<logger::Sink> standardSink;
   bool isLegacySink = false;
@@ -118,15 +171,29 @@ private:
 #define UR_STRIMPL_(x) #x
 #define UR_STR_(x) UR_STRIMPL_(x)
 
+#define UR_EXPAND_(x) x
+#define UR_FIRST_ARG_IMPL_(first, ...) first
+#define UR_FIRST_ARG_(...) UR_EXPAND_(UR_FIRST_ARG_IMPL_(__VA_ARGS__, ))
+
+// The format string, the first of the variadic arguments, is compiled once
+// per call site.
+#define URLOG_FORMAT_(...)                                                     \
+  static constexpr auto urLogFormat = ::logger::detail::compile_format(       \
+      []() { return UR_FIRST_ARG_(__VA_ARGS__); })
+
 #define URLOG2_(logger_instance, level, ...)                                   \
   {                                                                            \
-    (logger_instance).log(level, __FILE__, UR_STR_(__LINE__), __VA_ARGS__);    \
+    URLOG_FORMAT_(__VA_ARGS__);                                                \
+    (logger_instance)                                                          \
+        .log(urLogFormat, level, __FILE__, UR_STR_(__LINE__), __VA_ARGS__);    \
   }
 
 #define URLOG_L2_(logger_instance, level, legacy_message, ...)                 \
   {                                                                            \
+    URLOG_FORMAT_(__VA_ARGS__);                                                \
     (logger_instance)                                                          \
-        .log(legacy_message, level, __FILE__, UR_STR_(__LINE__), __VA_ARGS__); \
+        .log(urLogFormat, legacy_message, level, __FILE__, UR_STR_(__LINE__),  \
+             __VA_ARGS__);                                                     \
   }
 
 // some symbols usefuls for log levels are predfined in some systems,
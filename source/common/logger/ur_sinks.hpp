@@ -6,58 +6,93 @@
 #ifndef UR_SINKS_HPP
 #define UR_SINKS_HPP 1
 
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <iostream>
 #include <mutex>
 #include <sstream>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 
 #include "unified-runtime/ur_api.h"
 #include "unified-runtime/ur_print.hpp"
+#include "ur_async_queue.hpp"
 #include "ur_filesystem_resolved.hpp"
+#include "ur_format.hpp"
 #include "ur_level.hpp"
 
 namespace logger {
 
 inline bool isTearDowned = false;
 
+namespace detail {
+template <typename T> constexpr bool is_async_string_v =
+    std::is_same_v<T, const char *> || std::is_same_v<T, char *> ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <typename T> constexpr bool is_async_value_v =
+    std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+    std::is_same_v<T, void *> || std::is_same_v<T, const void *> ||
+    std::is_same_v<T, std::nullptr_t>;
+
+// The type an argument of a message is kept as until the writer thread of an
+// asynchronous sink formats it, or void if it isn't known to be safe to keep,
+// such as a pointer to an object that may be gone by then.
+template <typename T, typename D = std::decay_t<T>>
+using async_arg_t = std::conditional_t<
+    is_async_string_v<D>, std::string,
+    std::conditional_t<is_async_value_v<D>, D, void>>;
+
+template <typename T> async_arg_t<T> to_async_arg(T &&arg) {
+  if constexpr (std::is_pointer_v<std::remove_reference_t<T>> &&
+                is_async_string_v<std::decay_t<T>>) {
+    return arg ? std::string(arg) : std::string();
+  } else {
+    return async_arg_t<T>(std::forward<T>(arg));
+  }
+}
+} // namespace detail
+
 class Sink {
 public:
-  template <typename... Args>
+  // fmt is either a format string, parsed as the message is formatted, or a
+  // format compiled by the UR_LOG macros.
+  template <typename FormatT, typename... Args>
   void log(ur_logger_level_t level, const char *filename, const char *lineno,
-           const char *fmt, Args &&...args) {
-    std::ostringstream buffer;
-    if (!skip_prefix && level != UR_LOGGER_LEVEL_QUIET) {
-      buffer << "<" << logger_name << ">"
-             << "[" << level_to_str(level) << "]: ";
-    }
-
-    format(buffer, filename, lineno, fmt, std::forward<Args>(args)...);
-    if (add_fileline) {
-      buffer << " <" << filename << ":" << lineno << ">";
-    }
-    if (!skip_linebreak) {
-      buffer << "\n";
-    }
-
-    std::string message = buffer.str();
-
-    // This is a temporary workaround, where UR adapter is teardowned
-    // before the UR loader, which will result in access violation when we use
-    // print function as the overrided print function was already released with
-    // the UR adapter.
-    // TODO: Change adapters to use a common sink class in the loader instead of
-    // using thier own sink class that inherit from logger::Sink.
-    if (isTearDowned) {
-      std::cerr << message;
-    } else {
-      print(level, message);
+           const FormatT &fmt, Args &&...args) {
+    // A message logged while the writer formats another one is output right
+    // away, waiting for the writer would deadlock.
+    if (asyncQueue && !asyncQueue->isWriterThread()) {
+      logAsync(level, filename, lineno, fmt, std::forward<Args>(args)...);
+      return;
     }
+    detail::FormatBuffer buffer;
+    formatMessage(buffer, level, filename, lineno, fmt,
+                  std::forward<Args>(args)...);
+    output(level, buffer.str());
   }
 
   void setFileLine(bool fileline) { add_fileline = fileline; }
   void setFlushLevel(ur_logger_level_t level) { this->flush_level = level; }
 
+  // Has the messages formatted and output by a writer thread, so that the
+  // logging threads only record them. Messages at or above the flush level
+  // are still output before log returns.
+  void setAsync(AsyncPolicy policy,
+                size_t capacity = AsyncQueue::DefaultCapacity) {
+    asyncQueue = std::make_unique<AsyncQueue>(
+        policy, capacity, [this](size_t dropped) {
+          output(UR_LOGGER_LEVEL_WARN,
+                 makeMessage(UR_LOGGER_LEVEL_WARN, __FILE__,
+                             std::to_string(__LINE__).c_str(),
+                             "Dropped {} message(s), the logger couldn't "
+                             "keep up",
+                             dropped));
+        });
+  }
+
   virtual ~Sink() = default;
 
 protected:
@@ -80,24 +115,180 @@ protected:
     }
   }
 
+  // Outputs the messages left to the writer thread and stops it. Sinks that
+  // can be asynchronous have to call this in their destructor, while print
+  // can still be called.
+  void stopAsync() { asyncQueue.reset(); }
+
 private:
+  // A message whose arguments are kept until the writer formats it. FormatT
+  // is a format string or a pointer to a compiled format.
+  template <typename FormatT, typename... Ts>
+  struct DeferredRecord : AsyncRecord {
+    template <typename... Args>
+    DeferredRecord(Sink *sink, ur_logger_level_t level, const char *filename,
+                   const char *lineno, FormatT fmt, Args &&...args)
+        : sink(sink), level(level), filename(filename), lineno(lineno),
+          fmt(fmt), args(detail::to_async_arg(std::forward<Args>(args))...) {}
+
+    void write() override {
+      std::apply(
+          [this](const Ts &...args) {
+            detail::FormatBuffer buffer;
+            if constexpr (std::is_same_v<FormatT, const char *>) {
+              sink->formatMessage(buffer, level, filename, lineno, fmt,
+                                  args...);
+            } else {
+              sink->formatMessage(buffer, level, filename, lineno, *fmt,
+                                  args...);
+            }
+            sink->output(level, buffer.str());
+          },
+          args);
+    }
+
+    Sink *sink;
+    ur_logger_level_t level;
+    const char *filename;
+    const char *lineno;
+    // A format string points to a copy in the slot, the one passed to log
+    // may be a temporary. The compiled formats of the UR_LOG macros are
+    // static.
+    FormatT fmt;
+    std::tuple<Ts...> args;
+  };
+
+  // A message that had to be formatted by the logging thread.
+  struct FormattedRecord : AsyncRecord {
+    FormattedRecord(Sink *sink, ur_logger_level_t level, std::string message)
+        : sink(sink), level(level), message(std::move(message)) {}
+
+    void write() override { sink->output(level, message); }
+
+    Sink *sink;
+    ur_logger_level_t level;
+    std::string message;
+  };
+
   std::string logger_name;
   const bool skip_prefix;
   const bool skip_linebreak;
   bool add_fileline;
   std::mutex output_mutex;
   const char *error_prefix = "Log message syntax error: ";
+  std::unique_ptr<AsyncQueue> asyncQueue;
+
+  template <typename FormatT, typename... Args>
+  void logAsync(ur_logger_level_t level, const char *filename,
+                const char *lineno, const FormatT &fmt, Args &&...args) {
+    const bool waitForWrite = level >= flush_level;
+    if constexpr (!(std::is_void_v<detail::async_arg_t<Args>> || ...)) {
+      if constexpr (detail::is_compiled_format_v<FormatT>) {
+        using RecordT =
+            DeferredRecord<const FormatT *, detail::async_arg_t<Args>...>;
+        if constexpr (sizeof(RecordT) <= sizeof(AsyncQueue::Slot::data)) {
+          AsyncQueue::Slot *slot = asyncQueue->reserve(!waitForWrite);
+          if (slot) {
+            asyncQueue->commit(new (slot->data)
+                                   RecordT(this, level, filename, lineno, &fmt,
+                                           std::forward<Args>(args)...),
+                               waitForWrite);
+          }
+          return;
+        }
+      } else {
+        using RecordT =
+            DeferredRecord<const char *, detail::async_arg_t<Args>...>;
+        const size_t fmtSize = std::strlen(fmt) + 1;
+        if (sizeof(RecordT) + fmtSize <= sizeof(AsyncQueue::Slot::data)) {
+          AsyncQueue::Slot *slot = asyncQueue->reserve(!waitForWrite);
+          if (!slot) {
+            return;
+          }
+          char *fmtCopy =
+              reinterpret_cast<char *>(slot->data) + sizeof(RecordT);
+          std::memcpy(fmtCopy, fmt, fmtSize);
+          asyncQueue->commit(new (slot->data)
+                                 RecordT(this, level, filename, lineno,
+                                         fmtCopy, std::forward<Args>(args)...),
+                             waitForWrite);
+          return;
+        }
+      }
+    }
+
+    std::string message = makeMessage(level, filename, lineno, fmt,
+                                      std::forward<Args>(args)...);
+    static_assert(sizeof(FormattedRecord) <=
+                  sizeof(AsyncQueue::Slot::data));
+    AsyncQueue::Slot *slot = asyncQueue->reserve(!waitForWrite);
+    if (!slot) {
+      return;
+    }
+    asyncQueue->commit(new (slot->data)
+                           FormattedRecord(this, level, std::move(message)),
+                       waitForWrite);
+  }
+
+  template <typename FormatT, typename... Args>
+  std::string makeMessage(ur_logger_level_t level, const char *filename,
+                          const char *lineno, const FormatT &fmt,
+                          Args &&...args) {
+    detail::FormatBuffer buffer;
+    formatMessage(buffer, level, filename, lineno, fmt,
+                  std::forward<Args>(args)...);
+    return buffer.str();
+  }
+
+  template <typename FormatT, typename... Args>
+  void formatMessage(detail::FormatBuffer &buffer, ur_logger_level_t level,
+                     const char *filename, const char *lineno,
+                     const FormatT &fmt, Args &&...args) {
+    if (!skip_prefix && level != UR_LOGGER_LEVEL_QUIET) {
+      buffer.append('<');
+      buffer.append(logger_name);
+      buffer.append(">[");
+      buffer.append(level_to_str(level));
+      buffer.append("]: ");
+    }
+
+    format(buffer, filename, lineno, fmt, std::forward<Args>(args)...);
+    if (add_fileline) {
+      buffer.append(" <");
+      buffer.append(filename);
+      buffer.append(':');
+      buffer.append(lineno);
+      buffer.append('>');
+    }
+    if (!skip_linebreak) {
+      buffer.append('\n');
+    }
+  }
 
-  void format(std::ostringstream &buffer, const char *filename,
+  void output(ur_logger_level_t level, const std::string &message) {
+    // This is a temporary workaround, where UR adapter is teardowned
+    // before the UR loader, which will result in access violation when we use
+    // print function as the overrided print function was already released with
+    // the UR adapter.
+    // TODO: Change adapters to use a common sink class in the loader instead of
+    // using thier own sink class that inherit from logger::Sink.
+    if (isTearDowned) {
+      std::cerr << message;
+    } else {
+      print(level, message);
+    }
+  }
+
+  void format(detail::FormatBuffer &buffer, const char *filename,
               const char *lineno, const char *fmt) {
     while (*fmt != '\0') {
       while (*fmt != '{' && *fmt != '}' && *fmt != '\0') {
-        buffer << *fmt++;
+        buffer.append(*fmt++);
       }
 
       if (*fmt == '{') {
         if (*(++fmt) == '{') {
-          buffer << *fmt++;
+          buffer.append(*fmt++);
         } else {
           std::cerr << error_prefix
                     << "No arguments provided and braces not escaped!"
@@ -105,7 +296,7 @@ private:
         }
       } else if (*fmt == '}') {
         if (*(++fmt) == '}') {
-          buffer << *fmt++;
+          buffer.append(*fmt++);
         } else {
           std::cerr << error_prefix << "Closing curly brace not escaped!"
                     << filename << ":" << lineno << std::endl;
@@ -115,27 +306,27 @@ private:
   }
 
   template <typename Arg, typename... Args>
-  void format(std::ostringstream &buffer, const char *filename,
+  void format(detail::FormatBuffer &buffer, const char *filename,
               const char *lineno, const char *fmt, Arg &&arg, Args &&...args) {
     bool arg_printed = false;
     while (!arg_printed) {
       while (*fmt != '{' && *fmt != '}' && *fmt != '\0') {
-        buffer << *fmt++;
+        buffer.append(*fmt++);
       }
 
       if (*fmt == '{') {
         if (*(++fmt) == '{') {
-          buffer << *fmt++;
+          buffer.append(*fmt++);
         } else if (*fmt != '}') {
           std::cerr << error_prefix << "Only empty braces are allowed!"
                     << filename << ":" << lineno << std::endl;
         } else {
-          buffer << arg;
+          buffer.appendArg(arg);
           arg_printed = true;
         }
       } else if (*fmt == '}') {
         if (*(++fmt) == '}') {
-          buffer << *fmt++;
+          buffer.append(*fmt++);
         } else {
           std::cerr << error_prefix << "Closing curly brace not escaped!"
                     << filename << ":" << lineno << std::endl;
@@ -153,6 +344,23 @@ private:
 
     format(buffer, filename, lineno, ++fmt, std::forward<Args>(args)...);
   }
+  template <size_t Size, size_t NArgs, typename... Args>
+  void format(detail::FormatBuffer &buffer, const char *, const char *,
+              const detail::CompiledFormat<Size, NArgs> &fmt,
+              Args &&...args) {
+    static_assert(NArgs == sizeof...(Args),
+                  "The number of arguments doesn't match the number of {} in "
+                  "the log message");
+    size_t offset = 0;
+    size_t arg = 0;
+    [[maybe_unused]] auto appendNext = [&](const auto &value) {
+      buffer.append(fmt.text + offset, fmt.offsets[arg] - offset);
+      buffer.appendArg(value);
+      offset = fmt.offsets[arg++];
+    };
+    (appendNext(args), ...);
+    buffer.append(fmt.text + offset, Size - offset);
+  }
 };
 
 class StdoutSink : public Sink {
@@ -169,7 +377,7 @@ public:
     this->flush_level = flush_lvl;
   }
 
-  ~StdoutSink() = default;
+  ~StdoutSink() { stopAsync(); }
 };
 
 class StderrSink : public Sink {
@@ -186,7 +394,10 @@ public:
     this->flush_level = flush_lvl;
   }
 
-  ~StderrSink() { logger::isTearDowned = true; }
+  ~StderrSink() {
+    stopAsync();
+    logger::isTearDowned = true;
+  }
 };
 
 class FileSink : public Sink {
@@ -212,7 +423,7 @@ public:
     this->flush_level = flush_lvl;
   }
 
-  ~FileSink() = default;
+  ~FileSink() { stopAsync(); }
 
 private:
   std::ofstream ofstream;
@@ -230,7 +441,7 @@ public:
     this->flush_level = flush_lvl;
   }
 
-  ~CallbackSink() = default;
+  ~CallbackSink() { stopAsync(); }
 
   void setCallback(ur_logger_callback_t cb, void *pUserData) {
     callback = cb;
@@ -11,6 +11,8 @@
 #define UR_LIB_LOADER_HPP 1
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #if _WIN32
 #include <windows.h>
@@ -34,6 +36,15 @@ public:
   static void freeAdapterLibrary(HMODULE handle);
 
   static void *getFunctionPtr(HMODULE handle, const char *func_name);
+
+  // Returns the path the library was loaded from, or an empty string if it
+  // can't be found.
+  static std::string getLibraryPath(HMODULE handle);
+
+  // Returns the paths of the libraries the library depends on, as far as
+  // they can be found: its direct dependencies, and the libraries loaded
+  // after it, which include the ones it loaded itself, such as drivers.
+  static std::vector<std::string> getDependencyPaths(HMODULE handle);
 };
 
 } // namespace ur_loader
@@ -0,0 +1,134 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include "ur_stack_depot.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+namespace ur {
+
+// A saved backtrace, followed by its frames.
+struct StackDepot::Node {
+  Node *next;
+  uint32_t hash;
+  uint32_t id;
+  size_t frameCount;
+
+  BacktraceFrame *frames() {
+    return reinterpret_cast<BacktraceFrame *>(this + 1);
+  }
+  const BacktraceFrame *frames() const {
+    return reinterpret_cast<const BacktraceFrame *>(this + 1);
+  }
+};
+
+namespace {
+
+constexpr size_t ArenaBlockSize = 1 << 16;
+
+// MurmurHash2, like the stack depot of compiler-rt.
+uint32_t hashFrames(const BacktraceFrame *frames, size_t frameCount) {
+  constexpr uint32_t m = 0x5bd1e995;
+  constexpr uint32_t r = 24;
+  uint32_t h = 0x9747b28c ^ uint32_t(frameCount * sizeof(BacktraceFrame));
+  for (size_t i = 0; i < frameCount; i++) {
+    const uint64_t frame = reinterpret_cast<uintptr_t>(frames[i]);
+    uint32_t k = uint32_t(frame) ^ uint32_t(frame >> 32);
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+    h *= m;
+    h ^= k;
+  }
+  h ^= h >> 13;
+  h *= m;
+  h ^= h >> 15;
+  return h;
+}
+
+} // namespace
+
+StackDepot::StackDepot() = default;
+StackDepot::~StackDepot() = default;
+
+const StackDepot::Node *StackDepot::find(const Node *head, const Node *end,
+                                          uint32_t hash,
+                                          const BacktraceFrame *frames,
+                                          size_t frameCount) {
+  for (auto *node = head; node != end; node = node->next) {
+    if (node->hash == hash && node->frameCount == frameCount &&
+        std::equal(frames, frames + frameCount, node->frames())) {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+uint32_t StackDepot::put(const BacktraceFrame *frames, size_t frameCount) {
+  const uint32_t hash = hashFrames(frames, frameCount);
+  auto &bucket = buckets[hash % NumBuckets];
+
+  Node *head = bucket.load(std::memory_order_acquire);
+  if (auto *node = find(head, nullptr, hash, frames, frameCount)) {
+    return node->id;
+  }
+
+  std::unique_lock<std::shared_mutex> lock(mutex);
+  // Another thread may have saved the frames meanwhile.
+  Node *newHead = bucket.load(std::memory_order_relaxed);
+  if (auto *node = find(newHead, head, hash, frames, frameCount)) {
+    return node->id;
+  }
+
+  auto *node = new (allocate(sizeof(Node) +
+                             frameCount * sizeof(BacktraceFrame))) Node;
+  node->next = newHead;
+  node->hash = hash;
+  node->frameCount = frameCount;
+  std::copy(frames, frames + frameCount, node->frames());
+  nodes.push_back(node);
+  node->id = static_cast<uint32_t>(nodes.size());
+
+  bucket.store(node, std::memory_order_release);
+  return node->id;
+}
+
+uint32_t StackDepot::capture() {
+  BacktraceFrame frames[MaxBacktraceFrames];
+  size_t frameCount = captureBacktrace(frames, MaxBacktraceFrames);
+  return put(frames, frameCount);
+}
+
+std::vector<BacktraceFrame> StackDepot::get(uint32_t id) const {
+  std::shared_lock<std::shared_mutex> lock(mutex);
+  if (id == 0 || id > nodes.size()) {
+    return {};
+  }
+  const Node *node = nodes[id - 1];
+  return {node->frames(), node->frames() + node->frameCount};
+}
+
+std::vector<BacktraceLine> StackDepot::symbolize(uint32_t id) const {
+  auto frames = get(id);
+  return symbolizeBacktrace(frames.data(), frames.size());
+}
+
+void *StackDepot::allocate(size_t bytes) {
+  bytes = (bytes + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+  if (bytes > arenaLeft) {
+    const size_t blockSize = std::max(bytes, ArenaBlockSize);
+    arena.emplace_back(new char[blockSize]);
+    arenaPtr = arena.back().get();
+    arenaLeft = blockSize;
+  }
+  void *ptr = arenaPtr;
+  arenaPtr += bytes;
+  arenaLeft -= bytes;
+  return ptr;
+}
+
+} // namespace ur
@@ -0,0 +1,68 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#ifndef UR_STACK_DEPOT_H
+#define UR_STACK_DEPOT_H 1
+
+#include "backtrace.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+namespace ur {
+
+// Saves each distinct backtrace once, as its raw return addresses, and
+// identifies it with a 32-bit id. Backtraces are symbolized only when they
+// are printed.
+//
+// The backtraces are kept in an append-only arena and looked up in a hash
+// table whose buckets are lists that only grow at their head, so finding a
+// backtrace that was saved before doesn't take any lock. Saving a new
+// backtrace and loading one by id take the lock of the depot.
+class StackDepot {
+public:
+  StackDepot();
+  ~StackDepot();
+  StackDepot(const StackDepot &) = delete;
+  StackDepot &operator=(const StackDepot &) = delete;
+
+  // Saves the frames and returns their id, which is never 0. Saving the
+  // same frames again returns the same id.
+  uint32_t put(const BacktraceFrame *frames, size_t frameCount);
+
+  // Saves the backtrace of the caller and returns its id.
+  uint32_t capture();
+
+  // The frames saved with the id, which are empty if the id is unknown.
+  std::vector<BacktraceFrame> get(uint32_t id) const;
+
+  std::vector<BacktraceLine> symbolize(uint32_t id) const;
+
+private:
+  struct Node;
+
+  static constexpr size_t NumBuckets = 1 << 14;
+
+  // Finds the frames in the nodes from head until end.
+  static const Node *find(const Node *head, const Node *end, uint32_t hash,
+                          const BacktraceFrame *frames, size_t frameCount);
+  void *allocate(size_t bytes);
+
+  std::array<std::atomic<Node *>, NumBuckets> buckets{};
+
+  mutable std::shared_mutex mutex;
+  // The saved backtraces, indexed by their id minus 1.
+  std::vector<const Node *> nodes;
+  std::vector<std::unique_ptr<char[]>> arena;
+  char *arenaPtr = nullptr;
+  size_t arenaLeft = 0;
+};
+
+} // namespace ur
+
+#endif /* UR_STACK_DEPOT_H */
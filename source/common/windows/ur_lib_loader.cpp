@@ -41,4 +41,18 @@ void *LibLoader::getFunctionPtr(HMODULE handle, const char *func_name) {
   return reinterpret_cast<void *>(GetProcAddress(handle, func_name));
 }
 
+std::string LibLoader::getLibraryPath(HMODULE handle) {
+  char path[MAX_PATH];
+  DWORD size = GetModuleFileNameA(handle, path, MAX_PATH);
+  if (size == 0 || size == MAX_PATH) {
+    return {};
+  }
+  return std::string(path, size);
+}
+
+std::vector<std::string> LibLoader::getDependencyPaths(HMODULE) {
+  // Not tracked on Windows.
+  return {};
+}
+
 } // namespace ur_loader
@@ -0,0 +1,166 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file asan_allocation_index.cpp
+ *
+ */
+
+#include "asan_allocation_index.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
+
+namespace ur_sanitizer_layer {
+namespace asan {
+
+size_t AllocationIndex::getLevel(uptr Size) {
+  for (size_t Level = 0; Level + 1 < kPageShifts.size(); Level++) {
+    if (Size <= (kMaxPagesPerAllocation << kPageShifts[Level])) {
+      return Level;
+    }
+  }
+  return kPageShifts.size() - 1;
+}
+
+uptr AllocationIndex::getPageKey(size_t Level, uptr Page) {
+  // Pages are at least 4KB, so their number leaves room for the level
+  return (Page << 3) | Level;
+}
+
+size_t AllocationIndex::getShard(uptr Key) {
+  // Fibonacci hashing, so that neighbouring pages go to different shards
+  return (Key * 0x9E3779B97F4A7C15ULL) >> 58;
+}
+
+template <typename Fn>
+void AllocationIndex::forEachPage(const std::shared_ptr<AllocInfo> &AI,
+                                  Fn &&F) {
+  const size_t Level = getLevel(AI->AllocSize);
+  const uptr Shift = kPageShifts[Level];
+  const uptr Last = AI->AllocBegin + std::max<uptr>(AI->AllocSize, 1) - 1;
+  for (uptr Page = AI->AllocBegin >> Shift; Page <= (Last >> Shift); Page++) {
+    const uptr Key = getPageKey(Level, Page);
+    F(PageShards[getShard(Key)], Key);
+  }
+}
+
+bool AllocationIndex::insert(std::shared_ptr<AllocInfo> AI) {
+  auto &Shard = AllocShards[getShard(AI->AllocBegin)];
+  std::scoped_lock<ur_mutex> Guard(Shard.Mutex);
+  if (!Shard.AllocInfos.emplace(AI->AllocBegin, AI).second) {
+    return false;
+  }
+
+  forEachPage(AI, [&](PageShard &PageShard, uptr Key) {
+    std::scoped_lock<ur_shared_mutex> PageGuard(PageShard.Mutex);
+    PageShard.Pages[Key].push_back(AI);
+  });
+  LevelCounts[getLevel(AI->AllocSize)]++;
+
+  auto &CtxShard =
+      ContextShards[getShard(reinterpret_cast<uptr>(AI->Context))];
+  std::scoped_lock<ur_shared_mutex> CtxGuard(CtxShard.Mutex);
+  CtxShard.AllocInfos[AI->Context].emplace(AI->AllocBegin, AI);
+
+  return true;
+}
+
+std::shared_ptr<AllocInfo> AllocationIndex::erase(uptr AllocBegin) {
+  auto &Shard = AllocShards[getShard(AllocBegin)];
+  std::scoped_lock<ur_mutex> Guard(Shard.Mutex);
+  auto It = Shard.AllocInfos.find(AllocBegin);
+  if (It == Shard.AllocInfos.end()) {
+    return nullptr;
+  }
+  auto AI = std::move(It->second);
+  Shard.AllocInfos.erase(It);
+
+  forEachPage(AI, [&](PageShard &PageShard, uptr Key) {
+    std::scoped_lock<ur_shared_mutex> PageGuard(PageShard.Mutex);
+    auto PageIt = PageShard.Pages.find(Key);
+    assert(PageIt != PageShard.Pages.end());
+    auto &Slot = PageIt->second;
+    Slot.erase(std::find(Slot.begin(), Slot.end(), AI));
+    if (Slot.empty()) {
+      PageShard.Pages.erase(PageIt);
+    }
+  });
+  LevelCounts[getLevel(AI->AllocSize)]--;
+
+  auto &CtxShard =
+      ContextShards[getShard(reinterpret_cast<uptr>(AI->Context))];
+  std::scoped_lock<ur_shared_mutex> CtxGuard(CtxShard.Mutex);
+  auto CtxIt = CtxShard.AllocInfos.find(AI->Context);
+  assert(CtxIt != CtxShard.AllocInfos.end());
+  CtxIt->second.erase(AllocBegin);
+  if (CtxIt->second.empty()) {
+    CtxShard.AllocInfos.erase(CtxIt);
+  }
+
+  return AI;
+}
+
+std::shared_ptr<AllocInfo> AllocationIndex::find(uptr Address) const {
+  for (size_t Level = 0; Level < kPageShifts.size(); Level++) {
+    if (LevelCounts[Level] == 0) {
+      continue;
+    }
+    const uptr Key = getPageKey(Level, Address >> kPageShifts[Level]);
+    const auto &PageShard = PageShards[getShard(Key)];
+    std::shared_lock<ur_shared_mutex> Guard(PageShard.Mutex);
+    auto It = PageShard.Pages.find(Key);
+    if (It == PageShard.Pages.end()) {
+      continue;
+    }
+    for (const auto &AI : It->second) {
+      if (Address >= AI->AllocBegin &&
+          Address < AI->AllocBegin + AI->AllocSize) {
+        return AI;
+      }
+    }
+  }
+  return nullptr;
+}
+
+std::vector<std::shared_ptr<AllocInfo>>
+AllocationIndex::findByContext(ur_context_handle_t Context) const {
+  const auto &CtxShard =
+      ContextShards[getShard(reinterpret_cast<uptr>(Context))];
+  std::shared_lock<ur_shared_mutex> Guard(CtxShard.Mutex);
+  std::vector<std::shared_ptr<AllocInfo>> AllocInfos;
+  auto It = CtxShard.AllocInfos.find(Context);
+  if (It != CtxShard.AllocInfos.end()) {
+    AllocInfos.reserve(It->second.size());
+    for (const auto &[_, AI] : It->second) {
+      AllocInfos.push_back(AI);
+    }
+  }
+  return AllocInfos;
+}
+
+void AllocationIndex::clear() {
+  for (auto &Shard : AllocShards) {
+    std::scoped_lock<ur_mutex> Guard(Shard.Mutex);
+    Shard.AllocInfos.clear();
+  }
+  for (auto &Shard : PageShards) {
+    std::scoped_lock<ur_shared_mutex> Guard(Shard.Mutex);
+    Shard.Pages.clear();
+  }
+  for (auto &Count : LevelCounts) {
+    Count = 0;
+  }
+  for (auto &Shard : ContextShards) {
+    std::scoped_lock<ur_shared_mutex> Guard(Shard.Mutex);
+    Shard.AllocInfos.clear();
+  }
+}
+
+} // namespace asan
+} // namespace ur_sanitizer_layer
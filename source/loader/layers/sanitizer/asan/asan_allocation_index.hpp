@@ -0,0 +1,92 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file asan_allocation_index.hpp
+ *
+ */
+
+#pragma once
+
+#include "asan_allocator.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ur_sanitizer_layer {
+namespace asan {
+
+/// Indexes the allocations by the memory they own and by their context.
+///
+/// The memory of an allocation is registered in the slots of a page table with
+/// several page sizes. Each allocation goes to the smallest page size that
+/// keeps it within kMaxPagesPerAllocation pages, so finding the allocation
+/// that owns an address looks at one slot per page size. The slots, the
+/// allocations and the contexts are sharded by hash, each shard with its own
+/// lock, so lookups and updates on different threads rarely contend.
+class AllocationIndex {
+public:
+  /// Adds AI, unless an allocation beginning at the same address is indexed,
+  /// in which case false is returned
+  bool insert(std::shared_ptr<AllocInfo> AI);
+
+  /// Removes the allocation beginning at AllocBegin and returns it, or
+  /// nullptr if there is none
+  std::shared_ptr<AllocInfo> erase(uptr AllocBegin);
+
+  /// Returns the allocation whose memory contains Address, or nullptr
+  std::shared_ptr<AllocInfo> find(uptr Address) const;
+
+  /// Returns the allocations of Context
+  std::vector<std::shared_ptr<AllocInfo>>
+  findByContext(ur_context_handle_t Context) const;
+
+  void clear();
+
+private:
+  static constexpr size_t kNumShards = 64;
+  static constexpr uptr kMaxPagesPerAllocation = 64;
+  // log2 of the page sizes, from 4KB up to 4TB
+  static constexpr std::array<uptr, 6> kPageShifts = {12, 18, 24, 30, 36, 42};
+
+  struct PageShard {
+    mutable ur_shared_mutex Mutex;
+    std::unordered_map<uptr, std::vector<std::shared_ptr<AllocInfo>>> Pages;
+  };
+
+  struct AllocShard {
+    ur_mutex Mutex;
+    std::unordered_map<uptr, std::shared_ptr<AllocInfo>> AllocInfos;
+  };
+
+  struct ContextShard {
+    mutable ur_shared_mutex Mutex;
+    std::unordered_map<ur_context_handle_t,
+                       std::unordered_map<uptr, std::shared_ptr<AllocInfo>>>
+        AllocInfos;
+  };
+
+  static size_t getLevel(uptr Size);
+  static uptr getPageKey(size_t Level, uptr Page);
+  static size_t getShard(uptr Key);
+
+  template <typename Fn>
+  void forEachPage(const std::shared_ptr<AllocInfo> &AI, Fn &&F);
+
+  std::array<PageShard, kNumShards> PageShards;
+  std::array<AllocShard, kNumShards> AllocShards;
+  std::array<ContextShard, kNumShards> ContextShards;
+
+  // The number of allocations at each page size, to skip the empty ones
+  std::array<std::atomic<size_t>, kPageShifts.size()> LevelCounts{};
+};
+
+} // namespace asan
+} // namespace ur_sanitizer_layer
@@ -14,7 +14,7 @@
 
 #include "sanitizer_common/sanitizer_allocator.hpp"
 #include "sanitizer_common/sanitizer_common.hpp"
-#include "sanitizer_common/sanitizer_stacktrace.hpp"
+#include "sanitizer_common/sanitizer_stackdepot.hpp"
 
 namespace ur_sanitizer_layer {
 namespace asan {
@@ -31,15 +31,13 @@ struct AllocInfo {
   ur_context_handle_t Context = nullptr;
   ur_device_handle_t Device = nullptr;
 
-  StackTrace AllocStack;
-  StackTrace ReleaseStack;
+  // Ids of the stacks in the stack depot
+  uint32_t AllocStackId = 0;
+  uint32_t ReleaseStackId = 0;
 
   void print();
   size_t getRedzoneSize() { return AllocSize - (UserEnd - UserBegin); }
 };
 
-using AllocationMap = std::map<uptr, std::shared_ptr<AllocInfo>>;
-using AllocationIterator = AllocationMap::iterator;
-
 } // namespace asan
 } // namespace ur_sanitizer_layer
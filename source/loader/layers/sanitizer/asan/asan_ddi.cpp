@@ -1548,7 +1548,7 @@ __urdlllocal ur_result_t UR_APICALL urEnqueueKernelLaunchWithArgsExp(
     }
     case UR_EXP_KERNEL_ARG_TYPE_POINTER: {
       KernelInfo.PointerArgs[pArgs[ArgPropIndex].index] = {
-          pArgs[ArgPropIndex].value.pointer, GetCurrentBacktrace()};
+          pArgs[ArgPropIndex].value.pointer, GetCurrentBacktraceId()};
       break;
     }
     case UR_EXP_KERNEL_ARG_TYPE_VALUE: {
@@ -1660,9 +1660,9 @@ __urdlllocal ur_result_t UR_APICALL urMemoryExportExportMemoryHandleExp(
     void *pMemHandleRet) {
   UR_LOG_L(getContext()->logger, DEBUG,
            "==== urMemoryExportExportMemoryHandleExp");
-  auto AllocInfoItOp = getAsanInterceptor()->findAllocInfoByAddress((uptr)pMem);
-  if (AllocInfoItOp.has_value()) {
-    pMem = reinterpret_cast<void *>(AllocInfoItOp.value()->first);
+  auto AllocInfo = getAsanInterceptor()->findAllocInfoByAddress((uptr)pMem);
+  if (AllocInfo) {
+    pMem = reinterpret_cast<void *>(AllocInfo->AllocBegin);
   }
   UR_CALL(getContext()->urDdiTable.MemoryExportExp.pfnExportMemoryHandleExp(
       hContext, hDevice, handleTypeToExport, pMem, pMemHandleRet));
@@ -37,9 +37,9 @@ AsanInterceptor::~AsanInterceptor() {
   m_MemBufferMap.clear();
   m_KernelMap.clear();
   m_ContextMap.clear();
-  // AllocationMap need to be cleared after ContextMap because memory leak
-  // detection depends on it.
-  m_AllocationMap.clear();
+  // The allocations need to be cleared after ContextMap because memory leak
+  // detection depends on them.
+  m_AllocationIndex.clear();
 
   for (auto &[_, ShadowMemory] : m_ShadowMap) {
     ShadowMemory->Destory();
@@ -130,8 +130,8 @@ ur_result_t AsanInterceptor::allocateMemory(ur_context_handle_t Context,
                                                   false,
                                                   Context,
                                                   Device,
-                                                  GetCurrentBacktrace(),
-                                                  {}});
+                                                  GetCurrentBacktraceId(),
+                                                  0});
 
   AI->print();
 
@@ -142,12 +142,10 @@ ur_result_t AsanInterceptor::allocateMemory(ur_context_handle_t Context,
     for (const auto &Device : ContextInfo->DeviceList)
       getDeviceInfo(Device)->insertAllocInfo(AI);
   }
+  retainShadow(AI);
 
   // For memory release
-  {
-    std::scoped_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-    m_AllocationMap.emplace(AI->AllocBegin, std::move(AI));
-  }
+  m_AllocationIndex.insert(std::move(AI));
 
   return UR_RESULT_SUCCESS;
 }
@@ -157,9 +155,9 @@ ur_result_t AsanInterceptor::releaseMemory(ur_context_handle_t Context,
   auto ContextInfo = getContextInfo(Context);
 
   auto Addr = reinterpret_cast<uptr>(Ptr);
-  auto AllocInfoItOp = findAllocInfoByAddress(Addr);
+  auto AllocInfo = findAllocInfoByAddress(Addr);
 
-  if (!AllocInfoItOp) {
+  if (!AllocInfo) {
     // "Addr" might be a host pointer
     ReportBadFree(Addr, GetCurrentBacktrace(), nullptr);
     if (getContext()->Options.HaltOnError) {
@@ -168,11 +166,6 @@ ur_result_t AsanInterceptor::releaseMemory(ur_context_handle_t Context,
     return UR_RESULT_SUCCESS;
   }
 
-  auto AllocInfoIt = *AllocInfoItOp;
-  // NOTE: AllocInfoIt will be erased later, so "AllocInfo" must be a new
-  // reference here
-  auto AllocInfo = AllocInfoIt->second;
-
   if (AllocInfo->Context != Context) {
     if (AllocInfo->UserBegin == Addr) {
       ReportBadContext(Addr, GetCurrentBacktrace(), AllocInfo);
@@ -203,7 +196,7 @@ ur_result_t AsanInterceptor::releaseMemory(ur_context_handle_t Context,
   }
 
   AllocInfo->IsReleased = true;
-  AllocInfo->ReleaseStack = GetCurrentBacktrace();
+  AllocInfo->ReleaseStackId = GetCurrentBacktraceId();
 
   if (AllocInfo->Type == AllocType::HOST_USM) {
     for (const auto &Device : ContextInfo->DeviceList)
@@ -220,8 +213,8 @@ ur_result_t AsanInterceptor::releaseMemory(ur_context_handle_t Context,
     ContextInfo->Stats.UpdateUSMRealFreed(AllocInfo->AllocSize,
                                           AllocInfo->getRedzoneSize());
 
-    std::scoped_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-    m_AllocationMap.erase(AllocInfoIt);
+    m_AllocationIndex.erase(AllocInfo->AllocBegin);
+    UR_CALL(releaseShadow({AllocInfo}));
 
     if (AllocInfo->Type != AllocType::EXPORTABLE_MEM) {
       return getContext()->urDdiTable.USM.pfnFree(
@@ -235,17 +228,22 @@ ur_result_t AsanInterceptor::releaseMemory(ur_context_handle_t Context,
 
   // If quarantine is enabled, cache it
   auto ReleaseList =
-      ContextInfo->m_Quarantine->put(AllocInfo->Device, AllocInfoIt);
+      ContextInfo->m_Quarantine->put(AllocInfo->Device, AllocInfo);
   if (ReleaseList.size()) {
-    std::scoped_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-    for (auto &It : ReleaseList) {
-      auto ToFreeAllocInfo = It->second;
+    uptr EvictedSize = 0;
+    for (auto &ToFreeAllocInfo : ReleaseList) {
       UR_LOG_L(getContext()->logger, INFO, "Quarantine Free: {}",
                (void *)ToFreeAllocInfo->AllocBegin);
 
       ContextInfo->Stats.UpdateUSMRealFreed(ToFreeAllocInfo->AllocSize,
                                             ToFreeAllocInfo->getRedzoneSize());
+      EvictedSize += ToFreeAllocInfo->AllocSize;
+    }
+    ContextInfo->Stats.UpdateQuarantineEvicted(ReleaseList.size(),
+                                               EvictedSize);
+    UR_CALL(releaseShadow(ReleaseList));
 
+    for (auto &ToFreeAllocInfo : ReleaseList) {
       if (ToFreeAllocInfo->Type != AllocType::EXPORTABLE_MEM) {
         UR_CALL(getContext()->urDdiTable.USM.pfnFree(
             Context, (void *)(ToFreeAllocInfo->AllocBegin)));
@@ -257,7 +255,7 @@ ur_result_t AsanInterceptor::releaseMemory(ur_context_handle_t Context,
       }
 
       // Erase it at last to avoid use-after-free.
-      m_AllocationMap.erase(It);
+      m_AllocationIndex.erase(ToFreeAllocInfo->AllocBegin);
     }
   }
   ContextInfo->Stats.UpdateUSMFreed(AllocInfo->AllocSize);
@@ -279,30 +277,27 @@ ur_result_t AsanInterceptor::registerIPCMemory(ur_context_handle_t Context,
                                                   false,
                                                   Context,
                                                   Device,
-                                                  GetCurrentBacktrace(),
-                                                  {}});
+                                                  GetCurrentBacktraceId(),
+                                                  0});
 
   DI->insertAllocInfo(AI);
+  retainShadow(AI);
 
   // For memory release
-  {
-    std::scoped_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-    m_AllocationMap.emplace(AI->AllocBegin, std::move(AI));
-  }
+  m_AllocationIndex.insert(std::move(AI));
 
   return UR_RESULT_SUCCESS;
 }
 
 ur_result_t AsanInterceptor::unregisterIPCMemory(uptr Addr) {
-  auto AllocInfoItOp = findAllocInfoByAddress(Addr);
-  if (AllocInfoItOp.has_value()) {
-    auto AllocInfo = AllocInfoItOp.value()->second;
+  auto AllocInfo = findAllocInfoByAddress(Addr);
+  if (AllocInfo) {
     AllocInfo->IsReleased = true;
-    AllocInfo->ReleaseStack = GetCurrentBacktrace();
+    AllocInfo->ReleaseStackId = GetCurrentBacktraceId();
     getDeviceInfo(AllocInfo->Device)->insertAllocInfo(AllocInfo);
 
-    std::scoped_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-    m_AllocationMap.erase(*AllocInfoItOp);
+    m_AllocationIndex.erase(AllocInfo->AllocBegin);
+    UR_CALL(releaseShadow({AllocInfo}));
   }
 
   return UR_RESULT_SUCCESS;
@@ -385,10 +380,11 @@ AsanInterceptor::getOrCreateShadowMemory(ur_device_handle_t Device,
 ///
 /// ref:
 /// https://github.com/google/sanitizers/wiki/AddressSanitizerAlgorithm#mapping
-ur_result_t
-AsanInterceptor::enqueueAllocInfo(std::shared_ptr<DeviceInfo> &DeviceInfo,
-                                  ur_queue_handle_t Queue,
-                                  std::shared_ptr<AllocInfo> &AI) {
+void AsanInterceptor::poisonAllocInfo(std::shared_ptr<DeviceInfo> &DeviceInfo,
+                                      ShadowPoisonBatch &Batch,
+                                      std::shared_ptr<AllocInfo> &AI) {
+  auto &Shadow = DeviceInfo->Shadow;
+
   if (AI->IsReleased) {
     const int8_t *ShadowByte;
     switch (AI->Type) {
@@ -411,18 +407,16 @@ AsanInterceptor::enqueueAllocInfo(std::shared_ptr<DeviceInfo> &DeviceInfo,
       ShadowByte = &kUnknownMagic;
       assert(false && "Unknow AllocInfo Type");
     }
-    UR_CALL(DeviceInfo->Shadow->EnqueuePoisonShadow(Queue, AI->AllocBegin,
-                                                    AI->AllocSize, ShadowByte));
-    return UR_RESULT_SUCCESS;
+    Shadow->PoisonShadow(Batch, AI->AllocBegin, AI->AllocSize, *ShadowByte);
+    return;
   }
 
   // Init zero
-  UR_CALL(DeviceInfo->Shadow->EnqueuePoisonShadow(Queue, AI->AllocBegin,
-                                                  AI->AllocSize, &kZeroMagic));
+  Shadow->PoisonShadow(Batch, AI->AllocBegin, AI->AllocSize, kZeroMagic);
 
   // If no redzones to poison, so we're done.
   if (AI->UserEnd == (AI->AllocBegin + AI->AllocSize))
-    return UR_RESULT_SUCCESS;
+    return;
 
   uptr TailBegin = RoundUpTo(AI->UserEnd, ASAN_SHADOW_GRANULARITY);
   uptr TailEnd = AI->AllocBegin + AI->AllocSize;
@@ -436,8 +430,7 @@ AsanInterceptor::enqueueAllocInfo(std::shared_ptr<DeviceInfo> &DeviceInfo,
     }();
     auto Value =
         AI->UserEnd - RoundDownTo(AI->UserEnd, ASAN_SHADOW_GRANULARITY);
-    UR_CALL(DeviceInfo->Shadow->EnqueuePoisonShadow(Queue, AI->UserEnd, 1,
-                                                    &TailMagic[Value]));
+    Shadow->PoisonShadow(Batch, AI->UserEnd, 1, TailMagic[Value]);
   }
 
   const int8_t *ShadowByte;
@@ -466,14 +459,11 @@ AsanInterceptor::enqueueAllocInfo(std::shared_ptr<DeviceInfo> &DeviceInfo,
   }
 
   // Left red zone
-  UR_CALL(DeviceInfo->Shadow->EnqueuePoisonShadow(
-      Queue, AI->AllocBegin, AI->UserBegin - AI->AllocBegin, ShadowByte));
+  Shadow->PoisonShadow(Batch, AI->AllocBegin, AI->UserBegin - AI->AllocBegin,
+                       *ShadowByte);
 
   // Right red zone
-  UR_CALL(DeviceInfo->Shadow->EnqueuePoisonShadow(
-      Queue, TailBegin, TailEnd - TailBegin, ShadowByte));
-
-  return UR_RESULT_SUCCESS;
+  Shadow->PoisonShadow(Batch, TailBegin, TailEnd - TailBegin, *ShadowByte);
 }
 
 ur_result_t
@@ -481,14 +471,68 @@ AsanInterceptor::updateShadowMemory(std::shared_ptr<DeviceInfo> &DeviceInfo,
                                     ur_queue_handle_t Queue) {
   std::scoped_lock<ur_shared_mutex> Guard(DeviceInfo->AllocInfos.Mutex);
 
+  // The shadow of all pending allocations is written at once, so that
+  // neighbouring allocations share their writes
+  ShadowPoisonBatch Batch;
   for (auto &AI : DeviceInfo->AllocInfos.List) {
-    UR_CALL(enqueueAllocInfo(DeviceInfo, Queue, AI));
+    poisonAllocInfo(DeviceInfo, Batch, AI);
   }
+  UR_CALL(DeviceInfo->Shadow->EnqueuePoisonShadowBatch(Queue, Batch));
   DeviceInfo->AllocInfos.List.clear();
 
   return UR_RESULT_SUCCESS;
 }
 
+std::vector<std::shared_ptr<ShadowMemory>>
+AsanInterceptor::getShadowMemories(const std::shared_ptr<AllocInfo> &AI) {
+  std::vector<std::shared_ptr<ShadowMemory>> Shadows;
+  auto AddShadow = [&](ur_device_handle_t Device) {
+    auto Shadow = getDeviceInfo(Device)->Shadow;
+    // Devices of the same type share their shadow memory
+    if (Shadow &&
+        std::find(Shadows.begin(), Shadows.end(), Shadow) == Shadows.end()) {
+      Shadows.push_back(std::move(Shadow));
+    }
+  };
+  if (AI->Type == AllocType::HOST_USM) {
+    for (const auto &Device : getContextInfo(AI->Context)->DeviceList) {
+      AddShadow(Device);
+    }
+  } else {
+    AddShadow(AI->Device);
+  }
+  return Shadows;
+}
+
+void AsanInterceptor::retainShadow(const std::shared_ptr<AllocInfo> &AI) {
+  for (auto &Shadow : getShadowMemories(AI)) {
+    Shadow->RetainShadow(AI->AllocBegin, AI->AllocSize);
+  }
+}
+
+ur_result_t AsanInterceptor::releaseShadow(
+    const std::vector<std::shared_ptr<AllocInfo>> &AllocInfos) {
+  // Release the shadow of all the allocations at once on each shadow memory
+  std::vector<std::pair<std::shared_ptr<ShadowMemory>,
+                        std::vector<std::pair<uptr, uptr>>>>
+      RangesOfShadow;
+  for (const auto &AI : AllocInfos) {
+    for (auto &Shadow : getShadowMemories(AI)) {
+      auto It = std::find_if(RangesOfShadow.begin(), RangesOfShadow.end(),
+                             [&](auto &Pair) { return Pair.first == Shadow; });
+      if (It == RangesOfShadow.end()) {
+        It = RangesOfShadow.insert(It, {Shadow, {}});
+      }
+      It->second.emplace_back(AI->AllocBegin, AI->AllocSize);
+    }
+  }
+
+  for (auto &[Shadow, Ranges] : RangesOfShadow) {
+    UR_CALL(Shadow->ReleaseShadow(Ranges));
+  }
+  return UR_RESULT_SUCCESS;
+}
+
 ur_result_t AsanInterceptor::registerProgram(ur_program_handle_t Program) {
   ur_result_t Result = UR_RESULT_SUCCESS;
 
@@ -511,10 +555,13 @@ ur_result_t AsanInterceptor::unregisterProgram(ur_program_handle_t Program) {
   auto ProgramInfo = getProgramInfo(Program);
   assert(ProgramInfo != nullptr && "unregistered program!");
 
-  std::scoped_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-  for (auto AI : ProgramInfo->AllocInfoForGlobals) {
-    m_AllocationMap.erase(AI->AllocBegin);
+  std::vector<std::shared_ptr<AllocInfo>> Globals(
+      ProgramInfo->AllocInfoForGlobals.begin(),
+      ProgramInfo->AllocInfoForGlobals.end());
+  for (const auto &AI : Globals) {
+    m_AllocationIndex.erase(AI->AllocBegin);
   }
+  UR_CALL(releaseShadow(Globals));
   ProgramInfo->AllocInfoForGlobals.clear();
 
   ProgramInfo->KernelMetadataMap.clear();
@@ -658,14 +705,14 @@ AsanInterceptor::registerDeviceGlobals(ur_program_handle_t Program) {
                       false,
                       Context,
                       Device,
-                      GetCurrentBacktrace(),
-                      {}});
+                      GetCurrentBacktraceId(),
+                      0});
 
         getDeviceInfo(Device)->insertAllocInfo(AI);
         ProgramInfo->AllocInfoForGlobals.emplace(AI);
+        retainShadow(AI);
 
-        std::scoped_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-        m_AllocationMap.emplace(AI->AllocBegin, std::move(AI));
+        m_AllocationIndex.insert(std::move(AI));
       }
     }
   }
@@ -840,7 +887,7 @@ ur_result_t AsanInterceptor::prepareLaunch(
       if (auto ValidateResult = ValidateUSMPointer(
               Kernel, ContextInfo->Handle, DeviceInfo->Handle, (uptr)Ptr)) {
         ReportInvalidKernelArgument(Kernel, ArgIndex, (uptr)Ptr, ValidateResult,
-                                    PtrPair.second);
+                                    StackDepotGet(PtrPair.second));
         if (ValidateResult.Type != ValidateUSMResult::MAYBE_HOST_POINTER) {
           exitWithErrors();
         }
@@ -991,34 +1038,15 @@ ur_result_t AsanInterceptor::prepareLaunch(
   return UR_RESULT_SUCCESS;
 }
 
-std::optional<AllocationIterator>
+std::shared_ptr<AllocInfo>
 AsanInterceptor::findAllocInfoByAddress(uptr Address) {
-  std::shared_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-  auto It = m_AllocationMap.upper_bound(Address);
-  if (It == m_AllocationMap.begin()) {
-    return std::nullopt;
-  }
-  --It;
-
-  // Maybe it's a host pointer
-  if (Address < It->second->AllocBegin ||
-      Address >= It->second->AllocBegin + It->second->AllocSize) {
-    return std::nullopt;
-  }
-  return It;
+  // Maybe it's a host pointer, if nothing is found
+  return m_AllocationIndex.find(Address);
 }
 
-std::vector<AllocationIterator>
+std::vector<std::shared_ptr<AllocInfo>>
 AsanInterceptor::findAllocInfoByContext(ur_context_handle_t Context) {
-  std::shared_lock<ur_shared_mutex> Guard(m_AllocationMapMutex);
-  std::vector<AllocationIterator> AllocInfos;
-  for (auto It = m_AllocationMap.begin(); It != m_AllocationMap.end(); It++) {
-    const auto &[_, AI] = *It;
-    if (AI->Context == Context) {
-      AllocInfos.emplace_back(It);
-    }
-  }
-  return AllocInfos;
+  return m_AllocationIndex.findByContext(Context);
 }
 
 bool ProgramInfo::isKernelInstrumented(ur_kernel_handle_t Kernel) const {
@@ -1052,10 +1080,8 @@ ContextInfo::~ContextInfo() {
   // check memory leaks
   if (getContext()->Options.DetectLeaks &&
       getAsanInterceptor()->isNormalExit()) {
-    std::vector<AllocationIterator> AllocInfos =
-        getAsanInterceptor()->findAllocInfoByContext(Handle);
-    for (const auto &It : AllocInfos) {
-      const auto &[_, AI] = *It;
+    auto AllocInfos = getAsanInterceptor()->findAllocInfoByContext(Handle);
+    for (const auto &AI : AllocInfos) {
       if (!AI->IsReleased) {
         ReportMemoryLeak(AI);
       }
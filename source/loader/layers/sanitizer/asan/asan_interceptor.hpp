@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include "asan_allocation_index.hpp"
 #include "asan_allocator.hpp"
 #include "asan_buffer.hpp"
 #include "asan_libdevice.hpp"
@@ -25,7 +26,6 @@
 
 #include <memory>
 #include <optional>
-#include <queue>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -48,11 +48,6 @@ struct DeviceInfo {
   // Device features
   bool IsSupportSharedSystemUSM = false;
 
-  // lock this mutex if following fields are accessed
-  ur_mutex Mutex;
-  std::queue<std::shared_ptr<AllocInfo>> Quarantine;
-  size_t QuarantineSize = 0;
-
   AllocInfoList AllocInfos;
 
   // Device handles are special and alive in the whole process lifetime,
@@ -99,7 +94,8 @@ struct KernelInfo {
 
   // lock this mutex if following fields are accessed
   ur_shared_mutex Mutex;
-  std::unordered_map<uint32_t, std::pair<const void *, StackTrace>> PointerArgs;
+  // The pointer and the stack id of where it was set
+  std::unordered_map<uint32_t, std::pair<const void *, uint32_t>> PointerArgs;
 
   // Need preserve the order of local arguments
   std::map<uint32_t, LocalArgsInfo> LocalArgs;
@@ -348,9 +344,9 @@ public:
     return UR_RESULT_SUCCESS;
   }
 
-  std::optional<AllocationIterator> findAllocInfoByAddress(uptr Address);
+  std::shared_ptr<AllocInfo> findAllocInfoByAddress(uptr Address);
 
-  std::vector<AllocationIterator>
+  std::vector<std::shared_ptr<AllocInfo>>
   findAllocInfoByContext(ur_context_handle_t Context);
 
   std::shared_ptr<ContextInfo> getContextInfo(ur_context_handle_t Context) {
@@ -392,9 +388,18 @@ private:
   ur_result_t updateShadowMemory(std::shared_ptr<DeviceInfo> &DeviceInfo,
                                  ur_queue_handle_t Queue);
 
-  ur_result_t enqueueAllocInfo(std::shared_ptr<DeviceInfo> &DeviceInfo,
-                               ur_queue_handle_t Queue,
-                               std::shared_ptr<AllocInfo> &AI);
+  void poisonAllocInfo(std::shared_ptr<DeviceInfo> &DeviceInfo,
+                       ShadowPoisonBatch &Batch,
+                       std::shared_ptr<AllocInfo> &AI);
+
+  /// Returns the shadow memories of the devices that can access AI
+  std::vector<std::shared_ptr<ShadowMemory>>
+  getShadowMemories(const std::shared_ptr<AllocInfo> &AI);
+
+  /// Keeps the shadow of AI, until it's released once AI is freed
+  void retainShadow(const std::shared_ptr<AllocInfo> &AI);
+  ur_result_t
+  releaseShadow(const std::vector<std::shared_ptr<AllocInfo>> &AllocInfos);
 
   /// Initialize Global Variables & Kernel Name at first Launch
   ur_result_t prepareLaunch(std::shared_ptr<ContextInfo> &ContextInfo,
@@ -426,8 +431,7 @@ private:
   ur_shared_mutex m_MemBufferMapMutex;
 
   /// Assumption: all USM chunks are allocated in one VA
-  AllocationMap m_AllocationMap;
-  ur_shared_mutex m_AllocationMapMutex;
+  AllocationIndex m_AllocationIndex;
 
   std::unordered_set<ur_adapter_handle_t> m_Adapters;
   ur_shared_mutex m_AdaptersMutex;
@@ -12,25 +12,89 @@
 
 #include "asan_quarantine.hpp"
 
+#include <utility>
+
 namespace ur_sanitizer_layer {
 namespace asan {
 
-std::vector<AllocationIterator> Quarantine::put(ur_device_handle_t Device,
-                                                AllocationIterator &It) {
-  auto &AI = It->second;
-  auto AllocSize = AI->AllocSize;
-  auto &Cache = getCache(Device);
-
-  std::vector<AllocationIterator> DequeueList;
-  std::scoped_lock<ur_mutex> Guard(Cache.Mutex);
-  while (Cache.size() + AllocSize > m_MaxQuarantineSize) {
-    auto ElementOp = Cache.dequeue();
-    if (!ElementOp) {
-      break;
+QuarantineFifo::~QuarantineFifo() {
+  while (pop()) {
+  }
+  delete m_Tail;
+}
+
+void QuarantineFifo::push(Element AI) {
+  auto *NewNode = new Node;
+  NewNode->AI = std::move(AI);
+  Node *Prev = m_Head.exchange(NewNode, std::memory_order_acq_rel);
+  Prev->Next.store(NewNode, std::memory_order_release);
+}
+
+QuarantineFifo::Element QuarantineFifo::pop() {
+  Node *Next = m_Tail->Next.load(std::memory_order_acquire);
+  if (!Next) {
+    return nullptr;
+  }
+  delete m_Tail;
+  m_Tail = Next;
+  return std::move(Next->AI);
+}
+
+Quarantine::~Quarantine() {
+  auto *DQ = m_Devices.load();
+  while (DQ) {
+    delete std::exchange(DQ, DQ->Next);
+  }
+}
+
+Quarantine::DeviceQuarantine &
+Quarantine::getDeviceQuarantine(ur_device_handle_t Device) {
+  auto *Head = m_Devices.load(std::memory_order_acquire);
+  for (auto *DQ = Head; DQ; DQ = DQ->Next) {
+    if (DQ->Device == Device) {
+      return *DQ;
+    }
+  }
+
+  auto NewDQ = std::make_unique<DeviceQuarantine>(Device);
+  NewDQ->Next = Head;
+  while (!m_Devices.compare_exchange_weak(NewDQ->Next, NewDQ.get(),
+                                          std::memory_order_acq_rel)) {
+    // Another thread may have added the device meanwhile
+    for (auto *DQ = NewDQ->Next; DQ != Head; DQ = DQ->Next) {
+      if (DQ->Device == Device) {
+        return *DQ;
+      }
+    }
+    Head = NewDQ->Next;
+  }
+  return *NewDQ.release();
+}
+
+std::vector<std::shared_ptr<AllocInfo>>
+Quarantine::put(ur_device_handle_t Device, std::shared_ptr<AllocInfo> &AI) {
+  const uptr AllocSize = AI->AllocSize;
+  auto &DQ = getDeviceQuarantine(Device);
+
+  std::vector<std::shared_ptr<AllocInfo>> DequeueList;
+  if (DQ.Size + AllocSize > m_MaxQuarantineSize &&
+      !DQ.Evicting.test_and_set(std::memory_order_acquire)) {
+    const uptr Limit =
+        m_MaxQuarantineSize - m_MaxQuarantineSize / kEvictionDivisor;
+    while (DQ.Size + AllocSize > Limit) {
+      auto Evicted = DQ.Fifo.pop();
+      if (!Evicted) {
+        break;
+      }
+      DQ.Size -= Evicted->AllocSize;
+      DequeueList.emplace_back(std::move(Evicted));
     }
-    DequeueList.emplace_back(*ElementOp);
+    DQ.Evicting.clear(std::memory_order_release);
   }
-  Cache.enqueue(It);
+
+  // Account for AI before it can be popped
+  DQ.Size += AllocSize;
+  DQ.Fifo.push(AI);
   return DequeueList;
 }
 
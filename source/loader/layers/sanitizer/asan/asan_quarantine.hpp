@@ -15,60 +15,81 @@
 #include "asan_allocator.hpp"
 
 #include <atomic>
-#include <queue>
-#include <unordered_map>
+#include <memory>
 #include <vector>
 
 namespace ur_sanitizer_layer {
 namespace asan {
 
-class QuarantineCache {
+/// Lock-free FIFO of released allocations, for any number of producers and a
+/// single consumer at a time (Vyukov's MPSC queue)
+class QuarantineFifo {
 public:
-  using Element = AllocationIterator;
-  using List = std::queue<Element>;
-
-  // The following methods are not thread safe, use this lock
-  ur_mutex Mutex;
-
-  // Total memory used, including internal accounting.
-  uptr size() const { return m_Size; }
-
-  void enqueue(Element &It) {
-    m_List.push(It);
-    m_Size += It->second->AllocSize;
-  }
-
-  std::optional<Element> dequeue() {
-    if (m_List.empty()) {
-      return std::optional<Element>{};
-    }
-    auto It = m_List.front();
-    m_List.pop();
-    m_Size -= It->second->AllocSize;
-    return It;
-  }
+  using Element = std::shared_ptr<AllocInfo>;
+
+  QuarantineFifo() : m_Head(new Node), m_Tail(m_Head.load()) {}
+  ~QuarantineFifo();
+
+  QuarantineFifo(const QuarantineFifo &) = delete;
+  QuarantineFifo &operator=(const QuarantineFifo &) = delete;
+
+  // Thread safe
+  void push(Element AI);
+
+  // Only one thread at a time may pop. Returns nullptr if the FIFO is empty,
+  // or if the element following the last popped one isn't linked yet.
+  Element pop();
 
 private:
-  List m_List;
-  std::atomic_uintptr_t m_Size = 0;
+  struct Node {
+    std::atomic<Node *> Next = nullptr;
+    Element AI;
+  };
+
+  // The last pushed node
+  std::atomic<Node *> m_Head;
+  // The last popped node, whose successor is popped next
+  Node *m_Tail;
 };
 
+/// Keeps the released allocations of a context, per device, until the size of
+/// the quarantined memory of the device exceeds the limit. The allocations are
+/// then evicted in FIFO order, and in batches: enough of them to leave room for
+/// MaxQuarantineSize / kEvictionDivisor more, so that the next puts don't evict
+/// one allocation at a time.
 class Quarantine {
 public:
   explicit Quarantine(size_t MaxQuarantineSize)
       : m_MaxQuarantineSize(MaxQuarantineSize) {}
+  ~Quarantine();
 
-  std::vector<AllocationIterator> put(ur_device_handle_t Device,
-                                      AllocationIterator &Ptr);
+  /// Quarantines AI, and returns the allocations it evicts, if any. While a
+  /// thread evicts the allocations of a device, the other threads putting
+  /// allocations of the device don't evict any.
+  std::vector<std::shared_ptr<AllocInfo>>
+  put(ur_device_handle_t Device, std::shared_ptr<AllocInfo> &AI);
 
 private:
-  QuarantineCache &getCache(ur_device_handle_t Device) {
-    std::scoped_lock<ur_mutex> Guard(m_Mutex);
-    return m_Map[Device];
-  }
+  static constexpr size_t kEvictionDivisor = 4;
+
+  struct DeviceQuarantine {
+    explicit DeviceQuarantine(ur_device_handle_t Device) : Device(Device) {}
+
+    ur_device_handle_t Device;
+    DeviceQuarantine *Next = nullptr;
+
+    QuarantineFifo Fifo;
+    // Total memory of the quarantined allocations
+    std::atomic<uptr> Size = 0;
+    // Held by the thread evicting allocations, as the consumer of Fifo
+    std::atomic_flag Evicting = ATOMIC_FLAG_INIT;
+  };
+
+  DeviceQuarantine &getDeviceQuarantine(ur_device_handle_t Device);
 
-  std::unordered_map<ur_device_handle_t, QuarantineCache> m_Map;
-  ur_mutex m_Mutex;
+  // The devices are only ever added, at the head, so they can be looked up
+  // without a lock
+  std::atomic<DeviceQuarantine *> m_Devices = nullptr;
   size_t m_MaxQuarantineSize;
 };
 
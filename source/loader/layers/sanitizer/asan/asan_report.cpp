@@ -29,10 +29,10 @@ void PrintAllocateInfo(uptr Addr, const AllocInfo *AI) {
            "{} is located inside of {} region [{}, {})", (void *)Addr,
            ToString(AI->Type), (void *)AI->UserBegin, (void *)AI->UserEnd);
   UR_LOG_L(getContext()->logger, QUIET, "allocated here:");
-  AI->AllocStack.print();
+  StackDepotGet(AI->AllocStackId).print();
   if (AI->IsReleased) {
     UR_LOG_L(getContext()->logger, QUIET, "freed here:");
-    AI->ReleaseStack.print();
+    StackDepotGet(AI->ReleaseStackId).print();
   }
 }
 
@@ -75,9 +75,9 @@ void ReportDoubleFree(uptr Addr, const StackTrace &Stack,
            "{} is located inside of {} region [{}, {})", (void *)Addr,
            ToString(AI->Type), (void *)AI->UserBegin, (void *)AI->UserEnd);
   UR_LOG_L(getContext()->logger, QUIET, "freed here:");
-  AI->ReleaseStack.print();
+  StackDepotGet(AI->ReleaseStackId).print();
   UR_LOG_L(getContext()->logger, QUIET, "previously allocated here:");
-  AI->AllocStack.print();
+  StackDepotGet(AI->AllocStackId).print();
 }
 
 void ReportMemoryLeak(const std::shared_ptr<AllocInfo> &AI) {
@@ -87,7 +87,7 @@ void ReportMemoryLeak(const std::shared_ptr<AllocInfo> &AI) {
   UR_LOG_L(getContext()->logger, QUIET,
            "Direct leak of {} byte(s) at {} allocated from:",
            AI->UserEnd - AI->UserBegin, (void *)AI->UserBegin);
-  AI->AllocStack.print();
+  StackDepotGet(AI->AllocStackId).print();
 }
 
 void ReportFatalError(const AsanErrorReport &Report) {
@@ -140,15 +140,14 @@ void ReportUseAfterFree(const AsanErrorReport &Report,
   UR_LOG_L(getContext()->logger, QUIET, "");
 
   if (getContext()->Options.MaxQuarantineSizeMB > 0) {
-    auto AllocInfoItOp =
+    auto AllocInfo =
         getAsanInterceptor()->findAllocInfoByAddress(Report.Address);
 
-    if (!AllocInfoItOp) {
+    if (!AllocInfo) {
       UR_LOG_L(getContext()->logger, QUIET,
                "Failed to find which chunck {} is allocated",
                (void *)Report.Address);
     } else {
-      auto &AllocInfo = (*AllocInfoItOp)->second;
       if (AllocInfo->Context != Context) {
         UR_LOG_L(getContext()->logger, QUIET,
                  "Failed to find which chunck {} is allocated",
@@ -206,7 +205,7 @@ void ReportInvalidKernelArgument(ur_kernel_handle_t Kernel, uint32_t ArgIndex,
              ArgIndex + 1, (void *)Addr, (void *)AI->UserBegin,
              (void *)AI->UserEnd);
     UR_LOG_L(getContext()->logger, QUIET, "allocated here:");
-    AI->AllocStack.print();
+    StackDepotGet(AI->AllocStackId).print();
     break;
   default:
     break;
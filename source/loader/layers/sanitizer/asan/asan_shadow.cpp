@@ -33,6 +33,39 @@ std::shared_ptr<ShadowMemory> CreateShadowMemory(ur_device_handle_t Device,
   }
 }
 
+ur_result_t
+ShadowMemory::EnqueuePoisonShadowBatch(ur_queue_handle_t Queue,
+                                       const ShadowPoisonBatch &Batch) {
+  if (Batch.Empty()) {
+    return UR_RESULT_SUCCESS;
+  }
+
+  auto Writes = Batch.GetWrites();
+  UR_LOG_L(getContext()->logger, DEBUG, "EnqueuePoisonShadowBatch({} writes)",
+           Writes.size());
+
+  ur_result_t Result = UR_RESULT_SUCCESS;
+  bool HasCopies = false;
+  for (const auto &Write : Writes) {
+    Result = EnqueueWriteShadow(Queue, Write);
+    if (Result != UR_RESULT_SUCCESS) {
+      break;
+    }
+    HasCopies |= !Write.IsFill();
+  }
+
+  // Enqueued copies read the bytes of Writes, so they're kept until the
+  // copies are done
+  if (HasCopies) {
+    auto URes = KeepWritesAlive(Queue, std::move(Writes));
+    if (Result == UR_RESULT_SUCCESS) {
+      Result = URes;
+    }
+  }
+
+  return Result;
+}
+
 ur_result_t ShadowMemoryCPU::Setup() {
   size_t ShadowSize = GetShadowSize();
   ShadowBegin = MmapNoReserve(0, ShadowSize);
@@ -91,6 +124,17 @@ ur_result_t ShadowMemoryCPU::EnqueuePoisonShadow(ur_queue_handle_t, uptr Ptr,
   return UR_RESULT_SUCCESS;
 }
 
+ur_result_t
+ShadowMemoryCPU::EnqueueWriteShadow(ur_queue_handle_t,
+                                    const ShadowPoisonBatch::Write &Write) {
+  if (Write.IsFill()) {
+    memset((void *)Write.ShadowPtr, Write.Value, Write.Size);
+  } else {
+    memcpy((void *)Write.ShadowPtr, Write.Bytes.data(), Write.Size);
+  }
+  return UR_RESULT_SUCCESS;
+}
+
 ur_result_t ShadowMemoryGPU::Setup() {
   // Currently, Level-Zero doesn't create independent VAs for each contexts, if
   // we reserve shadow memory for each contexts, this will cause out-of-resource
@@ -111,11 +155,13 @@ ur_result_t ShadowMemoryGPU::Setup() {
     return Result;
   }
   ShadowEnd = ShadowBegin + ShadowSize;
+  PageSize = GetVirtualMemGranularity(Context, Device);
 
   // Set shadow memory for null pointer
   // For GPU, wu use up to 1 page of shadow memory
-  const size_t NullptrRedzoneSize = GetVirtualMemGranularity(Context, Device)
-                                    << ASAN_SHADOW_SCALE;
+  const size_t NullptrRedzoneSize = PageSize << ASAN_SHADOW_SCALE;
+  // It's never released
+  RetainShadow(0, NullptrRedzoneSize);
   ManagedQueue Queue(Context, Device);
   Result = EnqueuePoisonShadow(Queue, 0, NullptrRedzoneSize,
                                &kNullPointerRedzoneMagic);
@@ -128,6 +174,11 @@ ur_result_t ShadowMemoryGPU::Setup() {
 }
 
 ur_result_t ShadowMemoryGPU::Destory() {
+  {
+    std::scoped_lock<ur_mutex> Guard(InFlightWritesMutex);
+    UR_CALL(ReleaseWritesInFlight(true));
+  }
+
   if (PrivateShadowOffset != 0) {
     UR_CALL(getContext()->urDdiTable.USM.pfnFree(Context,
                                                  (void *)PrivateShadowOffset));
@@ -147,12 +198,14 @@ ur_result_t ShadowMemoryGPU::Destory() {
   }
 
   {
-    const size_t PageSize = GetVirtualMemGranularity(Context, Device);
-    for (auto [MappedPtr, PhysicalMem] : VirtualMemMaps) {
+    for (auto [MappedPtr, Chunk] : VirtualMemMaps) {
       UR_CALL(getContext()->urDdiTable.VirtualMem.pfnUnmap(
-          Context, (void *)MappedPtr, PageSize));
-      UR_CALL(getContext()->urDdiTable.PhysicalMem.pfnRelease(PhysicalMem));
+          Context, (void *)MappedPtr, Chunk.Size));
+      UR_CALL(
+          getContext()->urDdiTable.PhysicalMem.pfnRelease(Chunk.PhysicalMem));
     }
+    VirtualMemMaps.clear();
+    ShadowPageRefs.clear();
     UR_CALL(getContext()->urDdiTable.VirtualMem.pfnFree(
         Context, (const void *)ShadowBegin, GetShadowSize()));
 
@@ -182,67 +235,279 @@ ur_result_t ShadowMemoryGPU::EnqueuePoisonShadow(ur_queue_handle_t Queue,
            (void *)ShadowBegin, ShadowEnd - ShadowBegin + 1,
            (void *)(size_t)*Value);
 
-  // Make sure the shadow memory is mapped to physical memory
-  {
-    static const size_t PageSize = GetVirtualMemGranularity(Context, Device);
-
-    ur_physical_mem_properties_t Desc{UR_STRUCTURE_TYPE_PHYSICAL_MEM_PROPERTIES,
-                                      nullptr, 0};
-
-    // Make sure [Ptr, Ptr + Size] is mapped to physical memory
-    for (auto MappedPtr = RoundDownTo(ShadowBegin, PageSize);
-         MappedPtr <= ShadowEnd; MappedPtr += PageSize) {
-      std::scoped_lock<ur_mutex> Guard(VirtualMemMapsMutex);
-      if (VirtualMemMaps.find(MappedPtr) == VirtualMemMaps.end()) {
-        ur_physical_mem_handle_t PhysicalMem{};
-        auto URes = getContext()->urDdiTable.PhysicalMem.pfnCreate(
-            Context, Device, PageSize, &Desc, &PhysicalMem);
-        if (URes != UR_RESULT_SUCCESS) {
-          UR_LOG_L(getContext()->logger, ERR, "urPhysicalMemCreate(): {}",
-                   URes);
-          return URes;
-        }
+  std::scoped_lock<ur_mutex> Guard(VirtualMemMapsMutex);
 
-        URes = getContext()->urDdiTable.VirtualMem.pfnMap(
-            Context, (void *)MappedPtr, PageSize, PhysicalMem, 0,
-            UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE);
-        if (URes != UR_RESULT_SUCCESS) {
-          UR_LOG_L(getContext()->logger, ERR, "urVirtualMemMap({}, {}): {}",
-                   (void *)MappedPtr, PageSize, URes);
-          return URes;
-        }
+  // Poisons [Begin, End) of the shadow
+  auto EnqueuePoison = [&](uptr Begin, uptr End) {
+    UR_CALL(EnsureShadowMapped(Queue, Begin, End - 1));
 
-        UR_LOG_L(getContext()->logger, DEBUG, "urVirtualMemMap: {} ~ {}",
-                 (void *)MappedPtr, (void *)(MappedPtr + PageSize - 1));
+    auto URes = EnqueueUSMSet(Queue, (void *)Begin, Value, End - Begin);
+    if (URes != UR_RESULT_SUCCESS) {
+      UR_LOG_L(getContext()->logger, ERR,
+               "EnqueuePoisonShadow(addr={}, count={}, value={}): {}",
+               (void *)Begin, End - Begin, (void *)(size_t)*Value, URes);
+      return URes;
+    }
+    return UR_RESULT_SUCCESS;
+  };
 
-        // Initialize to zero
-        URes = EnqueueUSMSetZero(Queue, (void *)MappedPtr, PageSize);
-        if (URes != UR_RESULT_SUCCESS) {
-          UR_LOG_L(getContext()->logger, ERR, "EnqueueUSMBlockingSet(): {}",
-                   URes);
-          return URes;
-        }
+  return ForEachRetainedRun(ShadowBegin, ShadowEnd + 1, EnqueuePoison);
+}
 
-        VirtualMemMaps[MappedPtr] = PhysicalMem;
+ur_result_t ShadowMemoryGPU::EnsureShadowMapped(ur_queue_handle_t Queue,
+                                                uptr ShadowBegin,
+                                                uptr ShadowEnd) {
+  ur_physical_mem_properties_t Desc{UR_STRUCTURE_TYPE_PHYSICAL_MEM_PROPERTIES,
+                                    nullptr, 0};
+
+  const uptr MapBegin = RoundDownTo(ShadowBegin, PageSize);
+  const uptr MapEnd = RoundUpTo(ShadowEnd + 1, PageSize);
+  uptr MappedPtr = MapBegin;
+  while (MappedPtr < MapEnd) {
+    // Skip the chunk mapping MappedPtr, if any
+    auto Next = VirtualMemMaps.upper_bound(MappedPtr);
+    if (Next != VirtualMemMaps.begin()) {
+      auto Prev = std::prev(Next);
+      if (MappedPtr < Prev->first + Prev->second.Size) {
+        MappedPtr = Prev->first + Prev->second.Size;
+        continue;
       }
     }
 
-    ShadowLowerBound =
-        std::min(ShadowLowerBound, RoundDownTo(ShadowBegin, PageSize));
-    ShadowUpperBound =
-        std::max(ShadowUpperBound, RoundUpTo(ShadowEnd, PageSize));
+    // Map the pages up to the next chunk with a new one
+    uptr ChunkEnd = std::min(MapEnd, MappedPtr + kMaxChunkPages * PageSize);
+    if (Next != VirtualMemMaps.end()) {
+      ChunkEnd = std::min(ChunkEnd, Next->first);
+    }
+    const size_t ChunkSize = ChunkEnd - MappedPtr;
+
+    ur_physical_mem_handle_t PhysicalMem{};
+    auto URes = getContext()->urDdiTable.PhysicalMem.pfnCreate(
+        Context, Device, ChunkSize, &Desc, &PhysicalMem);
+    if (URes != UR_RESULT_SUCCESS) {
+      UR_LOG_L(getContext()->logger, ERR, "urPhysicalMemCreate(): {}", URes);
+      return URes;
+    }
+
+    URes = getContext()->urDdiTable.VirtualMem.pfnMap(
+        Context, (void *)MappedPtr, ChunkSize, PhysicalMem, 0,
+        UR_VIRTUAL_MEM_ACCESS_FLAG_READ_WRITE);
+    if (URes != UR_RESULT_SUCCESS) {
+      UR_LOG_L(getContext()->logger, ERR, "urVirtualMemMap({}, {}): {}",
+               (void *)MappedPtr, ChunkSize, URes);
+      getContext()->urDdiTable.PhysicalMem.pfnRelease(PhysicalMem);
+      return URes;
+    }
+
+    UR_LOG_L(getContext()->logger, DEBUG, "urVirtualMemMap: {} ~ {}",
+             (void *)MappedPtr, (void *)(ChunkEnd - 1));
+
+    // Initialize to zero
+    URes = EnqueueUSMSetZero(Queue, (void *)MappedPtr, ChunkSize);
+    if (URes != UR_RESULT_SUCCESS) {
+      UR_LOG_L(getContext()->logger, ERR, "EnqueueUSMBlockingSet(): {}", URes);
+      return URes;
+    }
+
+    VirtualMemMaps[MappedPtr] = ShadowChunk{ChunkSize, PhysicalMem};
+    MappedPtr = ChunkEnd;
+  }
+
+  ShadowLowerBound = std::min(ShadowLowerBound, MapBegin);
+  ShadowUpperBound = std::max(ShadowUpperBound, MapEnd);
+
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t
+ShadowMemoryGPU::EnqueueWriteShadow(ur_queue_handle_t Queue,
+                                    const ShadowPoisonBatch::Write &Write) {
+  std::scoped_lock<ur_mutex> Guard(VirtualMemMapsMutex);
+
+  // Writes [Begin, End) of the shadow of Write
+  auto EnqueueWrite = [&](uptr Begin, uptr End) {
+    UR_CALL(EnsureShadowMapped(Queue, Begin, End - 1));
+
+    ur_result_t URes;
+    if (Write.IsFill()) {
+      URes = EnqueueUSMSet(Queue, (void *)Begin, &Write.Value, End - Begin);
+    } else {
+      URes = getContext()->urDdiTable.Enqueue.pfnUSMMemcpy(
+          Queue, false, (void *)Begin,
+          Write.Bytes.data() + (Begin - Write.ShadowPtr), End - Begin, 0,
+          nullptr, nullptr);
+    }
+    if (URes != UR_RESULT_SUCCESS) {
+      UR_LOG_L(getContext()->logger, ERR,
+               "EnqueueWriteShadow(addr={}, count={}, fill={}): {}",
+               (void *)Begin, End - Begin, Write.IsFill(), URes);
+      return URes;
+    }
+    return UR_RESULT_SUCCESS;
+  };
+
+  return ForEachRetainedRun(Write.ShadowPtr, Write.ShadowPtr + Write.Size,
+                            EnqueueWrite);
+}
+
+ur_result_t ShadowMemoryGPU::ForEachRetainedRun(
+    uptr ShadowBegin, uptr ShadowEnd,
+    const std::function<ur_result_t(uptr, uptr)> &Fn) {
+  if (!getContext()->Options.ReleaseShadow) {
+    return Fn(ShadowBegin, ShadowEnd);
   }
 
-  auto URes = EnqueueUSMSet(Queue, (void *)ShadowBegin, Value,
-                            ShadowEnd - ShadowBegin + 1);
+  // The shadow of allocations that were released is reclaimed, so only the
+  // retained pages are written
+  std::optional<uptr> RunBegin;
+  for (uptr Page = RoundDownTo(ShadowBegin, PageSize); Page < ShadowEnd;
+       Page += PageSize) {
+    const uptr Begin = std::max(Page, ShadowBegin);
+    if (IsShadowPageRetained(Page)) {
+      if (!RunBegin) {
+        RunBegin = Begin;
+      }
+      continue;
+    }
+    if (RunBegin) {
+      UR_CALL(Fn(*RunBegin, Begin));
+      RunBegin.reset();
+    }
+  }
+  if (RunBegin) {
+    UR_CALL(Fn(*RunBegin, ShadowEnd));
+  }
 
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ShadowMemoryGPU::KeepWritesAlive(
+    ur_queue_handle_t Queue, std::vector<ShadowPoisonBatch::Write> &&Writes) {
+  std::scoped_lock<ur_mutex> Guard(InFlightWritesMutex);
+  // The copies of the previous batches are usually done by now
+  UR_CALL(ReleaseWritesInFlight(false));
+
+  ur_event_handle_t Event{};
+  auto URes = getContext()->urDdiTable.Enqueue.pfnEventsWait(Queue, 0, nullptr,
+                                                             &Event);
   if (URes != UR_RESULT_SUCCESS) {
-    UR_LOG_L(getContext()->logger, ERR,
-             "EnqueuePoisonShadow(addr={}, count={}, value={}): {}",
-             (void *)ShadowBegin, ShadowEnd - ShadowBegin + 1,
-             (void *)(size_t)*Value, URes);
+    UR_LOG_L(getContext()->logger, ERR, "urEnqueueEventsWait(): {}", URes);
+    // Without an event, the copies must be done before Writes are freed
+    UR_CALL(getContext()->urDdiTable.Queue.pfnFinish(Queue));
     return URes;
   }
+  InFlightWrites.push_back(WritesInFlight{Event, std::move(Writes)});
+
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ShadowMemoryGPU::ReleaseWritesInFlight(bool Wait) {
+  for (auto It = InFlightWrites.begin(); It != InFlightWrites.end();) {
+    if (Wait) {
+      UR_CALL(getContext()->urDdiTable.Event.pfnWait(1, &It->Event));
+    } else {
+      ur_event_status_t Status = UR_EVENT_STATUS_QUEUED;
+      auto URes = getContext()->urDdiTable.Event.pfnGetInfo(
+          It->Event, UR_EVENT_INFO_COMMAND_EXECUTION_STATUS, sizeof(Status),
+          &Status, nullptr);
+      if (URes != UR_RESULT_SUCCESS || Status != UR_EVENT_STATUS_COMPLETE) {
+        ++It;
+        continue;
+      }
+    }
+    UR_CALL(getContext()->urDdiTable.Event.pfnRelease(It->Event));
+    It = InFlightWrites.erase(It);
+  }
+
+  return UR_RESULT_SUCCESS;
+}
+
+void ShadowMemoryGPU::RetainShadow(uptr Ptr, uptr Size) {
+  if (!getContext()->Options.ReleaseShadow || Size == 0) {
+    return;
+  }
+
+  const uptr ShadowBegin = MemToShadow(Ptr);
+  const uptr ShadowEnd = MemToShadow(Ptr + Size - 1);
+
+  std::scoped_lock<ur_mutex> Guard(VirtualMemMapsMutex);
+  for (uptr Page = RoundDownTo(ShadowBegin, PageSize); Page <= ShadowEnd;
+       Page += PageSize) {
+    ShadowPageRefs[Page]++;
+  }
+}
+
+ur_result_t ShadowMemoryGPU::ReleaseShadow(
+    const std::vector<std::pair<uptr, uptr>> &Ranges) {
+  if (!getContext()->Options.ReleaseShadow) {
+    return UR_RESULT_SUCCESS;
+  }
+
+  std::scoped_lock<ur_mutex> Guard(VirtualMemMapsMutex);
+
+  for (auto [Ptr, Size] : Ranges) {
+    if (Size == 0) {
+      continue;
+    }
+    const uptr ShadowBegin = MemToShadow(Ptr);
+    const uptr ShadowEnd = MemToShadow(Ptr + Size - 1);
+
+    // Reclaims each run of pages that are unreferenced now, rather than the
+    // shadow between the ranges too
+    std::optional<uptr> RunBegin;
+    for (uptr Page = RoundDownTo(ShadowBegin, PageSize); Page <= ShadowEnd;
+         Page += PageSize) {
+      auto It = ShadowPageRefs.find(Page);
+      assert(It != ShadowPageRefs.end() && "Shadow page isn't retained");
+      if (It != ShadowPageRefs.end() && --It->second == 0) {
+        ShadowPageRefs.erase(It);
+        if (!RunBegin) {
+          RunBegin = Page;
+        }
+        continue;
+      }
+      if (RunBegin) {
+        UR_CALL(ReclaimShadow(*RunBegin, Page - 1));
+        RunBegin.reset();
+      }
+    }
+    if (RunBegin) {
+      UR_CALL(ReclaimShadow(*RunBegin, RoundUpTo(ShadowEnd + 1, PageSize) - 1));
+    }
+  }
+
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t ShadowMemoryGPU::ReclaimShadow(uptr ShadowBegin, uptr ShadowEnd) {
+  // The first chunk overlapping ShadowBegin, if any
+  auto It = VirtualMemMaps.upper_bound(ShadowBegin);
+  if (It != VirtualMemMaps.begin()) {
+    It = std::prev(It);
+  }
+
+  while (It != VirtualMemMaps.end() && It->first <= ShadowEnd) {
+    const auto [MappedPtr, Chunk] = *It;
+    bool IsRetained = false;
+    for (uptr Page = MappedPtr; Page < MappedPtr + Chunk.Size;
+         Page += PageSize) {
+      if (IsShadowPageRetained(Page)) {
+        IsRetained = true;
+        break;
+      }
+    }
+    if (IsRetained || MappedPtr + Chunk.Size <= ShadowBegin) {
+      ++It;
+      continue;
+    }
+
+    UR_LOG_L(getContext()->logger, DEBUG, "urVirtualMemUnmap: {} ~ {}",
+             (void *)MappedPtr, (void *)(MappedPtr + Chunk.Size - 1));
+    UR_CALL(getContext()->urDdiTable.VirtualMem.pfnUnmap(
+        Context, (void *)MappedPtr, Chunk.Size));
+    UR_CALL(getContext()->urDdiTable.PhysicalMem.pfnRelease(Chunk.PhysicalMem));
+    It = VirtualMemMaps.erase(It);
+  }
 
   return UR_RESULT_SUCCESS;
 }
@@ -14,8 +14,13 @@
 
 #include "sanitizer_common/sanitizer_common.hpp"
 #include "sanitizer_common/sanitizer_libdevice.hpp"
+#include "sanitizer_common/sanitizer_shadow_batch.hpp"
 #include "ur_sanitizer_layer.hpp"
 
+#include <functional>
+#include <map>
+#include <unordered_map>
+
 namespace ur_sanitizer_layer {
 namespace asan {
 
@@ -49,8 +54,45 @@ struct ShadowMemory {
   virtual ur_result_t EnqueuePoisonShadow(ur_queue_handle_t Queue, uptr Ptr,
                                           uptr Size, const int8_t *Value) = 0;
 
+  /// Adds the poisoning of [Ptr, Ptr + Size) with Value to Batch
+  void PoisonShadow(ShadowPoisonBatch &Batch, uptr Ptr, uptr Size,
+                    int8_t Value) {
+    if (Size == 0) {
+      return;
+    }
+    Batch.Poison(MemToShadow(Ptr), MemToShadow(Ptr + Size - 1) + 1, Value);
+  }
+
+  /// Writes the shadow values of Batch, with one operation per contiguous
+  /// span of shadow memory rather than one per poisoned range
+  ur_result_t EnqueuePoisonShadowBatch(ur_queue_handle_t Queue,
+                                       const ShadowPoisonBatch &Batch);
+
   virtual size_t GetShadowSize() = 0;
 
+  virtual ur_result_t
+  EnqueueWriteShadow(ur_queue_handle_t Queue,
+                     const ShadowPoisonBatch::Write &Write) = 0;
+
+  /// Keeps Writes, whose copies were enqueued on Queue, until the copies are
+  /// done. The writes of the host shadow are done once they're enqueued.
+  virtual ur_result_t
+  KeepWritesAlive(ur_queue_handle_t,
+                  std::vector<ShadowPoisonBatch::Write> &&) {
+    return UR_RESULT_SUCCESS;
+  }
+
+  /// Keeps the shadow of [Ptr, Ptr + Size) until it's released, for shadow
+  /// memory that can be reclaimed
+  virtual void RetainShadow(uptr, uptr) {}
+
+  /// Releases the shadow of each [Ptr, Ptr + Size) in Ranges, and reclaims the
+  /// shadow memory that no allocation keeps anymore
+  virtual ur_result_t
+  ReleaseShadow(const std::vector<std::pair<uptr, uptr>> &) {
+    return UR_RESULT_SUCCESS;
+  }
+
   virtual ur_result_t AllocLocalShadow(ur_queue_handle_t Queue, uint32_t NumWG,
                                        uptr &Begin, uptr &End) = 0;
 
@@ -81,6 +123,10 @@ struct ShadowMemoryCPU final : public ShadowMemory {
   ur_result_t EnqueuePoisonShadow(ur_queue_handle_t Queue, uptr Ptr, uptr Size,
                                   const int8_t *Value) override;
 
+  ur_result_t
+  EnqueueWriteShadow(ur_queue_handle_t Queue,
+                     const ShadowPoisonBatch::Write &Write) override;
+
   size_t GetShadowSize() override { return 0x80000000000ULL; }
 
   ur_result_t AllocLocalShadow(ur_queue_handle_t, uint32_t, uptr &Begin,
@@ -107,6 +153,19 @@ struct ShadowMemoryGPU : public ShadowMemory {
   ur_result_t EnqueuePoisonShadow(ur_queue_handle_t Queue, uptr Ptr, uptr Size,
                                   const int8_t *Value) override final;
 
+  ur_result_t
+  EnqueueWriteShadow(ur_queue_handle_t Queue,
+                     const ShadowPoisonBatch::Write &Write) override final;
+
+  ur_result_t KeepWritesAlive(
+      ur_queue_handle_t Queue,
+      std::vector<ShadowPoisonBatch::Write> &&Writes) override final;
+
+  void RetainShadow(uptr Ptr, uptr Size) override final;
+
+  ur_result_t ReleaseShadow(
+      const std::vector<std::pair<uptr, uptr>> &Ranges) override final;
+
   ur_result_t AllocLocalShadow(ur_queue_handle_t Queue, uint32_t NumWG,
                                uptr &Begin, uptr &End) override final;
 
@@ -114,9 +173,61 @@ struct ShadowMemoryGPU : public ShadowMemory {
                                  uptr *&Base, uptr &Begin,
                                  uptr &End) override final;
 
+  /// Maps the pages of [ShadowBegin, ShadowEnd] to physical memory, with
+  /// one chunk of physical memory per run of unmapped pages. Must be called
+  /// with VirtualMemMapsMutex held.
+  ur_result_t EnsureShadowMapped(ur_queue_handle_t Queue, uptr ShadowBegin,
+                                 uptr ShadowEnd);
+
+  /// Calls Fn with each run [Begin, End) of [ShadowBegin, ShadowEnd) in
+  /// retained pages, or with all of it without the "release_shadow" option.
+  /// Must be called with VirtualMemMapsMutex held.
+  ur_result_t
+  ForEachRetainedRun(uptr ShadowBegin, uptr ShadowEnd,
+                     const std::function<ur_result_t(uptr, uptr)> &Fn);
+
+  /// Unmaps the chunks overlapping [ShadowBegin, ShadowEnd] whose pages are
+  /// all unreferenced. Must be called with VirtualMemMapsMutex held.
+  ur_result_t ReclaimShadow(uptr ShadowBegin, uptr ShadowEnd);
+
+  /// Releases the writes whose copies are done, or waits for all of them if
+  /// Wait is set. Must be called with InFlightWritesMutex held.
+  ur_result_t ReleaseWritesInFlight(bool Wait);
+
+  bool IsShadowPageRetained(uptr Page) const {
+    return ShadowPageRefs.find(Page) != ShadowPageRefs.end();
+  }
+
+  /// The most pages mapped with one chunk of physical memory, so that the
+  /// chunks of freed allocations can be reclaimed
+  static constexpr size_t kMaxChunkPages = 64;
+
+  struct ShadowChunk {
+    size_t Size;
+    ur_physical_mem_handle_t PhysicalMem;
+  };
+
+  size_t PageSize = 0;
+
   ur_mutex VirtualMemMapsMutex;
 
-  std::unordered_map<uptr, ur_physical_mem_handle_t> VirtualMemMaps;
+  /// The mapped chunks of shadow memory, by their beginning
+  std::map<uptr, ShadowChunk> VirtualMemMaps;
+
+  /// The number of allocations keeping each page of shadow memory, only
+  /// tracked with the "release_shadow" option
+  std::unordered_map<uptr, size_t> ShadowPageRefs;
+
+  /// Writes whose copies may still be running, with the event of a marker
+  /// enqueued after the copies
+  struct WritesInFlight {
+    ur_event_handle_t Event;
+    std::vector<ShadowPoisonBatch::Write> Writes;
+  };
+
+  ur_mutex InFlightWritesMutex;
+
+  std::vector<WritesInFlight> InFlightWrites;
 
   uptr LocalShadowOffset = 0;
 
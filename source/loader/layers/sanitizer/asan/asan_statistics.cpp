@@ -24,6 +24,8 @@ struct AsanStats {
   void UpdateUSMFreed(uptr FreedSize);
   void UpdateUSMRealFreed(uptr FreedSize, uptr RedzoneSize);
 
+  void UpdateQuarantineEvicted(uptr EvictedCount, uptr EvictedSize);
+
   void UpdateShadowMmaped(uptr ShadowSize);
   void UpdateShadowMalloced(uptr ShadowSize);
   void UpdateShadowFreed(uptr ShadowSize);
@@ -37,6 +39,11 @@ private:
   // Quarantined memory
   std::atomic<uptr> UsmFreed;
 
+  // Evicted from quarantine, in batches
+  std::atomic<uptr> QuarantineEvictions = 0;
+  std::atomic<uptr> QuarantineEvictedCount = 0;
+  std::atomic<uptr> QuarantineEvictedSize = 0;
+
   std::atomic<uptr> ShadowMalloced;
 
   double Overhead = 0.0;
@@ -48,6 +55,12 @@ void AsanStats::Print(ur_context_handle_t Context) {
   UR_LOG_L(getContext()->logger, QUIET, "Stats: Context {}", (void *)Context);
   UR_LOG_L(getContext()->logger, QUIET, "Stats:   peak memory overhead: {}%",
            Overhead * 100);
+  if (getContext()->Options.MaxQuarantineSizeMB) {
+    UR_LOG_L(getContext()->logger, QUIET,
+             "Stats:   quarantine evictions: {} ({} allocations, {} bytes)",
+             QuarantineEvictions, QuarantineEvictedCount,
+             QuarantineEvictedSize);
+  }
 }
 
 void AsanStats::UpdateUSMMalloced(uptr MallocedSize, uptr RedzoneSize) {
@@ -77,6 +90,16 @@ void AsanStats::UpdateUSMRealFreed(uptr FreedSize, uptr RedzoneSize) {
   UpdateOverhead();
 }
 
+void AsanStats::UpdateQuarantineEvicted(uptr EvictedCount, uptr EvictedSize) {
+  QuarantineEvictions++;
+  QuarantineEvictedCount += EvictedCount;
+  QuarantineEvictedSize += EvictedSize;
+  UR_LOG_L(getContext()->logger, DEBUG,
+           "Stats: UpdateQuarantineEvicted(QuarantineEvictions={}, "
+           "QuarantineEvictedCount={}, QuarantineEvictedSize={})",
+           QuarantineEvictions, QuarantineEvictedCount, QuarantineEvictedSize);
+}
+
 void AsanStats::UpdateShadowMalloced(uptr ShadowSize) {
   ShadowMalloced += ShadowSize;
   UR_LOG_L(getContext()->logger, DEBUG,
@@ -120,6 +143,13 @@ void AsanStatsWrapper::UpdateUSMRealFreed(uptr FreedSize, uptr RedzoneSize) {
   }
 }
 
+void AsanStatsWrapper::UpdateQuarantineEvicted(uptr EvictedCount,
+                                               uptr EvictedSize) {
+  if (Stat) {
+    Stat->UpdateQuarantineEvicted(EvictedCount, EvictedSize);
+  }
+}
+
 void AsanStatsWrapper::UpdateShadowMalloced(uptr ShadowSize) {
   if (Stat) {
     Stat->UpdateShadowMalloced(ShadowSize);
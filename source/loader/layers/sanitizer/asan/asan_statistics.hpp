@@ -28,6 +28,8 @@ struct AsanStatsWrapper {
   void UpdateUSMFreed(uptr FreedSize);
   void UpdateUSMRealFreed(uptr FreedSize, uptr RedzoneSize);
 
+  void UpdateQuarantineEvicted(uptr EvictedCount, uptr EvictedSize);
+
   void UpdateShadowMalloced(uptr ShadowSize);
   void UpdateShadowFreed(uptr ShadowSize);
 
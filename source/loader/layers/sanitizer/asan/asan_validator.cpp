@@ -40,8 +40,8 @@ ValidateUSMResult ValidateUSMPointer(ur_kernel_handle_t Kernel,
                                      ur_device_handle_t Device, uptr Ptr) {
   assert(Ptr != 0 && "Don't validate nullptr here");
 
-  auto AllocInfoItOp = getAsanInterceptor()->findAllocInfoByAddress(Ptr);
-  if (!AllocInfoItOp) {
+  auto AllocInfo = getAsanInterceptor()->findAllocInfoByAddress(Ptr);
+  if (!AllocInfo) {
     auto DI = getAsanInterceptor()->getDeviceInfo(Device);
     bool IsSupportSharedSystemUSM = DI->IsSupportSharedSystemUSM;
     if (IsSupportSharedSystemUSM) {
@@ -51,8 +51,6 @@ ValidateUSMResult ValidateUSMPointer(ur_kernel_handle_t Kernel,
     return ValidateUSMResult::fail(ValidateUSMResult::MAYBE_HOST_POINTER);
   }
 
-  auto AllocInfo = AllocInfoItOp.value()->second;
-
   auto &KI = getAsanInterceptor()->getOrCreateKernelInfo(Kernel);
   if (!KI.IsIndirectAccess && AllocInfo->Context != Context) {
     return ValidateUSMResult::fail(ValidateUSMResult::BAD_CONTEXT, AllocInfo);
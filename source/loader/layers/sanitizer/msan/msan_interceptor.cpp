@@ -115,10 +115,10 @@ ur_result_t MsanInterceptor::allocateMemory(ur_context_handle_t Context,
     return UR_RESULT_ERROR_UNKNOWN;
   }
 
-  StackTrace Stack = GetCurrentBacktrace();
-  Origin HeapOrigin = DontCheckHostOrSharedUSM
-                          ? Origin::FromRawId(0)
-                          : Origin::CreateHeapOrigin(Stack, HeapType);
+  Origin HeapOrigin =
+      DontCheckHostOrSharedUSM
+          ? Origin::FromRawId(0)
+          : Origin::CreateHeapOrigin(GetCurrentBacktraceId(), HeapType);
 
   // Update shadow memory
   auto EnqueuePoison = [&](const std::vector<ur_device_handle_t> &Devices) {
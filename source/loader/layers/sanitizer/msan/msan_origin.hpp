@@ -145,13 +145,11 @@ public:
 
   StackTrace getHeapStackTrace() const {
     assert(isHeapOrigin());
-    return StackDepotGet(raw_id_);
+    return StackDepotGet(getHeapId());
   }
 
-  static Origin CreateHeapOrigin(StackTrace &Stack, HeapType Type) {
-    static std::array<std::atomic_uint32_t, kHeapTypeCount> _NextIds;
-    uint32_t StackId = _NextIds[(uint32_t)Type].fetch_add(1);
-
+  // StackId is the id of the allocation stack in the stack depot
+  static Origin CreateHeapOrigin(uint32_t StackId, HeapType Type) {
     switch (Type) {
     case HeapType::DeviceUSM:
       assert((StackId & kDeviceUSMIdMask) == StackId);
@@ -178,8 +176,6 @@ public:
       StackId = 0;
     }
 
-    StackDepotPut(StackId, Stack);
-
     return Origin(StackId);
   }
 
@@ -9,6 +9,7 @@
  * @file backtrace.cpp
  *
  */
+#include "sanitizer_common/sanitizer_stackdepot.hpp"
 #include "sanitizer_common/sanitizer_stacktrace.hpp"
 
 #include <execinfo.h>
@@ -17,8 +18,9 @@
 
 namespace ur_sanitizer_layer {
 
-StackTrace GetCurrentBacktrace() {
-  BacktraceFrame Frames[MAX_BACKTRACE_FRAMES];
+namespace {
+
+int CaptureBacktrace(BacktraceFrame (&Frames)[MAX_BACKTRACE_FRAMES]) {
   int FrameCount = backtrace(Frames, MAX_BACKTRACE_FRAMES);
 
   // The Frames contain the return addresses, which is one instruction after the
@@ -28,12 +30,28 @@ StackTrace GetCurrentBacktrace() {
     Frames[I] = (void *)((uintptr_t)Frames[I] - 1);
   }
 
+  return FrameCount;
+}
+
+} // namespace
+
+StackTrace GetCurrentBacktrace() {
+  BacktraceFrame Frames[MAX_BACKTRACE_FRAMES];
+  int FrameCount = CaptureBacktrace(Frames);
+
   StackTrace Stack;
   Stack.stack = std::vector<BacktraceFrame>(&Frames[0], &Frames[FrameCount]);
 
   return Stack;
 }
 
+uint32_t GetCurrentBacktraceId() {
+  BacktraceFrame Frames[MAX_BACKTRACE_FRAMES];
+  int FrameCount = CaptureBacktrace(Frames);
+
+  return StackDepotPut(Frames, FrameCount);
+}
+
 char **GetBacktraceSymbols(const std::vector<BacktraceFrame> &BacktraceFrames) {
   assert(!BacktraceFrames.empty());
 
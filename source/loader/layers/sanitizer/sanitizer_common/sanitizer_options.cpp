@@ -28,7 +28,7 @@ void SanitizerOptions::Init(const std::string &EnvName,
     std::stringstream SS;
     SS << "<SANITIZER>[ERROR]: ";
     SS << e.what();
-    UR_LOG_L(Logger, QUIET, SS.str().c_str());
+    UR_LOG_L(Logger, QUIET, "{}", SS.str());
     die("Sanitizer failed to parse options.\n");
   }
 
@@ -47,6 +47,7 @@ void SanitizerOptions::Init(const std::string &EnvName,
   Parser.ParseBool("halt_on_error", HaltOnError);
   Parser.ParseBool("recover", Recover);
   Parser.ParseBool("msan_check_host_and_shared_usm", MsanCheckHostAndSharedUSM);
+  Parser.ParseBool("release_shadow", ReleaseShadow);
 
   Parser.ParseUint64("quarantine_size_mb", MaxQuarantineSizeMB, 0, UINT32_MAX);
   Parser.ParseUint64("redzone", MinRZSize, 16);
@@ -32,6 +32,7 @@ struct SanitizerOptions {
   bool HaltOnError = true;
   bool Recover = false;
   bool MsanCheckHostAndSharedUSM = true;
+  bool ReleaseShadow = false;
 
   void Init(const std::string &EnvName, logger::Logger &Logger);
 };
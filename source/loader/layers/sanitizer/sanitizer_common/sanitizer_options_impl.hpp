@@ -71,7 +71,7 @@ struct OptionParser {
           SS << " \"" << S << "\"";
         }
         SS << ".";
-        UR_LOG_L(Logger, ERR, SS.str().c_str());
+        UR_LOG_L(Logger, ERR, "{}", SS.str());
         die("Sanitizer failed to parse options.\n");
       }
     }
@@ -0,0 +1,83 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file sanitizer_shadow_batch.cpp
+ *
+ */
+
+#include "sanitizer_shadow_batch.hpp"
+
+#include <iterator>
+
+namespace ur_sanitizer_layer {
+
+void ShadowPoisonBatch::Poison(uptr ShadowBegin, uptr ShadowEnd,
+                               int8_t Value) {
+  if (ShadowBegin >= ShadowEnd) {
+    return;
+  }
+
+  auto It = Spans.lower_bound(ShadowBegin);
+
+  // A span beginning before ShadowBegin keeps its head, and its tail if it
+  // extends past ShadowEnd
+  if (It != Spans.begin()) {
+    auto Prev = std::prev(It);
+    auto [PrevEnd, PrevValue] = Prev->second;
+    if (PrevEnd > ShadowBegin) {
+      Prev->second.End = ShadowBegin;
+      if (PrevEnd > ShadowEnd) {
+        Spans.emplace(ShadowEnd, Span{PrevEnd, PrevValue});
+      }
+    }
+  }
+
+  // Spans beginning within [ShadowBegin, ShadowEnd) only keep their tail
+  while (It != Spans.end() && It->first < ShadowEnd) {
+    auto [ItEnd, ItValue] = It->second;
+    It = Spans.erase(It);
+    if (ItEnd > ShadowEnd) {
+      Spans.emplace(ShadowEnd, Span{ItEnd, ItValue});
+      break;
+    }
+  }
+
+  Spans[ShadowBegin] = Span{ShadowEnd, Value};
+}
+
+std::vector<ShadowPoisonBatch::Write> ShadowPoisonBatch::GetWrites() const {
+  std::vector<Write> Writes;
+
+  for (const auto &[Begin, Span] : Spans) {
+    const uptr Size = Span.End - Begin;
+    Write *Last = Writes.empty() ? nullptr : &Writes.back();
+    const bool Adjacent = Last && Last->ShadowPtr + Last->Size == Begin;
+
+    if (Adjacent && Last->IsFill() && Last->Value == Span.Value) {
+      Last->Size += Size;
+      continue;
+    }
+
+    if (!Adjacent || Size >= MinFillSize ||
+        (Last->IsFill() && Last->Size >= MinFillSize)) {
+      Writes.push_back(Write{Begin, Size, Span.Value, {}});
+      continue;
+    }
+
+    // A short span next to a short write: copy them together
+    if (Last->IsFill()) {
+      Last->Bytes.assign(Last->Size, Last->Value);
+    }
+    Last->Bytes.insert(Last->Bytes.end(), Size, Span.Value);
+    Last->Size += Size;
+  }
+
+  return Writes;
+}
+
+} // namespace ur_sanitizer_layer
@@ -0,0 +1,62 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file sanitizer_shadow_batch.hpp
+ *
+ */
+
+#pragma once
+
+#include "sanitizer_common.hpp"
+
+#include <map>
+#include <vector>
+
+namespace ur_sanitizer_layer {
+
+/// Shadow values set by a sequence of poisoning operations, merged so that
+/// they can be written to the shadow memory with few operations. Where the
+/// ranges of the operations overlap, the later operations win, as they would
+/// if each operation was enqueued on its own.
+class ShadowPoisonBatch {
+public:
+  /// A write of Size bytes of shadow memory at ShadowPtr: a fill with Value if
+  /// Bytes is empty, or else a copy of Bytes.
+  struct Write {
+    uptr ShadowPtr;
+    uptr Size;
+    int8_t Value;
+    std::vector<int8_t> Bytes;
+
+    bool IsFill() const { return Bytes.empty(); }
+  };
+
+  /// Constant spans of at least this many bytes of shadow get a fill of their
+  /// own, while shorter neighbouring spans are copied together.
+  static constexpr uptr MinFillSize = 4096;
+
+  /// Sets the shadow bytes in [ShadowBegin, ShadowEnd) to Value.
+  void Poison(uptr ShadowBegin, uptr ShadowEnd, int8_t Value);
+
+  bool Empty() const { return Spans.empty(); }
+
+  /// Returns the writes that set the shadow bytes of the batch, in address
+  /// order.
+  std::vector<Write> GetWrites() const;
+
+private:
+  struct Span {
+    uptr End;
+    int8_t Value;
+  };
+
+  // Disjoint spans of constant shadow, by their beginning
+  std::map<uptr, Span> Spans;
+};
+
+} // namespace ur_sanitizer_layer
@@ -11,37 +11,20 @@
  */
 
 #include "sanitizer_stackdepot.hpp"
-
-#include <unordered_map>
+#include "ur_stack_depot.hpp"
 
 namespace ur_sanitizer_layer {
 
-class StackDepot {
-public:
-  uint32_t Put(uint32_t Id, StackTrace Stack) {
-    std::scoped_lock<ur_shared_mutex> Guard(_Mutex);
-    _Depot[Id] = Stack;
-    return Id;
-  }
-
-  StackTrace Get(uint32_t Id) {
-    std::shared_lock<ur_shared_mutex> Guard(_Mutex);
-    auto It = _Depot.find(Id);
-    if (It != _Depot.end()) {
-      return It->second;
-    }
-    return StackTrace();
-  }
-
-private:
-  ur_shared_mutex _Mutex;
-  std::unordered_map<uint32_t, StackTrace> _Depot;
-};
+static ur::StackDepot TheDepot;
 
-static StackDepot TheDepot;
+uint32_t StackDepotPut(const BacktraceFrame *Frames, size_t Size) {
+  return TheDepot.put(Frames, Size);
+}
 
-void StackDepotPut(uint32_t Id, StackTrace &Stack) { TheDepot.Put(Id, Stack); }
+uint32_t StackDepotPut(const StackTrace &Stack) {
+  return TheDepot.put(Stack.stack.data(), Stack.stack.size());
+}
 
-StackTrace StackDepotGet(uint32_t Id) { return TheDepot.Get(Id); }
+StackTrace StackDepotGet(uint32_t Id) { return StackTrace{TheDepot.get(Id)}; }
 
 } // namespace ur_sanitizer_layer
@@ -36,8 +36,15 @@ inline const char *ToString(HeapType Type) {
   }
 }
 
-// Save/load stack with corresponding stack id
-void StackDepotPut(uint32_t Id, StackTrace &Stack);
+// Saves the stack in the stack depot and returns its id, which is never 0.
+// A stack is saved only once, so saving it again returns the same id.
+uint32_t StackDepotPut(const BacktraceFrame *Frames, size_t Size);
+uint32_t StackDepotPut(const StackTrace &Stack);
+
+// Loads the stack of Id, which is empty if Id is unknown
 StackTrace StackDepotGet(uint32_t Id);
 
+// Saves the current backtrace in the stack depot and returns its id
+uint32_t GetCurrentBacktraceId();
+
 } // namespace ur_sanitizer_layer
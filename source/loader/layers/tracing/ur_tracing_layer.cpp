@@ -14,10 +14,13 @@
 #include "ur_util.hpp"
 #include "xpti/xpti_data_types.h"
 #include "xpti/xpti_trace_framework.h"
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <optional>
 #include <sstream>
+#include <string>
+#include <unordered_map>
 
 namespace ur_tracing_layer {
 context_t *getContext() { return context_t::get_direct(); }
@@ -57,6 +60,38 @@ static std::shared_ptr<XptiContextManager> xptiContextManagerGet() {
 static xpti_td *GURCallEvent = nullptr;
 static thread_local xpti_td *activeEvent;
 
+// Tracepoints of the debug stream, by code location. Creating a tracepoint
+// hashes its payload in the XPTI framework, so this is done once per code
+// location and thread.
+static thread_local std::unordered_map<std::string, xpti_td *> codelocEvents;
+
+static constexpr auto OPTIONS_ENV_VAR = "UR_LAYER_TRACING_OPTIONS";
+
+// Whether name matches pattern, in which '*' matches any sequence of
+// characters.
+static bool matchPattern(const char *pattern, const char *name) {
+  const char *star = nullptr;
+  const char *backtrack = nullptr;
+  while (*name) {
+    if (*pattern == '*') {
+      star = pattern++;
+      backtrack = name;
+    } else if (*pattern == *name) {
+      pattern++;
+      name++;
+    } else if (star) {
+      pattern = star + 1;
+      name = ++backtrack;
+    } else {
+      return false;
+    }
+  }
+  while (*pattern == '*') {
+    pattern++;
+  }
+  return *pattern == '\0';
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 context_t::context_t() : logger(logger::create_logger("tracing", true, true)) {
   this->xptiContextManager = xptiContextManagerGet();
@@ -90,16 +125,137 @@ void context_t::notify(uint16_t trace_type, uint32_t id, const char *name,
   }
 }
 
+void context_t::initFunctionFilter() {
+  includedFunctions.clear();
+  excludedFunctions.clear();
+  sampleInterval = 1;
+  samples.reset();
+
+  std::optional<EnvVarMap> options;
+  try {
+    options = getenv_to_map(OPTIONS_ENV_VAR);
+  } catch (std::invalid_argument &e) {
+    UR_LOG_L(logger, ERR, "{}, all functions are traced\n", e.what());
+    return;
+  }
+  if (!options.has_value()) {
+    return;
+  }
+
+  for (auto &[key, values] : *options) {
+    if (key == "include") {
+      includedFunctions = values;
+    } else if (key == "exclude") {
+      excludedFunctions = values;
+    } else if (key == "sample") {
+      try {
+        sampleInterval = std::stoull(values.front());
+      } catch (std::exception &) {
+        sampleInterval = 0;
+      }
+      if (values.size() != 1 || sampleInterval == 0) {
+        UR_LOG_L(logger, ERR,
+                 "invalid {} sample interval, all calls are traced\n",
+                 OPTIONS_ENV_VAR);
+        sampleInterval = 1;
+      }
+    } else {
+      UR_LOG_L(logger, WARN, "unknown {} option: {}\n", OPTIONS_ENV_VAR, key);
+    }
+  }
+
+  if (sampleInterval > 1) {
+    samples = std::make_unique<function_samples[]>(FUNCTION_ID_LIMIT);
+  }
+}
+
+bool context_t::isTraced(const char *functionName) const {
+  auto matches = [functionName](const std::string &pattern) {
+    return matchPattern(pattern.c_str(), functionName);
+  };
+  if (!includedFunctions.empty() &&
+      std::none_of(includedFunctions.begin(), includedFunctions.end(),
+                   matches)) {
+    return false;
+  }
+  return std::none_of(excludedFunctions.begin(), excludedFunctions.end(),
+                      matches);
+}
+
+uint64_t context_t::getSkippedCalls(uint32_t id) const {
+  if (!samples || id >= FUNCTION_ID_LIMIT) {
+    return 0;
+  }
+  return samples[id].skipped.load(std::memory_order_relaxed);
+}
+
+bool context_t::sampled(uint32_t id, const char *name) {
+  if (id >= FUNCTION_ID_LIMIT) {
+    return true;
+  }
+  auto &function = samples[id];
+  // The counters are only statistics, so relaxed ordering is enough.
+  auto call = function.calls.fetch_add(1, std::memory_order_relaxed);
+  if (call % sampleInterval == 0) {
+    return true;
+  }
+  function.name.store(name, std::memory_order_relaxed);
+  function.skipped.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+void context_t::reportSkippedCalls() {
+  if (!samples) {
+    return;
+  }
+  for (uint32_t id = 0; id < FUNCTION_ID_LIMIT; id++) {
+    auto &function = samples[id];
+    auto skipped = function.skipped.exchange(0, std::memory_order_relaxed);
+    if (skipped > 0) {
+      UR_LOG_L(logger, INFO, "{}: {} of {} calls not sampled\n",
+               function.name.load(std::memory_order_relaxed), skipped,
+               function.calls.exchange(0, std::memory_order_relaxed));
+    }
+  }
+}
+
+ur_result_t context_t::tearDown() {
+  reportSkippedCalls();
+  return UR_RESULT_SUCCESS;
+}
+
 uint64_t context_t::notify_begin(uint32_t id, const char *name, void *args) {
+  // Calls that are not sampled are dropped before any XPTI work is done.
+  if (samples && !sampled(id, name)) {
+    return UINT64_MAX;
+  }
+
   if (xptiCheckTraceEnabled(debug_call_stream_id)) {
-    // Create a new tracepoint with code location info for each UR API call.
-    // This adds significant overhead to the tracing toolchain, so do this only
-    // if there are debug stream subscribers.
+    // Use a tracepoint with code location info for each UR API call. This
+    // adds significant overhead to the tracing toolchain, so do this only if
+    // there are debug stream subscribers.
     if (auto loc = codelocData.get_codeloc()) {
-      xpti_tracepoint_t *Event = xptiCreateTracepoint(
-          loc->functionName, loc->sourceFile, loc->lineNumber,
-          loc->columnNumber, (void *)this);
-      activeEvent = Event ? Event->event_ref() : nullptr;
+      // The buffer of the key is reused, so that finding the tracepoint of a
+      // code location seen before doesn't allocate.
+      static thread_local std::string key;
+      key.assign(loc->functionName ? loc->functionName : "");
+      key.push_back('\0');
+      key.append(loc->sourceFile ? loc->sourceFile : "");
+      key.push_back('\0');
+      key.append(reinterpret_cast<const char *>(&loc->lineNumber),
+                 sizeof(loc->lineNumber));
+      key.append(reinterpret_cast<const char *>(&loc->columnNumber),
+                 sizeof(loc->columnNumber));
+
+      auto it = codelocEvents.find(key);
+      if (it == codelocEvents.end()) {
+        xpti_tracepoint_t *Event = xptiCreateTracepoint(
+            loc->functionName, loc->sourceFile, loc->lineNumber,
+            loc->columnNumber, (void *)this);
+        xpti_td *event = Event ? Event->event_ref() : nullptr;
+        it = codelocEvents.emplace(key, event).first;
+      }
+      activeEvent = it->second;
     }
   } else if (xptiCheckTraceEnabled(call_stream_id)) {
     // Otherwise use global event for all UR API calls.
@@ -19,6 +19,9 @@
 #include "ur_proxy_layer.hpp"
 #include "ur_util.hpp"
 
+#include <atomic>
+#include <memory>
+
 #define TRACING_COMP_NAME "tracing layer"
 
 namespace ur_tracing_layer {
@@ -39,12 +42,31 @@ public:
   ur_result_t init(ur_dditable_t *dditable,
                    const std::set<std::string> &enabledLayerNames,
                    codeloc_data codelocData) override;
-  ur_result_t tearDown() override { return UR_RESULT_SUCCESS; }
+  ur_result_t tearDown() override;
   uint64_t notify_begin(uint32_t id, const char *name, void *args);
   void notify_end(uint32_t id, const char *name, void *args,
                   ur_result_t *resultp, uint64_t instance);
 
+  // Reads the functions to trace, and how often their calls are sampled,
+  // from UR_LAYER_TRACING_OPTIONS.
+  void initFunctionFilter();
+  // Whether calls to the function go through the tracing layer.
+  bool isTraced(const char *functionName) const;
+  // The number of calls to the function that were not sampled.
+  uint64_t getSkippedCalls(uint32_t id) const;
+
+  // One past the highest function id, defined in the generated ur_trcddi.cpp.
+  static const uint32_t FUNCTION_ID_LIMIT;
+
 private:
+  struct function_samples {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> skipped{0};
+    std::atomic<const char *> name{nullptr};
+  };
+
+  bool sampled(uint32_t id, const char *name);
+  void reportSkippedCalls();
   void notify(uint16_t trace_type, uint32_t id, const char *name, void *args,
               ur_result_t *resultp, uint64_t instance);
   uint8_t call_stream_id;
@@ -52,6 +74,16 @@ private:
 
   inline static const std::string name = "UR_LAYER_TRACING";
 
+  // Patterns of the function names to trace and not to trace, in which '*'
+  // matches any sequence of characters.
+  std::vector<std::string> includedFunctions;
+  std::vector<std::string> excludedFunctions;
+
+  // One call in sampleInterval to each function is notified to XPTI.
+  uint64_t sampleInterval = 1;
+  // Indexed by function id, allocated only when sampling.
+  std::unique_ptr<function_samples[]> samples;
+
   std::shared_ptr<XptiContextManager> xptiContextManager;
 };
 
@@ -16,6 +16,9 @@
 #include <stdio.h>
 
 namespace ur_tracing_layer {
+/// @brief One past the highest ur_function_t value.
+const uint32_t context_t::FUNCTION_ID_LIMIT = 327;
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Intercept function for urAdapterGet
 __urdlllocal ur_result_t UR_APICALL urAdapterGet(
@@ -11547,27 +11550,42 @@ __urdlllocal ur_result_t UR_APICALL urGetAdapterProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnGet = pDdiTable->pfnGet;
-  pDdiTable->pfnGet = ur_tracing_layer::urAdapterGet;
+  if (ur_tracing_layer::getContext()->isTraced("urAdapterGet")) {
+    pDdiTable->pfnGet = ur_tracing_layer::urAdapterGet;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urAdapterRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urAdapterRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urAdapterRelease;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urAdapterRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urAdapterRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urAdapterRetain;
+  }
 
   dditable.pfnGetLastError = pDdiTable->pfnGetLastError;
-  pDdiTable->pfnGetLastError = ur_tracing_layer::urAdapterGetLastError;
+  if (ur_tracing_layer::getContext()->isTraced("urAdapterGetLastError")) {
+    pDdiTable->pfnGetLastError = ur_tracing_layer::urAdapterGetLastError;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urAdapterGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urAdapterGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urAdapterGetInfo;
+  }
 
   dditable.pfnSetLoggerCallback = pDdiTable->pfnSetLoggerCallback;
-  pDdiTable->pfnSetLoggerCallback =
-      ur_tracing_layer::urAdapterSetLoggerCallback;
+  if (ur_tracing_layer::getContext()->isTraced("urAdapterSetLoggerCallback")) {
+    pDdiTable->pfnSetLoggerCallback =
+        ur_tracing_layer::urAdapterSetLoggerCallback;
+  }
 
   dditable.pfnSetLoggerCallbackLevel = pDdiTable->pfnSetLoggerCallbackLevel;
-  pDdiTable->pfnSetLoggerCallbackLevel =
-      ur_tracing_layer::urAdapterSetLoggerCallbackLevel;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urAdapterSetLoggerCallbackLevel")) {
+    pDdiTable->pfnSetLoggerCallbackLevel =
+        ur_tracing_layer::urAdapterSetLoggerCallbackLevel;
+  }
 
   return result;
 }
@@ -11599,103 +11617,173 @@ __urdlllocal ur_result_t UR_APICALL urGetBindlessImagesExpProcAddrTable(
 
   dditable.pfnUnsampledImageHandleDestroyExp =
       pDdiTable->pfnUnsampledImageHandleDestroyExp;
-  pDdiTable->pfnUnsampledImageHandleDestroyExp =
-      ur_tracing_layer::urBindlessImagesUnsampledImageHandleDestroyExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesUnsampledImageHandleDestroyExp")) {
+    pDdiTable->pfnUnsampledImageHandleDestroyExp =
+        ur_tracing_layer::urBindlessImagesUnsampledImageHandleDestroyExp;
+  }
 
   dditable.pfnSampledImageHandleDestroyExp =
       pDdiTable->pfnSampledImageHandleDestroyExp;
-  pDdiTable->pfnSampledImageHandleDestroyExp =
-      ur_tracing_layer::urBindlessImagesSampledImageHandleDestroyExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesSampledImageHandleDestroyExp")) {
+    pDdiTable->pfnSampledImageHandleDestroyExp =
+        ur_tracing_layer::urBindlessImagesSampledImageHandleDestroyExp;
+  }
 
   dditable.pfnImageAllocateExp = pDdiTable->pfnImageAllocateExp;
-  pDdiTable->pfnImageAllocateExp =
-      ur_tracing_layer::urBindlessImagesImageAllocateExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesImageAllocateExp")) {
+    pDdiTable->pfnImageAllocateExp =
+        ur_tracing_layer::urBindlessImagesImageAllocateExp;
+  }
 
   dditable.pfnImageFreeExp = pDdiTable->pfnImageFreeExp;
-  pDdiTable->pfnImageFreeExp = ur_tracing_layer::urBindlessImagesImageFreeExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesImageFreeExp")) {
+    pDdiTable->pfnImageFreeExp = ur_tracing_layer::urBindlessImagesImageFreeExp;
+  }
 
   dditable.pfnUnsampledImageCreateExp = pDdiTable->pfnUnsampledImageCreateExp;
-  pDdiTable->pfnUnsampledImageCreateExp =
-      ur_tracing_layer::urBindlessImagesUnsampledImageCreateExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesUnsampledImageCreateExp")) {
+    pDdiTable->pfnUnsampledImageCreateExp =
+        ur_tracing_layer::urBindlessImagesUnsampledImageCreateExp;
+  }
 
   dditable.pfnSampledImageCreateExp = pDdiTable->pfnSampledImageCreateExp;
-  pDdiTable->pfnSampledImageCreateExp =
-      ur_tracing_layer::urBindlessImagesSampledImageCreateExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesSampledImageCreateExp")) {
+    pDdiTable->pfnSampledImageCreateExp =
+        ur_tracing_layer::urBindlessImagesSampledImageCreateExp;
+  }
 
   dditable.pfnImageCopyExp = pDdiTable->pfnImageCopyExp;
-  pDdiTable->pfnImageCopyExp = ur_tracing_layer::urBindlessImagesImageCopyExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesImageCopyExp")) {
+    pDdiTable->pfnImageCopyExp = ur_tracing_layer::urBindlessImagesImageCopyExp;
+  }
 
   dditable.pfnImageGetInfoExp = pDdiTable->pfnImageGetInfoExp;
-  pDdiTable->pfnImageGetInfoExp =
-      ur_tracing_layer::urBindlessImagesImageGetInfoExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesImageGetInfoExp")) {
+    pDdiTable->pfnImageGetInfoExp =
+        ur_tracing_layer::urBindlessImagesImageGetInfoExp;
+  }
 
   dditable.pfnGetImageMemoryHandleTypeSupportExp =
       pDdiTable->pfnGetImageMemoryHandleTypeSupportExp;
-  pDdiTable->pfnGetImageMemoryHandleTypeSupportExp =
-      ur_tracing_layer::urBindlessImagesGetImageMemoryHandleTypeSupportExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesGetImageMemoryHandleTypeSupportExp")) {
+    pDdiTable->pfnGetImageMemoryHandleTypeSupportExp =
+        ur_tracing_layer::urBindlessImagesGetImageMemoryHandleTypeSupportExp;
+  }
 
   dditable.pfnGetImageUnsampledHandleSupportExp =
       pDdiTable->pfnGetImageUnsampledHandleSupportExp;
-  pDdiTable->pfnGetImageUnsampledHandleSupportExp =
-      ur_tracing_layer::urBindlessImagesGetImageUnsampledHandleSupportExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesGetImageUnsampledHandleSupportExp")) {
+    pDdiTable->pfnGetImageUnsampledHandleSupportExp =
+        ur_tracing_layer::urBindlessImagesGetImageUnsampledHandleSupportExp;
+  }
 
   dditable.pfnGetImageSampledHandleSupportExp =
       pDdiTable->pfnGetImageSampledHandleSupportExp;
-  pDdiTable->pfnGetImageSampledHandleSupportExp =
-      ur_tracing_layer::urBindlessImagesGetImageSampledHandleSupportExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesGetImageSampledHandleSupportExp")) {
+    pDdiTable->pfnGetImageSampledHandleSupportExp =
+        ur_tracing_layer::urBindlessImagesGetImageSampledHandleSupportExp;
+  }
 
   dditable.pfnMipmapGetLevelExp = pDdiTable->pfnMipmapGetLevelExp;
-  pDdiTable->pfnMipmapGetLevelExp =
-      ur_tracing_layer::urBindlessImagesMipmapGetLevelExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesMipmapGetLevelExp")) {
+    pDdiTable->pfnMipmapGetLevelExp =
+        ur_tracing_layer::urBindlessImagesMipmapGetLevelExp;
+  }
 
   dditable.pfnMipmapFreeExp = pDdiTable->pfnMipmapFreeExp;
-  pDdiTable->pfnMipmapFreeExp = ur_tracing_layer::urBindlessImagesMipmapFreeExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesMipmapFreeExp")) {
+    pDdiTable->pfnMipmapFreeExp =
+        ur_tracing_layer::urBindlessImagesMipmapFreeExp;
+  }
 
   dditable.pfnImportExternalMemoryExp = pDdiTable->pfnImportExternalMemoryExp;
-  pDdiTable->pfnImportExternalMemoryExp =
-      ur_tracing_layer::urBindlessImagesImportExternalMemoryExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesImportExternalMemoryExp")) {
+    pDdiTable->pfnImportExternalMemoryExp =
+        ur_tracing_layer::urBindlessImagesImportExternalMemoryExp;
+  }
 
   dditable.pfnMapExternalArrayExp = pDdiTable->pfnMapExternalArrayExp;
-  pDdiTable->pfnMapExternalArrayExp =
-      ur_tracing_layer::urBindlessImagesMapExternalArrayExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesMapExternalArrayExp")) {
+    pDdiTable->pfnMapExternalArrayExp =
+        ur_tracing_layer::urBindlessImagesMapExternalArrayExp;
+  }
 
   dditable.pfnMapExternalLinearMemoryExp =
       pDdiTable->pfnMapExternalLinearMemoryExp;
-  pDdiTable->pfnMapExternalLinearMemoryExp =
-      ur_tracing_layer::urBindlessImagesMapExternalLinearMemoryExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesMapExternalLinearMemoryExp")) {
+    pDdiTable->pfnMapExternalLinearMemoryExp =
+        ur_tracing_layer::urBindlessImagesMapExternalLinearMemoryExp;
+  }
 
   dditable.pfnReleaseExternalMemoryExp = pDdiTable->pfnReleaseExternalMemoryExp;
-  pDdiTable->pfnReleaseExternalMemoryExp =
-      ur_tracing_layer::urBindlessImagesReleaseExternalMemoryExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesReleaseExternalMemoryExp")) {
+    pDdiTable->pfnReleaseExternalMemoryExp =
+        ur_tracing_layer::urBindlessImagesReleaseExternalMemoryExp;
+  }
 
   dditable.pfnFreeMappedLinearMemoryExp =
       pDdiTable->pfnFreeMappedLinearMemoryExp;
-  pDdiTable->pfnFreeMappedLinearMemoryExp =
-      ur_tracing_layer::urBindlessImagesFreeMappedLinearMemoryExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesFreeMappedLinearMemoryExp")) {
+    pDdiTable->pfnFreeMappedLinearMemoryExp =
+        ur_tracing_layer::urBindlessImagesFreeMappedLinearMemoryExp;
+  }
 
   dditable.pfnSupportsImportingHandleTypeExp =
       pDdiTable->pfnSupportsImportingHandleTypeExp;
-  pDdiTable->pfnSupportsImportingHandleTypeExp =
-      ur_tracing_layer::urBindlessImagesSupportsImportingHandleTypeExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesSupportsImportingHandleTypeExp")) {
+    pDdiTable->pfnSupportsImportingHandleTypeExp =
+        ur_tracing_layer::urBindlessImagesSupportsImportingHandleTypeExp;
+  }
 
   dditable.pfnImportExternalSemaphoreExp =
       pDdiTable->pfnImportExternalSemaphoreExp;
-  pDdiTable->pfnImportExternalSemaphoreExp =
-      ur_tracing_layer::urBindlessImagesImportExternalSemaphoreExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesImportExternalSemaphoreExp")) {
+    pDdiTable->pfnImportExternalSemaphoreExp =
+        ur_tracing_layer::urBindlessImagesImportExternalSemaphoreExp;
+  }
 
   dditable.pfnReleaseExternalSemaphoreExp =
       pDdiTable->pfnReleaseExternalSemaphoreExp;
-  pDdiTable->pfnReleaseExternalSemaphoreExp =
-      ur_tracing_layer::urBindlessImagesReleaseExternalSemaphoreExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesReleaseExternalSemaphoreExp")) {
+    pDdiTable->pfnReleaseExternalSemaphoreExp =
+        ur_tracing_layer::urBindlessImagesReleaseExternalSemaphoreExp;
+  }
 
   dditable.pfnWaitExternalSemaphoreExp = pDdiTable->pfnWaitExternalSemaphoreExp;
-  pDdiTable->pfnWaitExternalSemaphoreExp =
-      ur_tracing_layer::urBindlessImagesWaitExternalSemaphoreExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesWaitExternalSemaphoreExp")) {
+    pDdiTable->pfnWaitExternalSemaphoreExp =
+        ur_tracing_layer::urBindlessImagesWaitExternalSemaphoreExp;
+  }
 
   dditable.pfnSignalExternalSemaphoreExp =
       pDdiTable->pfnSignalExternalSemaphoreExp;
-  pDdiTable->pfnSignalExternalSemaphoreExp =
-      ur_tracing_layer::urBindlessImagesSignalExternalSemaphoreExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urBindlessImagesSignalExternalSemaphoreExp")) {
+    pDdiTable->pfnSignalExternalSemaphoreExp =
+        ur_tracing_layer::urBindlessImagesSignalExternalSemaphoreExp;
+  }
 
   return result;
 }
@@ -11726,95 +11814,159 @@ __urdlllocal ur_result_t UR_APICALL urGetCommandBufferExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnCreateExp = pDdiTable->pfnCreateExp;
-  pDdiTable->pfnCreateExp = ur_tracing_layer::urCommandBufferCreateExp;
+  if (ur_tracing_layer::getContext()->isTraced("urCommandBufferCreateExp")) {
+    pDdiTable->pfnCreateExp = ur_tracing_layer::urCommandBufferCreateExp;
+  }
 
   dditable.pfnRetainExp = pDdiTable->pfnRetainExp;
-  pDdiTable->pfnRetainExp = ur_tracing_layer::urCommandBufferRetainExp;
+  if (ur_tracing_layer::getContext()->isTraced("urCommandBufferRetainExp")) {
+    pDdiTable->pfnRetainExp = ur_tracing_layer::urCommandBufferRetainExp;
+  }
 
   dditable.pfnReleaseExp = pDdiTable->pfnReleaseExp;
-  pDdiTable->pfnReleaseExp = ur_tracing_layer::urCommandBufferReleaseExp;
+  if (ur_tracing_layer::getContext()->isTraced("urCommandBufferReleaseExp")) {
+    pDdiTable->pfnReleaseExp = ur_tracing_layer::urCommandBufferReleaseExp;
+  }
 
   dditable.pfnFinalizeExp = pDdiTable->pfnFinalizeExp;
-  pDdiTable->pfnFinalizeExp = ur_tracing_layer::urCommandBufferFinalizeExp;
+  if (ur_tracing_layer::getContext()->isTraced("urCommandBufferFinalizeExp")) {
+    pDdiTable->pfnFinalizeExp = ur_tracing_layer::urCommandBufferFinalizeExp;
+  }
 
   dditable.pfnAppendKernelLaunchExp = pDdiTable->pfnAppendKernelLaunchExp;
-  pDdiTable->pfnAppendKernelLaunchExp =
-      ur_tracing_layer::urCommandBufferAppendKernelLaunchExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendKernelLaunchExp")) {
+    pDdiTable->pfnAppendKernelLaunchExp =
+        ur_tracing_layer::urCommandBufferAppendKernelLaunchExp;
+  }
 
   dditable.pfnAppendKernelLaunchWithArgsExp =
       pDdiTable->pfnAppendKernelLaunchWithArgsExp;
-  pDdiTable->pfnAppendKernelLaunchWithArgsExp =
-      ur_tracing_layer::urCommandBufferAppendKernelLaunchWithArgsExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendKernelLaunchWithArgsExp")) {
+    pDdiTable->pfnAppendKernelLaunchWithArgsExp =
+        ur_tracing_layer::urCommandBufferAppendKernelLaunchWithArgsExp;
+  }
 
   dditable.pfnAppendUSMMemcpyExp = pDdiTable->pfnAppendUSMMemcpyExp;
-  pDdiTable->pfnAppendUSMMemcpyExp =
-      ur_tracing_layer::urCommandBufferAppendUSMMemcpyExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendUSMMemcpyExp")) {
+    pDdiTable->pfnAppendUSMMemcpyExp =
+        ur_tracing_layer::urCommandBufferAppendUSMMemcpyExp;
+  }
 
   dditable.pfnAppendUSMFillExp = pDdiTable->pfnAppendUSMFillExp;
-  pDdiTable->pfnAppendUSMFillExp =
-      ur_tracing_layer::urCommandBufferAppendUSMFillExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendUSMFillExp")) {
+    pDdiTable->pfnAppendUSMFillExp =
+        ur_tracing_layer::urCommandBufferAppendUSMFillExp;
+  }
 
   dditable.pfnAppendMemBufferCopyExp = pDdiTable->pfnAppendMemBufferCopyExp;
-  pDdiTable->pfnAppendMemBufferCopyExp =
-      ur_tracing_layer::urCommandBufferAppendMemBufferCopyExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendMemBufferCopyExp")) {
+    pDdiTable->pfnAppendMemBufferCopyExp =
+        ur_tracing_layer::urCommandBufferAppendMemBufferCopyExp;
+  }
 
   dditable.pfnAppendMemBufferWriteExp = pDdiTable->pfnAppendMemBufferWriteExp;
-  pDdiTable->pfnAppendMemBufferWriteExp =
-      ur_tracing_layer::urCommandBufferAppendMemBufferWriteExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendMemBufferWriteExp")) {
+    pDdiTable->pfnAppendMemBufferWriteExp =
+        ur_tracing_layer::urCommandBufferAppendMemBufferWriteExp;
+  }
 
   dditable.pfnAppendMemBufferReadExp = pDdiTable->pfnAppendMemBufferReadExp;
-  pDdiTable->pfnAppendMemBufferReadExp =
-      ur_tracing_layer::urCommandBufferAppendMemBufferReadExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendMemBufferReadExp")) {
+    pDdiTable->pfnAppendMemBufferReadExp =
+        ur_tracing_layer::urCommandBufferAppendMemBufferReadExp;
+  }
 
   dditable.pfnAppendMemBufferCopyRectExp =
       pDdiTable->pfnAppendMemBufferCopyRectExp;
-  pDdiTable->pfnAppendMemBufferCopyRectExp =
-      ur_tracing_layer::urCommandBufferAppendMemBufferCopyRectExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendMemBufferCopyRectExp")) {
+    pDdiTable->pfnAppendMemBufferCopyRectExp =
+        ur_tracing_layer::urCommandBufferAppendMemBufferCopyRectExp;
+  }
 
   dditable.pfnAppendMemBufferWriteRectExp =
       pDdiTable->pfnAppendMemBufferWriteRectExp;
-  pDdiTable->pfnAppendMemBufferWriteRectExp =
-      ur_tracing_layer::urCommandBufferAppendMemBufferWriteRectExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendMemBufferWriteRectExp")) {
+    pDdiTable->pfnAppendMemBufferWriteRectExp =
+        ur_tracing_layer::urCommandBufferAppendMemBufferWriteRectExp;
+  }
 
   dditable.pfnAppendMemBufferReadRectExp =
       pDdiTable->pfnAppendMemBufferReadRectExp;
-  pDdiTable->pfnAppendMemBufferReadRectExp =
-      ur_tracing_layer::urCommandBufferAppendMemBufferReadRectExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendMemBufferReadRectExp")) {
+    pDdiTable->pfnAppendMemBufferReadRectExp =
+        ur_tracing_layer::urCommandBufferAppendMemBufferReadRectExp;
+  }
 
   dditable.pfnAppendMemBufferFillExp = pDdiTable->pfnAppendMemBufferFillExp;
-  pDdiTable->pfnAppendMemBufferFillExp =
-      ur_tracing_layer::urCommandBufferAppendMemBufferFillExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendMemBufferFillExp")) {
+    pDdiTable->pfnAppendMemBufferFillExp =
+        ur_tracing_layer::urCommandBufferAppendMemBufferFillExp;
+  }
 
   dditable.pfnAppendUSMPrefetchExp = pDdiTable->pfnAppendUSMPrefetchExp;
-  pDdiTable->pfnAppendUSMPrefetchExp =
-      ur_tracing_layer::urCommandBufferAppendUSMPrefetchExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendUSMPrefetchExp")) {
+    pDdiTable->pfnAppendUSMPrefetchExp =
+        ur_tracing_layer::urCommandBufferAppendUSMPrefetchExp;
+  }
 
   dditable.pfnAppendUSMAdviseExp = pDdiTable->pfnAppendUSMAdviseExp;
-  pDdiTable->pfnAppendUSMAdviseExp =
-      ur_tracing_layer::urCommandBufferAppendUSMAdviseExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendUSMAdviseExp")) {
+    pDdiTable->pfnAppendUSMAdviseExp =
+        ur_tracing_layer::urCommandBufferAppendUSMAdviseExp;
+  }
 
   dditable.pfnAppendNativeCommandExp = pDdiTable->pfnAppendNativeCommandExp;
-  pDdiTable->pfnAppendNativeCommandExp =
-      ur_tracing_layer::urCommandBufferAppendNativeCommandExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferAppendNativeCommandExp")) {
+    pDdiTable->pfnAppendNativeCommandExp =
+        ur_tracing_layer::urCommandBufferAppendNativeCommandExp;
+  }
 
   dditable.pfnUpdateKernelLaunchExp = pDdiTable->pfnUpdateKernelLaunchExp;
-  pDdiTable->pfnUpdateKernelLaunchExp =
-      ur_tracing_layer::urCommandBufferUpdateKernelLaunchExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferUpdateKernelLaunchExp")) {
+    pDdiTable->pfnUpdateKernelLaunchExp =
+        ur_tracing_layer::urCommandBufferUpdateKernelLaunchExp;
+  }
 
   dditable.pfnUpdateSignalEventExp = pDdiTable->pfnUpdateSignalEventExp;
-  pDdiTable->pfnUpdateSignalEventExp =
-      ur_tracing_layer::urCommandBufferUpdateSignalEventExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferUpdateSignalEventExp")) {
+    pDdiTable->pfnUpdateSignalEventExp =
+        ur_tracing_layer::urCommandBufferUpdateSignalEventExp;
+  }
 
   dditable.pfnUpdateWaitEventsExp = pDdiTable->pfnUpdateWaitEventsExp;
-  pDdiTable->pfnUpdateWaitEventsExp =
-      ur_tracing_layer::urCommandBufferUpdateWaitEventsExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferUpdateWaitEventsExp")) {
+    pDdiTable->pfnUpdateWaitEventsExp =
+        ur_tracing_layer::urCommandBufferUpdateWaitEventsExp;
+  }
 
   dditable.pfnGetInfoExp = pDdiTable->pfnGetInfoExp;
-  pDdiTable->pfnGetInfoExp = ur_tracing_layer::urCommandBufferGetInfoExp;
+  if (ur_tracing_layer::getContext()->isTraced("urCommandBufferGetInfoExp")) {
+    pDdiTable->pfnGetInfoExp = ur_tracing_layer::urCommandBufferGetInfoExp;
+  }
 
   dditable.pfnGetNativeHandleExp = pDdiTable->pfnGetNativeHandleExp;
-  pDdiTable->pfnGetNativeHandleExp =
-      ur_tracing_layer::urCommandBufferGetNativeHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urCommandBufferGetNativeHandleExp")) {
+    pDdiTable->pfnGetNativeHandleExp =
+        ur_tracing_layer::urCommandBufferGetNativeHandleExp;
+  }
 
   return result;
 }
@@ -11845,27 +11997,42 @@ __urdlllocal ur_result_t UR_APICALL urGetContextProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnCreate = pDdiTable->pfnCreate;
-  pDdiTable->pfnCreate = ur_tracing_layer::urContextCreate;
+  if (ur_tracing_layer::getContext()->isTraced("urContextCreate")) {
+    pDdiTable->pfnCreate = ur_tracing_layer::urContextCreate;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urContextRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urContextRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urContextRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urContextRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urContextRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urContextRelease;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urContextGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urContextGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urContextGetInfo;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urContextGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urContextGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urContextGetNativeHandle;
+  }
 
   dditable.pfnCreateWithNativeHandle = pDdiTable->pfnCreateWithNativeHandle;
-  pDdiTable->pfnCreateWithNativeHandle =
-      ur_tracing_layer::urContextCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urContextCreateWithNativeHandle")) {
+    pDdiTable->pfnCreateWithNativeHandle =
+        ur_tracing_layer::urContextCreateWithNativeHandle;
+  }
 
   dditable.pfnSetExtendedDeleter = pDdiTable->pfnSetExtendedDeleter;
-  pDdiTable->pfnSetExtendedDeleter =
-      ur_tracing_layer::urContextSetExtendedDeleter;
+  if (ur_tracing_layer::getContext()->isTraced("urContextSetExtendedDeleter")) {
+    pDdiTable->pfnSetExtendedDeleter =
+        ur_tracing_layer::urContextSetExtendedDeleter;
+  }
 
   return result;
 }
@@ -11896,87 +12063,141 @@ __urdlllocal ur_result_t UR_APICALL urGetEnqueueProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnEventsWait = pDdiTable->pfnEventsWait;
-  pDdiTable->pfnEventsWait = ur_tracing_layer::urEnqueueEventsWait;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueEventsWait")) {
+    pDdiTable->pfnEventsWait = ur_tracing_layer::urEnqueueEventsWait;
+  }
 
   dditable.pfnEventsWaitWithBarrier = pDdiTable->pfnEventsWaitWithBarrier;
-  pDdiTable->pfnEventsWaitWithBarrier =
-      ur_tracing_layer::urEnqueueEventsWaitWithBarrier;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urEnqueueEventsWaitWithBarrier")) {
+    pDdiTable->pfnEventsWaitWithBarrier =
+        ur_tracing_layer::urEnqueueEventsWaitWithBarrier;
+  }
 
   dditable.pfnMemBufferRead = pDdiTable->pfnMemBufferRead;
-  pDdiTable->pfnMemBufferRead = ur_tracing_layer::urEnqueueMemBufferRead;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemBufferRead")) {
+    pDdiTable->pfnMemBufferRead = ur_tracing_layer::urEnqueueMemBufferRead;
+  }
 
   dditable.pfnMemBufferWrite = pDdiTable->pfnMemBufferWrite;
-  pDdiTable->pfnMemBufferWrite = ur_tracing_layer::urEnqueueMemBufferWrite;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemBufferWrite")) {
+    pDdiTable->pfnMemBufferWrite = ur_tracing_layer::urEnqueueMemBufferWrite;
+  }
 
   dditable.pfnMemBufferReadRect = pDdiTable->pfnMemBufferReadRect;
-  pDdiTable->pfnMemBufferReadRect =
-      ur_tracing_layer::urEnqueueMemBufferReadRect;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemBufferReadRect")) {
+    pDdiTable->pfnMemBufferReadRect =
+        ur_tracing_layer::urEnqueueMemBufferReadRect;
+  }
 
   dditable.pfnMemBufferWriteRect = pDdiTable->pfnMemBufferWriteRect;
-  pDdiTable->pfnMemBufferWriteRect =
-      ur_tracing_layer::urEnqueueMemBufferWriteRect;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemBufferWriteRect")) {
+    pDdiTable->pfnMemBufferWriteRect =
+        ur_tracing_layer::urEnqueueMemBufferWriteRect;
+  }
 
   dditable.pfnMemBufferCopy = pDdiTable->pfnMemBufferCopy;
-  pDdiTable->pfnMemBufferCopy = ur_tracing_layer::urEnqueueMemBufferCopy;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemBufferCopy")) {
+    pDdiTable->pfnMemBufferCopy = ur_tracing_layer::urEnqueueMemBufferCopy;
+  }
 
   dditable.pfnMemBufferCopyRect = pDdiTable->pfnMemBufferCopyRect;
-  pDdiTable->pfnMemBufferCopyRect =
-      ur_tracing_layer::urEnqueueMemBufferCopyRect;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemBufferCopyRect")) {
+    pDdiTable->pfnMemBufferCopyRect =
+        ur_tracing_layer::urEnqueueMemBufferCopyRect;
+  }
 
   dditable.pfnMemBufferFill = pDdiTable->pfnMemBufferFill;
-  pDdiTable->pfnMemBufferFill = ur_tracing_layer::urEnqueueMemBufferFill;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemBufferFill")) {
+    pDdiTable->pfnMemBufferFill = ur_tracing_layer::urEnqueueMemBufferFill;
+  }
 
   dditable.pfnMemImageRead = pDdiTable->pfnMemImageRead;
-  pDdiTable->pfnMemImageRead = ur_tracing_layer::urEnqueueMemImageRead;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemImageRead")) {
+    pDdiTable->pfnMemImageRead = ur_tracing_layer::urEnqueueMemImageRead;
+  }
 
   dditable.pfnMemImageWrite = pDdiTable->pfnMemImageWrite;
-  pDdiTable->pfnMemImageWrite = ur_tracing_layer::urEnqueueMemImageWrite;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemImageWrite")) {
+    pDdiTable->pfnMemImageWrite = ur_tracing_layer::urEnqueueMemImageWrite;
+  }
 
   dditable.pfnMemImageCopy = pDdiTable->pfnMemImageCopy;
-  pDdiTable->pfnMemImageCopy = ur_tracing_layer::urEnqueueMemImageCopy;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemImageCopy")) {
+    pDdiTable->pfnMemImageCopy = ur_tracing_layer::urEnqueueMemImageCopy;
+  }
 
   dditable.pfnMemBufferMap = pDdiTable->pfnMemBufferMap;
-  pDdiTable->pfnMemBufferMap = ur_tracing_layer::urEnqueueMemBufferMap;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemBufferMap")) {
+    pDdiTable->pfnMemBufferMap = ur_tracing_layer::urEnqueueMemBufferMap;
+  }
 
   dditable.pfnMemUnmap = pDdiTable->pfnMemUnmap;
-  pDdiTable->pfnMemUnmap = ur_tracing_layer::urEnqueueMemUnmap;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueMemUnmap")) {
+    pDdiTable->pfnMemUnmap = ur_tracing_layer::urEnqueueMemUnmap;
+  }
 
   dditable.pfnUSMFill = pDdiTable->pfnUSMFill;
-  pDdiTable->pfnUSMFill = ur_tracing_layer::urEnqueueUSMFill;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMFill")) {
+    pDdiTable->pfnUSMFill = ur_tracing_layer::urEnqueueUSMFill;
+  }
 
   dditable.pfnUSMMemcpy = pDdiTable->pfnUSMMemcpy;
-  pDdiTable->pfnUSMMemcpy = ur_tracing_layer::urEnqueueUSMMemcpy;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMMemcpy")) {
+    pDdiTable->pfnUSMMemcpy = ur_tracing_layer::urEnqueueUSMMemcpy;
+  }
 
   dditable.pfnUSMPrefetch = pDdiTable->pfnUSMPrefetch;
-  pDdiTable->pfnUSMPrefetch = ur_tracing_layer::urEnqueueUSMPrefetch;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMPrefetch")) {
+    pDdiTable->pfnUSMPrefetch = ur_tracing_layer::urEnqueueUSMPrefetch;
+  }
 
   dditable.pfnUSMAdvise = pDdiTable->pfnUSMAdvise;
-  pDdiTable->pfnUSMAdvise = ur_tracing_layer::urEnqueueUSMAdvise;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMAdvise")) {
+    pDdiTable->pfnUSMAdvise = ur_tracing_layer::urEnqueueUSMAdvise;
+  }
 
   dditable.pfnUSMFill2D = pDdiTable->pfnUSMFill2D;
-  pDdiTable->pfnUSMFill2D = ur_tracing_layer::urEnqueueUSMFill2D;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMFill2D")) {
+    pDdiTable->pfnUSMFill2D = ur_tracing_layer::urEnqueueUSMFill2D;
+  }
 
   dditable.pfnUSMMemcpy2D = pDdiTable->pfnUSMMemcpy2D;
-  pDdiTable->pfnUSMMemcpy2D = ur_tracing_layer::urEnqueueUSMMemcpy2D;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMMemcpy2D")) {
+    pDdiTable->pfnUSMMemcpy2D = ur_tracing_layer::urEnqueueUSMMemcpy2D;
+  }
 
   dditable.pfnDeviceGlobalVariableWrite =
       pDdiTable->pfnDeviceGlobalVariableWrite;
-  pDdiTable->pfnDeviceGlobalVariableWrite =
-      ur_tracing_layer::urEnqueueDeviceGlobalVariableWrite;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urEnqueueDeviceGlobalVariableWrite")) {
+    pDdiTable->pfnDeviceGlobalVariableWrite =
+        ur_tracing_layer::urEnqueueDeviceGlobalVariableWrite;
+  }
 
   dditable.pfnDeviceGlobalVariableRead = pDdiTable->pfnDeviceGlobalVariableRead;
-  pDdiTable->pfnDeviceGlobalVariableRead =
-      ur_tracing_layer::urEnqueueDeviceGlobalVariableRead;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urEnqueueDeviceGlobalVariableRead")) {
+    pDdiTable->pfnDeviceGlobalVariableRead =
+        ur_tracing_layer::urEnqueueDeviceGlobalVariableRead;
+  }
 
   dditable.pfnReadHostPipe = pDdiTable->pfnReadHostPipe;
-  pDdiTable->pfnReadHostPipe = ur_tracing_layer::urEnqueueReadHostPipe;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueReadHostPipe")) {
+    pDdiTable->pfnReadHostPipe = ur_tracing_layer::urEnqueueReadHostPipe;
+  }
 
   dditable.pfnWriteHostPipe = pDdiTable->pfnWriteHostPipe;
-  pDdiTable->pfnWriteHostPipe = ur_tracing_layer::urEnqueueWriteHostPipe;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueWriteHostPipe")) {
+    pDdiTable->pfnWriteHostPipe = ur_tracing_layer::urEnqueueWriteHostPipe;
+  }
 
   dditable.pfnEventsWaitWithBarrierExt = pDdiTable->pfnEventsWaitWithBarrierExt;
-  pDdiTable->pfnEventsWaitWithBarrierExt =
-      ur_tracing_layer::urEnqueueEventsWaitWithBarrierExt;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urEnqueueEventsWaitWithBarrierExt")) {
+    pDdiTable->pfnEventsWaitWithBarrierExt =
+        ur_tracing_layer::urEnqueueEventsWaitWithBarrierExt;
+  }
 
   return result;
 }
@@ -12007,38 +12228,62 @@ __urdlllocal ur_result_t UR_APICALL urGetEnqueueExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnKernelLaunchWithArgsExp = pDdiTable->pfnKernelLaunchWithArgsExp;
-  pDdiTable->pfnKernelLaunchWithArgsExp =
-      ur_tracing_layer::urEnqueueKernelLaunchWithArgsExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urEnqueueKernelLaunchWithArgsExp")) {
+    pDdiTable->pfnKernelLaunchWithArgsExp =
+        ur_tracing_layer::urEnqueueKernelLaunchWithArgsExp;
+  }
 
   dditable.pfnUSMDeviceAllocExp = pDdiTable->pfnUSMDeviceAllocExp;
-  pDdiTable->pfnUSMDeviceAllocExp =
-      ur_tracing_layer::urEnqueueUSMDeviceAllocExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMDeviceAllocExp")) {
+    pDdiTable->pfnUSMDeviceAllocExp =
+        ur_tracing_layer::urEnqueueUSMDeviceAllocExp;
+  }
 
   dditable.pfnUSMSharedAllocExp = pDdiTable->pfnUSMSharedAllocExp;
-  pDdiTable->pfnUSMSharedAllocExp =
-      ur_tracing_layer::urEnqueueUSMSharedAllocExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMSharedAllocExp")) {
+    pDdiTable->pfnUSMSharedAllocExp =
+        ur_tracing_layer::urEnqueueUSMSharedAllocExp;
+  }
 
   dditable.pfnUSMHostAllocExp = pDdiTable->pfnUSMHostAllocExp;
-  pDdiTable->pfnUSMHostAllocExp = ur_tracing_layer::urEnqueueUSMHostAllocExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMHostAllocExp")) {
+    pDdiTable->pfnUSMHostAllocExp = ur_tracing_layer::urEnqueueUSMHostAllocExp;
+  }
 
   dditable.pfnUSMFreeExp = pDdiTable->pfnUSMFreeExp;
-  pDdiTable->pfnUSMFreeExp = ur_tracing_layer::urEnqueueUSMFreeExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueUSMFreeExp")) {
+    pDdiTable->pfnUSMFreeExp = ur_tracing_layer::urEnqueueUSMFreeExp;
+  }
 
   dditable.pfnTimestampRecordingExp = pDdiTable->pfnTimestampRecordingExp;
-  pDdiTable->pfnTimestampRecordingExp =
-      ur_tracing_layer::urEnqueueTimestampRecordingExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urEnqueueTimestampRecordingExp")) {
+    pDdiTable->pfnTimestampRecordingExp =
+        ur_tracing_layer::urEnqueueTimestampRecordingExp;
+  }
 
   dditable.pfnCommandBufferExp = pDdiTable->pfnCommandBufferExp;
-  pDdiTable->pfnCommandBufferExp = ur_tracing_layer::urEnqueueCommandBufferExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueCommandBufferExp")) {
+    pDdiTable->pfnCommandBufferExp =
+        ur_tracing_layer::urEnqueueCommandBufferExp;
+  }
 
   dditable.pfnHostTaskExp = pDdiTable->pfnHostTaskExp;
-  pDdiTable->pfnHostTaskExp = ur_tracing_layer::urEnqueueHostTaskExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueHostTaskExp")) {
+    pDdiTable->pfnHostTaskExp = ur_tracing_layer::urEnqueueHostTaskExp;
+  }
 
   dditable.pfnNativeCommandExp = pDdiTable->pfnNativeCommandExp;
-  pDdiTable->pfnNativeCommandExp = ur_tracing_layer::urEnqueueNativeCommandExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueNativeCommandExp")) {
+    pDdiTable->pfnNativeCommandExp =
+        ur_tracing_layer::urEnqueueNativeCommandExp;
+  }
 
   dditable.pfnGraphExp = pDdiTable->pfnGraphExp;
-  pDdiTable->pfnGraphExp = ur_tracing_layer::urEnqueueGraphExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEnqueueGraphExp")) {
+    pDdiTable->pfnGraphExp = ur_tracing_layer::urEnqueueGraphExp;
+  }
 
   return result;
 }
@@ -12069,29 +12314,46 @@ __urdlllocal ur_result_t UR_APICALL urGetEventProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urEventGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urEventGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urEventGetInfo;
+  }
 
   dditable.pfnGetProfilingInfo = pDdiTable->pfnGetProfilingInfo;
-  pDdiTable->pfnGetProfilingInfo = ur_tracing_layer::urEventGetProfilingInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urEventGetProfilingInfo")) {
+    pDdiTable->pfnGetProfilingInfo = ur_tracing_layer::urEventGetProfilingInfo;
+  }
 
   dditable.pfnWait = pDdiTable->pfnWait;
-  pDdiTable->pfnWait = ur_tracing_layer::urEventWait;
+  if (ur_tracing_layer::getContext()->isTraced("urEventWait")) {
+    pDdiTable->pfnWait = ur_tracing_layer::urEventWait;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urEventRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urEventRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urEventRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urEventRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urEventRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urEventRelease;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urEventGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urEventGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urEventGetNativeHandle;
+  }
 
   dditable.pfnCreateWithNativeHandle = pDdiTable->pfnCreateWithNativeHandle;
-  pDdiTable->pfnCreateWithNativeHandle =
-      ur_tracing_layer::urEventCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urEventCreateWithNativeHandle")) {
+    pDdiTable->pfnCreateWithNativeHandle =
+        ur_tracing_layer::urEventCreateWithNativeHandle;
+  }
 
   dditable.pfnSetCallback = pDdiTable->pfnSetCallback;
-  pDdiTable->pfnSetCallback = ur_tracing_layer::urEventSetCallback;
+  if (ur_tracing_layer::getContext()->isTraced("urEventSetCallback")) {
+    pDdiTable->pfnSetCallback = ur_tracing_layer::urEventSetCallback;
+  }
 
   return result;
 }
@@ -12122,7 +12384,9 @@ __urdlllocal ur_result_t UR_APICALL urGetEventExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnCreateExp = pDdiTable->pfnCreateExp;
-  pDdiTable->pfnCreateExp = ur_tracing_layer::urEventCreateExp;
+  if (ur_tracing_layer::getContext()->isTraced("urEventCreateExp")) {
+    pDdiTable->pfnCreateExp = ur_tracing_layer::urEventCreateExp;
+  }
 
   return result;
 }
@@ -12153,42 +12417,65 @@ __urdlllocal ur_result_t UR_APICALL urGetGraphExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnCreateExp = pDdiTable->pfnCreateExp;
-  pDdiTable->pfnCreateExp = ur_tracing_layer::urGraphCreateExp;
+  if (ur_tracing_layer::getContext()->isTraced("urGraphCreateExp")) {
+    pDdiTable->pfnCreateExp = ur_tracing_layer::urGraphCreateExp;
+  }
 
   dditable.pfnInstantiateGraphExp = pDdiTable->pfnInstantiateGraphExp;
-  pDdiTable->pfnInstantiateGraphExp =
-      ur_tracing_layer::urGraphInstantiateGraphExp;
+  if (ur_tracing_layer::getContext()->isTraced("urGraphInstantiateGraphExp")) {
+    pDdiTable->pfnInstantiateGraphExp =
+        ur_tracing_layer::urGraphInstantiateGraphExp;
+  }
 
   dditable.pfnDestroyExp = pDdiTable->pfnDestroyExp;
-  pDdiTable->pfnDestroyExp = ur_tracing_layer::urGraphDestroyExp;
+  if (ur_tracing_layer::getContext()->isTraced("urGraphDestroyExp")) {
+    pDdiTable->pfnDestroyExp = ur_tracing_layer::urGraphDestroyExp;
+  }
 
   dditable.pfnExecutableGraphDestroyExp =
       pDdiTable->pfnExecutableGraphDestroyExp;
-  pDdiTable->pfnExecutableGraphDestroyExp =
-      ur_tracing_layer::urGraphExecutableGraphDestroyExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urGraphExecutableGraphDestroyExp")) {
+    pDdiTable->pfnExecutableGraphDestroyExp =
+        ur_tracing_layer::urGraphExecutableGraphDestroyExp;
+  }
 
   dditable.pfnIsEmptyExp = pDdiTable->pfnIsEmptyExp;
-  pDdiTable->pfnIsEmptyExp = ur_tracing_layer::urGraphIsEmptyExp;
+  if (ur_tracing_layer::getContext()->isTraced("urGraphIsEmptyExp")) {
+    pDdiTable->pfnIsEmptyExp = ur_tracing_layer::urGraphIsEmptyExp;
+  }
 
   dditable.pfnGetIdExp = pDdiTable->pfnGetIdExp;
-  pDdiTable->pfnGetIdExp = ur_tracing_layer::urGraphGetIdExp;
+  if (ur_tracing_layer::getContext()->isTraced("urGraphGetIdExp")) {
+    pDdiTable->pfnGetIdExp = ur_tracing_layer::urGraphGetIdExp;
+  }
 
   dditable.pfnSetDestructionCallbackExp =
       pDdiTable->pfnSetDestructionCallbackExp;
-  pDdiTable->pfnSetDestructionCallbackExp =
-      ur_tracing_layer::urGraphSetDestructionCallbackExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urGraphSetDestructionCallbackExp")) {
+    pDdiTable->pfnSetDestructionCallbackExp =
+        ur_tracing_layer::urGraphSetDestructionCallbackExp;
+  }
 
   dditable.pfnDumpContentsExp = pDdiTable->pfnDumpContentsExp;
-  pDdiTable->pfnDumpContentsExp = ur_tracing_layer::urGraphDumpContentsExp;
+  if (ur_tracing_layer::getContext()->isTraced("urGraphDumpContentsExp")) {
+    pDdiTable->pfnDumpContentsExp = ur_tracing_layer::urGraphDumpContentsExp;
+  }
 
   dditable.pfnGetNativeHandleExp = pDdiTable->pfnGetNativeHandleExp;
-  pDdiTable->pfnGetNativeHandleExp =
-      ur_tracing_layer::urGraphGetNativeHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urGraphGetNativeHandleExp")) {
+    pDdiTable->pfnGetNativeHandleExp =
+        ur_tracing_layer::urGraphGetNativeHandleExp;
+  }
 
   dditable.pfnExecutableGraphGetNativeHandleExp =
       pDdiTable->pfnExecutableGraphGetNativeHandleExp;
-  pDdiTable->pfnExecutableGraphGetNativeHandleExp =
-      ur_tracing_layer::urGraphExecutableGraphGetNativeHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urGraphExecutableGraphGetNativeHandleExp")) {
+    pDdiTable->pfnExecutableGraphGetNativeHandleExp =
+        ur_tracing_layer::urGraphExecutableGraphGetNativeHandleExp;
+  }
 
   return result;
 }
@@ -12219,41 +12506,64 @@ __urdlllocal ur_result_t UR_APICALL urGetIPCExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnGetMemHandleExp = pDdiTable->pfnGetMemHandleExp;
-  pDdiTable->pfnGetMemHandleExp = ur_tracing_layer::urIPCGetMemHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCGetMemHandleExp")) {
+    pDdiTable->pfnGetMemHandleExp = ur_tracing_layer::urIPCGetMemHandleExp;
+  }
 
   dditable.pfnPutMemHandleExp = pDdiTable->pfnPutMemHandleExp;
-  pDdiTable->pfnPutMemHandleExp = ur_tracing_layer::urIPCPutMemHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCPutMemHandleExp")) {
+    pDdiTable->pfnPutMemHandleExp = ur_tracing_layer::urIPCPutMemHandleExp;
+  }
 
   dditable.pfnOpenMemHandleExp = pDdiTable->pfnOpenMemHandleExp;
-  pDdiTable->pfnOpenMemHandleExp = ur_tracing_layer::urIPCOpenMemHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCOpenMemHandleExp")) {
+    pDdiTable->pfnOpenMemHandleExp = ur_tracing_layer::urIPCOpenMemHandleExp;
+  }
 
   dditable.pfnCloseMemHandleExp = pDdiTable->pfnCloseMemHandleExp;
-  pDdiTable->pfnCloseMemHandleExp = ur_tracing_layer::urIPCCloseMemHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCCloseMemHandleExp")) {
+    pDdiTable->pfnCloseMemHandleExp = ur_tracing_layer::urIPCCloseMemHandleExp;
+  }
 
   dditable.pfnGetPhysMemHandleExp = pDdiTable->pfnGetPhysMemHandleExp;
-  pDdiTable->pfnGetPhysMemHandleExp =
-      ur_tracing_layer::urIPCGetPhysMemHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCGetPhysMemHandleExp")) {
+    pDdiTable->pfnGetPhysMemHandleExp =
+        ur_tracing_layer::urIPCGetPhysMemHandleExp;
+  }
 
   dditable.pfnPutPhysMemHandleExp = pDdiTable->pfnPutPhysMemHandleExp;
-  pDdiTable->pfnPutPhysMemHandleExp =
-      ur_tracing_layer::urIPCPutPhysMemHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCPutPhysMemHandleExp")) {
+    pDdiTable->pfnPutPhysMemHandleExp =
+        ur_tracing_layer::urIPCPutPhysMemHandleExp;
+  }
 
   dditable.pfnOpenPhysMemHandleExp = pDdiTable->pfnOpenPhysMemHandleExp;
-  pDdiTable->pfnOpenPhysMemHandleExp =
-      ur_tracing_layer::urIPCOpenPhysMemHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCOpenPhysMemHandleExp")) {
+    pDdiTable->pfnOpenPhysMemHandleExp =
+        ur_tracing_layer::urIPCOpenPhysMemHandleExp;
+  }
 
   dditable.pfnClosePhysMemHandleExp = pDdiTable->pfnClosePhysMemHandleExp;
-  pDdiTable->pfnClosePhysMemHandleExp =
-      ur_tracing_layer::urIPCClosePhysMemHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCClosePhysMemHandleExp")) {
+    pDdiTable->pfnClosePhysMemHandleExp =
+        ur_tracing_layer::urIPCClosePhysMemHandleExp;
+  }
 
   dditable.pfnGetEventHandleExp = pDdiTable->pfnGetEventHandleExp;
-  pDdiTable->pfnGetEventHandleExp = ur_tracing_layer::urIPCGetEventHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCGetEventHandleExp")) {
+    pDdiTable->pfnGetEventHandleExp = ur_tracing_layer::urIPCGetEventHandleExp;
+  }
 
   dditable.pfnPutEventHandleExp = pDdiTable->pfnPutEventHandleExp;
-  pDdiTable->pfnPutEventHandleExp = ur_tracing_layer::urIPCPutEventHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCPutEventHandleExp")) {
+    pDdiTable->pfnPutEventHandleExp = ur_tracing_layer::urIPCPutEventHandleExp;
+  }
 
   dditable.pfnOpenEventHandleExp = pDdiTable->pfnOpenEventHandleExp;
-  pDdiTable->pfnOpenEventHandleExp = ur_tracing_layer::urIPCOpenEventHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced("urIPCOpenEventHandleExp")) {
+    pDdiTable->pfnOpenEventHandleExp =
+        ur_tracing_layer::urIPCOpenEventHandleExp;
+  }
 
   return result;
 }
@@ -12284,52 +12594,83 @@ __urdlllocal ur_result_t UR_APICALL urGetKernelProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnCreate = pDdiTable->pfnCreate;
-  pDdiTable->pfnCreate = ur_tracing_layer::urKernelCreate;
+  if (ur_tracing_layer::getContext()->isTraced("urKernelCreate")) {
+    pDdiTable->pfnCreate = ur_tracing_layer::urKernelCreate;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urKernelGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urKernelGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urKernelGetInfo;
+  }
 
   dditable.pfnGetGroupInfo = pDdiTable->pfnGetGroupInfo;
-  pDdiTable->pfnGetGroupInfo = ur_tracing_layer::urKernelGetGroupInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urKernelGetGroupInfo")) {
+    pDdiTable->pfnGetGroupInfo = ur_tracing_layer::urKernelGetGroupInfo;
+  }
 
   dditable.pfnGetSubGroupInfo = pDdiTable->pfnGetSubGroupInfo;
-  pDdiTable->pfnGetSubGroupInfo = ur_tracing_layer::urKernelGetSubGroupInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urKernelGetSubGroupInfo")) {
+    pDdiTable->pfnGetSubGroupInfo = ur_tracing_layer::urKernelGetSubGroupInfo;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urKernelRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urKernelRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urKernelRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urKernelRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urKernelRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urKernelRelease;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urKernelGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urKernelGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urKernelGetNativeHandle;
+  }
 
   dditable.pfnCreateWithNativeHandle = pDdiTable->pfnCreateWithNativeHandle;
-  pDdiTable->pfnCreateWithNativeHandle =
-      ur_tracing_layer::urKernelCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urKernelCreateWithNativeHandle")) {
+    pDdiTable->pfnCreateWithNativeHandle =
+        ur_tracing_layer::urKernelCreateWithNativeHandle;
+  }
 
   dditable.pfnGetSuggestedLocalWorkSize =
       pDdiTable->pfnGetSuggestedLocalWorkSize;
-  pDdiTable->pfnGetSuggestedLocalWorkSize =
-      ur_tracing_layer::urKernelGetSuggestedLocalWorkSize;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urKernelGetSuggestedLocalWorkSize")) {
+    pDdiTable->pfnGetSuggestedLocalWorkSize =
+        ur_tracing_layer::urKernelGetSuggestedLocalWorkSize;
+  }
 
   dditable.pfnGetSuggestedLocalWorkSizeWithArgs =
       pDdiTable->pfnGetSuggestedLocalWorkSizeWithArgs;
-  pDdiTable->pfnGetSuggestedLocalWorkSizeWithArgs =
-      ur_tracing_layer::urKernelGetSuggestedLocalWorkSizeWithArgs;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urKernelGetSuggestedLocalWorkSizeWithArgs")) {
+    pDdiTable->pfnGetSuggestedLocalWorkSizeWithArgs =
+        ur_tracing_layer::urKernelGetSuggestedLocalWorkSizeWithArgs;
+  }
 
   dditable.pfnSetExecInfo = pDdiTable->pfnSetExecInfo;
-  pDdiTable->pfnSetExecInfo = ur_tracing_layer::urKernelSetExecInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urKernelSetExecInfo")) {
+    pDdiTable->pfnSetExecInfo = ur_tracing_layer::urKernelSetExecInfo;
+  }
 
   dditable.pfnSetSpecializationConstants =
       pDdiTable->pfnSetSpecializationConstants;
-  pDdiTable->pfnSetSpecializationConstants =
-      ur_tracing_layer::urKernelSetSpecializationConstants;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urKernelSetSpecializationConstants")) {
+    pDdiTable->pfnSetSpecializationConstants =
+        ur_tracing_layer::urKernelSetSpecializationConstants;
+  }
 
   dditable.pfnSuggestMaxCooperativeGroupCount =
       pDdiTable->pfnSuggestMaxCooperativeGroupCount;
-  pDdiTable->pfnSuggestMaxCooperativeGroupCount =
-      ur_tracing_layer::urKernelSuggestMaxCooperativeGroupCount;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urKernelSuggestMaxCooperativeGroupCount")) {
+    pDdiTable->pfnSuggestMaxCooperativeGroupCount =
+        ur_tracing_layer::urKernelSuggestMaxCooperativeGroupCount;
+  }
 
   return result;
 }
@@ -12360,38 +12701,60 @@ __urdlllocal ur_result_t UR_APICALL urGetMemProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnImageCreate = pDdiTable->pfnImageCreate;
-  pDdiTable->pfnImageCreate = ur_tracing_layer::urMemImageCreate;
+  if (ur_tracing_layer::getContext()->isTraced("urMemImageCreate")) {
+    pDdiTable->pfnImageCreate = ur_tracing_layer::urMemImageCreate;
+  }
 
   dditable.pfnBufferCreate = pDdiTable->pfnBufferCreate;
-  pDdiTable->pfnBufferCreate = ur_tracing_layer::urMemBufferCreate;
+  if (ur_tracing_layer::getContext()->isTraced("urMemBufferCreate")) {
+    pDdiTable->pfnBufferCreate = ur_tracing_layer::urMemBufferCreate;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urMemRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urMemRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urMemRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urMemRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urMemRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urMemRelease;
+  }
 
   dditable.pfnBufferPartition = pDdiTable->pfnBufferPartition;
-  pDdiTable->pfnBufferPartition = ur_tracing_layer::urMemBufferPartition;
+  if (ur_tracing_layer::getContext()->isTraced("urMemBufferPartition")) {
+    pDdiTable->pfnBufferPartition = ur_tracing_layer::urMemBufferPartition;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urMemGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urMemGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urMemGetNativeHandle;
+  }
 
   dditable.pfnBufferCreateWithNativeHandle =
       pDdiTable->pfnBufferCreateWithNativeHandle;
-  pDdiTable->pfnBufferCreateWithNativeHandle =
-      ur_tracing_layer::urMemBufferCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urMemBufferCreateWithNativeHandle")) {
+    pDdiTable->pfnBufferCreateWithNativeHandle =
+        ur_tracing_layer::urMemBufferCreateWithNativeHandle;
+  }
 
   dditable.pfnImageCreateWithNativeHandle =
       pDdiTable->pfnImageCreateWithNativeHandle;
-  pDdiTable->pfnImageCreateWithNativeHandle =
-      ur_tracing_layer::urMemImageCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urMemImageCreateWithNativeHandle")) {
+    pDdiTable->pfnImageCreateWithNativeHandle =
+        ur_tracing_layer::urMemImageCreateWithNativeHandle;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urMemGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urMemGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urMemGetInfo;
+  }
 
   dditable.pfnImageGetInfo = pDdiTable->pfnImageGetInfo;
-  pDdiTable->pfnImageGetInfo = ur_tracing_layer::urMemImageGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urMemImageGetInfo")) {
+    pDdiTable->pfnImageGetInfo = ur_tracing_layer::urMemImageGetInfo;
+  }
 
   return result;
 }
@@ -12422,16 +12785,25 @@ __urdlllocal ur_result_t UR_APICALL urGetMemoryExportExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnAllocExportableMemoryExp = pDdiTable->pfnAllocExportableMemoryExp;
-  pDdiTable->pfnAllocExportableMemoryExp =
-      ur_tracing_layer::urMemoryExportAllocExportableMemoryExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urMemoryExportAllocExportableMemoryExp")) {
+    pDdiTable->pfnAllocExportableMemoryExp =
+        ur_tracing_layer::urMemoryExportAllocExportableMemoryExp;
+  }
 
   dditable.pfnFreeExportableMemoryExp = pDdiTable->pfnFreeExportableMemoryExp;
-  pDdiTable->pfnFreeExportableMemoryExp =
-      ur_tracing_layer::urMemoryExportFreeExportableMemoryExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urMemoryExportFreeExportableMemoryExp")) {
+    pDdiTable->pfnFreeExportableMemoryExp =
+        ur_tracing_layer::urMemoryExportFreeExportableMemoryExp;
+  }
 
   dditable.pfnExportMemoryHandleExp = pDdiTable->pfnExportMemoryHandleExp;
-  pDdiTable->pfnExportMemoryHandleExp =
-      ur_tracing_layer::urMemoryExportExportMemoryHandleExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urMemoryExportExportMemoryHandleExp")) {
+    pDdiTable->pfnExportMemoryHandleExp =
+        ur_tracing_layer::urMemoryExportExportMemoryHandleExp;
+  }
 
   return result;
 }
@@ -12462,16 +12834,24 @@ __urdlllocal ur_result_t UR_APICALL urGetPhysicalMemProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnCreate = pDdiTable->pfnCreate;
-  pDdiTable->pfnCreate = ur_tracing_layer::urPhysicalMemCreate;
+  if (ur_tracing_layer::getContext()->isTraced("urPhysicalMemCreate")) {
+    pDdiTable->pfnCreate = ur_tracing_layer::urPhysicalMemCreate;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urPhysicalMemRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urPhysicalMemRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urPhysicalMemRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urPhysicalMemRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urPhysicalMemRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urPhysicalMemRelease;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urPhysicalMemGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urPhysicalMemGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urPhysicalMemGetInfo;
+  }
 
   return result;
 }
@@ -12502,23 +12882,37 @@ __urdlllocal ur_result_t UR_APICALL urGetPlatformProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnGet = pDdiTable->pfnGet;
-  pDdiTable->pfnGet = ur_tracing_layer::urPlatformGet;
+  if (ur_tracing_layer::getContext()->isTraced("urPlatformGet")) {
+    pDdiTable->pfnGet = ur_tracing_layer::urPlatformGet;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urPlatformGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urPlatformGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urPlatformGetInfo;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urPlatformGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urPlatformGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urPlatformGetNativeHandle;
+  }
 
   dditable.pfnCreateWithNativeHandle = pDdiTable->pfnCreateWithNativeHandle;
-  pDdiTable->pfnCreateWithNativeHandle =
-      ur_tracing_layer::urPlatformCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urPlatformCreateWithNativeHandle")) {
+    pDdiTable->pfnCreateWithNativeHandle =
+        ur_tracing_layer::urPlatformCreateWithNativeHandle;
+  }
 
   dditable.pfnGetApiVersion = pDdiTable->pfnGetApiVersion;
-  pDdiTable->pfnGetApiVersion = ur_tracing_layer::urPlatformGetApiVersion;
+  if (ur_tracing_layer::getContext()->isTraced("urPlatformGetApiVersion")) {
+    pDdiTable->pfnGetApiVersion = ur_tracing_layer::urPlatformGetApiVersion;
+  }
 
   dditable.pfnGetBackendOption = pDdiTable->pfnGetBackendOption;
-  pDdiTable->pfnGetBackendOption = ur_tracing_layer::urPlatformGetBackendOption;
+  if (ur_tracing_layer::getContext()->isTraced("urPlatformGetBackendOption")) {
+    pDdiTable->pfnGetBackendOption =
+        ur_tracing_layer::urPlatformGetBackendOption;
+  }
 
   return result;
 }
@@ -12549,51 +12943,83 @@ __urdlllocal ur_result_t UR_APICALL urGetProgramProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnCreateWithIL = pDdiTable->pfnCreateWithIL;
-  pDdiTable->pfnCreateWithIL = ur_tracing_layer::urProgramCreateWithIL;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramCreateWithIL")) {
+    pDdiTable->pfnCreateWithIL = ur_tracing_layer::urProgramCreateWithIL;
+  }
 
   dditable.pfnCreateWithBinary = pDdiTable->pfnCreateWithBinary;
-  pDdiTable->pfnCreateWithBinary = ur_tracing_layer::urProgramCreateWithBinary;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramCreateWithBinary")) {
+    pDdiTable->pfnCreateWithBinary =
+        ur_tracing_layer::urProgramCreateWithBinary;
+  }
 
   dditable.pfnBuild = pDdiTable->pfnBuild;
-  pDdiTable->pfnBuild = ur_tracing_layer::urProgramBuild;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramBuild")) {
+    pDdiTable->pfnBuild = ur_tracing_layer::urProgramBuild;
+  }
 
   dditable.pfnCompile = pDdiTable->pfnCompile;
-  pDdiTable->pfnCompile = ur_tracing_layer::urProgramCompile;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramCompile")) {
+    pDdiTable->pfnCompile = ur_tracing_layer::urProgramCompile;
+  }
 
   dditable.pfnLink = pDdiTable->pfnLink;
-  pDdiTable->pfnLink = ur_tracing_layer::urProgramLink;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramLink")) {
+    pDdiTable->pfnLink = ur_tracing_layer::urProgramLink;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urProgramRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urProgramRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urProgramRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urProgramRelease;
+  }
 
   dditable.pfnGetFunctionPointer = pDdiTable->pfnGetFunctionPointer;
-  pDdiTable->pfnGetFunctionPointer =
-      ur_tracing_layer::urProgramGetFunctionPointer;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramGetFunctionPointer")) {
+    pDdiTable->pfnGetFunctionPointer =
+        ur_tracing_layer::urProgramGetFunctionPointer;
+  }
 
   dditable.pfnGetGlobalVariablePointer = pDdiTable->pfnGetGlobalVariablePointer;
-  pDdiTable->pfnGetGlobalVariablePointer =
-      ur_tracing_layer::urProgramGetGlobalVariablePointer;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urProgramGetGlobalVariablePointer")) {
+    pDdiTable->pfnGetGlobalVariablePointer =
+        ur_tracing_layer::urProgramGetGlobalVariablePointer;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urProgramGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urProgramGetInfo;
+  }
 
   dditable.pfnGetBuildInfo = pDdiTable->pfnGetBuildInfo;
-  pDdiTable->pfnGetBuildInfo = ur_tracing_layer::urProgramGetBuildInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramGetBuildInfo")) {
+    pDdiTable->pfnGetBuildInfo = ur_tracing_layer::urProgramGetBuildInfo;
+  }
 
   dditable.pfnSetSpecializationConstants =
       pDdiTable->pfnSetSpecializationConstants;
-  pDdiTable->pfnSetSpecializationConstants =
-      ur_tracing_layer::urProgramSetSpecializationConstants;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urProgramSetSpecializationConstants")) {
+    pDdiTable->pfnSetSpecializationConstants =
+        ur_tracing_layer::urProgramSetSpecializationConstants;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urProgramGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urProgramGetNativeHandle;
+  }
 
   dditable.pfnCreateWithNativeHandle = pDdiTable->pfnCreateWithNativeHandle;
-  pDdiTable->pfnCreateWithNativeHandle =
-      ur_tracing_layer::urProgramCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urProgramCreateWithNativeHandle")) {
+    pDdiTable->pfnCreateWithNativeHandle =
+        ur_tracing_layer::urProgramCreateWithNativeHandle;
+  }
 
   return result;
 }
@@ -12624,16 +13050,24 @@ __urdlllocal ur_result_t UR_APICALL urGetProgramExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnDynamicLinkExp = pDdiTable->pfnDynamicLinkExp;
-  pDdiTable->pfnDynamicLinkExp = ur_tracing_layer::urProgramDynamicLinkExp;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramDynamicLinkExp")) {
+    pDdiTable->pfnDynamicLinkExp = ur_tracing_layer::urProgramDynamicLinkExp;
+  }
 
   dditable.pfnBuildExp = pDdiTable->pfnBuildExp;
-  pDdiTable->pfnBuildExp = ur_tracing_layer::urProgramBuildExp;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramBuildExp")) {
+    pDdiTable->pfnBuildExp = ur_tracing_layer::urProgramBuildExp;
+  }
 
   dditable.pfnCompileExp = pDdiTable->pfnCompileExp;
-  pDdiTable->pfnCompileExp = ur_tracing_layer::urProgramCompileExp;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramCompileExp")) {
+    pDdiTable->pfnCompileExp = ur_tracing_layer::urProgramCompileExp;
+  }
 
   dditable.pfnLinkExp = pDdiTable->pfnLinkExp;
-  pDdiTable->pfnLinkExp = ur_tracing_layer::urProgramLinkExp;
+  if (ur_tracing_layer::getContext()->isTraced("urProgramLinkExp")) {
+    pDdiTable->pfnLinkExp = ur_tracing_layer::urProgramLinkExp;
+  }
 
   return result;
 }
@@ -12664,29 +13098,46 @@ __urdlllocal ur_result_t UR_APICALL urGetQueueProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urQueueGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urQueueGetInfo;
+  }
 
   dditable.pfnCreate = pDdiTable->pfnCreate;
-  pDdiTable->pfnCreate = ur_tracing_layer::urQueueCreate;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueCreate")) {
+    pDdiTable->pfnCreate = ur_tracing_layer::urQueueCreate;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urQueueRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urQueueRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urQueueRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urQueueRelease;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urQueueGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urQueueGetNativeHandle;
+  }
 
   dditable.pfnCreateWithNativeHandle = pDdiTable->pfnCreateWithNativeHandle;
-  pDdiTable->pfnCreateWithNativeHandle =
-      ur_tracing_layer::urQueueCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urQueueCreateWithNativeHandle")) {
+    pDdiTable->pfnCreateWithNativeHandle =
+        ur_tracing_layer::urQueueCreateWithNativeHandle;
+  }
 
   dditable.pfnFinish = pDdiTable->pfnFinish;
-  pDdiTable->pfnFinish = ur_tracing_layer::urQueueFinish;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueFinish")) {
+    pDdiTable->pfnFinish = ur_tracing_layer::urQueueFinish;
+  }
 
   dditable.pfnFlush = pDdiTable->pfnFlush;
-  pDdiTable->pfnFlush = ur_tracing_layer::urQueueFlush;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueFlush")) {
+    pDdiTable->pfnFlush = ur_tracing_layer::urQueueFlush;
+  }
 
   return result;
 }
@@ -12717,23 +13168,35 @@ __urdlllocal ur_result_t UR_APICALL urGetQueueExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnBeginGraphCaptureExp = pDdiTable->pfnBeginGraphCaptureExp;
-  pDdiTable->pfnBeginGraphCaptureExp =
-      ur_tracing_layer::urQueueBeginGraphCaptureExp;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueBeginGraphCaptureExp")) {
+    pDdiTable->pfnBeginGraphCaptureExp =
+        ur_tracing_layer::urQueueBeginGraphCaptureExp;
+  }
 
   dditable.pfnBeginCaptureIntoGraphExp = pDdiTable->pfnBeginCaptureIntoGraphExp;
-  pDdiTable->pfnBeginCaptureIntoGraphExp =
-      ur_tracing_layer::urQueueBeginCaptureIntoGraphExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urQueueBeginCaptureIntoGraphExp")) {
+    pDdiTable->pfnBeginCaptureIntoGraphExp =
+        ur_tracing_layer::urQueueBeginCaptureIntoGraphExp;
+  }
 
   dditable.pfnEndGraphCaptureExp = pDdiTable->pfnEndGraphCaptureExp;
-  pDdiTable->pfnEndGraphCaptureExp =
-      ur_tracing_layer::urQueueEndGraphCaptureExp;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueEndGraphCaptureExp")) {
+    pDdiTable->pfnEndGraphCaptureExp =
+        ur_tracing_layer::urQueueEndGraphCaptureExp;
+  }
 
   dditable.pfnIsGraphCaptureEnabledExp = pDdiTable->pfnIsGraphCaptureEnabledExp;
-  pDdiTable->pfnIsGraphCaptureEnabledExp =
-      ur_tracing_layer::urQueueIsGraphCaptureEnabledExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urQueueIsGraphCaptureEnabledExp")) {
+    pDdiTable->pfnIsGraphCaptureEnabledExp =
+        ur_tracing_layer::urQueueIsGraphCaptureEnabledExp;
+  }
 
   dditable.pfnGetGraphExp = pDdiTable->pfnGetGraphExp;
-  pDdiTable->pfnGetGraphExp = ur_tracing_layer::urQueueGetGraphExp;
+  if (ur_tracing_layer::getContext()->isTraced("urQueueGetGraphExp")) {
+    pDdiTable->pfnGetGraphExp = ur_tracing_layer::urQueueGetGraphExp;
+  }
 
   return result;
 }
@@ -12764,23 +13227,36 @@ __urdlllocal ur_result_t UR_APICALL urGetSamplerProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnCreate = pDdiTable->pfnCreate;
-  pDdiTable->pfnCreate = ur_tracing_layer::urSamplerCreate;
+  if (ur_tracing_layer::getContext()->isTraced("urSamplerCreate")) {
+    pDdiTable->pfnCreate = ur_tracing_layer::urSamplerCreate;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urSamplerRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urSamplerRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urSamplerRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urSamplerRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urSamplerRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urSamplerRelease;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urSamplerGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urSamplerGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urSamplerGetInfo;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urSamplerGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urSamplerGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urSamplerGetNativeHandle;
+  }
 
   dditable.pfnCreateWithNativeHandle = pDdiTable->pfnCreateWithNativeHandle;
-  pDdiTable->pfnCreateWithNativeHandle =
-      ur_tracing_layer::urSamplerCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urSamplerCreateWithNativeHandle")) {
+    pDdiTable->pfnCreateWithNativeHandle =
+        ur_tracing_layer::urSamplerCreateWithNativeHandle;
+  }
 
   return result;
 }
@@ -12811,31 +13287,49 @@ __urdlllocal ur_result_t UR_APICALL urGetUSMProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnHostAlloc = pDdiTable->pfnHostAlloc;
-  pDdiTable->pfnHostAlloc = ur_tracing_layer::urUSMHostAlloc;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMHostAlloc")) {
+    pDdiTable->pfnHostAlloc = ur_tracing_layer::urUSMHostAlloc;
+  }
 
   dditable.pfnDeviceAlloc = pDdiTable->pfnDeviceAlloc;
-  pDdiTable->pfnDeviceAlloc = ur_tracing_layer::urUSMDeviceAlloc;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMDeviceAlloc")) {
+    pDdiTable->pfnDeviceAlloc = ur_tracing_layer::urUSMDeviceAlloc;
+  }
 
   dditable.pfnSharedAlloc = pDdiTable->pfnSharedAlloc;
-  pDdiTable->pfnSharedAlloc = ur_tracing_layer::urUSMSharedAlloc;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMSharedAlloc")) {
+    pDdiTable->pfnSharedAlloc = ur_tracing_layer::urUSMSharedAlloc;
+  }
 
   dditable.pfnFree = pDdiTable->pfnFree;
-  pDdiTable->pfnFree = ur_tracing_layer::urUSMFree;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMFree")) {
+    pDdiTable->pfnFree = ur_tracing_layer::urUSMFree;
+  }
 
   dditable.pfnGetMemAllocInfo = pDdiTable->pfnGetMemAllocInfo;
-  pDdiTable->pfnGetMemAllocInfo = ur_tracing_layer::urUSMGetMemAllocInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMGetMemAllocInfo")) {
+    pDdiTable->pfnGetMemAllocInfo = ur_tracing_layer::urUSMGetMemAllocInfo;
+  }
 
   dditable.pfnPoolCreate = pDdiTable->pfnPoolCreate;
-  pDdiTable->pfnPoolCreate = ur_tracing_layer::urUSMPoolCreate;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolCreate")) {
+    pDdiTable->pfnPoolCreate = ur_tracing_layer::urUSMPoolCreate;
+  }
 
   dditable.pfnPoolRetain = pDdiTable->pfnPoolRetain;
-  pDdiTable->pfnPoolRetain = ur_tracing_layer::urUSMPoolRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolRetain")) {
+    pDdiTable->pfnPoolRetain = ur_tracing_layer::urUSMPoolRetain;
+  }
 
   dditable.pfnPoolRelease = pDdiTable->pfnPoolRelease;
-  pDdiTable->pfnPoolRelease = ur_tracing_layer::urUSMPoolRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolRelease")) {
+    pDdiTable->pfnPoolRelease = ur_tracing_layer::urUSMPoolRelease;
+  }
 
   dditable.pfnPoolGetInfo = pDdiTable->pfnPoolGetInfo;
-  pDdiTable->pfnPoolGetInfo = ur_tracing_layer::urUSMPoolGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolGetInfo")) {
+    pDdiTable->pfnPoolGetInfo = ur_tracing_layer::urUSMPoolGetInfo;
+  }
 
   return result;
 }
@@ -12866,52 +13360,81 @@ __urdlllocal ur_result_t UR_APICALL urGetUSMExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnPoolCreateExp = pDdiTable->pfnPoolCreateExp;
-  pDdiTable->pfnPoolCreateExp = ur_tracing_layer::urUSMPoolCreateExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolCreateExp")) {
+    pDdiTable->pfnPoolCreateExp = ur_tracing_layer::urUSMPoolCreateExp;
+  }
 
   dditable.pfnPoolDestroyExp = pDdiTable->pfnPoolDestroyExp;
-  pDdiTable->pfnPoolDestroyExp = ur_tracing_layer::urUSMPoolDestroyExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolDestroyExp")) {
+    pDdiTable->pfnPoolDestroyExp = ur_tracing_layer::urUSMPoolDestroyExp;
+  }
 
   dditable.pfnPoolGetDefaultDevicePoolExp =
       pDdiTable->pfnPoolGetDefaultDevicePoolExp;
-  pDdiTable->pfnPoolGetDefaultDevicePoolExp =
-      ur_tracing_layer::urUSMPoolGetDefaultDevicePoolExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urUSMPoolGetDefaultDevicePoolExp")) {
+    pDdiTable->pfnPoolGetDefaultDevicePoolExp =
+        ur_tracing_layer::urUSMPoolGetDefaultDevicePoolExp;
+  }
 
   dditable.pfnPoolGetInfoExp = pDdiTable->pfnPoolGetInfoExp;
-  pDdiTable->pfnPoolGetInfoExp = ur_tracing_layer::urUSMPoolGetInfoExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolGetInfoExp")) {
+    pDdiTable->pfnPoolGetInfoExp = ur_tracing_layer::urUSMPoolGetInfoExp;
+  }
 
   dditable.pfnPoolSetInfoExp = pDdiTable->pfnPoolSetInfoExp;
-  pDdiTable->pfnPoolSetInfoExp = ur_tracing_layer::urUSMPoolSetInfoExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolSetInfoExp")) {
+    pDdiTable->pfnPoolSetInfoExp = ur_tracing_layer::urUSMPoolSetInfoExp;
+  }
 
   dditable.pfnPoolSetDevicePoolExp = pDdiTable->pfnPoolSetDevicePoolExp;
-  pDdiTable->pfnPoolSetDevicePoolExp =
-      ur_tracing_layer::urUSMPoolSetDevicePoolExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolSetDevicePoolExp")) {
+    pDdiTable->pfnPoolSetDevicePoolExp =
+        ur_tracing_layer::urUSMPoolSetDevicePoolExp;
+  }
 
   dditable.pfnPoolGetDevicePoolExp = pDdiTable->pfnPoolGetDevicePoolExp;
-  pDdiTable->pfnPoolGetDevicePoolExp =
-      ur_tracing_layer::urUSMPoolGetDevicePoolExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolGetDevicePoolExp")) {
+    pDdiTable->pfnPoolGetDevicePoolExp =
+        ur_tracing_layer::urUSMPoolGetDevicePoolExp;
+  }
 
   dditable.pfnPoolTrimToExp = pDdiTable->pfnPoolTrimToExp;
-  pDdiTable->pfnPoolTrimToExp = ur_tracing_layer::urUSMPoolTrimToExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPoolTrimToExp")) {
+    pDdiTable->pfnPoolTrimToExp = ur_tracing_layer::urUSMPoolTrimToExp;
+  }
 
   dditable.pfnPitchedAllocExp = pDdiTable->pfnPitchedAllocExp;
-  pDdiTable->pfnPitchedAllocExp = ur_tracing_layer::urUSMPitchedAllocExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMPitchedAllocExp")) {
+    pDdiTable->pfnPitchedAllocExp = ur_tracing_layer::urUSMPitchedAllocExp;
+  }
 
   dditable.pfnContextMemcpyExp = pDdiTable->pfnContextMemcpyExp;
-  pDdiTable->pfnContextMemcpyExp = ur_tracing_layer::urUSMContextMemcpyExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMContextMemcpyExp")) {
+    pDdiTable->pfnContextMemcpyExp = ur_tracing_layer::urUSMContextMemcpyExp;
+  }
 
   dditable.pfnHostAllocUnregisterExp = pDdiTable->pfnHostAllocUnregisterExp;
-  pDdiTable->pfnHostAllocUnregisterExp =
-      ur_tracing_layer::urUSMHostAllocUnregisterExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMHostAllocUnregisterExp")) {
+    pDdiTable->pfnHostAllocUnregisterExp =
+        ur_tracing_layer::urUSMHostAllocUnregisterExp;
+  }
 
   dditable.pfnHostAllocRegisterExp = pDdiTable->pfnHostAllocRegisterExp;
-  pDdiTable->pfnHostAllocRegisterExp =
-      ur_tracing_layer::urUSMHostAllocRegisterExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMHostAllocRegisterExp")) {
+    pDdiTable->pfnHostAllocRegisterExp =
+        ur_tracing_layer::urUSMHostAllocRegisterExp;
+  }
 
   dditable.pfnImportExp = pDdiTable->pfnImportExp;
-  pDdiTable->pfnImportExp = ur_tracing_layer::urUSMImportExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMImportExp")) {
+    pDdiTable->pfnImportExp = ur_tracing_layer::urUSMImportExp;
+  }
 
   dditable.pfnReleaseExp = pDdiTable->pfnReleaseExp;
-  pDdiTable->pfnReleaseExp = ur_tracing_layer::urUSMReleaseExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUSMReleaseExp")) {
+    pDdiTable->pfnReleaseExp = ur_tracing_layer::urUSMReleaseExp;
+  }
 
   return result;
 }
@@ -12942,16 +13465,24 @@ __urdlllocal ur_result_t UR_APICALL urGetUsmP2PExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnEnablePeerAccessExp = pDdiTable->pfnEnablePeerAccessExp;
-  pDdiTable->pfnEnablePeerAccessExp =
-      ur_tracing_layer::urUsmP2PEnablePeerAccessExp;
+  if (ur_tracing_layer::getContext()->isTraced("urUsmP2PEnablePeerAccessExp")) {
+    pDdiTable->pfnEnablePeerAccessExp =
+        ur_tracing_layer::urUsmP2PEnablePeerAccessExp;
+  }
 
   dditable.pfnDisablePeerAccessExp = pDdiTable->pfnDisablePeerAccessExp;
-  pDdiTable->pfnDisablePeerAccessExp =
-      ur_tracing_layer::urUsmP2PDisablePeerAccessExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urUsmP2PDisablePeerAccessExp")) {
+    pDdiTable->pfnDisablePeerAccessExp =
+        ur_tracing_layer::urUsmP2PDisablePeerAccessExp;
+  }
 
   dditable.pfnPeerAccessGetInfoExp = pDdiTable->pfnPeerAccessGetInfoExp;
-  pDdiTable->pfnPeerAccessGetInfoExp =
-      ur_tracing_layer::urUsmP2PPeerAccessGetInfoExp;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urUsmP2PPeerAccessGetInfoExp")) {
+    pDdiTable->pfnPeerAccessGetInfoExp =
+        ur_tracing_layer::urUsmP2PPeerAccessGetInfoExp;
+  }
 
   return result;
 }
@@ -12982,26 +13513,41 @@ __urdlllocal ur_result_t UR_APICALL urGetVirtualMemProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnGranularityGetInfo = pDdiTable->pfnGranularityGetInfo;
-  pDdiTable->pfnGranularityGetInfo =
-      ur_tracing_layer::urVirtualMemGranularityGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urVirtualMemGranularityGetInfo")) {
+    pDdiTable->pfnGranularityGetInfo =
+        ur_tracing_layer::urVirtualMemGranularityGetInfo;
+  }
 
   dditable.pfnReserve = pDdiTable->pfnReserve;
-  pDdiTable->pfnReserve = ur_tracing_layer::urVirtualMemReserve;
+  if (ur_tracing_layer::getContext()->isTraced("urVirtualMemReserve")) {
+    pDdiTable->pfnReserve = ur_tracing_layer::urVirtualMemReserve;
+  }
 
   dditable.pfnFree = pDdiTable->pfnFree;
-  pDdiTable->pfnFree = ur_tracing_layer::urVirtualMemFree;
+  if (ur_tracing_layer::getContext()->isTraced("urVirtualMemFree")) {
+    pDdiTable->pfnFree = ur_tracing_layer::urVirtualMemFree;
+  }
 
   dditable.pfnMap = pDdiTable->pfnMap;
-  pDdiTable->pfnMap = ur_tracing_layer::urVirtualMemMap;
+  if (ur_tracing_layer::getContext()->isTraced("urVirtualMemMap")) {
+    pDdiTable->pfnMap = ur_tracing_layer::urVirtualMemMap;
+  }
 
   dditable.pfnUnmap = pDdiTable->pfnUnmap;
-  pDdiTable->pfnUnmap = ur_tracing_layer::urVirtualMemUnmap;
+  if (ur_tracing_layer::getContext()->isTraced("urVirtualMemUnmap")) {
+    pDdiTable->pfnUnmap = ur_tracing_layer::urVirtualMemUnmap;
+  }
 
   dditable.pfnSetAccess = pDdiTable->pfnSetAccess;
-  pDdiTable->pfnSetAccess = ur_tracing_layer::urVirtualMemSetAccess;
+  if (ur_tracing_layer::getContext()->isTraced("urVirtualMemSetAccess")) {
+    pDdiTable->pfnSetAccess = ur_tracing_layer::urVirtualMemSetAccess;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urVirtualMemGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urVirtualMemGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urVirtualMemGetInfo;
+  }
 
   return result;
 }
@@ -13032,33 +13578,52 @@ __urdlllocal ur_result_t UR_APICALL urGetDeviceProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnGet = pDdiTable->pfnGet;
-  pDdiTable->pfnGet = ur_tracing_layer::urDeviceGet;
+  if (ur_tracing_layer::getContext()->isTraced("urDeviceGet")) {
+    pDdiTable->pfnGet = ur_tracing_layer::urDeviceGet;
+  }
 
   dditable.pfnGetInfo = pDdiTable->pfnGetInfo;
-  pDdiTable->pfnGetInfo = ur_tracing_layer::urDeviceGetInfo;
+  if (ur_tracing_layer::getContext()->isTraced("urDeviceGetInfo")) {
+    pDdiTable->pfnGetInfo = ur_tracing_layer::urDeviceGetInfo;
+  }
 
   dditable.pfnRetain = pDdiTable->pfnRetain;
-  pDdiTable->pfnRetain = ur_tracing_layer::urDeviceRetain;
+  if (ur_tracing_layer::getContext()->isTraced("urDeviceRetain")) {
+    pDdiTable->pfnRetain = ur_tracing_layer::urDeviceRetain;
+  }
 
   dditable.pfnRelease = pDdiTable->pfnRelease;
-  pDdiTable->pfnRelease = ur_tracing_layer::urDeviceRelease;
+  if (ur_tracing_layer::getContext()->isTraced("urDeviceRelease")) {
+    pDdiTable->pfnRelease = ur_tracing_layer::urDeviceRelease;
+  }
 
   dditable.pfnPartition = pDdiTable->pfnPartition;
-  pDdiTable->pfnPartition = ur_tracing_layer::urDevicePartition;
+  if (ur_tracing_layer::getContext()->isTraced("urDevicePartition")) {
+    pDdiTable->pfnPartition = ur_tracing_layer::urDevicePartition;
+  }
 
   dditable.pfnSelectBinary = pDdiTable->pfnSelectBinary;
-  pDdiTable->pfnSelectBinary = ur_tracing_layer::urDeviceSelectBinary;
+  if (ur_tracing_layer::getContext()->isTraced("urDeviceSelectBinary")) {
+    pDdiTable->pfnSelectBinary = ur_tracing_layer::urDeviceSelectBinary;
+  }
 
   dditable.pfnGetNativeHandle = pDdiTable->pfnGetNativeHandle;
-  pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urDeviceGetNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced("urDeviceGetNativeHandle")) {
+    pDdiTable->pfnGetNativeHandle = ur_tracing_layer::urDeviceGetNativeHandle;
+  }
 
   dditable.pfnCreateWithNativeHandle = pDdiTable->pfnCreateWithNativeHandle;
-  pDdiTable->pfnCreateWithNativeHandle =
-      ur_tracing_layer::urDeviceCreateWithNativeHandle;
+  if (ur_tracing_layer::getContext()->isTraced(
+          "urDeviceCreateWithNativeHandle")) {
+    pDdiTable->pfnCreateWithNativeHandle =
+        ur_tracing_layer::urDeviceCreateWithNativeHandle;
+  }
 
   dditable.pfnGetGlobalTimestamps = pDdiTable->pfnGetGlobalTimestamps;
-  pDdiTable->pfnGetGlobalTimestamps =
-      ur_tracing_layer::urDeviceGetGlobalTimestamps;
+  if (ur_tracing_layer::getContext()->isTraced("urDeviceGetGlobalTimestamps")) {
+    pDdiTable->pfnGetGlobalTimestamps =
+        ur_tracing_layer::urDeviceGetGlobalTimestamps;
+  }
 
   return result;
 }
@@ -13089,7 +13654,9 @@ __urdlllocal ur_result_t UR_APICALL urGetDeviceExpProcAddrTable(
   ur_result_t result = UR_RESULT_SUCCESS;
 
   dditable.pfnWaitExp = pDdiTable->pfnWaitExp;
-  pDdiTable->pfnWaitExp = ur_tracing_layer::urDeviceWaitExp;
+  if (ur_tracing_layer::getContext()->isTraced("urDeviceWaitExp")) {
+    pDdiTable->pfnWaitExp = ur_tracing_layer::urDeviceWaitExp;
+  }
 
   return result;
 }
@@ -13109,6 +13676,9 @@ ur_result_t context_t::init(ur_dditable_t *dditable,
 
   ur_tracing_layer::getContext()->codelocData = codelocData;
 
+  // Untraced functions are left pointing to the next layer
+  ur_tracing_layer::getContext()->initFunctionFilter();
+
   if (UR_RESULT_SUCCESS == result) {
     result = ur_tracing_layer::urGetAdapterProcAddrTable(UR_API_VERSION_CURRENT,
                                                          &dditable->Adapter);
@@ -5,9 +5,11 @@
 #ifndef UR_LEAK_CHECK_H
 #define UR_LEAK_CHECK_H 1
 
-#include "backtrace.hpp"
+#include "ur_stack_depot.hpp"
 #include "ur_validation_layer.hpp"
 
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <typeindex>
 #include <unordered_map>
@@ -20,11 +22,10 @@ private:
   struct RefRuntimeInfo {
     int64_t refCount;
     std::type_index type;
-    std::vector<ur::BacktraceLine> backtrace;
+    uint32_t stackId;
 
-    RefRuntimeInfo(int64_t refCount, std::type_index type,
-                   std::vector<ur::BacktraceLine> backtrace)
-        : refCount(refCount), type(type), backtrace(std::move(backtrace)) {}
+    RefRuntimeInfo(int64_t refCount, std::type_index type, uint32_t stackId)
+        : refCount(refCount), type(type), stackId(stackId) {}
   };
 
   enum RefCountUpdateType {
@@ -34,16 +35,32 @@ private:
     REFCOUNT_DECREASE,
   };
 
-  std::mutex mutex;
-  std::unordered_map<void *, struct RefRuntimeInfo> counts;
-  int64_t adapterCount = 0;
+  // The handles are spread over shards with their own lock, so that threads
+  // creating and releasing different handles rarely contend.
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<void *, struct RefRuntimeInfo> counts;
+  };
+
+  static constexpr size_t NumShards = 64;
+  std::array<Shard, NumShards> shards;
+  std::atomic<int64_t> adapterCount = 0;
+  ur::StackDepot stackDepot;
+
+  Shard &getShard(void *ptr) {
+    // Handles are usually allocated, so their low bits are always the same.
+    auto bits = reinterpret_cast<uintptr_t>(ptr);
+    return shards[((bits >> 4) ^ (bits >> 12)) % NumShards];
+  }
 
   template <typename T>
   void updateRefCount(T handle, enum RefCountUpdateType type,
                       bool isAdapterHandle = false) {
-    std::unique_lock<std::mutex> ulock(mutex);
-
     void *ptr = static_cast<void *>(handle);
+    auto &shard = getShard(ptr);
+    std::unique_lock<std::mutex> ulock(shard.mutex);
+
+    auto &counts = shard.counts;
     auto it = counts.find(ptr);
 
     switch (type) {
@@ -51,7 +68,7 @@ private:
       if (it == counts.end()) {
         std::tie(it, std::ignore) = counts.emplace(
             ptr, RefRuntimeInfo{1, std::type_index(typeid(handle)),
-                                ur::getCurrentBacktrace()});
+                                stackDepot.capture()});
         if (isAdapterHandle) {
           adapterCount++;
         }
@@ -63,7 +80,7 @@ private:
       if (it == counts.end()) {
         std::tie(it, std::ignore) = counts.emplace(
             ptr, RefRuntimeInfo{1, std::type_index(typeid(handle)),
-                                ur::getCurrentBacktrace()});
+                                stackDepot.capture()});
       } else {
         getContext()->logger.log(UR_LOGGER_LEVEL_ERROR, __FILE__,
                                  UR_STR_(__LINE__), "Handle {} already exists",
@@ -85,7 +102,7 @@ private:
       if (it == counts.end()) {
         std::tie(it, std::ignore) = counts.emplace(
             ptr, RefRuntimeInfo{-1, std::type_index(typeid(handle)),
-                                ur::getCurrentBacktrace()});
+                                stackDepot.capture()});
       } else {
         it->second.refCount--;
       }
@@ -105,13 +122,52 @@ private:
                              it->second.refCount);
 
     if (it->second.refCount == 0) {
-      counts.erase(ptr);
+      counts.erase(it);
     }
+    ulock.unlock();
 
     // No more active adapters, so any references still held are leaked
     if (adapterCount == 0) {
-      logInvalidReferences(__FILE__, UR_STR_(__LINE__));
-      counts.clear();
+      auto locks = lockAllShards();
+      // Checked again, as an adapter handle may have been created before the
+      // shards were locked. No handle can change until the report is done.
+      if (adapterCount == 0) {
+        logInvalidReferencesLocked(__FILE__, UR_STR_(__LINE__),
+                                   /* clear= */ true);
+      }
+    }
+  }
+
+  // Locks every shard, in index order so that threads locking them all at
+  // once can't deadlock.
+  std::array<std::unique_lock<std::mutex>, NumShards> lockAllShards() {
+    std::array<std::unique_lock<std::mutex>, NumShards> locks;
+    for (size_t i = 0; i < NumShards; i++) {
+      locks[i] = std::unique_lock<std::mutex>(shards[i].mutex);
+    }
+    return locks;
+  }
+
+  // Must be called with all the shards locked.
+  void logInvalidReferencesLocked(const char *filename, const char *lineno,
+                                  bool clear) {
+    for (auto &shard : shards) {
+      for (auto &[ptr, refRuntimeInfo] : shard.counts) {
+        getContext()->logger.log(UR_LOGGER_LEVEL_ERROR, filename, lineno,
+                                 "Retained {} reference(s) to handle {}",
+                                 refRuntimeInfo.refCount, ptr);
+        getContext()->logger.log(
+            UR_LOGGER_LEVEL_ERROR, filename, lineno,
+            "Handle {} was recorded for first time here:", ptr);
+        auto backtrace = stackDepot.symbolize(refRuntimeInfo.stackId);
+        for (size_t i = 0; i < backtrace.size(); i++) {
+          getContext()->logger.log(UR_LOGGER_LEVEL_ERROR, filename, lineno,
+                                   "#{} {}", i, backtrace[i].c_str());
+        }
+      }
+      if (clear) {
+        shard.counts.clear();
+      }
     }
   }
 
@@ -136,29 +192,21 @@ public:
   }
 
   template <typename T> bool isReferenceValid(T handle) {
-    std::unique_lock<std::mutex> lock(mutex);
-    auto it = counts.find(static_cast<void *>(handle));
-    if (it == counts.end() || it->second.refCount < 1) {
+    void *ptr = static_cast<void *>(handle);
+    auto &shard = getShard(ptr);
+    std::unique_lock<std::mutex> lock(shard.mutex);
+    auto it = shard.counts.find(ptr);
+    if (it == shard.counts.end() || it->second.refCount < 1) {
       return false;
     }
 
     return (it->second.type == std::type_index(typeid(handle)));
   }
 
-  void logInvalidReferences(const char *filename, const char *lineno) {
-    for (auto &[ptr, refRuntimeInfo] : counts) {
-      getContext()->logger.log(UR_LOGGER_LEVEL_ERROR, filename, lineno,
-                               "Retained {} reference(s) to handle {}",
-                               refRuntimeInfo.refCount, ptr);
-      getContext()->logger.log(
-          UR_LOGGER_LEVEL_ERROR, filename, lineno,
-          "Handle {} was recorded for first time here:", ptr);
-      for (size_t i = 0; i < refRuntimeInfo.backtrace.size(); i++) {
-        getContext()->logger.log(UR_LOGGER_LEVEL_ERROR, filename, lineno,
-                                 "#{} {}", i,
-                                 refRuntimeInfo.backtrace[i].c_str());
-      }
-    }
+  void logInvalidReferences(const char *filename, const char *lineno,
+                            bool clear = false) {
+    auto locks = lockAllShards();
+    logInvalidReferencesLocked(filename, lineno, clear);
   }
 
   void logInvalidReference(const char *filename, const char *lineno,
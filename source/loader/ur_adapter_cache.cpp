@@ -0,0 +1,213 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <sstream>
+
+#include "logger/ur_logger.hpp"
+#include "ur_adapter_cache.hpp"
+#include "ur_util.hpp"
+
+namespace ur_loader {
+
+#ifdef _WIN32
+constexpr auto LIBRARY_PATH_ENV = "PATH";
+#else
+constexpr auto LIBRARY_PATH_ENV = "LD_LIBRARY_PATH";
+#endif
+
+// The environment variables that change which devices or libraries the
+// adapters find.
+constexpr const char *KEY_ENVS[] = {
+    "ONEAPI_DEVICE_SELECTOR", "CUDA_VISIBLE_DEVICES", "HIP_VISIBLE_DEVICES",
+    "ROCR_VISIBLE_DEVICES",   "ZE_AFFINITY_MASK",     LIBRARY_PATH_ENV,
+};
+
+static std::optional<int64_t> getModificationTime(const std::string &path) {
+  std::error_code ec;
+  auto time = fs::last_write_time(path, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return static_cast<int64_t>(time.time_since_epoch().count());
+}
+
+std::unique_ptr<AdapterDiscoveryCache> AdapterDiscoveryCache::create() {
+  auto path = ur_getenv("UR_LOADER_DISCOVERY_CACHE");
+  if (!path.has_value()) {
+    return nullptr;
+  }
+
+  std::string environment;
+  for (auto name : KEY_ENVS) {
+    if (auto value = ur_getenv(name)) {
+      environment += '|';
+      environment += name;
+      environment += '=';
+      environment += *value;
+    }
+  }
+
+  auto cache = std::unique_ptr<AdapterDiscoveryCache>(
+      new AdapterDiscoveryCache(*path, std::move(environment)));
+
+  // Each line of the file is an entry, with tab-separated fields. The
+  // dependencies of the library are in the last fields, each made of its
+  // modification time and its path.
+  std::ifstream file(cache->path);
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    std::string key, hasPlatforms;
+    entry entry;
+    if (!std::getline(fields, key, '\t') ||
+        !std::getline(fields, entry.libraryPath, '\t') ||
+        !(fields >> entry.modificationTime >> hasPlatforms)) {
+      continue;
+    }
+    entry.hasPlatforms = hasPlatforms == "1";
+    std::string dependency;
+    fields.ignore(1);
+    while (std::getline(fields, dependency, '\t')) {
+      auto space = dependency.find(' ');
+      if (space != std::string::npos) {
+        entry.dependencies.emplace_back(
+            dependency.substr(space + 1),
+            std::strtoll(dependency.c_str(), nullptr, 10));
+      }
+    }
+    cache->entries.emplace(std::move(key), std::move(entry));
+  }
+
+  return cache;
+}
+
+AdapterDiscoveryCache::AdapterDiscoveryCache(fs::path path,
+                                             std::string environment)
+    : path(std::move(path)), environment(std::move(environment)) {}
+
+std::string AdapterDiscoveryCache::getKey(
+    const std::vector<fs::path> &adapterPaths) const {
+  std::string key;
+  for (const auto &adapterPath : adapterPaths) {
+    key += adapterPath.string();
+    key += ';';
+  }
+  key += environment;
+  // The key must fit in a field of the file.
+  if (key.find_first_of("\t\n") != std::string::npos) {
+    return {};
+  }
+  return key;
+}
+
+bool AdapterDiscoveryCache::skip(const std::string &key) {
+  if (key.empty()) {
+    return false;
+  }
+  std::scoped_lock<std::mutex> lock(mutex);
+  auto it = entries.find(key);
+  if (it == entries.end() || it->second.hasPlatforms) {
+    return false;
+  }
+  // The library or one of its dependencies was updated since it was
+  // recorded.
+  if (getModificationTime(it->second.libraryPath) !=
+      it->second.modificationTime) {
+    return false;
+  }
+  for (const auto &[dependencyPath, modificationTime] :
+       it->second.dependencies) {
+    if (getModificationTime(dependencyPath) != modificationTime) {
+      UR_LOG(INFO, "not skipping adapter {}, {} was updated",
+             it->second.libraryPath, dependencyPath);
+      return false;
+    }
+  }
+  UR_LOG(INFO, "skipping adapter {}, which had no platforms",
+         it->second.libraryPath);
+  return true;
+}
+
+void AdapterDiscoveryCache::record(const std::string &key, HMODULE handle,
+                                   bool hasPlatforms) {
+  if (key.empty() || !handle) {
+    return;
+  }
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it != entries.end() && it->second.hasPlatforms == hasPlatforms) {
+      return;
+    }
+  }
+
+  auto libraryPath = LibLoader::getLibraryPath(handle);
+  auto modificationTime = getModificationTime(libraryPath);
+  if (!modificationTime.has_value()) {
+    return;
+  }
+  entry entry{libraryPath, *modificationTime, hasPlatforms, {}};
+  for (auto &dependencyPath : LibLoader::getDependencyPaths(handle)) {
+    if (auto dependencyTime = getModificationTime(dependencyPath)) {
+      if (dependencyPath.find_first_of("\t\n") == std::string::npos) {
+        entry.dependencies.emplace_back(std::move(dependencyPath),
+                                        *dependencyTime);
+      }
+    }
+  }
+
+  {
+    std::scoped_lock<std::mutex> lock(mutex);
+    entries[key] = std::move(entry);
+    changed = true;
+  }
+  save();
+}
+
+void AdapterDiscoveryCache::save() {
+  std::scoped_lock<std::mutex> lock(mutex);
+  if (!changed) {
+    return;
+  }
+
+  // Other processes may be reading or writing the file, so it's replaced
+  // at once.
+  auto tmpPath = path;
+  tmpPath += ".tmp" + std::to_string(ur_getpid());
+  bool written;
+  {
+    std::ofstream file(tmpPath, std::ios::trunc);
+    for (const auto &[key, entry] : entries) {
+      file << key << '\t' << entry.libraryPath << '\t'
+           << entry.modificationTime << ' ' << entry.hasPlatforms;
+      for (const auto &[dependencyPath, modificationTime] :
+           entry.dependencies) {
+        file << '\t' << modificationTime << ' ' << dependencyPath;
+      }
+      file << '\n';
+    }
+    written = file.good();
+  }
+  std::error_code ec;
+  if (written) {
+    fs::rename(tmpPath, path, ec);
+  }
+  if (!written || ec) {
+    UR_LOG(WARN, "failed to write the adapter discovery cache {}",
+           path.string());
+    fs::remove(tmpPath, ec);
+    return;
+  }
+  changed = false;
+}
+
+} // namespace ur_loader
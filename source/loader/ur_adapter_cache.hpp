@@ -0,0 +1,81 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+#ifndef UR_ADAPTER_CACHE_HPP
+#define UR_ADAPTER_CACHE_HPP 1
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ur_filesystem_resolved.hpp"
+#include "ur_lib_loader.hpp"
+
+namespace fs = filesystem;
+
+namespace ur_loader {
+
+// Remembers across processes which adapter libraries produced no platforms,
+// so that they aren't loaded at all the next time. An entry is keyed on the
+// candidate paths of the adapter and on the environment variables selecting
+// devices and libraries. It is only used while the library it was recorded
+// for, and the libraries that library depended on, such as its driver, keep
+// their modification times. Enabled by setting UR_LOADER_DISCOVERY_CACHE to
+// the path of the cache file.
+//
+// The platforms of an adapter are recorded when the application queries
+// them, so the cache never calls the adapters itself, and all the calls to
+// the adapters go through the layers.
+class AdapterDiscoveryCache {
+public:
+  // Returns nullptr if the cache isn't enabled.
+  static std::unique_ptr<AdapterDiscoveryCache> create();
+
+  // Returns the key of the adapter, which is empty if the adapter can't be
+  // cached.
+  std::string getKey(const std::vector<fs::path> &adapterPaths) const;
+
+  // Whether the adapter produced no platforms the last time it was loaded.
+  bool skip(const std::string &key);
+
+  // Records whether the library loaded for the adapter produces platforms,
+  // and writes the cache file back if that changed.
+  void record(const std::string &key, HMODULE handle, bool hasPlatforms);
+
+  // Writes the cache file back if it changed.
+  void save();
+
+private:
+  struct entry {
+    std::string libraryPath;
+    int64_t modificationTime;
+    bool hasPlatforms;
+    // The paths and modification times of the libraries the library
+    // depended on.
+    std::vector<std::pair<std::string, int64_t>> dependencies;
+  };
+
+  AdapterDiscoveryCache(fs::path path, std::string environment);
+
+  fs::path path;
+  // The part of the keys that depends on the environment.
+  std::string environment;
+
+  std::mutex mutex;
+  std::map<std::string, entry> entries;
+  bool changed = false;
+};
+
+} // namespace ur_loader
+
+#endif /* UR_ADAPTER_CACHE_HPP */
@@ -102,7 +102,7 @@ public:
     try {
       forceLoadedAdaptersOpt = getenv_to_vec("UR_ADAPTERS_FORCE_LOAD");
     } catch (const std::invalid_argument &e) {
-      UR_LOG(ERR, e.what());
+      UR_LOG(ERR, "{}", e.what());
     }
 
     if (forceLoadedAdaptersOpt.has_value()) {
@@ -120,7 +120,7 @@ public:
         try {
           exists = fs::exists(path);
         } catch (std::exception &e) {
-          UR_LOG(ERR, e.what());
+          UR_LOG(ERR, "{}", e.what());
         }
 
         if (exists) {
@@ -205,7 +205,7 @@ private:
     try {
       pathStringsOpt = getenv_to_vec("UR_ADAPTERS_SEARCH_PATH");
     } catch (const std::invalid_argument &e) {
-      UR_LOG(ERR, e.what());
+      UR_LOG(ERR, "{}", e.what());
       return std::nullopt;
     }
 
@@ -0,0 +1,292 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file ur_device_selector.cpp
+ *
+ */
+
+#include "ur_device_selector.hpp"
+#include "logger/ur_logger.hpp"
+
+#include <algorithm>
+
+namespace ur_lib {
+
+DeviceSelector::DeviceSelector() {
+  value = ur_getenv("ONEAPI_DEVICE_SELECTOR");
+
+  // The std::map is sorted by its key, so this method of parsing the ODS env
+  // var alters the ordering of the terms, which makes it impossible to check
+  // whether all discard terms appear after all accept terms and to preserve
+  // the ordering of backends as specified in the ODS string. However, for
+  // single-platform requests, we are only interested in exactly one backend,
+  // and we know that discard filter terms always override accept filter
+  // terms, so the ordering of terms can be safely ignored -- in the special
+  // case where the whole ODS string contains at most one accept term, and at
+  // most one discard term, for that backend.
+  // (If we wished to preserve the ordering of terms, we could replace
+  // `std::map` with `std::queue<std::pair<key_type_t, value_type_t>>` or
+  // something similar.)
+  std::optional<EnvVarMap> maybeEnvVarMap{};
+  try {
+    maybeEnvVarMap =
+        getenv_to_map("ONEAPI_DEVICE_SELECTOR", /* reject_empty= */ false,
+                      /* allow_duplicate= */ false, /* lower= */ true);
+  } catch (...) {
+    UR_LOG(ERR, "ERROR: could not parse ONEAPI_DEVICE_SELECTOR string");
+    parseResult = UR_RESULT_ERROR_INVALID_VALUE;
+    return;
+  }
+  UR_LOG(DEBUG, "getenv_to_map parsed env var and {} a map",
+         (maybeEnvVarMap.has_value() ? "produced" : "failed to produce"));
+
+  // if the ODS env var is not set at all, then pretend it was set to the
+  // default
+  mapODS = maybeEnvVarMap.has_value() ? maybeEnvVarMap.value()
+                                      : EnvVarMap{{"*", {"*"}}};
+}
+
+const DeviceSelector::BackendFilters &
+DeviceSelector::getFilters(ur_backend_t backend) {
+  std::scoped_lock<std::mutex> lock(mutex);
+  auto it = filters.find(backend);
+  if (it == filters.end()) {
+    it = filters.emplace(backend, parseFilters(backend)).first;
+  }
+  return it->second;
+}
+
+std::optional<std::vector<ur_device_handle_t>>
+DeviceSelector::getSelectedDevices(ur_platform_handle_t hPlatform,
+                                   ur_device_type_t DeviceType) {
+  std::scoped_lock<std::mutex> lock(mutex);
+  auto it = selectedDevices.find({hPlatform, DeviceType});
+  if (it == selectedDevices.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+void DeviceSelector::setSelectedDevices(
+    ur_platform_handle_t hPlatform, ur_device_type_t DeviceType,
+    std::vector<ur_device_handle_t> devices) {
+  std::scoped_lock<std::mutex> lock(mutex);
+  selectedDevices[{hPlatform, DeviceType}] = std::move(devices);
+}
+
+DeviceSelector::BackendFilters
+DeviceSelector::parseFilters(ur_backend_t platformBackend) const {
+  constexpr std::pair<const ur_backend_t, const char *> adapters[7] = {
+      {UR_BACKEND_UNKNOWN, "*"},      {UR_BACKEND_LEVEL_ZERO, "level_zero"},
+      {UR_BACKEND_OPENCL, "opencl"},  {UR_BACKEND_CUDA, "cuda"},
+      {UR_BACKEND_HIP, "hip"},        {UR_BACKEND_NATIVE_CPU, "native_cpu"},
+      {UR_BACKEND_OFFLOAD, "offload"}};
+
+  BackendFilters backendFilters;
+  if (parseResult != UR_RESULT_SUCCESS) {
+    backendFilters.result = parseResult;
+    return backendFilters;
+  }
+
+  // the full BNF grammar can be found here:
+  // https://github.com/intel/llvm/blob/sycl/sycl/doc/EnvironmentVariables.md#oneapi_device_selector
+
+  // discardFilter = "!acceptFilter"
+  //  acceptFilter = "backend:filterStrings"
+  // filterStrings = "filterString[,filterString[,...]]"
+  //  filterString = "root[.sub[.subsub]]"
+  //          root = "*|int|cpu|gpu|fpga"
+  //           sub = "*|int"
+  //        subsub = "*|int"
+
+  auto getRootHardwareType = [](const std::string &input) -> ur_device_type_t {
+    std::string lowerInput(input);
+    std::transform(lowerInput.cbegin(), lowerInput.cend(), lowerInput.begin(),
+                   ::tolower);
+    if (lowerInput == "cpu") {
+      return ::UR_DEVICE_TYPE_CPU;
+    }
+    if (lowerInput == "gpu") {
+      return ::UR_DEVICE_TYPE_GPU;
+    }
+    if (lowerInput == "fpga") {
+      return ::UR_DEVICE_TYPE_FPGA;
+    }
+    return ::UR_DEVICE_TYPE_ALL;
+  };
+
+  auto getDeviceId = [&](const std::string &input) -> DeviceIdType {
+    if (input.find_first_not_of("0123456789") == std::string::npos) {
+      return std::stoul(input);
+    }
+    return DeviceIdTypeALL;
+  };
+
+  auto &acceptDeviceList = backendFilters.acceptDeviceList;
+  auto &discardDeviceList = backendFilters.discardDeviceList;
+
+  for (auto &termPair : mapODS) {
+    std::string backend = termPair.first;
+    // TODO: Figure out how to process all ODS errors rather than returning
+    // on the first error.
+    if (backend.empty()) {
+      // FIXME: never true because getenv_to_map rejects this case
+      // malformed term: missing backend -- output ERROR, then continue
+      UR_LOG(ERR, "ERROR: missing backend, format of filter = "
+                  "'[!]backend:filterStrings'");
+      continue;
+    }
+    enum FilterType {
+      AcceptFilter,
+      DiscardFilter,
+    } termType = (backend.front() != '!') ? AcceptFilter : DiscardFilter;
+    UR_LOG(DEBUG, "termType is {}",
+           (termType != AcceptFilter ? "DiscardFilter" : "AcceptFilter"));
+    auto &deviceList =
+        (termType != AcceptFilter) ? discardDeviceList : acceptDeviceList;
+    if (termType != AcceptFilter) {
+      UR_LOG(DEBUG, "DEBUG: backend was '{}'", backend);
+      backend.erase(backend.cbegin());
+      UR_LOG(DEBUG, "DEBUG: backend now '{}'", backend);
+    }
+    // Note the hPlatform -> platformBackend -> platformBackendName conversion
+    // in urDeviceGetSelected guarantees minimal sanity for the comparison with
+    // backend from the ODS string
+    if (backend.front() != '*') {
+      auto cend = &adapters[sizeof(adapters) / sizeof(adapters[0])];
+      auto found = std::find_if(adapters, cend,
+                                [&](auto &p) { return p.second == backend; });
+      if (found == cend) {
+        // It's not a legal backend
+        UR_LOG(ERR, "unrecognised backend '{}'", backend);
+        backendFilters.result = UR_RESULT_ERROR_INVALID_VALUE;
+        return backendFilters;
+      } else if (found->first != platformBackend) {
+        // If it's a rule for a different backend, ignore it
+        continue;
+      }
+    }
+    if (termPair.second.size() == 0) {
+      // malformed term: missing filterStrings -- output ERROR
+      UR_LOG(ERR, "missing filterStrings, format of filter = "
+                  "'[!]backend:filterStrings'");
+      backendFilters.result = UR_RESULT_ERROR_INVALID_VALUE;
+      return backendFilters;
+    }
+    if (std::find_if(termPair.second.cbegin(), termPair.second.cend(),
+                     [](const auto &s) { return s.empty(); }) !=
+        termPair.second.cend()) {
+      // FIXME: never true because getenv_to_map rejects this case
+      // malformed term: missing filterString -- output warning, then continue
+      UR_LOG(WARN, "WARNING: empty filterString, format of filterStrings "
+                   "= 'filterString[,filterString[,...]]'");
+      continue;
+    }
+    if (std::find_if(termPair.second.cbegin(), termPair.second.cend(),
+                     [](const auto &s) {
+                       return std::count(s.cbegin(), s.cend(), '.') > 2;
+                     }) != termPair.second.cend()) {
+      // malformed term: too many dots in filterString
+      UR_LOG(ERR, "too many dots in filterString, format of "
+                  "filterString = 'root[.sub[.subsub]]'");
+      backendFilters.result = UR_RESULT_ERROR_INVALID_VALUE;
+      return backendFilters;
+    }
+    if (std::find_if(termPair.second.cbegin(), termPair.second.cend(),
+                     [](const auto &s) {
+                       // GOOD: "*.*", "1.*.*", "*.*.*"
+                       // BAD: "*.1", "*.", "1.*.2", "*.gpu"
+                       std::string prefix = "*."; // every "*." pattern ...
+                       std::string whole = "*.*"; // ... must be start of "*.*"
+                       std::string::size_type pos = 0;
+                       while ((pos = s.find(prefix, pos)) !=
+                              std::string::npos) {
+                         if (s.substr(pos, whole.size()) != whole) {
+                           return true; // found a BAD thing, either "\*\.$" or
+                                        // "\*\.[^*]"
+                         }
+                         pos += prefix.size();
+                       }
+                       return false; // no BAD things, so must be okay
+                     }) != termPair.second.cend()) {
+      // malformed term: star dot no-star in filterString
+      UR_LOG(ERR, "invalid wildcard in filterString, '*.' => '*.*'");
+      backendFilters.result = UR_RESULT_ERROR_INVALID_VALUE;
+      return backendFilters;
+    }
+
+    // TODO -- validate filterString against the grammar above to catch all
+    // other syntax errors in the ODS string
+
+    for (auto &filterString : termPair.second) {
+      std::string::size_type locationDot1 = filterString.find('.');
+      if (locationDot1 != std::string::npos) {
+        std::string firstPart = filterString.substr(0, locationDot1);
+        const auto hardwareType = getRootHardwareType(firstPart);
+        const auto firstDeviceId = getDeviceId(firstPart);
+        // first dot found, look for another
+        std::string::size_type locationDot2 =
+            filterString.find('.', locationDot1 + 1);
+        std::string secondPart = filterString.substr(
+            locationDot1 + 1, locationDot2 == std::string::npos
+                                  ? std::string::npos
+                                  : locationDot2 - locationDot1);
+        const auto secondDeviceId = getDeviceId(secondPart);
+        if (locationDot2 != std::string::npos) {
+          // second dot found, this is a subsubdevice
+          std::string thirdPart = filterString.substr(locationDot2 + 1);
+          const auto thirdDeviceId = getDeviceId(thirdPart);
+          deviceList.push_back(DeviceSpec{DevicePartLevel::SUBSUB, hardwareType,
+                                          firstDeviceId, secondDeviceId,
+                                          thirdDeviceId, nullptr});
+        } else {
+          // second dot not found, this is a subdevice
+          deviceList.push_back(DeviceSpec{DevicePartLevel::SUB, hardwareType,
+                                          firstDeviceId, secondDeviceId, 0,
+                                          nullptr});
+        }
+      } else {
+        // first dot not found, this is a root device
+        const auto hardwareType = getRootHardwareType(filterString);
+        const auto firstDeviceId = getDeviceId(filterString);
+        deviceList.push_back(DeviceSpec{DevicePartLevel::ROOT, hardwareType,
+                                        firstDeviceId, 0, 0, nullptr});
+      }
+
+      if (deviceList.back().rootId != DeviceIdTypeALL) {
+        backendFilters.deviceIdsInUse = true;
+      }
+      backendFilters.partLevel =
+          std::max(backendFilters.partLevel, deviceList.back().level);
+    }
+  }
+
+  if (acceptDeviceList.size() == 0 && discardDeviceList.size() == 0) {
+    // nothing in env var was understood as a valid term
+    return backendFilters;
+  } else if (acceptDeviceList.size() == 0) {
+    // no accept terms were understood, but at least one discard term was
+    // we are magnanimous to the user when there were bad/ignored accept terms
+    // by pretending there were no bad/ignored accept terms in the env var
+    // for example, we pretend that "garbage:0;!cuda:*" was just "!cuda:*"
+    // so we add an implicit accept-all term (equivalent to prepending "*:*;")
+    // as we would have done if the user had given us the corrected string
+    acceptDeviceList.push_back(DeviceSpec{DevicePartLevel::ROOT,
+                                          ::UR_DEVICE_TYPE_ALL, DeviceIdTypeALL,
+                                          0, 0, nullptr});
+  }
+
+  UR_LOG(DEBUG, "DEBUG: size of acceptDeviceList = {}",
+         acceptDeviceList.size());
+  UR_LOG(DEBUG, "DEBUG: size of discardDeviceList = {}",
+         discardDeviceList.size());
+
+  return backendFilters;
+}
+
+} // namespace ur_lib
@@ -0,0 +1,94 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file ur_device_selector.hpp
+ *
+ */
+
+#ifndef UR_DEVICE_SELECTOR_HPP
+#define UR_DEVICE_SELECTOR_HPP 1
+
+#include "unified-runtime/ur_api.h"
+#include "ur_util.hpp"
+
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ur_lib {
+
+// ONEAPI_DEVICE_SELECTOR, parsed once into the filters that
+// urDeviceGetSelected applies to the devices of each backend. The filters of a
+// backend are built on first use, and the devices selected on a platform are
+// remembered when selecting them doesn't partition any device.
+class DeviceSelector {
+public:
+  enum class DevicePartLevel { ROOT, SUB, SUBSUB };
+
+  using DeviceIdType = unsigned long;
+  static constexpr DeviceIdType DeviceIdTypeALL =
+      -1; // ULONG_MAX but without #include <climits>
+
+  struct DeviceSpec {
+    DevicePartLevel level;
+    ur_device_type_t hwType = ::UR_DEVICE_TYPE_ALL;
+    DeviceIdType rootId = DeviceIdTypeALL;
+    DeviceIdType subId = DeviceIdTypeALL;
+    DeviceIdType subsubId = DeviceIdTypeALL;
+    ur_device_handle_t urDeviceHandle;
+  };
+
+  // The terms of the selector that apply to a backend.
+  struct BackendFilters {
+    // The error to return if the selector is invalid for the backend.
+    ur_result_t result = UR_RESULT_SUCCESS;
+    std::vector<DeviceSpec> acceptDeviceList;
+    std::vector<DeviceSpec> discardDeviceList;
+    bool deviceIdsInUse = false;
+    // The deepest level of devices that the filters refer to, so that devices
+    // are only partitioned when a filter can select their sub-devices.
+    DevicePartLevel partLevel = DevicePartLevel::ROOT;
+  };
+
+  // Parses the current value of ONEAPI_DEVICE_SELECTOR.
+  DeviceSelector();
+
+  // Whether ONEAPI_DEVICE_SELECTOR was changed since it was parsed.
+  bool isStale(const std::optional<std::string> &currentValue) const {
+    return currentValue != value;
+  }
+
+  const BackendFilters &getFilters(ur_backend_t backend);
+
+  std::optional<std::vector<ur_device_handle_t>>
+  getSelectedDevices(ur_platform_handle_t hPlatform,
+                     ur_device_type_t DeviceType);
+  void setSelectedDevices(ur_platform_handle_t hPlatform,
+                          ur_device_type_t DeviceType,
+                          std::vector<ur_device_handle_t> devices);
+
+private:
+  BackendFilters parseFilters(ur_backend_t backend) const;
+
+  std::optional<std::string> value;
+  ur_result_t parseResult = UR_RESULT_SUCCESS;
+  EnvVarMap mapODS;
+
+  std::mutex mutex;
+  std::map<ur_backend_t, BackendFilters> filters;
+  std::map<std::pair<ur_platform_handle_t, ur_device_type_t>,
+           std::vector<ur_device_handle_t>>
+      selectedDevices;
+};
+
+} // namespace ur_lib
+
+#endif /* UR_DEVICE_SELECTOR_HPP */
@@ -0,0 +1,303 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+#include <algorithm>
+#include <cstring>
+
+#include "logger/ur_logger.hpp"
+#include "ur_lazy_adapter.hpp"
+#include "ur_loader.hpp"
+#include "ur_manifests.hpp"
+#include "ur_util.hpp"
+
+namespace ur_loader {
+
+static lazy_adapter_t *getLazyAdapter(ur_adapter_handle_t hAdapter) {
+  return reinterpret_cast<lazy_adapter_t *>(hAdapter);
+}
+
+// Returns the adapter of the library, getting it on the first call.
+static ur_result_t getAdapter(lazy_adapter_t *lazy,
+                              ur_adapter_handle_t *phAdapter) {
+  std::scoped_lock<std::mutex> lock(lazy->mutex);
+  if (!lazy->adapter) {
+    auto *pfnGet = lazy->platform->dditable.Adapter.pfnGet;
+    if (!pfnGet) {
+      return UR_RESULT_ERROR_UNINITIALIZED;
+    }
+    uint32_t numAdapters = 0;
+    ur_adapter_handle_t adapter = nullptr;
+    auto result = pfnGet(1, &adapter, &numAdapters);
+    if (result != UR_RESULT_SUCCESS) {
+      return result;
+    }
+    if (numAdapters == 0 || !adapter) {
+      return UR_RESULT_ERROR_UNINITIALIZED;
+    }
+    UR_LOG(DEBUG, "initialized adapter {} on first use",
+           static_cast<void *>(lazy));
+    lazy->adapter = adapter;
+  }
+  *phAdapter = lazy->adapter;
+  return UR_RESULT_SUCCESS;
+}
+
+template <typename T>
+static ur_result_t returnValue(size_t propSize, void *pPropValue,
+                               size_t *pPropSizeRet, T value) {
+  if (pPropValue) {
+    if (propSize < sizeof(T)) {
+      return UR_RESULT_ERROR_INVALID_SIZE;
+    }
+    std::memcpy(pPropValue, &value, sizeof(T));
+  }
+  if (pPropSizeRet) {
+    *pPropSizeRet = sizeof(T);
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t UR_APICALL adapterRelease(ur_adapter_handle_t hAdapter) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  std::scoped_lock<std::mutex> lock(lazy->mutex);
+  if (lazy->refCount == 0) {
+    return UR_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (--lazy->refCount > 0 || !lazy->adapter) {
+    return UR_RESULT_SUCCESS;
+  }
+  auto adapter = lazy->adapter;
+  lazy->adapter = nullptr;
+  return lazy->platform->dditable.Adapter.pfnRelease(adapter);
+}
+
+static ur_result_t UR_APICALL adapterRetain(ur_adapter_handle_t hAdapter) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  std::scoped_lock<std::mutex> lock(lazy->mutex);
+  lazy->refCount++;
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t UR_APICALL adapterGetLastError(ur_adapter_handle_t hAdapter,
+                                                  const char **ppMessage,
+                                                  int32_t *pError) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  ur_adapter_handle_t adapter;
+  auto result = getAdapter(lazy, &adapter);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  return lazy->platform->dditable.Adapter.pfnGetLastError(adapter, ppMessage,
+                                                          pError);
+}
+
+static ur_result_t UR_APICALL adapterGetInfo(ur_adapter_handle_t hAdapter,
+                                             ur_adapter_info_t propName,
+                                             size_t propSize, void *pPropValue,
+                                             size_t *pPropSizeRet) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  // Applications query the backend to pick the adapters they use, so it's
+  // answered without getting the adapter when the library is known.
+  if (propName == UR_ADAPTER_INFO_BACKEND && lazy->backend.has_value()) {
+    return returnValue(propSize, pPropValue, pPropSizeRet, *lazy->backend);
+  }
+  if (propName == UR_ADAPTER_INFO_REFERENCE_COUNT) {
+    std::scoped_lock<std::mutex> lock(lazy->mutex);
+    return returnValue(propSize, pPropValue, pPropSizeRet, lazy->refCount);
+  }
+
+  ur_adapter_handle_t adapter;
+  auto result = getAdapter(lazy, &adapter);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  return lazy->platform->dditable.Adapter.pfnGetInfo(
+      adapter, propName, propSize, pPropValue, pPropSizeRet);
+}
+
+static ur_result_t UR_APICALL
+adapterSetLoggerCallback(ur_adapter_handle_t hAdapter,
+                         ur_logger_callback_t pfnLoggerCallback,
+                         void *pUserData, ur_logger_level_t level) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  ur_adapter_handle_t adapter;
+  auto result = getAdapter(lazy, &adapter);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  return lazy->platform->dditable.Adapter.pfnSetLoggerCallback(
+      adapter, pfnLoggerCallback, pUserData, level);
+}
+
+static ur_result_t UR_APICALL
+adapterSetLoggerCallbackLevel(ur_adapter_handle_t hAdapter,
+                              ur_logger_level_t level) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  ur_adapter_handle_t adapter;
+  auto result = getAdapter(lazy, &adapter);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  return lazy->platform->dditable.Adapter.pfnSetLoggerCallbackLevel(adapter,
+                                                                    level);
+}
+
+static ur_result_t UR_APICALL platformGet(ur_adapter_handle_t hAdapter,
+                                          uint32_t NumEntries,
+                                          ur_platform_handle_t *phPlatforms,
+                                          uint32_t *pNumPlatforms) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  ur_adapter_handle_t adapter;
+  auto result = getAdapter(lazy, &adapter);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  return lazy->platform->dditable.Platform.pfnGet(adapter, NumEntries,
+                                                  phPlatforms, pNumPlatforms);
+}
+
+static ur_result_t UR_APICALL platformCreateWithNativeHandle(
+    ur_native_handle_t hNativePlatform, ur_adapter_handle_t hAdapter,
+    const ur_platform_native_properties_t *pProperties,
+    ur_platform_handle_t *phPlatform) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  ur_adapter_handle_t adapter;
+  auto result = getAdapter(lazy, &adapter);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  return lazy->platform->dditable.Platform.pfnCreateWithNativeHandle(
+      hNativePlatform, adapter, pProperties, phPlatform);
+}
+
+static ur_result_t UR_APICALL deviceCreateWithNativeHandle(
+    ur_native_handle_t hNativeDevice, ur_adapter_handle_t hAdapter,
+    const ur_device_native_properties_t *pProperties,
+    ur_device_handle_t *phDevice) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  ur_adapter_handle_t adapter;
+  auto result = getAdapter(lazy, &adapter);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  return lazy->platform->dditable.Device.pfnCreateWithNativeHandle(
+      hNativeDevice, adapter, pProperties, phDevice);
+}
+
+static ur_result_t UR_APICALL contextCreateWithNativeHandle(
+    ur_native_handle_t hNativeContext, ur_adapter_handle_t hAdapter,
+    uint32_t numDevices, const ur_device_handle_t *phDevices,
+    const ur_context_native_properties_t *pProperties,
+    ur_context_handle_t *phContext) {
+  auto *lazy = getLazyAdapter(hAdapter);
+  ur_adapter_handle_t adapter;
+  auto result = getAdapter(lazy, &adapter);
+  if (result != UR_RESULT_SUCCESS) {
+    return result;
+  }
+  return lazy->platform->dditable.Context.pfnCreateWithNativeHandle(
+      hNativeContext, adapter, numDevices, phDevices, pProperties, phContext);
+}
+
+// Returns the backend of the library loaded for the platform, if it's one of
+// the known adapters.
+static std::optional<ur_backend_t> getBackend(const platform_t &platform) {
+  if (!platform.handle) {
+    return std::nullopt;
+  }
+  auto libraryPath = LibLoader::getLibraryPath(platform.handle.get());
+  auto fileName = fs::path(libraryPath).filename().string();
+  for (const auto &manifest : ur_adapter_manifests) {
+    if (fileName == manifest.library) {
+      return manifest.backend;
+    }
+  }
+  return std::nullopt;
+}
+
+std::unique_ptr<LazyAdapters> LazyAdapters::create() {
+  if (!getenv_tobool("UR_LOADER_LAZY_ADAPTERS")) {
+    return nullptr;
+  }
+  return std::unique_ptr<LazyAdapters>(new LazyAdapters());
+}
+
+ur_result_t LazyAdapters::get(std::vector<platform_t> &platforms,
+                              uint32_t NumEntries,
+                              ur_adapter_handle_t *phAdapters,
+                              uint32_t *pNumAdapters) {
+  // The tables of the libraries are only complete once the loader is
+  // initialized, so the adapters are created on the first call.
+  std::call_once(created, [&] {
+    for (auto &platform : platforms) {
+      if (platform.initStatus != UR_RESULT_SUCCESS) {
+        continue;
+      }
+      auto lazy = std::make_unique<lazy_adapter_t>();
+      lazy->proxyDdiTable = platform.dditable;
+      lazy->dditable = &lazy->proxyDdiTable;
+      lazy->platform = &platform;
+      lazy->backend = getBackend(platform);
+
+      auto &adapterTable = lazy->proxyDdiTable.Adapter;
+      adapterTable.pfnRelease = adapterRelease;
+      adapterTable.pfnRetain = adapterRetain;
+      adapterTable.pfnGetLastError = adapterGetLastError;
+      adapterTable.pfnGetInfo = adapterGetInfo;
+      adapterTable.pfnSetLoggerCallback = adapterSetLoggerCallback;
+      adapterTable.pfnSetLoggerCallbackLevel = adapterSetLoggerCallbackLevel;
+      lazy->proxyDdiTable.Platform.pfnGet = platformGet;
+      lazy->proxyDdiTable.Platform.pfnCreateWithNativeHandle =
+          platformCreateWithNativeHandle;
+      lazy->proxyDdiTable.Device.pfnCreateWithNativeHandle =
+          deviceCreateWithNativeHandle;
+      lazy->proxyDdiTable.Context.pfnCreateWithNativeHandle =
+          contextCreateWithNativeHandle;
+
+      adapters.push_back(std::move(lazy));
+    }
+  });
+
+  if (phAdapters) {
+    uint32_t count =
+        std::min(NumEntries, static_cast<uint32_t>(adapters.size()));
+    for (uint32_t i = 0; i < count; i++) {
+      adapterRetain(reinterpret_cast<ur_adapter_handle_t>(adapters[i].get()));
+      phAdapters[i] = reinterpret_cast<ur_adapter_handle_t>(adapters[i].get());
+    }
+  }
+  if (pNumAdapters) {
+    *pNumAdapters = static_cast<uint32_t>(adapters.size());
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+ur_adapter_handle_t LazyAdapters::getHandle(ur_adapter_handle_t adapter) {
+  if (!adapter) {
+    return adapter;
+  }
+  for (auto &lazy : adapters) {
+    std::scoped_lock<std::mutex> lock(lazy->mutex);
+    if (lazy->adapter == adapter) {
+      return reinterpret_cast<ur_adapter_handle_t>(lazy.get());
+    }
+  }
+  return adapter;
+}
+
+platform_t *LazyAdapters::getPlatform(ur_adapter_handle_t hAdapter) {
+  for (auto &lazy : adapters) {
+    if (reinterpret_cast<ur_adapter_handle_t>(lazy.get()) == hAdapter) {
+      return lazy->platform;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace ur_loader
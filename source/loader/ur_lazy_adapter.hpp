@@ -0,0 +1,71 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+#ifndef UR_LAZY_ADAPTER_HPP
+#define UR_LAZY_ADAPTER_HPP 1
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "unified-runtime/ur_ddi.h"
+
+namespace ur_loader {
+
+struct platform_t;
+
+// Stands in for the adapter of a loaded library until the adapter is needed.
+// Its handle dispatches to the functions of the library, except for the
+// functions taking an adapter handle, which get the adapter of the library on
+// their first call and forward it.
+struct lazy_adapter_t {
+  // The loader dispatches on the first member of the handles.
+  ur_dditable_t *dditable;
+  ur_dditable_t proxyDdiTable;
+  platform_t *platform;
+  // The backend of the library, if it's one of the known adapters.
+  std::optional<ur_backend_t> backend;
+
+  std::mutex mutex;
+  ur_adapter_handle_t adapter = nullptr;
+  uint32_t refCount = 0;
+};
+
+// Defers calling urAdapterGet of every loaded library until the application
+// uses the adapter, so that backends that the application skips, e.g. by
+// querying UR_ADAPTER_INFO_BACKEND, are never initialized. Enabled by setting
+// UR_LOADER_LAZY_ADAPTERS.
+class LazyAdapters {
+public:
+  // Returns nullptr if lazy adapters aren't enabled.
+  static std::unique_ptr<LazyAdapters> create();
+
+  // Implements urAdapterGet, with one adapter per loaded library.
+  ur_result_t get(std::vector<platform_t> &platforms, uint32_t NumEntries,
+                  ur_adapter_handle_t *phAdapters, uint32_t *pNumAdapters);
+
+  // Returns the handle that the application knows the adapter by.
+  ur_adapter_handle_t getHandle(ur_adapter_handle_t adapter);
+
+  // Returns the platform of the lazy adapter, or nullptr if the handle isn't
+  // one of the lazy adapters.
+  platform_t *getPlatform(ur_adapter_handle_t hAdapter);
+
+private:
+  LazyAdapters() = default;
+
+  std::once_flag created;
+  std::vector<std::unique_ptr<lazy_adapter_t>> adapters;
+};
+
+} // namespace ur_loader
+
+#endif /* UR_LAZY_ADAPTER_HPP */
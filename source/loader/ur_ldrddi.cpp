@@ -33,42 +33,11 @@ __urdlllocal ur_result_t UR_APICALL urAdapterGet(
 
   auto context = getContext();
 
-  uint32_t numAdapters = 0;
-  for (auto &platform : context->platforms) {
-    if (platform.initStatus != UR_RESULT_SUCCESS)
-      continue;
-
-    auto *pfnGet = platform.dditable.Adapter.pfnGet;
-    if (*pfnGet == nullptr)
-      return UR_RESULT_ERROR_UNINITIALIZED;
-
-    // Count adapters without writing handles when the caller did not request
-    // them or its output array is already full.
-    if (phAdapters == nullptr || numAdapters >= NumEntries) {
-      uint32_t adapter = 0;
-      auto result = pfnGet(0, nullptr, &adapter);
-      if (result == UR_RESULT_SUCCESS)
-        numAdapters += adapter;
-      continue;
-    }
+  if (context->lazyAdapters)
+    return context->lazyAdapters->get(context->platforms, NumEntries,
+                                      phAdapters, pNumAdapters);
 
-    // Query single adapter into a temporary handle and copy it to output array
-    // if the query was successful.
-    uint32_t adapter = 0;
-    ur_adapter_handle_t adapterHandle = nullptr;
-    auto result = pfnGet(1, &adapterHandle, &adapter);
-    if (result != UR_RESULT_SUCCESS || adapterHandle == nullptr)
-      continue;
-
-    phAdapters[numAdapters] = adapterHandle;
-    numAdapters += adapter;
-  }
-
-  if (pNumAdapters != nullptr) {
-    *pNumAdapters = numAdapters;
-  }
-
-  return UR_RESULT_SUCCESS;
+  return context->getAdapters(NumEntries, phAdapters, pNumAdapters);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -218,7 +187,13 @@ __urdlllocal ur_result_t UR_APICALL urPlatformGet(
     return UR_RESULT_ERROR_UNINITIALIZED;
 
   // forward to device-platform
-  return pfnGet(hAdapter, NumEntries, phPlatforms, pNumPlatforms);
+  auto result = pfnGet(hAdapter, NumEntries, phPlatforms, pNumPlatforms);
+
+  // Remember whether the adapter has platforms for the next processes.
+  if (result == UR_RESULT_SUCCESS && pNumPlatforms != nullptr)
+    getContext()->recordPlatforms(hAdapter, *pNumPlatforms);
+
+  return result;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -247,7 +222,18 @@ __urdlllocal ur_result_t UR_APICALL urPlatformGetInfo(
     return UR_RESULT_ERROR_UNINITIALIZED;
 
   // forward to device-platform
-  return pfnGetInfo(hPlatform, propName, propSize, pPropValue, pPropSizeRet);
+  auto result =
+      pfnGetInfo(hPlatform, propName, propSize, pPropValue, pPropSizeRet);
+
+  // The application knows lazy adapters by the handles of the loader.
+  auto context = getContext();
+  if (result == UR_RESULT_SUCCESS && context->lazyAdapters &&
+      propName == UR_PLATFORM_INFO_ADAPTER && pPropValue != nullptr) {
+    auto *phAdapter = static_cast<ur_adapter_handle_t *>(pPropValue);
+    *phAdapter = context->lazyAdapters->getHandle(*phAdapter);
+  }
+
+  return result;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
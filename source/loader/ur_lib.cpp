@@ -23,7 +23,6 @@
 #include "ur_loader.hpp"
 
 #include <cstring> // for std::memcpy
-#include <regex>
 #include <stdlib.h>
 
 // With static UMF, its library destructor finalizes UMF before the loader
@@ -63,6 +62,15 @@ ur_result_t context_t::initLayers() {
   return UR_RESULT_SUCCESS;
 }
 
+std::shared_ptr<DeviceSelector> context_t::getDeviceSelector() {
+  auto value = ur_getenv("ONEAPI_DEVICE_SELECTOR");
+  std::scoped_lock<std::mutex> lock(deviceSelectorMutex);
+  if (!deviceSelector || deviceSelector->isStale(value)) {
+    deviceSelector = std::make_shared<DeviceSelector>();
+  }
+  return deviceSelector;
+}
+
 void context_t::tearDownLayers() const {
   for (auto it = layers.rbegin(); it != layers.rend(); ++it) {
     auto [layer, destroy] = *it;
@@ -266,348 +274,17 @@ urLoaderConfigSetMockingEnabled(ur_loader_config_handle_t hLoaderConfig,
   return UR_RESULT_SUCCESS;
 }
 
-ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
-                                ur_device_type_t DeviceType,
-                                uint32_t NumEntries,
-                                ur_device_handle_t *phDevices,
-                                uint32_t *pNumDevices) {
-  constexpr std::pair<const ur_backend_t, const char *> adapters[7] = {
-      {UR_BACKEND_UNKNOWN, "*"},      {UR_BACKEND_LEVEL_ZERO, "level_zero"},
-      {UR_BACKEND_OPENCL, "opencl"},  {UR_BACKEND_CUDA, "cuda"},
-      {UR_BACKEND_HIP, "hip"},        {UR_BACKEND_NATIVE_CPU, "native_cpu"},
-      {UR_BACKEND_OFFLOAD, "offload"}};
-
-  if (!hPlatform) {
-    return UR_RESULT_ERROR_INVALID_NULL_HANDLE;
-  }
-  if (NumEntries > 0 && !phDevices) {
-    return UR_RESULT_ERROR_INVALID_NULL_POINTER;
-  }
-  // pNumDevices is the actual number of device handles added to phDevices by
-  // this function
-  if (NumEntries == 0 && !pNumDevices) {
-    return UR_RESULT_ERROR_INVALID_SIZE;
-  }
-
-  switch (DeviceType) {
-  case UR_DEVICE_TYPE_ALL:
-  case UR_DEVICE_TYPE_GPU:
-  case UR_DEVICE_TYPE_DEFAULT:
-  case UR_DEVICE_TYPE_CPU:
-  case UR_DEVICE_TYPE_FPGA:
-  case UR_DEVICE_TYPE_MCA:
-  case UR_DEVICE_TYPE_CUSTOM:
-    break;
-  default:
-    return UR_RESULT_ERROR_INVALID_ENUMERATION;
-    // urPrint("Unknown device type");
-    break;
-  }
-  // plan:
-  // 0. basic validation of argument values (see code above)
-  // 1. conversion of argument values into useful data items
-  // 2. retrieval and parsing of environment variable string
-  // 3. conversion of term map to accept and discard filters
-  // 4. inserting a default "*:*" accept filter, if required
-  // 5. symbolic consolidation of accept and discard filters
-  // 6. querying the platform handles for all 'root' devices
-  // 7. partioning via platform root devices into subdevices
-  // 8. partioning via platform subdevices into subsubdevices
-  // 9. short-listing devices to accept using accept filters
-  // A. de-listing devices to discard using discard filters
-
-  // possible symbolic short-circuit special cases exist:
-  // * if there are no terms,     select all   root devices
-  // * if any discard is "*",     select no    root devices
-  // * if any discard is "*.*",   select no     sub-devices
-  // * if any discard is "*.*.*", select no sub-sub-devices
-  // *
-  //
-  // detail for step 5 of above plan:
-  // * combine all accept filters into a single accept list
-  // * combine all discard filters into single discard list
-  // then invert it to make the initial/default accept list
-  // (needs knowledge of the valid range from the platform)
-  // "!level_zero:1,2" -> "level_zero:0,3,...,max"
-  // * finally subtract the discard set from the accept set
-
-  // accept  "2,*" != "*,2"
-  // because "2,*" == "2,0,1,3"
-  // whereas "*,2" == "0,1,2,3"
-  // however
-  // discard "2,*" == "*,2"
-
-  // The std::map is sorted by its key, so this method of parsing the ODS env
-  // var alters the ordering of the terms, which makes it impossible to check
-  // whether all discard terms appear after all accept terms and to preserve the
-  // ordering of backends as specified in the ODS string. However, for
-  // single-platform requests, we are only interested in exactly one backend,
-  // and we know that discard filter terms always override accept filter terms,
-  // so the ordering of terms can be safely ignored -- in the special case where
-  // the whole ODS string contains at most one accept term, and at most one
-  // discard term, for that backend.
-  // (If we wished to preserve the ordering of terms, we could replace
-  // `std::map` with `std::queue<std::pair<key_type_t, value_type_t>>` or
-  // something similar.)
-  std::optional<EnvVarMap> maybeEnvVarMap{};
-  try {
-    maybeEnvVarMap =
-        getenv_to_map("ONEAPI_DEVICE_SELECTOR", /* reject_empty= */ false,
-                      /* allow_duplicate= */ false, /* lower= */ true);
-  } catch (...) {
-    UR_LOG(ERR, "ERROR: could not parse ONEAPI_DEVICE_SELECTOR string");
-    return UR_RESULT_ERROR_INVALID_VALUE;
-  }
-  UR_LOG(DEBUG, "getenv_to_map parsed env var and {} a map",
-         (maybeEnvVarMap.has_value() ? "produced" : "failed to produce"));
-
-  // if the ODS env var is not set at all, then pretend it was set to the
-  // default
-  using EnvVarMap = std::map<std::string, std::vector<std::string>>;
-  EnvVarMap mapODS = maybeEnvVarMap.has_value() ? maybeEnvVarMap.value()
-                                                : EnvVarMap{{"*", {"*"}}};
-
-  // the full BNF grammar can be found here:
-  // https://github.com/intel/llvm/blob/sycl/sycl/doc/EnvironmentVariables.md#oneapi_device_selector
-
-  // discardFilter = "!acceptFilter"
-  //  acceptFilter = "backend:filterStrings"
-  // filterStrings = "filterString[,filterString[,...]]"
-  //  filterString = "root[.sub[.subsub]]"
-  //          root = "*|int|cpu|gpu|fpga"
-  //           sub = "*|int"
-  //        subsub = "*|int"
-
-  // validation regex for filterString (not used in this code)
-  std::regex validation_pattern(
-      "^("
-      "\\*" // C++ escape for \, regex escape for literal '*'
-      "|"
-      "cpu" // ensure case-insenitive, when using
-      "|"
-      "gpu" // ensure case-insenitive, when using
-      "|"
-      "fpga" // ensure case-insenitive, when using
-      "|"
-      "[[:digit:]]+" // '<num>'
-      "|"
-      "[[:digit:]]+\\.[[:digit:]]+" // '<num>.<num>'
-      "|"
-      "[[:digit:]]+\\.\\*" // '<num>.*.*'
-      "|"
-      "\\*\\.\\*" // C++ and regex escapes, literal '*.*'
-      "|"
-      "[[:digit:]]+\\.[[:digit:]]+\\.[[:digit:]]+" // '<num>.<num>.<num>'
-      "|"
-      "[[:digit:]]+\\.[[:digit:]]+\\.\\*" // '<num>.<num>.*'
-      "|"
-      "[[:digit:]]+\\.\\*\\.\\*" // '<num>.*.*'
-      "|"
-      "\\*\\.\\*\\.\\*" // C++ and regex escapes, literal '*.*.*'
-      ")$",
-      std::regex_constants::icase);
-
-  ur_backend_t platformBackend;
-  if (UR_RESULT_SUCCESS !=
-      urPlatformGetInfo(hPlatform, UR_PLATFORM_INFO_BACKEND,
-                        sizeof(ur_backend_t), &platformBackend, 0)) {
-    return UR_RESULT_ERROR_INVALID_PLATFORM;
-  }
-
+// Applies the filters of the platform's backend to the devices of the
+// platform.
+static ur_result_t
+selectDevices(ur_platform_handle_t hPlatform, ur_device_type_t DeviceType,
+              const DeviceSelector::BackendFilters &filters,
+              std::vector<ur_device_handle_t> &selectedDevices) {
   using DeviceHardwareType = ur_device_type_t;
-
-  enum class DevicePartLevel { ROOT, SUB, SUBSUB };
-
-  using DeviceIdType = unsigned long;
-  constexpr DeviceIdType DeviceIdTypeALL =
-      -1; // ULONG_MAX but without #include <climits>
-
-  struct DeviceSpec {
-    DevicePartLevel level;
-    DeviceHardwareType hwType = ::UR_DEVICE_TYPE_ALL;
-    DeviceIdType rootId = DeviceIdTypeALL;
-    DeviceIdType subId = DeviceIdTypeALL;
-    DeviceIdType subsubId = DeviceIdTypeALL;
-    ur_device_handle_t urDeviceHandle;
-  };
-
-  auto getRootHardwareType =
-      [](const std::string &input) -> DeviceHardwareType {
-    std::string lowerInput(input);
-    std::transform(lowerInput.cbegin(), lowerInput.cend(), lowerInput.begin(),
-                   ::tolower);
-    if (lowerInput == "cpu") {
-      return ::UR_DEVICE_TYPE_CPU;
-    }
-    if (lowerInput == "gpu") {
-      return ::UR_DEVICE_TYPE_GPU;
-    }
-    if (lowerInput == "fpga") {
-      return ::UR_DEVICE_TYPE_FPGA;
-    }
-    return ::UR_DEVICE_TYPE_ALL;
-  };
-
-  auto getDeviceId = [&](const std::string &input) -> DeviceIdType {
-    if (input.find_first_not_of("0123456789") == std::string::npos) {
-      return std::stoul(input);
-    }
-    return DeviceIdTypeALL;
-  };
-
-  std::vector<DeviceSpec> acceptDeviceList;
-  std::vector<DeviceSpec> discardDeviceList;
-
-  bool deviceIdsInUse = false;
-  for (auto &termPair : mapODS) {
-    std::string backend = termPair.first;
-    // TODO: Figure out how to process all ODS errors rather than returning
-    // on the first error.
-    if (backend.empty()) {
-      // FIXME: never true because getenv_to_map rejects this case
-      // malformed term: missing backend -- output ERROR, then continue
-      UR_LOG(ERR, "ERROR: missing backend, format of filter = "
-                  "'[!]backend:filterStrings'");
-      continue;
-    }
-    enum FilterType {
-      AcceptFilter,
-      DiscardFilter,
-    } termType = (backend.front() != '!') ? AcceptFilter : DiscardFilter;
-    UR_LOG(DEBUG, "termType is {}",
-           (termType != AcceptFilter ? "DiscardFilter" : "AcceptFilter"));
-    auto &deviceList =
-        (termType != AcceptFilter) ? discardDeviceList : acceptDeviceList;
-    if (termType != AcceptFilter) {
-      UR_LOG(DEBUG, "DEBUG: backend was '{}'", backend);
-      backend.erase(backend.cbegin());
-      UR_LOG(DEBUG, "DEBUG: backend now '{}'", backend);
-    }
-    // Note the hPlatform -> platformBackend -> platformBackendName conversion
-    // above guarantees minimal sanity for the comparison with backend from the
-    // ODS string
-    if (backend.front() != '*') {
-      auto cend = &adapters[sizeof(adapters) / sizeof(adapters[0])];
-      auto found = std::find_if(adapters, cend,
-                                [&](auto &p) { return p.second == backend; });
-      if (found == cend) {
-        // It's not a legal backend
-        UR_LOG(ERR, "unrecognised backend '{}'", backend);
-        return UR_RESULT_ERROR_INVALID_VALUE;
-      } else if (found->first != platformBackend) {
-        // If it's a rule for a different backend, ignore it
-        continue;
-      }
-    }
-    if (termPair.second.size() == 0) {
-      // malformed term: missing filterStrings -- output ERROR
-      UR_LOG(ERR, "missing filterStrings, format of filter = "
-                  "'[!]backend:filterStrings'");
-      return UR_RESULT_ERROR_INVALID_VALUE;
-    }
-    if (std::find_if(termPair.second.cbegin(), termPair.second.cend(),
-                     [](const auto &s) { return s.empty(); }) !=
-        termPair.second.cend()) {
-      // FIXME: never true because getenv_to_map rejects this case
-      // malformed term: missing filterString -- output warning, then continue
-      UR_LOG(WARN, "WARNING: empty filterString, format of filterStrings "
-                   "= 'filterString[,filterString[,...]]'");
-      continue;
-    }
-    if (std::find_if(termPair.second.cbegin(), termPair.second.cend(),
-                     [](const auto &s) {
-                       return std::count(s.cbegin(), s.cend(), '.') > 2;
-                     }) != termPair.second.cend()) {
-      // malformed term: too many dots in filterString
-      UR_LOG(ERR, "too many dots in filterString, format of "
-                  "filterString = 'root[.sub[.subsub]]'");
-      return UR_RESULT_ERROR_INVALID_VALUE;
-    }
-    if (std::find_if(termPair.second.cbegin(), termPair.second.cend(),
-                     [](const auto &s) {
-                       // GOOD: "*.*", "1.*.*", "*.*.*"
-                       // BAD: "*.1", "*.", "1.*.2", "*.gpu"
-                       std::string prefix = "*."; // every "*." pattern ...
-                       std::string whole = "*.*"; // ... must be start of "*.*"
-                       std::string::size_type pos = 0;
-                       while ((pos = s.find(prefix, pos)) !=
-                              std::string::npos) {
-                         if (s.substr(pos, whole.size()) != whole) {
-                           return true; // found a BAD thing, either "\*\.$" or
-                                        // "\*\.[^*]"
-                         }
-                         pos += prefix.size();
-                       }
-                       return false; // no BAD things, so must be okay
-                     }) != termPair.second.cend()) {
-      // malformed term: star dot no-star in filterString
-      UR_LOG(ERR, "invalid wildcard in filterString, '*.' => '*.*'");
-      return UR_RESULT_ERROR_INVALID_VALUE;
-    }
-
-    // TODO -- use regex validation_pattern to catch all other syntax errors in
-    // the ODS string
-
-    for (auto &filterString : termPair.second) {
-      std::string::size_type locationDot1 = filterString.find('.');
-      if (locationDot1 != std::string::npos) {
-        std::string firstPart = filterString.substr(0, locationDot1);
-        const auto hardwareType = getRootHardwareType(firstPart);
-        const auto firstDeviceId = getDeviceId(firstPart);
-        // first dot found, look for another
-        std::string::size_type locationDot2 =
-            filterString.find('.', locationDot1 + 1);
-        std::string secondPart = filterString.substr(
-            locationDot1 + 1, locationDot2 == std::string::npos
-                                  ? std::string::npos
-                                  : locationDot2 - locationDot1);
-        const auto secondDeviceId = getDeviceId(secondPart);
-        if (locationDot2 != std::string::npos) {
-          // second dot found, this is a subsubdevice
-          std::string thirdPart = filterString.substr(locationDot2 + 1);
-          const auto thirdDeviceId = getDeviceId(thirdPart);
-          deviceList.push_back(DeviceSpec{DevicePartLevel::SUBSUB, hardwareType,
-                                          firstDeviceId, secondDeviceId,
-                                          thirdDeviceId, nullptr});
-        } else {
-          // second dot not found, this is a subdevice
-          deviceList.push_back(DeviceSpec{DevicePartLevel::SUB, hardwareType,
-                                          firstDeviceId, secondDeviceId, 0,
-                                          nullptr});
-        }
-      } else {
-        // first dot not found, this is a root device
-        const auto hardwareType = getRootHardwareType(filterString);
-        const auto firstDeviceId = getDeviceId(filterString);
-        deviceList.push_back(DeviceSpec{DevicePartLevel::ROOT, hardwareType,
-                                        firstDeviceId, 0, 0, nullptr});
-      }
-
-      if (deviceList.back().rootId != DeviceIdTypeALL) {
-        deviceIdsInUse = true;
-      }
-    }
-  }
-
-  if (acceptDeviceList.size() == 0 && discardDeviceList.size() == 0) {
-    // nothing in env var was understood as a valid term
-    return UR_RESULT_SUCCESS;
-  } else if (acceptDeviceList.size() == 0) {
-    // no accept terms were understood, but at least one discard term was
-    // we are magnanimous to the user when there were bad/ignored accept terms
-    // by pretending there were no bad/ignored accept terms in the env var
-    // for example, we pretend that "garbage:0;!cuda:*" was just "!cuda:*"
-    // so we add an implicit accept-all term (equivalent to prepending "*:*;")
-    // as we would have done if the user had given us the corrected string
-    acceptDeviceList.push_back(DeviceSpec{DevicePartLevel::ROOT,
-                                          ::UR_DEVICE_TYPE_ALL, DeviceIdTypeALL,
-                                          0, 0, nullptr});
-  }
-
-  UR_LOG(DEBUG, "DEBUG: size of acceptDeviceList = {}",
-         acceptDeviceList.size());
-  UR_LOG(DEBUG, "DEBUG: size of discardDeviceList = {}",
-         discardDeviceList.size());
+  using DevicePartLevel = DeviceSelector::DevicePartLevel;
+  using DeviceIdType = DeviceSelector::DeviceIdType;
+  using DeviceSpec = DeviceSelector::DeviceSpec;
+  constexpr DeviceIdType DeviceIdTypeALL = DeviceSelector::DeviceIdTypeALL;
 
   std::vector<DeviceSpec> rootDevices;
   std::vector<DeviceSpec> subDevices;
@@ -630,7 +307,7 @@ ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
     }
 
     uint32_t startIdCount = 0;
-    if (deviceIdsInUse) {
+    if (filters.deviceIdsInUse) {
       ur_adapter_handle_t adapter;
       if (UR_RESULT_SUCCESS !=
           urPlatformGetInfo(hPlatform, UR_PLATFORM_INFO_ADAPTER,
@@ -698,73 +375,82 @@ ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
         rootDevices.end());
   }
 
-  // To support sub-device terms:
-  std::for_each(
-      rootDevices.cbegin(), rootDevices.cend(), [&](DeviceSpec device) {
-        ur_device_partition_property_t propNextPart{
-            UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN,
-            {UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE}};
-        ur_device_partition_properties_t partitionProperties{
-            UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr,
-            &propNextPart, 1};
-        uint32_t numSubdevices = 0;
-        if (UR_RESULT_SUCCESS != urDevicePartition(device.urDeviceHandle,
-                                                   &partitionProperties, 0,
-                                                   nullptr, &numSubdevices)) {
-          return UR_RESULT_ERROR_DEVICE_PARTITION_FAILED;
-        }
-        std::vector<ur_device_handle_t> subDeviceHandles(numSubdevices);
-        auto pSubDevices = subDeviceHandles.data();
-        if (UR_RESULT_SUCCESS !=
-            urDevicePartition(device.urDeviceHandle, &partitionProperties,
-                              numSubdevices, pSubDevices, 0)) {
-          return UR_RESULT_ERROR_DEVICE_PARTITION_FAILED;
-        }
-        DeviceIdType subDeviceCount = 0;
-        std::transform(subDeviceHandles.cbegin(), subDeviceHandles.cend(),
-                       std::back_inserter(subDevices),
-                       [&](ur_device_handle_t urDeviceHandle) {
-                         return DeviceSpec{
-                             DevicePartLevel::SUB, device.hwType,
-                             device.rootId,        subDeviceCount++,
-                             DeviceIdTypeALL,      urDeviceHandle};
-                       });
-        return UR_RESULT_SUCCESS;
-      });
+  // To support sub-device terms, which are the only reason to partition the
+  // devices into new device handles:
+  if (filters.partLevel != DevicePartLevel::ROOT) {
+    std::for_each(
+        rootDevices.cbegin(), rootDevices.cend(), [&](DeviceSpec device) {
+          ur_device_partition_property_t propNextPart{
+              UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN,
+              {UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE}};
+          ur_device_partition_properties_t partitionProperties{
+              UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr,
+              &propNextPart, 1};
+          uint32_t numSubdevices = 0;
+          if (UR_RESULT_SUCCESS != urDevicePartition(device.urDeviceHandle,
+                                                     &partitionProperties, 0,
+                                                     nullptr, &numSubdevices)) {
+            return UR_RESULT_ERROR_DEVICE_PARTITION_FAILED;
+          }
+          std::vector<ur_device_handle_t> subDeviceHandles(numSubdevices);
+          auto pSubDevices = subDeviceHandles.data();
+          if (UR_RESULT_SUCCESS !=
+              urDevicePartition(device.urDeviceHandle, &partitionProperties,
+                                numSubdevices, pSubDevices, 0)) {
+            return UR_RESULT_ERROR_DEVICE_PARTITION_FAILED;
+          }
+          DeviceIdType subDeviceCount = 0;
+          std::transform(subDeviceHandles.cbegin(), subDeviceHandles.cend(),
+                         std::back_inserter(subDevices),
+                         [&](ur_device_handle_t urDeviceHandle) {
+                           return DeviceSpec{
+                               DevicePartLevel::SUB, device.hwType,
+                               device.rootId,        subDeviceCount++,
+                               DeviceIdTypeALL,      urDeviceHandle};
+                         });
+          return UR_RESULT_SUCCESS;
+        });
+  }
 
   // To support sub-sub-device terms:
-  std::for_each(subDevices.cbegin(), subDevices.cend(), [&](DeviceSpec device) {
-    ur_device_partition_property_t propNextPart{
-        UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN,
-        {UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE}};
-    ur_device_partition_properties_t partitionProperties{
-        UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr, &propNextPart,
-        1};
-    uint32_t numSubSubdevices = 0;
-    if (UR_RESULT_SUCCESS != urDevicePartition(device.urDeviceHandle,
-                                               &partitionProperties, 0, nullptr,
-                                               &numSubSubdevices)) {
-      return UR_RESULT_ERROR_DEVICE_PARTITION_FAILED;
-    }
-    std::vector<ur_device_handle_t> subSubDeviceHandles(numSubSubdevices);
-    auto pSubSubDevices = subSubDeviceHandles.data();
-    if (UR_RESULT_SUCCESS !=
-        urDevicePartition(device.urDeviceHandle, &partitionProperties,
-                          numSubSubdevices, pSubSubDevices, 0)) {
-      return UR_RESULT_ERROR_DEVICE_PARTITION_FAILED;
-    }
-    DeviceIdType subSubDeviceCount = 0;
-    std::transform(subSubDeviceHandles.cbegin(), subSubDeviceHandles.cend(),
-                   std::back_inserter(subSubDevices),
-                   [&](ur_device_handle_t urDeviceHandle) {
-                     return DeviceSpec{DevicePartLevel::SUBSUB, device.hwType,
-                                       device.rootId,           device.subId,
-                                       subSubDeviceCount++,     urDeviceHandle};
-                   });
-    return UR_RESULT_SUCCESS;
-  });
-
-  auto ApplyFilter = [&](DeviceSpec &filter, DeviceSpec &device) -> bool {
+  if (filters.partLevel == DevicePartLevel::SUBSUB) {
+    std::for_each(
+        subDevices.cbegin(), subDevices.cend(), [&](DeviceSpec device) {
+          ur_device_partition_property_t propNextPart{
+              UR_DEVICE_PARTITION_BY_AFFINITY_DOMAIN,
+              {UR_DEVICE_AFFINITY_DOMAIN_FLAG_NEXT_PARTITIONABLE}};
+          ur_device_partition_properties_t partitionProperties{
+              UR_STRUCTURE_TYPE_DEVICE_PARTITION_PROPERTIES, nullptr,
+              &propNextPart, 1};
+          uint32_t numSubSubdevices = 0;
+          if (UR_RESULT_SUCCESS !=
+              urDevicePartition(device.urDeviceHandle, &partitionProperties,
+                                0, nullptr, &numSubSubdevices)) {
+            return UR_RESULT_ERROR_DEVICE_PARTITION_FAILED;
+          }
+          std::vector<ur_device_handle_t> subSubDeviceHandles(
+              numSubSubdevices);
+          auto pSubSubDevices = subSubDeviceHandles.data();
+          if (UR_RESULT_SUCCESS !=
+              urDevicePartition(device.urDeviceHandle, &partitionProperties,
+                                numSubSubdevices, pSubSubDevices, 0)) {
+            return UR_RESULT_ERROR_DEVICE_PARTITION_FAILED;
+          }
+          DeviceIdType subSubDeviceCount = 0;
+          std::transform(
+              subSubDeviceHandles.cbegin(), subSubDeviceHandles.cend(),
+              std::back_inserter(subSubDevices),
+              [&](ur_device_handle_t urDeviceHandle) {
+                return DeviceSpec{DevicePartLevel::SUBSUB, device.hwType,
+                                  device.rootId,           device.subId,
+                                  subSubDeviceCount++,     urDeviceHandle};
+              });
+          return UR_RESULT_SUCCESS;
+        });
+  }
+
+  auto ApplyFilter = [&](const DeviceSpec &filter,
+                         const DeviceSpec &device) -> bool {
     bool matches = false;
     if (filter.rootId == DeviceIdTypeALL) {
       // if this is a root device filter, then it must be '*' or 'cpu' or 'gpu'
@@ -779,12 +465,12 @@ ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
       // root part of device
       matches = false;
       UR_LOG(DEBUG,
-             "DEBUG: In ApplyFilter, if block case 2, matches = ", matches);
+             "DEBUG: In ApplyFilter, if block case 2, matches = {}", matches);
     } else if (filter.level == DevicePartLevel::ROOT) {
       // this is a root device filter with a number that matches
       matches = true;
       UR_LOG(DEBUG,
-             "DEBUG: In ApplyFilter, if block case 3, matches = ", matches);
+             "DEBUG: In ApplyFilter, if block case 3, matches = {}", matches);
     } else if (filter.subId == DeviceIdTypeALL) {
       // sub type of star always matches (when root part matches, which we
       // already know here) if this is a subdevice filter, then it must be
@@ -792,30 +478,30 @@ ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
       // 'matches.*.*'
       matches = true;
       UR_LOG(DEBUG,
-             "DEBUG: In ApplyFilter, if block case 4, matches = ", matches);
+             "DEBUG: In ApplyFilter, if block case 4, matches = {}", matches);
     } else if (filter.subId != device.subId) {
       // sub part in filter is a number but does not match the number in the sub
       // part of device
       matches = false;
       UR_LOG(DEBUG,
-             "DEBUG: In ApplyFilter, if block case 5, matches = ", matches);
+             "DEBUG: In ApplyFilter, if block case 5, matches = {}", matches);
     } else if (filter.level == DevicePartLevel::SUB) {
       // this is a sub device number filter, numbers match in both parts
       matches = true;
       UR_LOG(DEBUG,
-             "DEBUG: In ApplyFilter, if block case 6, matches = ", matches);
+             "DEBUG: In ApplyFilter, if block case 6, matches = {}", matches);
     } else if (filter.subsubId == DeviceIdTypeALL) {
       // subsub type of star always matches (when other parts match, which we
       // already know here) this is a subsub device filter, it must be
       // 'matches.matches.*'
       matches = true;
       UR_LOG(DEBUG,
-             "DEBUG: In ApplyFilter, if block case 7, matches = ", matches);
+             "DEBUG: In ApplyFilter, if block case 7, matches = {}", matches);
     } else {
       // this is a subsub device filter, numbers in all three parts match
       matches = (filter.subsubId == device.subsubId);
       UR_LOG(DEBUG,
-             "DEBUG: In ApplyFilter, if block case 8, matches = ", matches);
+             "DEBUG: In ApplyFilter, if block case 8, matches = {}", matches);
     }
     return matches;
   };
@@ -823,7 +509,7 @@ ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
   // apply each discard filter in turn by removing all matching elements
   // from the appropriate device handle vector returned by the platform;
   // no side-effect: the matching devices are just removed and discarded
-  for (auto &discard : discardDeviceList) {
+  for (const auto &discard : filters.discardDeviceList) {
     auto ApplyDiscardFilter = [&](auto &device) -> bool {
       return ApplyFilter(discard, device);
     };
@@ -845,15 +531,13 @@ ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
     }
   }
 
-  std::vector<ur_device_handle_t> selectedDevices;
-
   // apply each accept filter in turn by removing all matching elements
   // from the appropriate device handle vector returned by the platform
   // but using a predicate with a side-effect that takes a copy of each
   // of the accepted device handles just before they are removed
   // removing each item as it is selected prevents us taking duplicates
   // without needing O(n^2) de-duplicatation or symbolic simplification
-  for (auto &accept : acceptDeviceList) {
+  for (const auto &accept : filters.acceptDeviceList) {
     auto ApplyAcceptFilter = [&](auto &device) -> bool {
       const bool matches = ApplyFilter(accept, device);
       if (matches) {
@@ -887,6 +571,113 @@ ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
     }
   }
 
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t urDeviceGetSelected(ur_platform_handle_t hPlatform,
+                                ur_device_type_t DeviceType,
+                                uint32_t NumEntries,
+                                ur_device_handle_t *phDevices,
+                                uint32_t *pNumDevices) {
+  if (!hPlatform) {
+    return UR_RESULT_ERROR_INVALID_NULL_HANDLE;
+  }
+  if (NumEntries > 0 && !phDevices) {
+    return UR_RESULT_ERROR_INVALID_NULL_POINTER;
+  }
+  // pNumDevices is the actual number of device handles added to phDevices by
+  // this function
+  if (NumEntries == 0 && !pNumDevices) {
+    return UR_RESULT_ERROR_INVALID_SIZE;
+  }
+
+  switch (DeviceType) {
+  case UR_DEVICE_TYPE_ALL:
+  case UR_DEVICE_TYPE_GPU:
+  case UR_DEVICE_TYPE_DEFAULT:
+  case UR_DEVICE_TYPE_CPU:
+  case UR_DEVICE_TYPE_FPGA:
+  case UR_DEVICE_TYPE_MCA:
+  case UR_DEVICE_TYPE_CUSTOM:
+    break;
+  default:
+    return UR_RESULT_ERROR_INVALID_ENUMERATION;
+    // urPrint("Unknown device type");
+    break;
+  }
+  // plan:
+  // 0. basic validation of argument values (see code above)
+  // 1. conversion of argument values into useful data items
+  // 2. retrieval and parsing of environment variable string
+  // 3. conversion of term map to accept and discard filters
+  // 4. inserting a default "*:*" accept filter, if required
+  // 5. symbolic consolidation of accept and discard filters
+  //    (steps 2 to 5 are done by DeviceSelector, once per value of the env
+  //    var and backend)
+  // 6. querying the platform handles for all 'root' devices
+  // 7. partioning via platform root devices into subdevices
+  // 8. partioning via platform subdevices into subsubdevices
+  // 9. short-listing devices to accept using accept filters
+  // A. de-listing devices to discard using discard filters
+
+  // possible symbolic short-circuit special cases exist:
+  // * if there are no terms,     select all   root devices
+  // * if any discard is "*",     select no    root devices
+  // * if any discard is "*.*",   select no     sub-devices
+  // * if any discard is "*.*.*", select no sub-sub-devices
+  // *
+  //
+  // detail for step 5 of above plan:
+  // * combine all accept filters into a single accept list
+  // * combine all discard filters into single discard list
+  // then invert it to make the initial/default accept list
+  // (needs knowledge of the valid range from the platform)
+  // "!level_zero:1,2" -> "level_zero:0,3,...,max"
+  // * finally subtract the discard set from the accept set
+
+  // accept  "2,*" != "*,2"
+  // because "2,*" == "2,0,1,3"
+  // whereas "*,2" == "0,1,2,3"
+  // however
+  // discard "2,*" == "*,2"
+
+  ur_backend_t platformBackend;
+  if (UR_RESULT_SUCCESS !=
+      urPlatformGetInfo(hPlatform, UR_PLATFORM_INFO_BACKEND,
+                        sizeof(ur_backend_t), &platformBackend, 0)) {
+    return UR_RESULT_ERROR_INVALID_PLATFORM;
+  }
+
+  auto deviceSelector = getContext()->getDeviceSelector();
+  const auto &filters = deviceSelector->getFilters(platformBackend);
+  if (filters.result != UR_RESULT_SUCCESS) {
+    return filters.result;
+  }
+  if (filters.acceptDeviceList.size() == 0 &&
+      filters.discardDeviceList.size() == 0) {
+    // nothing in env var was understood as a valid term
+    return UR_RESULT_SUCCESS;
+  }
+
+  // Selecting root devices always gives the same handles, so the selection
+  // is remembered until the env var or the loader changes. Partitioning
+  // gives new handles each time, so it isn't.
+  std::vector<ur_device_handle_t> selectedDevices;
+  if (auto cachedDevices =
+          deviceSelector->getSelectedDevices(hPlatform, DeviceType)) {
+    selectedDevices = std::move(*cachedDevices);
+  } else {
+    auto result =
+        selectDevices(hPlatform, DeviceType, filters, selectedDevices);
+    if (result != UR_RESULT_SUCCESS) {
+      return result;
+    }
+    if (filters.partLevel == DeviceSelector::DevicePartLevel::ROOT) {
+      deviceSelector->setSelectedDevices(hPlatform, DeviceType,
+                                         selectedDevices);
+    }
+  }
+
   // selectedDevices is now a vector containing all the right device handles
 
   // should we return the size of the vector or the content of the vector?
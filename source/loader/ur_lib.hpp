@@ -16,6 +16,7 @@
 #include "unified-runtime/ur_api.h"
 #include "unified-runtime/ur_ddi.h"
 #include "ur_codeloc.hpp"
+#include "ur_device_selector.hpp"
 #include "ur_proxy_layer.hpp"
 #include "ur_util.hpp"
 
@@ -28,6 +29,7 @@
 #endif
 
 #include <atomic>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <vector>
@@ -113,6 +115,14 @@ public:
   void parseEnvEnabledLayers();
   ur_result_t initLayers();
   void tearDownLayers() const;
+
+  // Returns ONEAPI_DEVICE_SELECTOR as parsed by urDeviceGetSelected, parsing
+  // it again if it changed.
+  std::shared_ptr<DeviceSelector> getDeviceSelector();
+
+private:
+  std::mutex deviceSelectorMutex;
+  std::shared_ptr<DeviceSelector> deviceSelector;
 };
 
 inline context_t *getContext() { return context_t::get_direct(); }
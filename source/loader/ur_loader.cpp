@@ -7,6 +7,9 @@
  * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
  *
  */
+#include <future>
+
+#include "ur_adapter_cache.hpp"
 #include "ur_loader.hpp"
 #ifdef UR_STATIC_ADAPTER_LEVEL_ZERO
 #include "adapters/level_zero/ur_interface_loader.hpp"
@@ -22,6 +25,21 @@ namespace ur_loader {
 ///////////////////////////////////////////////////////////////////////////////
 context_t *getContext() { return context_t::get_direct(); }
 
+static LibLoader::Lib loadAdapter(const std::vector<fs::path> &adapterPaths,
+                                  AdapterDiscoveryCache *discoveryCache,
+                                  const std::string &discoveryKey) {
+  if (discoveryCache && discoveryCache->skip(discoveryKey)) {
+    return nullptr;
+  }
+  for (const auto &path : adapterPaths) {
+    auto handle = LibLoader::loadAdapterLibrary(path.string().c_str());
+    if (handle) {
+      return handle;
+    }
+  }
+  return nullptr;
+}
+
 ur_result_t context_t::init() {
 #ifdef _WIN32
   // Suppress system errors.
@@ -68,6 +86,14 @@ ur_result_t context_t::init() {
   }
 #endif
 
+  discoveryCache = AdapterDiscoveryCache::create();
+
+  // Loading an adapter library may initialize its driver, which can take a
+  // while, so the adapters are loaded in parallel.
+  // The loads refer to the keys, so the keys must not be reallocated.
+  std::vector<std::string> discoveryKeys;
+  discoveryKeys.reserve(adapter_registry.size());
+  std::vector<std::future<LibLoader::Lib>> loads;
   for (const auto &adapterPaths : adapter_registry) {
     // Skip dynamic adapters that have already been statically registered
     // to avoid double-registration of the same backend.
@@ -75,14 +101,19 @@ ur_result_t context_t::init() {
         adapter_registry.isStaticallyLoaded(adapterPaths[0])) {
       continue;
     }
-    for (const auto &path : adapterPaths) {
-      auto handle = LibLoader::loadAdapterLibrary(path.string().c_str());
-      if (handle) {
-        platforms.emplace_back(std::move(handle));
-        break;
-      }
+    discoveryKeys.push_back(
+        discoveryCache ? discoveryCache->getKey(adapterPaths) : "");
+    loads.push_back(std::async(std::launch::async, loadAdapter,
+                               std::cref(adapterPaths), discoveryCache.get(),
+                               std::cref(discoveryKeys.back())));
+  }
+  for (size_t i = 0; i < loads.size(); i++) {
+    if (auto handle = loads[i].get()) {
+      auto &platform = platforms.emplace_back(std::move(handle));
+      platform.discoveryKey = std::move(discoveryKeys[i]);
     }
   }
+
 #ifdef _WIN32
   // Restore system error handling.
   (void)SetErrorMode(SavedMode);
@@ -90,6 +121,17 @@ ur_result_t context_t::init() {
 
   forceIntercept = getenv_tobool("UR_ENABLE_LOADER_INTERCEPT");
 
+  // The application gets the handles of the lazy adapters instead of the
+  // handles of the adapters, so the calls need to go through the loader.
+  lazyAdapters = LazyAdapters::create();
+  if (lazyAdapters) {
+    forceIntercept = true;
+  }
+  // The platforms of the adapters are recorded by the loader's urPlatformGet.
+  if (discoveryCache) {
+    forceIntercept = true;
+  }
+
   if (forceIntercept || platforms.size() > 1) {
     intercept_enabled = true;
   }
@@ -97,4 +139,91 @@ ur_result_t context_t::init() {
   return UR_RESULT_SUCCESS;
 }
 
+ur_result_t context_t::getAdapters(uint32_t NumEntries,
+                                   ur_adapter_handle_t *phAdapters,
+                                   uint32_t *pNumAdapters) {
+  std::vector<platform_t *> initialized;
+  for (auto &platform : platforms) {
+    if (platform.initStatus != UR_RESULT_SUCCESS) {
+      continue;
+    }
+    if (platform.dditable.Adapter.pfnGet == nullptr) {
+      return UR_RESULT_ERROR_UNINITIALIZED;
+    }
+    initialized.push_back(&platform);
+  }
+
+  struct query_t {
+    ur_result_t result;
+    uint32_t count = 0;
+    ur_adapter_handle_t handle = nullptr;
+  };
+  // The first call initializes the adapters, which may initialize their
+  // drivers, so the adapters are queried in parallel like their libraries
+  // are loaded. A single adapter is queried on the calling thread.
+  auto policy =
+      initialized.size() > 1 ? std::launch::async : std::launch::deferred;
+  std::vector<std::future<query_t>> queries;
+  for (auto *platform : initialized) {
+    auto *pfnGet = platform->dditable.Adapter.pfnGet;
+    queries.push_back(std::async(policy, [pfnGet, phAdapters]() {
+      query_t query;
+      // A single adapter is queried into a temporary handle, which is
+      // copied to the output array once the preceding adapters are counted.
+      query.result = phAdapters ? pfnGet(1, &query.handle, &query.count)
+                                : pfnGet(0, nullptr, &query.count);
+      return query;
+    }));
+  }
+
+  uint32_t numAdapters = 0;
+  for (size_t i = 0; i < queries.size(); i++) {
+    auto query = queries[i].get();
+    if (query.result != UR_RESULT_SUCCESS) {
+      continue;
+    }
+    if (phAdapters) {
+      if (query.handle == nullptr) {
+        continue;
+      }
+      if (numAdapters < NumEntries) {
+        phAdapters[numAdapters] = query.handle;
+      } else {
+        // The output array is already full, so the adapter is only counted.
+        initialized[i]->dditable.Adapter.pfnRelease(query.handle);
+      }
+    }
+    numAdapters += query.count;
+  }
+
+  if (pNumAdapters != nullptr) {
+    *pNumAdapters = numAdapters;
+  }
+
+  return UR_RESULT_SUCCESS;
+}
+
+void context_t::recordPlatforms(ur_adapter_handle_t hAdapter,
+                                uint32_t numPlatforms) {
+  if (!discoveryCache) {
+    return;
+  }
+  platform_t *platform = lazyAdapters ? lazyAdapters->getPlatform(hAdapter)
+                                      : nullptr;
+  if (!platform) {
+    // The adapters of different libraries have different tables.
+    auto *dditable = *reinterpret_cast<ur_dditable_t **>(hAdapter);
+    for (auto &candidate : platforms) {
+      if (candidate.dditable.Platform.pfnGet == dditable->Platform.pfnGet) {
+        platform = &candidate;
+        break;
+      }
+    }
+  }
+  if (platform && platform->handle) {
+    discoveryCache->record(platform->discoveryKey, platform->handle.get(),
+                           numPlatforms > 0);
+  }
+}
+
 } // namespace ur_loader
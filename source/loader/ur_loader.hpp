@@ -13,7 +13,9 @@
 #define UR_LOADER_HPP 1
 
 #include "unified-runtime/ur_ddi.h"
+#include "ur_adapter_cache.hpp"
 #include "ur_adapter_registry.hpp"
+#include "ur_lazy_adapter.hpp"
 #include "ur_lib_loader.hpp"
 
 namespace ur_loader {
@@ -25,6 +27,8 @@ struct platform_t {
   std::unique_ptr<HMODULE, LibLoader::lib_dtor> handle;
   ur_result_t initStatus = UR_RESULT_SUCCESS;
   ur_dditable_t dditable = {};
+  // The key of the library in the adapter discovery cache.
+  std::string discoveryKey;
 };
 
 using platform_vector_t = std::vector<platform_t>;
@@ -37,8 +41,17 @@ public:
   AdapterRegistry adapter_registry;
 
   bool forceIntercept = false;
+  // Set if the adapters are only initialized once they're used.
+  std::unique_ptr<LazyAdapters> lazyAdapters;
+  // Set if the adapters without platforms are remembered across processes.
+  std::unique_ptr<AdapterDiscoveryCache> discoveryCache;
 
   ur_result_t init();
+  // Implements urAdapterGet when the adapters aren't lazy.
+  ur_result_t getAdapters(uint32_t NumEntries, ur_adapter_handle_t *phAdapters,
+                          uint32_t *pNumAdapters);
+  // Records in the discovery cache whether the adapter has platforms.
+  void recordPlatforms(ur_adapter_handle_t hAdapter, uint32_t numPlatforms);
   bool intercept_enabled = false;
 };
 
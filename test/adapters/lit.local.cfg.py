@@ -13,3 +13,5 @@ if "hip" not in config.adapters_built:
     config.excludes.add("hip")
 if "level_zero" not in config.adapters_built:
     config.excludes.add("level_zero")
+if "native_cpu" not in config.adapters_built:
+    config.excludes.add("native_cpu")
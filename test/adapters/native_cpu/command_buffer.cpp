@@ -0,0 +1,217 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: ./command_buffer-test
+
+#include "helpers.hpp"
+
+#include <uur/raii.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace native_cpu_test;
+
+namespace {
+// Adds its value argument to the element of its pointer argument indexed by
+// the work-group id. Launched with work-groups of a single work-item.
+void addValue(void *const *Args, native_cpu::state *State) {
+  static_cast<uint32_t *>(Args[0])[State->MWorkGroup_id[0]] +=
+      *static_cast<const uint32_t *>(Args[1]);
+}
+
+const kernel_entry Entries[] = {{"addValue", addValue}, {nullptr, nullptr}};
+} // namespace
+
+struct urNativeCpuCommandBufferTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::SetUp());
+    ur_bool_t Supported = false;
+    ASSERT_SUCCESS(urDeviceGetInfo(device,
+                                   UR_DEVICE_INFO_COMMAND_BUFFER_SUPPORT_EXP,
+                                   sizeof(Supported), &Supported, nullptr));
+    ASSERT_TRUE(Supported);
+  }
+
+  void TearDown() override {
+    if (commandBuffer) {
+      EXPECT_SUCCESS(urCommandBufferReleaseExp(commandBuffer));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::TearDown());
+  }
+
+  void create(bool InOrder) {
+    ur_exp_command_buffer_desc_t Desc{
+        UR_STRUCTURE_TYPE_EXP_COMMAND_BUFFER_DESC, nullptr, false, InOrder,
+        false};
+    ASSERT_SUCCESS(
+        urCommandBufferCreateExp(context, device, &Desc, &commandBuffer));
+  }
+
+  void submit() {
+    ASSERT_SUCCESS(urEnqueueCommandBufferExp(queue, commandBuffer, 0, nullptr,
+                                             nullptr));
+    ASSERT_SUCCESS(urQueueFinish(queue));
+  }
+
+  ur_exp_command_buffer_handle_t commandBuffer = nullptr;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuCommandBufferTest);
+
+// Every submission runs the recorded launch with the arguments it was
+// appended with.
+TEST_P(urNativeCpuCommandBufferTest, KernelLaunch) {
+  constexpr size_t Size = 64;
+  uur::raii::Program Program;
+  uur::raii::Kernel Kernel;
+  ASSERT_NO_FATAL_FAILURE(createKernel(context, device, Entries, "addValue",
+                                       Program.ptr(), Kernel.ptr()));
+  uint32_t *Data = nullptr;
+  ASSERT_SUCCESS(urUSMSharedAlloc(context, device, nullptr, nullptr,
+                                  Size * sizeof(uint32_t),
+                                  reinterpret_cast<void **>(&Data)));
+  std::fill(Data, Data + Size, 0);
+
+  create(false);
+  const uint32_t Value = 3;
+  const ur_exp_kernel_arg_properties_t Args[] = {pointerArg(0, Data),
+                                                 valueArg(1, Value)};
+  const size_t LocalSize = 1;
+  ASSERT_SUCCESS(urCommandBufferAppendKernelLaunchWithArgsExp(
+      commandBuffer, Kernel, 1, nullptr, &Size, &LocalSize, 2, Args, 0,
+      nullptr, 0, nullptr, 0, nullptr, nullptr, nullptr, nullptr));
+  ASSERT_SUCCESS(urCommandBufferFinalizeExp(commandBuffer));
+
+  submit();
+  submit();
+  for (size_t I = 0; I < Size; I++) {
+    ASSERT_EQ(Data[I], 2 * Value) << "element " << I;
+  }
+  ASSERT_SUCCESS(urUSMFree(context, Data));
+}
+
+// A fill, a copy of its result and a launch on the copy run in the order of
+// their sync points, or of their appends for in-order command-buffers.
+TEST_P(urNativeCpuCommandBufferTest, SyncPoints) {
+  for (bool InOrder : {false, true}) {
+    constexpr size_t Size = 1024;
+    uur::raii::Program Program;
+    uur::raii::Kernel Kernel;
+    ASSERT_NO_FATAL_FAILURE(createKernel(context, device, Entries, "addValue",
+                                         Program.ptr(), Kernel.ptr()));
+    uint32_t *Src = nullptr;
+    uint32_t *Dst = nullptr;
+    ASSERT_SUCCESS(urUSMSharedAlloc(context, device, nullptr, nullptr,
+                                    Size * sizeof(uint32_t),
+                                    reinterpret_cast<void **>(&Src)));
+    ASSERT_SUCCESS(urUSMSharedAlloc(context, device, nullptr, nullptr,
+                                    Size * sizeof(uint32_t),
+                                    reinterpret_cast<void **>(&Dst)));
+
+    create(InOrder);
+    const uint32_t Pattern = 5;
+    ur_exp_command_buffer_sync_point_t Filled, Copied;
+    ASSERT_SUCCESS(urCommandBufferAppendUSMFillExp(
+        commandBuffer, Src, &Pattern, sizeof(Pattern), Size * sizeof(uint32_t),
+        0, nullptr, 0, nullptr, &Filled, nullptr, nullptr));
+    ASSERT_SUCCESS(urCommandBufferAppendUSMMemcpyExp(
+        commandBuffer, Dst, Src, Size * sizeof(uint32_t), InOrder ? 0 : 1,
+        InOrder ? nullptr : &Filled, 0, nullptr, &Copied, nullptr, nullptr));
+    const uint32_t Value = 1;
+    const ur_exp_kernel_arg_properties_t Args[] = {pointerArg(0, Dst),
+                                                   valueArg(1, Value)};
+    const size_t LocalSize = 1;
+    ASSERT_SUCCESS(urCommandBufferAppendKernelLaunchWithArgsExp(
+        commandBuffer, Kernel, 1, nullptr, &Size, &LocalSize, 2, Args, 0,
+        nullptr, InOrder ? 0 : 1, InOrder ? nullptr : &Copied, 0, nullptr,
+        nullptr, nullptr, nullptr));
+    ASSERT_SUCCESS(urCommandBufferFinalizeExp(commandBuffer));
+
+    submit();
+    for (size_t I = 0; I < Size; I++) {
+      ASSERT_EQ(Src[I], Pattern) << "element " << I;
+      ASSERT_EQ(Dst[I], Pattern + Value) << "element " << I;
+    }
+    ASSERT_SUCCESS(urCommandBufferReleaseExp(commandBuffer));
+    commandBuffer = nullptr;
+    ASSERT_SUCCESS(urUSMFree(context, Src));
+    ASSERT_SUCCESS(urUSMFree(context, Dst));
+  }
+}
+
+// Writes a region of host memory into a buffer, copies it into a buffer with
+// a different layout and reads it back.
+TEST_P(urNativeCpuCommandBufferTest, Rect) {
+  const ur_rect_region_t Region{4, 3, 2};
+  // The host data is tightly packed.
+  std::vector<uint8_t> Input(Region.width * Region.height * Region.depth);
+  std::iota(Input.begin(), Input.end(), uint8_t{1});
+  std::vector<uint8_t> Output(Input.size(), 0);
+
+  // A is 16x8x2 and B is 8x8x3 bytes.
+  const size_t ARowPitch = 16, ASlicePitch = 128, ASize = 256;
+  const size_t BRowPitch = 8, BSlicePitch = 64, BSize = 192;
+  const ur_rect_offset_t AOrigin{2, 1, 0}, BOrigin{1, 2, 1};
+  const ur_rect_offset_t HostOrigin{0, 0, 0};
+  uur::raii::Mem A, B;
+  ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_READ_WRITE, ASize,
+                                   nullptr, A.ptr()));
+  ASSERT_SUCCESS(urMemBufferCreate(context, UR_MEM_FLAG_READ_WRITE, BSize,
+                                   nullptr, B.ptr()));
+  std::vector<uint8_t> BContents(BSize);
+
+  create(true);
+  const uint8_t Zero = 0;
+  ASSERT_SUCCESS(urCommandBufferAppendMemBufferFillExp(
+      commandBuffer, A, &Zero, 1, 0, ASize, 0, nullptr, 0, nullptr, nullptr,
+      nullptr, nullptr));
+  ASSERT_SUCCESS(urCommandBufferAppendMemBufferFillExp(
+      commandBuffer, B, &Zero, 1, 0, BSize, 0, nullptr, 0, nullptr, nullptr,
+      nullptr, nullptr));
+  ASSERT_SUCCESS(urCommandBufferAppendMemBufferWriteRectExp(
+      commandBuffer, A, AOrigin, HostOrigin, Region, ARowPitch, ASlicePitch, 0,
+      0, Input.data(), 0, nullptr, 0, nullptr, nullptr, nullptr, nullptr));
+  ASSERT_SUCCESS(urCommandBufferAppendMemBufferCopyRectExp(
+      commandBuffer, A, B, AOrigin, BOrigin, Region, ARowPitch, ASlicePitch,
+      BRowPitch, BSlicePitch, 0, nullptr, 0, nullptr, nullptr, nullptr,
+      nullptr));
+  ASSERT_SUCCESS(urCommandBufferAppendMemBufferReadRectExp(
+      commandBuffer, B, BOrigin, HostOrigin, Region, BRowPitch, BSlicePitch, 0,
+      0, Output.data(), 0, nullptr, 0, nullptr, nullptr, nullptr, nullptr));
+  ASSERT_SUCCESS(urCommandBufferAppendMemBufferReadExp(
+      commandBuffer, B, 0, BSize, BContents.data(), 0, nullptr, 0, nullptr,
+      nullptr, nullptr, nullptr));
+  ASSERT_SUCCESS(urCommandBufferFinalizeExp(commandBuffer));
+
+  submit();
+  EXPECT_EQ(Output, Input);
+  std::vector<uint8_t> Expected(BSize, 0);
+  for (size_t d = 0; d < Region.depth; d++) {
+    for (size_t h = 0; h < Region.height; h++) {
+      for (size_t w = 0; w < Region.width; w++) {
+        Expected[(BOrigin.z + d) * BSlicePitch + (BOrigin.y + h) * BRowPitch +
+                 BOrigin.x + w] =
+            Input[(d * Region.height + h) * Region.width + w];
+      }
+    }
+  }
+  EXPECT_EQ(BContents, Expected);
+}
+
+// Command handles and events are only needed for updates, which aren't
+// supported.
+TEST_P(urNativeCpuCommandBufferTest, CommandHandleUnsupported) {
+  void *Ptr = nullptr;
+  ASSERT_SUCCESS(urUSMSharedAlloc(context, device, nullptr, nullptr, 64, &Ptr));
+  create(false);
+  const uint8_t Pattern = 1;
+  ur_exp_command_buffer_command_handle_t Command = nullptr;
+  EXPECT_EQ(urCommandBufferAppendUSMFillExp(commandBuffer, Ptr, &Pattern, 1, 64,
+                                            0, nullptr, 0, nullptr, nullptr,
+                                            nullptr, &Command),
+            UR_RESULT_ERROR_UNSUPPORTED_FEATURE);
+  ASSERT_SUCCESS(urUSMFree(context, Ptr));
+}
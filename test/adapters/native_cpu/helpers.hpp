@@ -0,0 +1,62 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#pragma once
+
+#include <uur/fixtures.h>
+
+#include "nativecpu_state.hpp"
+
+namespace native_cpu_test {
+
+// Signature of a Native CPU kernel: the argument array and the state of the
+// work-item, or of the work-group when the adapter is built with OCK.
+using kernel_fn_t = void(void *const *Args, native_cpu::state *State);
+
+// A Native CPU binary is a table of kernel names and entry points, terminated
+// by a null entry, so tests can build one from plain host functions.
+struct kernel_entry {
+  const char *Name;
+  kernel_fn_t *Fn;
+};
+
+// Creates a kernel running Fn, through the program the binary Entries
+// describes.
+inline void createKernel(ur_context_handle_t Context, ur_device_handle_t Device,
+                         const kernel_entry *Entries, const char *Name,
+                         ur_program_handle_t *Program,
+                         ur_kernel_handle_t *Kernel) {
+  auto *Binary = reinterpret_cast<const uint8_t *>(Entries);
+  size_t Length = sizeof(kernel_entry);
+  ASSERT_SUCCESS(urProgramCreateWithBinary(Context, 1, &Device, &Length,
+                                           &Binary, nullptr, Program));
+  ASSERT_SUCCESS(urProgramBuild(Context, *Program, nullptr));
+  ASSERT_SUCCESS(urKernelCreate(*Program, Name, Kernel));
+}
+
+inline ur_exp_kernel_arg_properties_t pointerArg(uint32_t Index,
+                                                 const void *Ptr) {
+  ur_exp_kernel_arg_properties_t Arg{};
+  Arg.stype = UR_STRUCTURE_TYPE_EXP_KERNEL_ARG_PROPERTIES;
+  Arg.type = UR_EXP_KERNEL_ARG_TYPE_POINTER;
+  Arg.index = Index;
+  Arg.size = sizeof(void *);
+  Arg.value.pointer = Ptr;
+  return Arg;
+}
+
+template <typename T>
+inline ur_exp_kernel_arg_properties_t valueArg(uint32_t Index,
+                                               const T &Value) {
+  ur_exp_kernel_arg_properties_t Arg{};
+  Arg.stype = UR_STRUCTURE_TYPE_EXP_KERNEL_ARG_PROPERTIES;
+  Arg.type = UR_EXP_KERNEL_ARG_TYPE_VALUE;
+  Arg.index = Index;
+  Arg.size = sizeof(T);
+  Arg.value.value = &Value;
+  return Arg;
+}
+
+} // namespace native_cpu_test
@@ -0,0 +1,109 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: ./in_order_queue-test
+
+#include "helpers.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+using namespace native_cpu_test;
+
+namespace {
+std::atomic<bool> Started;
+std::atomic<bool> Release;
+
+// Writes its value argument to its pointer argument, once released.
+void blockingStore(void *const *Args, native_cpu::state *) {
+  Started = true;
+  while (!Release) {
+    std::this_thread::yield();
+  }
+  *static_cast<int *>(Args[0]) = *static_cast<const int *>(Args[1]);
+}
+
+const kernel_entry Entries[] = {{"blockingStore", blockingStore},
+                                {nullptr, nullptr}};
+} // namespace
+
+struct urNativeCpuInOrderQueueTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::SetUp());
+    ASSERT_SUCCESS(
+        urQueueCreate(context, device, &queue_properties, &otherQueue));
+    ASSERT_SUCCESS(urUSMSharedAlloc(context, device, nullptr, nullptr,
+                                    sizeof(int) * 3,
+                                    reinterpret_cast<void **>(&Out)));
+  }
+
+  void TearDown() override {
+    if (Out) {
+      EXPECT_SUCCESS(urUSMFree(context, Out));
+    }
+    if (kernel) {
+      EXPECT_SUCCESS(urKernelRelease(kernel));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    if (otherQueue) {
+      EXPECT_SUCCESS(urQueueRelease(otherQueue));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::TearDown());
+  }
+
+  int *Out = nullptr;
+  ur_queue_handle_t otherQueue = nullptr;
+  ur_program_handle_t program = nullptr;
+  ur_kernel_handle_t kernel = nullptr;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuInOrderQueueTest);
+
+// A blocking command waiting for a command of another queue doesn't keep
+// other threads from submitting to its queue meanwhile.
+TEST_P(urNativeCpuInOrderQueueTest, SubmitWhileBlockingCommandWaits) {
+  ASSERT_NO_FATAL_FAILURE(createKernel(context, device, Entries,
+                                       "blockingStore", &program, &kernel));
+  Started = false;
+  Release = false;
+
+  const int One = 1;
+  const ur_exp_kernel_arg_properties_t Args[] = {pointerArg(0, &Out[0]),
+                                                 valueArg(1, One)};
+  const size_t Size = 1;
+  ur_event_handle_t KernelEvent = nullptr;
+  ASSERT_SUCCESS(urEnqueueKernelLaunchWithArgsExp(
+      otherQueue, kernel, 1, nullptr, &Size, &Size, 2, Args, nullptr, 0,
+      nullptr, &KernelEvent));
+  while (!Started) {
+    std::this_thread::yield();
+  }
+
+  auto Blocking = std::async(std::launch::async, [&]() {
+    return urEnqueueUSMMemcpy(queue, true, &Out[1], &Out[0], sizeof(int), 1,
+                              &KernelEvent, nullptr);
+  });
+  // Gives the blocking copy the time to start waiting
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const int Two = 2;
+  auto Submit = std::async(std::launch::async, [&]() {
+    return urEnqueueUSMFill(queue, &Out[2], sizeof(int), &Two, sizeof(int), 0,
+                            nullptr, nullptr);
+  });
+  EXPECT_EQ(Submit.wait_for(std::chrono::seconds(10)),
+            std::future_status::ready);
+
+  Release = true;
+  ASSERT_SUCCESS(Blocking.get());
+  ASSERT_SUCCESS(Submit.get());
+  ASSERT_SUCCESS(urQueueFinish(queue));
+  ASSERT_SUCCESS(urEventRelease(KernelEvent));
+
+  EXPECT_EQ(Out[1], 1);
+  EXPECT_EQ(Out[2], 2);
+}
@@ -0,0 +1,106 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: ./kernel_args-test
+
+#include "helpers.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace native_cpu_test;
+
+namespace {
+std::atomic<bool> Started;
+std::atomic<bool> Release;
+
+// Writes its value argument to its pointer argument, once released.
+void blockingStore(void *const *Args, native_cpu::state *) {
+  Started = true;
+  while (!Release) {
+    std::this_thread::yield();
+  }
+  *static_cast<int *>(Args[0]) = *static_cast<const int *>(Args[1]);
+}
+
+void store(void *const *Args, native_cpu::state *) {
+  *static_cast<int *>(Args[0]) = *static_cast<const int *>(Args[1]);
+}
+
+const kernel_entry Entries[] = {
+    {"blockingStore", blockingStore}, {"store", store}, {nullptr, nullptr}};
+} // namespace
+
+struct urNativeCpuKernelArgsTest : uur::urQueueTest {
+  void SetUp() override {
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::SetUp());
+    ASSERT_SUCCESS(urUSMSharedAlloc(context, device, nullptr, nullptr,
+                                    sizeof(int) * NumLaunches,
+                                    reinterpret_cast<void **>(&Out)));
+  }
+
+  void TearDown() override {
+    if (Out) {
+      EXPECT_SUCCESS(urUSMFree(context, Out));
+    }
+    if (kernel) {
+      EXPECT_SUCCESS(urKernelRelease(kernel));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::TearDown());
+  }
+
+  void launch(int *Dst, int Value) {
+    const ur_exp_kernel_arg_properties_t Args[] = {pointerArg(0, Dst),
+                                                   valueArg(1, Value)};
+    const size_t Size = 1;
+    ASSERT_SUCCESS(urEnqueueKernelLaunchWithArgsExp(
+        queue, kernel, 1, nullptr, &Size, &Size, 2, Args, nullptr, 0, nullptr,
+        nullptr));
+  }
+
+  static constexpr size_t NumLaunches = 256;
+  int *Out = nullptr;
+  ur_program_handle_t program = nullptr;
+  ur_kernel_handle_t kernel = nullptr;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuKernelArgsTest);
+
+// Arguments set while a launch is running don't affect that launch.
+TEST_P(urNativeCpuKernelArgsTest, SetWhileLaunchInFlight) {
+  ASSERT_NO_FATAL_FAILURE(createKernel(context, device, Entries,
+                                       "blockingStore", &program, &kernel));
+  Started = false;
+  Release = false;
+
+  launch(&Out[0], 1);
+  while (!Started) {
+    std::this_thread::yield();
+  }
+  // The first launch is still waiting to read its arguments
+  launch(&Out[1], 2);
+  Release = true;
+  ASSERT_SUCCESS(urQueueFinish(queue));
+
+  EXPECT_EQ(Out[0], 1);
+  EXPECT_EQ(Out[1], 2);
+}
+
+// Every launch sees the arguments it was enqueued with, although they are
+// replaced while earlier launches are still queued or running.
+TEST_P(urNativeCpuKernelArgsTest, SetForEveryLaunch) {
+  ASSERT_NO_FATAL_FAILURE(
+      createKernel(context, device, Entries, "store", &program, &kernel));
+  for (size_t I = 0; I < NumLaunches; I++) {
+    launch(&Out[I], static_cast<int>(I));
+  }
+  ASSERT_SUCCESS(urQueueFinish(queue));
+
+  for (size_t I = 0; I < NumLaunches; I++) {
+    ASSERT_EQ(Out[I], static_cast<int>(I)) << "launch " << I;
+  }
+}
@@ -0,0 +1,165 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Prints how many launches of a kernel with a single work-item Native CPU
+// enqueues and runs per second, with the arguments set once and with the
+// arguments passed to every launch. Takes the number of launches as an
+// optional argument.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <unified-runtime/ur_api.h>
+
+#include "nativecpu_state.hpp"
+
+#define CHECK(call)                                                            \
+  if ((call) != UR_RESULT_SUCCESS) {                                           \
+    std::fprintf(stderr, "%s failed\n", #call);                                \
+    std::exit(1);                                                              \
+  }
+
+// Writes its value argument to its pointer argument.
+static void store(void *const *Args, native_cpu::state *) {
+  *static_cast<int *>(Args[0]) = *static_cast<const int *>(Args[1]);
+}
+
+// A Native CPU binary is a table of kernel names and entry points.
+struct kernel_entry {
+  const char *Name;
+  void (*Fn)(void *const *, native_cpu::state *);
+};
+
+static const kernel_entry entries[] = {{"store", store}, {nullptr, nullptr}};
+
+static ur_device_handle_t getNativeCpuDevice() {
+  uint32_t numAdapters = 0;
+  CHECK(urAdapterGet(0, nullptr, &numAdapters));
+  std::vector<ur_adapter_handle_t> adapters(numAdapters);
+  CHECK(urAdapterGet(numAdapters, adapters.data(), nullptr));
+  for (auto adapter : adapters) {
+    ur_backend_t backend;
+    CHECK(urAdapterGetInfo(adapter, UR_ADAPTER_INFO_BACKEND, sizeof(backend),
+                           &backend, nullptr));
+    if (backend != UR_BACKEND_NATIVE_CPU) {
+      continue;
+    }
+    ur_platform_handle_t platform;
+    CHECK(urPlatformGet(adapter, 1, &platform, nullptr));
+    ur_device_handle_t device;
+    CHECK(urDeviceGet(platform, UR_DEVICE_TYPE_ALL, 1, &device, nullptr));
+    return device;
+  }
+  std::fprintf(stderr, "no Native CPU device found\n");
+  std::exit(1);
+}
+
+// Returns the best rate in launches per second of a few runs of count calls
+// of launch, including waiting for the launches to finish.
+template <typename F>
+static double launchesPerSecond(ur_queue_handle_t queue, size_t count,
+                                F &&launch) {
+  double best = 0;
+  for (int run = 0; run < 5; run++) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) {
+      launch();
+    }
+    CHECK(urQueueFinish(queue));
+    auto end = std::chrono::steady_clock::now();
+    best = std::max(
+        best, count / std::chrono::duration<double>(end - start).count());
+  }
+  return best;
+}
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  if (count == 0) {
+    std::fprintf(stderr, "usage: %s [launch count]\n", argv[0]);
+    return 1;
+  }
+
+  CHECK(urLoaderInit(0, nullptr));
+  ur_device_handle_t device = getNativeCpuDevice();
+  ur_context_handle_t context;
+  CHECK(urContextCreate(1, &device, nullptr, &context));
+
+  auto *binary = reinterpret_cast<const uint8_t *>(entries);
+  size_t length = sizeof(kernel_entry);
+  ur_program_handle_t program;
+  CHECK(urProgramCreateWithBinary(context, 1, &device, &length, &binary,
+                                  nullptr, &program));
+  CHECK(urProgramBuild(context, program, nullptr));
+  ur_kernel_handle_t kernel;
+  CHECK(urKernelCreate(program, "store", &kernel));
+
+  int *out;
+  CHECK(urUSMSharedAlloc(context, device, nullptr, nullptr, sizeof(int),
+                         reinterpret_cast<void **>(&out)));
+  const int one = 1;
+  ur_exp_kernel_arg_properties_t args[2] = {};
+  for (auto &arg : args) {
+    arg.stype = UR_STRUCTURE_TYPE_EXP_KERNEL_ARG_PROPERTIES;
+  }
+  args[0].type = UR_EXP_KERNEL_ARG_TYPE_POINTER;
+  args[0].index = 0;
+  args[0].size = sizeof(out);
+  args[0].value.pointer = out;
+  args[1].type = UR_EXP_KERNEL_ARG_TYPE_VALUE;
+  args[1].index = 1;
+  args[1].size = sizeof(one);
+  args[1].value.value = &one;
+
+  const size_t size = 1;
+  for (bool inOrder : {true, false}) {
+    const ur_queue_properties_t props{
+        UR_STRUCTURE_TYPE_QUEUE_PROPERTIES, nullptr,
+        inOrder ? ur_queue_flags_t{0}
+                : UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE};
+    ur_queue_handle_t queue;
+    CHECK(urQueueCreate(context, device, &props, &queue));
+    const char *name = inOrder ? "in-order" : "out-of-order";
+
+    // Sets the arguments the next launches use
+    CHECK(urEnqueueKernelLaunchWithArgsExp(queue, kernel, 1, nullptr, &size,
+                                           &size, 2, args, nullptr, 0, nullptr,
+                                           nullptr));
+    CHECK(urQueueFinish(queue));
+
+    std::printf("%s, arguments set once: %.0f launches/s\n", name,
+                launchesPerSecond(queue, count, [&]() {
+                  CHECK(urEnqueueKernelLaunchWithArgsExp(
+                      queue, kernel, 1, nullptr, &size, &size, 0, nullptr,
+                      nullptr, 0, nullptr, nullptr));
+                }));
+
+    // Launches still running hold on to the previous arguments, so passing
+    // them again copies them.
+    std::printf("%s, arguments per launch: %.0f launches/s\n", name,
+                launchesPerSecond(queue, count, [&]() {
+                  CHECK(urEnqueueKernelLaunchWithArgsExp(
+                      queue, kernel, 1, nullptr, &size, &size, 2, args,
+                      nullptr, 0, nullptr, nullptr));
+                }));
+
+    CHECK(urQueueRelease(queue));
+  }
+
+  if (*out != one) {
+    std::fprintf(stderr, "the kernel didn't run\n");
+    return 1;
+  }
+
+  CHECK(urUSMFree(context, out));
+  CHECK(urKernelRelease(kernel));
+  CHECK(urProgramRelease(program));
+  CHECK(urContextRelease(context));
+  CHECK(urLoaderTearDown());
+  return 0;
+}
@@ -0,0 +1,14 @@
+"""
+
+Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+See https://llvm.org/LICENSE.txt for license information.
+SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+
+config.suffixes = [".test", ".cpp"]
+
+config.environment["ONEAPI_DEVICE_SELECTOR"] = "native_cpu:*"
+config.excludes.update(
+    ["partitioning_benchmark.cpp", "memory_benchmark.cpp", "launch_benchmark.cpp"]
+)
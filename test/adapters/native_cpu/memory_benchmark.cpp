@@ -0,0 +1,121 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Prints the bandwidth of Native CPU fills, copies and rect reads, as seen
+// through the UR API. Takes the size of the memory operated on in MiB as an
+// optional argument.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <unified-runtime/ur_api.h>
+
+#define CHECK(call)                                                            \
+  if ((call) != UR_RESULT_SUCCESS) {                                           \
+    std::fprintf(stderr, "%s failed\n", #call);                                \
+    std::exit(1);                                                              \
+  }
+
+// Returns the best bandwidth in GB/s of a few runs of f, which processes
+// bytes bytes.
+template <typename F> static double gbPerSecond(size_t bytes, F &&f) {
+  double best = 0;
+  for (int run = 0; run < 5; run++) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    best = std::max(
+        best, bytes / std::chrono::duration<double, std::nano>(end - start)
+                          .count());
+  }
+  return best;
+}
+
+static ur_device_handle_t getNativeCpuDevice() {
+  uint32_t numAdapters = 0;
+  CHECK(urAdapterGet(0, nullptr, &numAdapters));
+  std::vector<ur_adapter_handle_t> adapters(numAdapters);
+  CHECK(urAdapterGet(numAdapters, adapters.data(), nullptr));
+  for (auto adapter : adapters) {
+    ur_backend_t backend;
+    CHECK(urAdapterGetInfo(adapter, UR_ADAPTER_INFO_BACKEND, sizeof(backend),
+                           &backend, nullptr));
+    if (backend != UR_BACKEND_NATIVE_CPU) {
+      continue;
+    }
+    ur_platform_handle_t platform;
+    CHECK(urPlatformGet(adapter, 1, &platform, nullptr));
+    ur_device_handle_t device;
+    CHECK(urDeviceGet(platform, UR_DEVICE_TYPE_ALL, 1, &device, nullptr));
+    return device;
+  }
+  std::fprintf(stderr, "no Native CPU device found\n");
+  std::exit(1);
+}
+
+int main(int argc, char **argv) {
+  const size_t mib = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+  if (mib == 0) {
+    std::fprintf(stderr, "usage: %s [size in MiB]\n", argv[0]);
+    return 1;
+  }
+  const size_t size = mib * 1024 * 1024;
+
+  CHECK(urLoaderInit(0, nullptr));
+  ur_device_handle_t device = getNativeCpuDevice();
+  ur_context_handle_t context;
+  CHECK(urContextCreate(1, &device, nullptr, &context));
+  ur_queue_handle_t queue;
+  CHECK(urQueueCreate(context, device, nullptr, &queue));
+
+  void *src, *dst;
+  CHECK(urUSMHostAlloc(context, nullptr, nullptr, size, &src));
+  CHECK(urUSMHostAlloc(context, nullptr, nullptr, size, &dst));
+
+  uint8_t pattern[24];
+  for (size_t i = 0; i < sizeof(pattern); i++) {
+    pattern[i] = static_cast<uint8_t>(i + 1);
+  }
+  for (size_t patternSize : {1, 3, 4, 24}) {
+    const size_t fillSize = size / patternSize * patternSize;
+    std::printf("fill, %zu-byte pattern: %.2f GB/s\n", patternSize,
+                gbPerSecond(fillSize, [&]() {
+                  CHECK(urEnqueueUSMFill(queue, dst, patternSize, pattern,
+                                         fillSize, 0, nullptr, nullptr));
+                  CHECK(urQueueFinish(queue));
+                }));
+  }
+
+  std::printf("copy: %.2f GB/s\n", gbPerSecond(size, [&]() {
+                CHECK(urEnqueueUSMMemcpy(queue, true, dst, src, size, 0,
+                                         nullptr, nullptr));
+              }));
+
+  // Reads the middle half of each row of a buffer of 8192 rows.
+  constexpr size_t numRows = 8192;
+  const size_t rowPitch = size / numRows;
+  ur_mem_handle_t buffer;
+  CHECK(urMemBufferCreate(context, UR_MEM_FLAG_READ_WRITE, size, nullptr,
+                          &buffer));
+  const ur_rect_region_t region{rowPitch / 2, numRows, 1};
+  std::printf("rect read, %zu rows: %.2f GB/s\n", numRows,
+              gbPerSecond(region.width * numRows, [&]() {
+                CHECK(urEnqueueMemBufferReadRect(
+                    queue, buffer, true, {rowPitch / 4, 0, 0}, {0, 0, 0},
+                    region, rowPitch, 0, region.width, 0, dst, 0, nullptr,
+                    nullptr));
+              }));
+
+  CHECK(urMemRelease(buffer));
+  CHECK(urUSMFree(context, src));
+  CHECK(urUSMFree(context, dst));
+  CHECK(urQueueRelease(queue));
+  CHECK(urContextRelease(context));
+  CHECK(urLoaderTearDown());
+  return 0;
+}
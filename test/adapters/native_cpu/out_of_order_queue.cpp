@@ -0,0 +1,122 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: SYCL_NATIVE_CPU_HOST_THREADS=2 ./out_of_order_queue-test
+
+#include "helpers.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace native_cpu_test;
+using namespace std::chrono_literals;
+
+namespace {
+std::atomic<bool> Started;
+std::atomic<bool> Release;
+
+// Writes its value argument to its pointer argument, once released.
+void blockingStore(void *const *Args, native_cpu::state *) {
+  Started = true;
+  while (!Release) {
+    std::this_thread::yield();
+  }
+  *static_cast<int *>(Args[0]) = *static_cast<const int *>(Args[1]);
+}
+
+const kernel_entry Entries[] = {{"blockingStore", blockingStore},
+                                {nullptr, nullptr}};
+} // namespace
+
+struct urNativeCpuOutOfOrderQueueTest : uur::urQueueTest {
+  void SetUp() override {
+    queue_properties.flags = UR_QUEUE_FLAG_OUT_OF_ORDER_EXEC_MODE_ENABLE;
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::SetUp());
+    ASSERT_SUCCESS(urUSMSharedAlloc(context, device, nullptr, nullptr,
+                                    sizeof(int) * (NumNodes + 1),
+                                    reinterpret_cast<void **>(&Out)));
+  }
+
+  void TearDown() override {
+    for (auto Event : Events) {
+      EXPECT_SUCCESS(urEventRelease(Event));
+    }
+    if (Out) {
+      EXPECT_SUCCESS(urUSMFree(context, Out));
+    }
+    if (kernel) {
+      EXPECT_SUCCESS(urKernelRelease(kernel));
+    }
+    if (program) {
+      EXPECT_SUCCESS(urProgramRelease(program));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(urQueueTest::TearDown());
+  }
+
+  static constexpr size_t NumNodes = 256;
+  int *Out = nullptr;
+  std::vector<ur_event_handle_t> Events;
+  ur_program_handle_t program = nullptr;
+  ur_kernel_handle_t kernel = nullptr;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuOutOfOrderQueueTest);
+
+// Every node of a binary tree of copies depends on its parent, whose root is
+// held back, so far more commands are pending than the pool has threads.
+// They must not take up the threads while they wait: a command without
+// dependencies still runs meanwhile, and the whole tree completes once the
+// root is released.
+TEST_P(urNativeCpuOutOfOrderQueueTest, DependenciesOutnumberThreads) {
+  ASSERT_NO_FATAL_FAILURE(createKernel(context, device, Entries,
+                                       "blockingStore", &program, &kernel));
+  Started = false;
+  Release = false;
+
+  const int One = 1;
+  const ur_exp_kernel_arg_properties_t Args[] = {pointerArg(0, &Out[0]),
+                                                 valueArg(1, One)};
+  const size_t Size = 1;
+  ur_event_handle_t Root = nullptr;
+  ASSERT_SUCCESS(urEnqueueKernelLaunchWithArgsExp(queue, kernel, 1, nullptr,
+                                                  &Size, &Size, 2, Args,
+                                                  nullptr, 0, nullptr, &Root));
+  Events.push_back(Root);
+  while (!Started) {
+    std::this_thread::yield();
+  }
+
+  for (size_t I = 1; I < NumNodes; I++) {
+    ur_event_handle_t Event = nullptr;
+    ASSERT_SUCCESS(urEnqueueUSMMemcpy(queue, false, &Out[I], &Out[(I - 1) / 2],
+                                      sizeof(int), 1, &Events[(I - 1) / 2],
+                                      &Event));
+    Events.push_back(Event);
+  }
+
+  const int Two = 2;
+  ur_event_handle_t Independent = nullptr;
+  ASSERT_SUCCESS(urEnqueueUSMFill(queue, &Out[NumNodes], sizeof(int), &Two,
+                                  sizeof(int), 0, nullptr, &Independent));
+  Events.push_back(Independent);
+  auto IndependentDone = std::async(std::launch::async, [Independent]() {
+    return urEventWait(1, &Independent);
+  });
+  EXPECT_EQ(IndependentDone.wait_for(10s), std::future_status::ready);
+
+  Release = true;
+  auto Finished =
+      std::async(std::launch::async, [this]() { return urQueueFinish(queue); });
+  ASSERT_EQ(Finished.wait_for(10s), std::future_status::ready);
+  ASSERT_SUCCESS(Finished.get());
+  ASSERT_SUCCESS(IndependentDone.get());
+
+  for (size_t I = 0; I < NumNodes; I++) {
+    ASSERT_EQ(Out[I], 1) << "node " << I;
+  }
+  EXPECT_EQ(Out[NumNodes], 2);
+}
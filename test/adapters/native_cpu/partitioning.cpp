@@ -0,0 +1,149 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: ./partitioning-test
+
+#include "partitioning.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using native_cpu::Partitioning;
+
+TEST(Partitioning, Parse) {
+  EXPECT_EQ(native_cpu::parsePartitioning(nullptr), Partitioning::Static);
+  EXPECT_EQ(native_cpu::parsePartitioning("static"), Partitioning::Static);
+  EXPECT_EQ(native_cpu::parsePartitioning("dynamic"), Partitioning::Dynamic);
+  EXPECT_EQ(native_cpu::parsePartitioning("guided"), Partitioning::Guided);
+  EXPECT_EQ(native_cpu::parsePartitioning("round-robin"),
+            Partitioning::Static);
+}
+
+struct StaticPartitioningTest
+    : ::testing::TestWithParam<std::tuple<size_t, size_t>> {};
+
+// Ranges are contiguous, cover every work-group and are balanced, including
+// when there are fewer work-groups than tasks.
+TEST_P(StaticPartitioningTest, CoversAllWorkGroups) {
+  const auto [numWG, numTasks] = GetParam();
+  std::vector<std::pair<size_t, size_t>> ranges;
+  native_cpu::forEachStaticWGRange(
+      numWG, numTasks, [&](size_t rangeStart, size_t rangeEnd) {
+        ranges.emplace_back(rangeStart, rangeEnd);
+      });
+
+  ASSERT_EQ(ranges.size(), std::min(numWG, numTasks));
+  size_t next = 0;
+  for (auto [rangeStart, rangeEnd] : ranges) {
+    EXPECT_EQ(rangeStart, next);
+    EXPECT_GT(rangeEnd, rangeStart);
+    EXPECT_LE(rangeEnd - rangeStart, numWG / numTasks + 1);
+    EXPECT_GE(rangeEnd - rangeStart, numWG / numTasks);
+    next = rangeEnd;
+  }
+  EXPECT_EQ(next, numWG);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    , StaticPartitioningTest,
+    ::testing::Combine(::testing::Values(1, 3, 64, 1000, 1021),
+                       ::testing::Values(1, 4, 16, 64)));
+
+struct CursorPartitioningTest
+    : ::testing::TestWithParam<std::tuple<bool, size_t, size_t, uint64_t>> {};
+
+// Threads claiming batches concurrently get every work-group exactly once.
+TEST_P(CursorPartitioningTest, ClaimsAllWorkGroupsOnce) {
+  const auto [guided, numWG, numThreads, WGCost] = GetParam();
+  native_cpu::WGCursor cursor;
+  cursor.init(numWG, numThreads, WGCost, guided);
+
+  std::vector<std::atomic<uint32_t>> claimed(numWG);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < std::min(numWG, numThreads); t++) {
+    threads.emplace_back([&]() {
+      size_t rangeStart, rangeEnd;
+      while (cursor.claim(rangeStart, rangeEnd)) {
+        ASSERT_LT(rangeStart, rangeEnd);
+        ASSERT_LE(rangeEnd, numWG);
+        for (size_t i = rangeStart; i < rangeEnd; i++) {
+          claimed[i]++;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < numWG; i++) {
+    ASSERT_EQ(claimed[i], 1u) << "work-group " << i;
+  }
+  size_t rangeStart, rangeEnd;
+  EXPECT_FALSE(cursor.claim(rangeStart, rangeEnd));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    , CursorPartitioningTest,
+    ::testing::Combine(::testing::Bool(), ::testing::Values(1, 3, 1000, 4099),
+                       ::testing::Values(1, 4, 8),
+                       ::testing::Values(0, 10, 100000)));
+
+// Guided batches shrink as the launch nears completion, but never below the
+// grain.
+TEST(Partitioning, GuidedBatchesShrink) {
+  native_cpu::WGCursor cursor;
+  cursor.init(4096, 4, 0, true);
+  size_t rangeStart, rangeEnd;
+  size_t lastBatch = SIZE_MAX;
+  while (cursor.claim(rangeStart, rangeEnd)) {
+    const size_t batch = rangeEnd - rangeStart;
+    EXPECT_LE(batch, lastBatch);
+    EXPECT_GE(batch, std::min<size_t>(4096 / (8 * 4), 4096 - rangeStart));
+    lastBatch = batch;
+  }
+  EXPECT_EQ(rangeEnd, 4096u);
+}
+
+struct NDRangeTest : ::testing::TestWithParam<std::array<size_t, 3>> {};
+
+// Linear ranges starting and ending anywhere map back to each N-D work-group
+// once, with dimension 0 varying fastest.
+TEST_P(NDRangeTest, VisitsEachWorkGroupOnce) {
+  const auto numWG = GetParam();
+  const size_t total = numWG[0] * numWG[1] * numWG[2];
+  std::vector<uint32_t> visited(total);
+  native_cpu::forEachStaticWGRange(
+      total, 7, [&](size_t rangeStart, size_t rangeEnd) {
+        size_t linear = rangeStart;
+        native_cpu::forEachWG(
+            numWG[0], numWG[1], rangeStart, rangeEnd,
+            [&](size_t g0, size_t g1, size_t g2) {
+              ASSERT_LT(g0, numWG[0]);
+              ASSERT_LT(g1, numWG[1]);
+              ASSERT_LT(g2, numWG[2]);
+              const size_t index = g0 + numWG[0] * (g1 + numWG[1] * g2);
+              EXPECT_EQ(index, linear++);
+              visited[index]++;
+            });
+        EXPECT_EQ(linear, rangeEnd);
+      });
+  for (size_t i = 0; i < total; i++) {
+    ASSERT_EQ(visited[i], 1u) << "work-group " << i;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(, NDRangeTest,
+                         ::testing::Values(std::array<size_t, 3>{1, 1, 1},
+                                           std::array<size_t, 3>{100, 1, 1},
+                                           std::array<size_t, 3>{5, 3, 1},
+                                           std::array<size_t, 3>{7, 5, 3},
+                                           std::array<size_t, 3>{1, 1, 13},
+                                           std::array<size_t, 3>{2, 9, 4}));
@@ -0,0 +1,120 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Prints how long a launch of synthetic work-groups takes with each
+// partitioning and thread pool, for uniform and unbalanced work-group costs.
+// This mirrors how urEnqueueKernelLaunch splits a launch, without needing a
+// device binary. Takes the number of work-groups as an optional argument.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "partitioning.hpp"
+#include "threadpool.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+// Busy-waits for roughly ns nanoseconds, like a work-group of that cost.
+static void spin(uint64_t ns) {
+  const auto end = Clock::now() + std::chrono::nanoseconds(ns);
+  while (Clock::now() < end) {
+  }
+}
+
+template <typename TP, typename CostF>
+static double msPerLaunch(TP &tp, native_cpu::Partitioning partitioning,
+                          size_t numWG, CostF &&cost) {
+  constexpr size_t numLaunches = 5;
+  const size_t numThreads = tp.num_threads();
+  std::vector<double> times;
+  uint64_t WGCost = 0;
+  for (size_t launch = 0; launch < numLaunches; launch++) {
+    native_cpu::LaunchInfo launchInfo;
+    auto start = Clock::now();
+    auto Tasks = native_cpu::getScheduler(tp);
+    if (partitioning == native_cpu::Partitioning::Static) {
+      native_cpu::forEachStaticWGRange(
+          numWG, numThreads * Tasks.TasksPerThread(),
+          [&](size_t rangeStart, size_t rangeEnd) {
+            Tasks.schedule([&cost, rangeStart, rangeEnd](size_t) {
+              for (size_t i = rangeStart; i < rangeEnd; i++) {
+                spin(cost(i));
+              }
+            });
+          });
+    } else {
+      launchInfo.Cursor.init(numWG, numThreads, WGCost,
+                             partitioning == native_cpu::Partitioning::Guided);
+      for (size_t t = 0; t < std::min(numWG, numThreads); t++) {
+        Tasks.schedule([&](size_t) {
+          const auto taskStart = Clock::now();
+          size_t rangeStart, rangeEnd;
+          while (launchInfo.Cursor.claim(rangeStart, rangeEnd)) {
+            for (size_t i = rangeStart; i < rangeEnd; i++) {
+              spin(cost(i));
+            }
+          }
+          const std::chrono::nanoseconds busy = Clock::now() - taskStart;
+          launchInfo.BusyTime += busy.count();
+        });
+      }
+    }
+    Tasks.getMovedTaskInfo().wait_all();
+    times.push_back(
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count());
+    // Like the adapter, later launches size their batches from the cost
+    // measured by the previous ones.
+    WGCost = launchInfo.BusyTime.load() / numWG;
+  }
+  std::sort(times.begin(), times.end());
+  return times[numLaunches / 2];
+}
+
+template <typename TP>
+static void run(const char *name, size_t numWG) {
+  TP tp;
+  struct {
+    const char *name;
+    uint64_t (*cost)(size_t);
+  } workloads[] = {
+      {"uniform", [](size_t) -> uint64_t { return 2000; }},
+      // The cost of a work-group grows with its index, as in a triangular
+      // loop nest.
+      {"linear", [](size_t i) -> uint64_t { return 200 + i / 4; }},
+      // One work-group in 64 is 50 times as expensive as the others.
+      {"skewed",
+       [](size_t i) -> uint64_t { return i % 64 == 0 ? 50000 : 1000; }},
+  };
+  const std::pair<const char *, native_cpu::Partitioning> partitionings[] = {
+      {"static", native_cpu::Partitioning::Static},
+      {"dynamic", native_cpu::Partitioning::Dynamic},
+      {"guided", native_cpu::Partitioning::Guided},
+  };
+  for (auto &workload : workloads) {
+    for (auto &[partitioningName, partitioning] : partitionings) {
+      std::printf("%s, %zu threads, %s, %s: %.2f ms/launch\n", name,
+                  tp.num_threads(), workload.name, partitioningName,
+                  msPerLaunch(tp, partitioning, numWG, workload.cost));
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  const size_t numWG = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 8192;
+  if (numWG == 0) {
+    std::fprintf(stderr, "usage: %s [work-group count]\n", argv[0]);
+    return 1;
+  }
+
+  run<native_cpu::simple_threadpool_t>("simple", numWG);
+  run<native_cpu::work_stealing_threadpool_t>("work-stealing", numWG);
+
+  return 0;
+}
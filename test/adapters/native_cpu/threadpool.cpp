@@ -0,0 +1,98 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: SYCL_NATIVE_CPU_HOST_THREADS=4 ./threadpool-test
+
+#include "threadpool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+using work_stealing_pool = native_cpu::detail::work_stealing_thread_pool;
+
+void schedule(work_stealing_pool &pool, std::function<void(size_t)> task) {
+  pool.schedule(native_cpu::worker_task_t(std::move(task)));
+}
+
+} // namespace
+
+// Every task of a round waits for all the others to start, so they can only
+// all finish if the tasks a worker moved from the injection queue into its
+// deque get stolen by the idle workers.
+TEST(WorkStealingThreadPool, IdleWorkersSteal) {
+  work_stealing_pool pool;
+  const size_t numTasks = pool.num_threads();
+
+  for (size_t round = 0; round < 100; round++) {
+    std::mutex mutex;
+    std::condition_variable condition;
+    size_t numStarted = 0;
+    std::set<size_t> threadIds;
+    bool timedOut = false;
+
+    for (size_t i = 0; i < numTasks; i++) {
+      schedule(pool, [&](size_t threadId) {
+        std::unique_lock<std::mutex> lock(mutex);
+        numStarted++;
+        threadIds.insert(threadId);
+        condition.notify_all();
+        if (!condition.wait_for(lock, 1s,
+                                [&]() { return numStarted == numTasks; })) {
+          timedOut = true;
+        }
+      });
+    }
+    pool.wait_for_all_pending_tasks();
+
+    ASSERT_FALSE(timedOut) << "round " << round;
+    ASSERT_EQ(threadIds.size(), numTasks);
+  }
+}
+
+TEST(WorkStealingThreadPool, WaitForAllPendingTasks) {
+  work_stealing_pool pool;
+  // Returns right away without any task
+  pool.wait_for_all_pending_tasks();
+
+  constexpr size_t numTasks = 64;
+  std::atomic<size_t> numDone = 0;
+  for (size_t i = 0; i < numTasks; i++) {
+    schedule(pool, [&numDone, i](size_t) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100 * (i % 8)));
+      numDone++;
+    });
+  }
+  pool.wait_for_all_pending_tasks();
+  EXPECT_EQ(numDone, numTasks);
+  EXPECT_EQ(pool.num_pending_tasks(), 0u);
+
+  // The pool can be waited on again after more work
+  schedule(pool, [&numDone](size_t) { numDone++; });
+  pool.wait_for_all_pending_tasks();
+  EXPECT_EQ(numDone, numTasks + 1);
+}
+
+TEST(WorkStealingThreadPool, DestructorRunsQueuedTasks) {
+  constexpr size_t numTasks = 256;
+  std::atomic<size_t> numDone = 0;
+  {
+    work_stealing_pool pool;
+    for (size_t i = 0; i < numTasks; i++) {
+      schedule(pool, [&numDone](size_t) { numDone++; });
+    }
+  }
+  EXPECT_EQ(numDone, numTasks);
+}
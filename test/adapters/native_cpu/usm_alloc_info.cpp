@@ -0,0 +1,70 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: ./usm_alloc_info-test
+
+#include <uur/fixtures.h>
+
+#include <vector>
+
+struct urNativeCpuUSMAllocInfoTest : uur::urContextTest {
+  void TearDown() override {
+    for (void *Ptr : Allocations) {
+      EXPECT_SUCCESS(urUSMFree(context, Ptr));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(urContextTest::TearDown());
+  }
+
+  void *alloc(size_t Size) {
+    void *Ptr = nullptr;
+    EXPECT_SUCCESS(
+        urUSMSharedAlloc(context, device, nullptr, nullptr, Size, &Ptr));
+    Allocations.push_back(Ptr);
+    return Ptr;
+  }
+
+  std::vector<void *> Allocations;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuUSMAllocInfoTest);
+
+// Pointers anywhere into allocations of any size, including ones spanning
+// many of the granules allocations are tracked by, find their allocation.
+TEST_P(urNativeCpuUSMAllocInfoTest, InteriorPointers) {
+  for (size_t Size : {size_t{8}, size_t{1000}, size_t{70000},
+                      size_t{1} << 20, size_t{5} << 20}) {
+    for (size_t I = 0; I < 8; I++) {
+      alloc(Size);
+    }
+  }
+
+  for (void *Base : Allocations) {
+    size_t Size = 0;
+    ASSERT_SUCCESS(urUSMGetMemAllocInfo(context, Base, UR_USM_ALLOC_INFO_SIZE,
+                                        sizeof(Size), &Size, nullptr));
+    for (size_t Offset : {size_t{0}, Size / 3, Size / 2, Size - 1}) {
+      void *Ptr = static_cast<char *>(Base) + Offset;
+      void *BasePtr = nullptr;
+      ASSERT_SUCCESS(urUSMGetMemAllocInfo(context, Ptr,
+                                          UR_USM_ALLOC_INFO_BASE_PTR,
+                                          sizeof(BasePtr), &BasePtr, nullptr));
+      ASSERT_EQ(BasePtr, Base) << "offset " << Offset << " of " << Size;
+      ur_usm_type_t Type = UR_USM_TYPE_UNKNOWN;
+      ASSERT_SUCCESS(urUSMGetMemAllocInfo(context, Ptr,
+                                          UR_USM_ALLOC_INFO_TYPE,
+                                          sizeof(Type), &Type, nullptr));
+      ASSERT_EQ(Type, UR_USM_TYPE_SHARED);
+    }
+  }
+}
+
+// Pointers outside of any allocation are reported as unknown memory.
+TEST_P(urNativeCpuUSMAllocInfoTest, UnknownPointer) {
+  alloc(64);
+  int Local = 0;
+  ur_usm_type_t Type = UR_USM_TYPE_SHARED;
+  ASSERT_SUCCESS(urUSMGetMemAllocInfo(context, &Local, UR_USM_ALLOC_INFO_TYPE,
+                                      sizeof(Type), &Type, nullptr));
+  ASSERT_EQ(Type, UR_USM_TYPE_UNKNOWN);
+}
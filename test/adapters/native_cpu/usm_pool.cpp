@@ -0,0 +1,96 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: ./usm_pool-test
+
+#include <uur/fixtures.h>
+
+#include <algorithm>
+#include <cstring>
+
+struct urNativeCpuUSMPoolTest : uur::urContextTest {
+  void TearDown() override {
+    if (pool) {
+      EXPECT_SUCCESS(urUSMPoolRelease(pool));
+    }
+    UUR_RETURN_ON_FATAL_FAILURE(urContextTest::TearDown());
+  }
+
+  void createPool(ur_usm_pool_flags_t Flags) {
+    ur_usm_pool_desc_t Desc{UR_STRUCTURE_TYPE_USM_POOL_DESC, nullptr, Flags};
+    ASSERT_SUCCESS(urUSMPoolCreate(context, &Desc, &pool));
+  }
+
+  uint32_t getReferenceCount() {
+    uint32_t Count = 0;
+    EXPECT_SUCCESS(urUSMPoolGetInfo(pool, UR_USM_POOL_INFO_REFERENCE_COUNT,
+                                    sizeof(Count), &Count, nullptr));
+    return Count;
+  }
+
+  ur_usm_pool_handle_t pool = nullptr;
+};
+UUR_INSTANTIATE_DEVICE_TEST_SUITE(urNativeCpuUSMPoolTest);
+
+// Blocks reused from the pool are zeroed again for zero-initializing pools.
+TEST_P(urNativeCpuUSMPoolTest, ZeroInitReusedBlock) {
+  createPool(UR_USM_POOL_FLAG_ZERO_INITIALIZE_BLOCK);
+  constexpr size_t Size = 256;
+
+  void *First = nullptr;
+  ASSERT_SUCCESS(
+      urUSMSharedAlloc(context, device, nullptr, pool, Size, &First));
+  std::memset(First, 0xff, Size);
+  ASSERT_SUCCESS(urUSMFree(context, First));
+
+  void *Second = nullptr;
+  ASSERT_SUCCESS(
+      urUSMSharedAlloc(context, device, nullptr, pool, Size, &Second));
+  // The freed block is cached, so this is the reuse path
+  ASSERT_EQ(Second, First);
+  auto *Bytes = static_cast<const uint8_t *>(Second);
+  EXPECT_TRUE(std::all_of(Bytes, Bytes + Size,
+                          [](uint8_t Byte) { return Byte == 0; }));
+  ASSERT_SUCCESS(urUSMFree(context, Second));
+}
+
+// Allocations keep their pool alive, so they can still be used and freed
+// after the pool was released.
+TEST_P(urNativeCpuUSMPoolTest, FreeAfterPoolRelease) {
+  createPool(0);
+  ASSERT_EQ(getReferenceCount(), 1u);
+
+  void *Pooled = nullptr;
+  ASSERT_SUCCESS(
+      urUSMSharedAlloc(context, device, nullptr, pool, 64, &Pooled));
+  void *Unpooled = nullptr;
+  // Too big for the buckets of the pool
+  ASSERT_SUCCESS(urUSMSharedAlloc(context, device, nullptr, pool,
+                                  64 * 1024 * 1024, &Unpooled));
+  EXPECT_EQ(getReferenceCount(), 3u);
+
+  ASSERT_SUCCESS(urUSMPoolRelease(pool));
+  pool = nullptr;
+
+  std::memset(Pooled, 1, 64);
+  std::memset(Unpooled, 1, 64 * 1024 * 1024);
+  ur_usm_pool_handle_t AllocPool = nullptr;
+  ASSERT_SUCCESS(urUSMGetMemAllocInfo(context, Pooled,
+                                      UR_USM_ALLOC_INFO_POOL,
+                                      sizeof(AllocPool), &AllocPool, nullptr));
+  EXPECT_NE(AllocPool, nullptr);
+  ASSERT_SUCCESS(urUSMFree(context, Pooled));
+  ASSERT_SUCCESS(urUSMFree(context, Unpooled));
+}
+
+// Freeing an allocation drops its reference to the pool.
+TEST_P(urNativeCpuUSMPoolTest, FreeReleasesPool) {
+  createPool(0);
+  void *Ptr = nullptr;
+  ASSERT_SUCCESS(urUSMHostAlloc(context, nullptr, pool, 128, &Ptr));
+  EXPECT_EQ(getReferenceCount(), 2u);
+  ASSERT_SUCCESS(urUSMFree(context, Ptr));
+  EXPECT_EQ(getReferenceCount(), 1u);
+}
@@ -0,0 +1,157 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file allocation_index.cpp
+ *
+ */
+
+// RUN: allocation_index-test
+// REQUIRES: sanitizer
+
+#include "asan/asan_allocation_index.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ur_sanitizer_layer;
+using namespace ur_sanitizer_layer::asan;
+
+namespace {
+
+ur_context_handle_t MakeContext(uptr Id) {
+  return reinterpret_cast<ur_context_handle_t>(Id);
+}
+
+std::shared_ptr<AllocInfo> MakeAllocInfo(uptr Begin, size_t Size,
+                                         ur_context_handle_t Context) {
+  auto AI = std::make_shared<AllocInfo>();
+  AI->AllocBegin = Begin;
+  AI->UserBegin = Begin;
+  AI->UserEnd = Begin + Size;
+  AI->AllocSize = Size;
+  AI->Context = Context;
+  return AI;
+}
+
+} // namespace
+
+TEST(AllocationIndex, Find) {
+  AllocationIndex Index;
+  auto Small = MakeAllocInfo(0x10000, 0x40, MakeContext(1));
+  auto Device = MakeAllocInfo(0xff00'0000'0010'0000, 0x3000, MakeContext(1));
+  ASSERT_TRUE(Index.insert(Small));
+  ASSERT_TRUE(Index.insert(Device));
+
+  EXPECT_EQ(Index.find(0x10000), Small);
+  EXPECT_EQ(Index.find(0x1003f), Small);
+  EXPECT_EQ(Index.find(0x10040), nullptr);
+  EXPECT_EQ(Index.find(0xffff), nullptr);
+  EXPECT_EQ(Index.find(0xff00'0000'0010'2fff), Device);
+  EXPECT_EQ(Index.find(0xff00'0000'0010'3000), nullptr);
+}
+
+TEST(AllocationIndex, NeighboursInOnePage) {
+  AllocationIndex Index;
+  std::vector<std::shared_ptr<AllocInfo>> AllocInfos;
+  for (uptr I = 0; I < 64; I++) {
+    AllocInfos.push_back(MakeAllocInfo(0x20000 + I * 0x40, 0x40, nullptr));
+    ASSERT_TRUE(Index.insert(AllocInfos.back()));
+  }
+
+  for (uptr I = 0; I < 64; I++) {
+    EXPECT_EQ(Index.find(0x20000 + I * 0x40 + 0x20), AllocInfos[I]);
+  }
+}
+
+TEST(AllocationIndex, LargeAllocations) {
+  AllocationIndex Index;
+  // Spans more pages at every page size but the largest one
+  auto Huge = MakeAllocInfo(0x1'0000'0000'0000 - 0x1000, 0x1'0000'0002'0000,
+                            MakeContext(1));
+  auto Large = MakeAllocInfo(0x4000'0000, 0x1000'0000, MakeContext(1));
+  ASSERT_TRUE(Index.insert(Huge));
+  ASSERT_TRUE(Index.insert(Large));
+
+  EXPECT_EQ(Index.find(0x1'0000'0000'0000 - 0x1000), Huge);
+  EXPECT_EQ(Index.find(0x1'8000'0000'0000), Huge);
+  EXPECT_EQ(Index.find(0x2'0000'0001'efff), Huge);
+  EXPECT_EQ(Index.find(0x2'0000'0001'f000), nullptr);
+  EXPECT_EQ(Index.find(0x4800'0000), Large);
+  EXPECT_EQ(Index.find(0x5000'0000), nullptr);
+
+  EXPECT_EQ(Index.erase(Huge->AllocBegin), Huge);
+  EXPECT_EQ(Index.find(0x1'8000'0000'0000), nullptr);
+  EXPECT_EQ(Index.find(0x4800'0000), Large);
+}
+
+TEST(AllocationIndex, InsertAndErase) {
+  AllocationIndex Index;
+  auto AI = MakeAllocInfo(0x30000, 0x100, MakeContext(1));
+  ASSERT_TRUE(Index.insert(AI));
+  // Like std::map::emplace, an allocation at the same address isn't replaced
+  EXPECT_FALSE(Index.insert(MakeAllocInfo(0x30000, 0x200, MakeContext(1))));
+  EXPECT_EQ(Index.find(0x30100), nullptr);
+
+  EXPECT_EQ(Index.erase(0x30010), nullptr);
+  EXPECT_EQ(Index.erase(0x30000), AI);
+  EXPECT_EQ(Index.erase(0x30000), nullptr);
+  EXPECT_EQ(Index.find(0x30000), nullptr);
+  EXPECT_TRUE(Index.findByContext(MakeContext(1)).empty());
+}
+
+TEST(AllocationIndex, FindByContext) {
+  AllocationIndex Index;
+  ASSERT_TRUE(Index.insert(MakeAllocInfo(0x40000, 0x100, MakeContext(1))));
+  ASSERT_TRUE(Index.insert(MakeAllocInfo(0x40100, 0x100, MakeContext(2))));
+  ASSERT_TRUE(Index.insert(MakeAllocInfo(0x40200, 0x100, MakeContext(1))));
+
+  auto AllocInfos = Index.findByContext(MakeContext(1));
+  ASSERT_EQ(AllocInfos.size(), 2u);
+  for (const auto &AI : AllocInfos) {
+    EXPECT_EQ(AI->Context, MakeContext(1));
+  }
+  EXPECT_EQ(Index.findByContext(MakeContext(2)).size(), 1u);
+  EXPECT_TRUE(Index.findByContext(MakeContext(3)).empty());
+
+  Index.erase(0x40100);
+  EXPECT_TRUE(Index.findByContext(MakeContext(2)).empty());
+
+  Index.clear();
+  EXPECT_TRUE(Index.findByContext(MakeContext(1)).empty());
+  EXPECT_EQ(Index.find(0x40000), nullptr);
+}
+
+TEST(AllocationIndex, Concurrent) {
+  constexpr uptr NumThreads = 8;
+  constexpr uptr NumAllocations = 1000;
+
+  AllocationIndex Index;
+  std::vector<std::thread> Threads;
+  for (uptr T = 0; T < NumThreads; T++) {
+    Threads.emplace_back([&Index, T] {
+      const uptr Base = 0x100'0000 * (T + 1);
+      for (uptr I = 0; I < NumAllocations; I++) {
+        uptr Begin = Base + I * 0x100;
+        ASSERT_TRUE(Index.insert(MakeAllocInfo(Begin, 0x80, MakeContext(T))));
+        auto AI = Index.find(Begin + 0x7f);
+        ASSERT_NE(AI, nullptr);
+        EXPECT_EQ(AI->AllocBegin, Begin);
+        if (I % 2) {
+          EXPECT_EQ(Index.erase(Begin), AI);
+        }
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  for (uptr T = 0; T < NumThreads; T++) {
+    EXPECT_EQ(Index.findByContext(MakeContext(T)).size(), NumAllocations / 2);
+  }
+}
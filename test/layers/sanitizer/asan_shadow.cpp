@@ -0,0 +1,382 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file asan_shadow.cpp
+ *
+ */
+
+// RUN: asan_shadow-test
+// REQUIRES: sanitizer
+
+#include "asan/asan_libdevice.hpp"
+#include "asan/asan_shadow.hpp"
+#include "ur_sanitizer_layer.hpp"
+
+#include <gtest/gtest.h>
+#include <unified-runtime/ur_ddi.h>
+#include <ur_mock_helpers.hpp>
+
+using namespace ur_sanitizer_layer;
+using namespace ur_sanitizer_layer::asan;
+
+namespace {
+
+constexpr size_t PageSize = 0x10000;
+
+// The memory whose shadow is a page
+constexpr uptr ShadowPageMem = PageSize << ASAN_SHADOW_SCALE;
+
+// The calls the shadow memory made to the mock adapter
+struct CallCounts {
+  size_t PhysicalMemCreate;
+  size_t VirtualMemMap;
+  size_t VirtualMemUnmap;
+  size_t USMFill;
+  size_t USMMemcpy;
+  size_t EventsWait;
+  size_t EventWait;
+  size_t QueueFinish;
+};
+
+CallCounts Calls;
+
+// The status of the events the mock adapter reports
+ur_event_status_t EventStatus;
+
+template <size_t CallCounts::*Count> ur_result_t countCall(void *) {
+  Calls.*Count += 1;
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t replaceVirtualMemGranularityGetInfo(void *pParams) {
+  auto &Params =
+      *static_cast<ur_virtual_mem_granularity_get_info_params_t *>(pParams);
+  if (*Params.ppPropValue) {
+    *static_cast<size_t *>(*Params.ppPropValue) = PageSize;
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t replaceVirtualMemReserve(void *pParams) {
+  auto &Params = *static_cast<ur_virtual_mem_reserve_params_t *>(pParams);
+  // Never accessed, as the mock adapter doesn't write to the memory
+  **Params.pppStart = reinterpret_cast<void *>(0x100'0000'0000'0000ULL);
+  return UR_RESULT_SUCCESS;
+}
+
+ur_result_t replaceEventGetInfo(void *pParams) {
+  auto &Params = *static_cast<ur_event_get_info_params_t *>(pParams);
+  if (*Params.ppropName == UR_EVENT_INFO_COMMAND_EXECUTION_STATUS &&
+      *Params.ppPropValue) {
+    *static_cast<ur_event_status_t *>(*Params.ppPropValue) = EventStatus;
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+const std::pair<const char *, ur_mock_callback_t> CountedCalls[] = {
+    {"urPhysicalMemCreate", &countCall<&CallCounts::PhysicalMemCreate>},
+    {"urVirtualMemMap", &countCall<&CallCounts::VirtualMemMap>},
+    {"urVirtualMemUnmap", &countCall<&CallCounts::VirtualMemUnmap>},
+    {"urEnqueueUSMFill", &countCall<&CallCounts::USMFill>},
+    {"urEnqueueUSMMemcpy", &countCall<&CallCounts::USMMemcpy>},
+    {"urEnqueueEventsWait", &countCall<&CallCounts::EventsWait>},
+    {"urEventWait", &countCall<&CallCounts::EventWait>},
+    {"urQueueFinish", &countCall<&CallCounts::QueueFinish>},
+};
+
+const std::pair<const char *, ur_mock_callback_t> ReplacedCalls[] = {
+    {"urVirtualMemGranularityGetInfo", &replaceVirtualMemGranularityGetInfo},
+    {"urVirtualMemReserve", &replaceVirtualMemReserve},
+    {"urEventGetInfo", &replaceEventGetInfo},
+};
+
+// Drives the shadow memory of the layer directly, with the calls it makes to
+// the mock adapter going through the loader.
+struct AsanShadowTest : public ::testing::Test {
+  void SetUp() override {
+    Calls = {};
+    EventStatus = UR_EVENT_STATUS_COMPLETE;
+    for (auto [Name, Callback] : CountedCalls) {
+      mock::getCallbacks().set_before_callback(Name, Callback);
+    }
+    for (auto [Name, Callback] : ReplacedCalls) {
+      mock::getCallbacks().set_replace_callback(Name, Callback);
+    }
+
+    ASSERT_EQ(urLoaderConfigCreate(&LoaderConfig), UR_RESULT_SUCCESS);
+    ASSERT_EQ(urLoaderConfigSetMockingEnabled(LoaderConfig, true),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urLoaderInit(0, LoaderConfig), UR_RESULT_SUCCESS);
+    ASSERT_EQ(urAdapterGet(1, &Adapter, nullptr), UR_RESULT_SUCCESS);
+    ur_platform_handle_t Platform;
+    ASSERT_EQ(urPlatformGet(Adapter, 1, &Platform, nullptr),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urDeviceGet(Platform, UR_DEVICE_TYPE_ALL, 1, &Device, nullptr),
+              UR_RESULT_SUCCESS);
+
+    auto &Table = getContext()->urDdiTable;
+    ASSERT_EQ(urGetContextProcAddrTable(UR_API_VERSION_CURRENT, &Table.Context),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urGetDeviceProcAddrTable(UR_API_VERSION_CURRENT, &Table.Device),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urGetEnqueueProcAddrTable(UR_API_VERSION_CURRENT, &Table.Enqueue),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urGetEventProcAddrTable(UR_API_VERSION_CURRENT, &Table.Event),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urGetPhysicalMemProcAddrTable(UR_API_VERSION_CURRENT,
+                                            &Table.PhysicalMem),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urGetQueueProcAddrTable(UR_API_VERSION_CURRENT, &Table.Queue),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urGetUSMProcAddrTable(UR_API_VERSION_CURRENT, &Table.USM),
+              UR_RESULT_SUCCESS);
+    ASSERT_EQ(urGetVirtualMemProcAddrTable(UR_API_VERSION_CURRENT,
+                                           &Table.VirtualMem),
+              UR_RESULT_SUCCESS);
+  }
+
+  void TearDown() override {
+    if (Queue) {
+      EXPECT_EQ(urQueueRelease(Queue), UR_RESULT_SUCCESS);
+    }
+    if (Device) {
+      EXPECT_EQ(urDeviceRelease(Device), UR_RESULT_SUCCESS);
+    }
+    if (Adapter) {
+      EXPECT_EQ(urAdapterRelease(Adapter), UR_RESULT_SUCCESS);
+    }
+    EXPECT_EQ(urLoaderTearDown(), UR_RESULT_SUCCESS);
+    EXPECT_EQ(urLoaderConfigRelease(LoaderConfig), UR_RESULT_SUCCESS);
+    getContext()->urDdiTable = {};
+    getContext()->Options.ReleaseShadow = false;
+
+    for (auto [Name, Callback] : CountedCalls) {
+      mock::getCallbacks().set_before_callback(Name, nullptr);
+    }
+    for (auto [Name, Callback] : ReplacedCalls) {
+      mock::getCallbacks().set_replace_callback(Name, nullptr);
+    }
+  }
+
+  // Sets up Shadow, and creates the queue writing it
+  void SetUpShadow(ShadowMemory &Shadow) {
+    ASSERT_EQ(Shadow.Setup(), UR_RESULT_SUCCESS);
+    ASSERT_EQ(urQueueCreate(Shadow.Context, Device, nullptr, &Queue),
+              UR_RESULT_SUCCESS);
+    Calls = {};
+  }
+
+  // Adds the shadow of an allocation at Ptr with short redzones, which is
+  // written with a copy
+  static void PoisonAllocation(ShadowMemory &Shadow, ShadowPoisonBatch &Batch,
+                               uptr Ptr) {
+    Shadow.PoisonShadow(Batch, Ptr, 0x40, kUsmDeviceRedzoneMagic);
+    Shadow.PoisonShadow(Batch, Ptr + 0x40, 0x40, kZeroMagic);
+    Shadow.PoisonShadow(Batch, Ptr + 0x80, 0x40, kUsmDeviceRedzoneMagic);
+  }
+
+  ur_loader_config_handle_t LoaderConfig = nullptr;
+  ur_adapter_handle_t Adapter = nullptr;
+  ur_device_handle_t Device = nullptr;
+  ur_queue_handle_t Queue = nullptr;
+};
+
+} // namespace
+
+TEST_F(AsanShadowTest, BatchCopiesKeptUntilDone) {
+  ShadowMemoryDG2 Shadow(Device);
+  SetUpShadow(Shadow);
+
+  // The copies of the first batch are still running at the second one
+  EventStatus = UR_EVENT_STATUS_RUNNING;
+  ShadowPoisonBatch Batch;
+  PoisonAllocation(Shadow, Batch, 0x1000);
+  ASSERT_EQ(Shadow.EnqueuePoisonShadowBatch(Queue, Batch), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.USMMemcpy, 1);
+  EXPECT_EQ(Calls.EventsWait, 1);
+  EXPECT_EQ(Shadow.InFlightWrites.size(), 1);
+
+  ASSERT_EQ(Shadow.EnqueuePoisonShadowBatch(Queue, Batch), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.USMMemcpy, 2);
+  EXPECT_EQ(Calls.EventsWait, 2);
+  EXPECT_EQ(Shadow.InFlightWrites.size(), 2);
+
+  // Batches without copies need no marker
+  ShadowPoisonBatch FillBatch;
+  Shadow.PoisonShadow(FillBatch, 0x100000,
+                      ShadowPoisonBatch::MinFillSize << ASAN_SHADOW_SCALE,
+                      kZeroMagic);
+  ASSERT_EQ(Shadow.EnqueuePoisonShadowBatch(Queue, FillBatch),
+            UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.EventsWait, 2);
+  EXPECT_EQ(Shadow.InFlightWrites.size(), 2);
+
+  // The writes of the previous batches are released once they're done
+  EventStatus = UR_EVENT_STATUS_COMPLETE;
+  ASSERT_EQ(Shadow.EnqueuePoisonShadowBatch(Queue, Batch), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.EventsWait, 3);
+  EXPECT_EQ(Shadow.InFlightWrites.size(), 1);
+
+  // The queue isn't finished for them, but the last ones are waited for
+  EXPECT_EQ(Calls.QueueFinish, 0);
+  EXPECT_EQ(Calls.EventWait, 0);
+  ASSERT_EQ(Shadow.Destory(), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.EventWait, 1);
+  EXPECT_TRUE(Shadow.InFlightWrites.empty());
+}
+
+TEST_F(AsanShadowTest, HostBatchCopiesNotSynchronized) {
+  ShadowMemoryCPU Shadow(Device);
+  SetUpShadow(Shadow);
+
+  ShadowPoisonBatch Batch;
+  PoisonAllocation(Shadow, Batch, 0x1000);
+  ASSERT_EQ(Shadow.EnqueuePoisonShadowBatch(Queue, Batch), UR_RESULT_SUCCESS);
+  EXPECT_EQ(*reinterpret_cast<int8_t *>(Shadow.MemToShadow(0x1000)),
+            kUsmDeviceRedzoneMagic);
+  EXPECT_EQ(*reinterpret_cast<int8_t *>(Shadow.MemToShadow(0x1040)),
+            kZeroMagic);
+
+  // The shadow is written by the host, with nothing to wait for
+  EXPECT_EQ(Calls.USMMemcpy, 0);
+  EXPECT_EQ(Calls.EventsWait, 0);
+  EXPECT_EQ(Calls.QueueFinish, 0);
+  ASSERT_EQ(Shadow.Destory(), UR_RESULT_SUCCESS);
+}
+
+TEST_F(AsanShadowTest, ShadowMappedInChunks) {
+  constexpr size_t MaxChunkPages = ShadowMemoryGPU::kMaxChunkPages;
+  ShadowMemoryDG2 Shadow(Device);
+  SetUpShadow(Shadow);
+
+  {
+    std::scoped_lock<ur_mutex> Guard(Shadow.VirtualMemMapsMutex);
+    const uptr Begin = Shadow.ShadowBegin + 16 * PageSize;
+    const uptr End = Begin + (2 * MaxChunkPages + 8) * PageSize;
+    ASSERT_EQ(Shadow.EnsureShadowMapped(Queue, Begin, End - 1),
+              UR_RESULT_SUCCESS);
+    EXPECT_EQ(Calls.PhysicalMemCreate, 3);
+    EXPECT_EQ(Calls.VirtualMemMap, 3);
+    EXPECT_EQ(Shadow.VirtualMemMaps.at(Begin).Size, MaxChunkPages * PageSize);
+    EXPECT_EQ(Shadow.VirtualMemMaps.at(Begin + MaxChunkPages * PageSize).Size,
+              MaxChunkPages * PageSize);
+    EXPECT_EQ(End - Shadow.VirtualMemMaps.rbegin()->first, 8 * PageSize);
+
+    // Only the pages that aren't mapped yet are
+    ASSERT_EQ(Shadow.EnsureShadowMapped(Queue, Begin + PageSize,
+                                        Begin + 2 * PageSize - 1),
+              UR_RESULT_SUCCESS);
+    EXPECT_EQ(Calls.VirtualMemMap, 3);
+    ASSERT_EQ(Shadow.EnsureShadowMapped(Queue, Begin - 2 * PageSize,
+                                        End + 2 * PageSize - 1),
+              UR_RESULT_SUCCESS);
+    EXPECT_EQ(Calls.PhysicalMemCreate, 5);
+    EXPECT_EQ(Calls.VirtualMemMap, 5);
+  }
+
+  ASSERT_EQ(Shadow.Destory(), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.VirtualMemUnmap, 6);
+}
+
+TEST_F(AsanShadowTest, PoisonOnlyMapsRetainedShadow) {
+  getContext()->Options.ReleaseShadow = true;
+  ShadowMemoryDG2 Shadow(Device);
+  SetUpShadow(Shadow);
+  // The shadow of the null pointer
+  EXPECT_EQ(Shadow.VirtualMemMaps.size(), 1);
+
+  // Memory without allocations has no shadow to poison
+  const uptr Ptr = 16 * ShadowPageMem;
+  ASSERT_EQ(Shadow.EnqueuePoisonShadow(Queue, Ptr, 4 * ShadowPageMem,
+                                       &kUsmDeviceRedzoneMagic),
+            UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.VirtualMemMap, 0);
+  EXPECT_EQ(Calls.USMFill, 0);
+
+  // Only the shadow of the allocations in it is mapped and poisoned
+  Shadow.RetainShadow(Ptr + ShadowPageMem, ShadowPageMem);
+  ASSERT_EQ(Shadow.EnqueuePoisonShadow(Queue, Ptr, 4 * ShadowPageMem,
+                                       &kUsmDeviceRedzoneMagic),
+            UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.PhysicalMemCreate, 1);
+  EXPECT_EQ(Calls.VirtualMemMap, 1);
+  EXPECT_EQ(Shadow.VirtualMemMaps.count(Shadow.MemToShadow(Ptr) + PageSize),
+            1);
+  // Zeroed when it's mapped, and then poisoned
+  EXPECT_EQ(Calls.USMFill, 2);
+
+  ASSERT_EQ(Shadow.Destory(), UR_RESULT_SUCCESS);
+}
+
+TEST_F(AsanShadowTest, ShadowReclaimedOnRelease) {
+  getContext()->Options.ReleaseShadow = true;
+  ShadowMemoryDG2 Shadow(Device);
+  SetUpShadow(Shadow);
+
+  // Two allocations sharing a page of shadow, and one far from them
+  const std::pair<uptr, uptr> First{16 * ShadowPageMem, 2 * ShadowPageMem};
+  const std::pair<uptr, uptr> Second{17 * ShadowPageMem + ShadowPageMem / 2,
+                                     ShadowPageMem + ShadowPageMem / 2};
+  const std::pair<uptr, uptr> Far{1024 * ShadowPageMem, ShadowPageMem};
+  for (auto [Ptr, Size] : {First, Second, Far}) {
+    Shadow.RetainShadow(Ptr, Size);
+    ASSERT_EQ(
+        Shadow.EnqueuePoisonShadow(Queue, Ptr, Size, &kUsmDeviceRedzoneMagic),
+        UR_RESULT_SUCCESS);
+  }
+  EXPECT_EQ(Calls.VirtualMemMap, 3);
+  EXPECT_EQ(Shadow.VirtualMemMaps.size(), 4);
+
+  // The page shared with the second allocation is kept
+  ASSERT_EQ(Shadow.ReleaseShadow({First}), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.VirtualMemUnmap, 0);
+  ASSERT_EQ(Shadow.ReleaseShadow({Second}), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.VirtualMemUnmap, 2);
+  ASSERT_EQ(Shadow.ReleaseShadow({Far}), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.VirtualMemUnmap, 3);
+  EXPECT_EQ(Shadow.VirtualMemMaps.size(), 1);
+
+  // Poisoning released memory doesn't map its shadow again
+  for (auto [Ptr, Size] : {First, Second, Far}) {
+    ASSERT_EQ(Shadow.EnqueuePoisonShadow(Queue, Ptr, Size,
+                                         &kUsmDeviceDeallocatedMagic),
+              UR_RESULT_SUCCESS);
+  }
+  EXPECT_EQ(Calls.VirtualMemMap, 3);
+
+  ASSERT_EQ(Shadow.Destory(), UR_RESULT_SUCCESS);
+}
+
+TEST_F(AsanShadowTest, ReleasedRangesReclaimedOnTheirOwn) {
+  getContext()->Options.ReleaseShadow = true;
+  ShadowMemoryDG2 Shadow(Device);
+  SetUpShadow(Shadow);
+
+  const std::pair<uptr, uptr> First{16 * ShadowPageMem, ShadowPageMem};
+  const std::pair<uptr, uptr> Last{1024 * ShadowPageMem, ShadowPageMem};
+  for (auto [Ptr, Size] : {First, Last}) {
+    Shadow.RetainShadow(Ptr, Size);
+    ASSERT_EQ(
+        Shadow.EnqueuePoisonShadow(Queue, Ptr, Size, &kUsmDeviceRedzoneMagic),
+        UR_RESULT_SUCCESS);
+  }
+
+  // Mapped shadow between the ranges, which releasing them mustn't reach
+  const uptr Between = Shadow.MemToShadow(512 * ShadowPageMem);
+  {
+    std::scoped_lock<ur_mutex> Guard(Shadow.VirtualMemMapsMutex);
+    ASSERT_EQ(Shadow.EnsureShadowMapped(Queue, Between, Between),
+              UR_RESULT_SUCCESS);
+  }
+
+  ASSERT_EQ(Shadow.ReleaseShadow({First, Last}), UR_RESULT_SUCCESS);
+  EXPECT_EQ(Calls.VirtualMemUnmap, 2);
+  EXPECT_EQ(Shadow.VirtualMemMaps.count(Between), 1);
+
+  ASSERT_EQ(Shadow.Destory(), UR_RESULT_SUCCESS);
+}
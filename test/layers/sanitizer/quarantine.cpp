@@ -0,0 +1,136 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file quarantine.cpp
+ *
+ */
+
+// RUN: quarantine-test
+// REQUIRES: sanitizer
+
+#include "asan/asan_quarantine.hpp"
+
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+
+using namespace ur_sanitizer_layer;
+using namespace ur_sanitizer_layer::asan;
+
+namespace {
+
+ur_device_handle_t MakeDevice(uptr Id) {
+  return reinterpret_cast<ur_device_handle_t>(Id);
+}
+
+std::shared_ptr<AllocInfo> MakeAllocInfo(uptr Begin, size_t Size) {
+  auto AI = std::make_shared<AllocInfo>();
+  AI->AllocBegin = Begin;
+  AI->AllocSize = Size;
+  return AI;
+}
+
+} // namespace
+
+TEST(QuarantineFifo, Order) {
+  QuarantineFifo Fifo;
+  EXPECT_EQ(Fifo.pop(), nullptr);
+
+  auto First = MakeAllocInfo(0x1000, 0x10);
+  auto Second = MakeAllocInfo(0x2000, 0x10);
+  Fifo.push(First);
+  Fifo.push(Second);
+  EXPECT_EQ(Fifo.pop(), First);
+  EXPECT_EQ(Fifo.pop(), Second);
+  EXPECT_EQ(Fifo.pop(), nullptr);
+}
+
+TEST(Quarantine, EvictsOldestInBatches) {
+  Quarantine Q(0x400);
+  std::vector<std::shared_ptr<AllocInfo>> AllocInfos;
+  for (uptr I = 0; I < 16; I++) {
+    AllocInfos.push_back(MakeAllocInfo(0x1000 + I * 0x100, 0x40));
+    EXPECT_TRUE(Q.put(nullptr, AllocInfos.back()).empty());
+  }
+
+  // Makes room for a quarter of the limit, oldest first
+  auto Extra = MakeAllocInfo(0x10000, 0x40);
+  auto Evicted = Q.put(nullptr, Extra);
+  ASSERT_EQ(Evicted.size(), 5u);
+  for (size_t I = 0; I < Evicted.size(); I++) {
+    EXPECT_EQ(Evicted[I], AllocInfos[I]);
+  }
+
+  // So that the next ones don't evict anything
+  for (uptr I = 0; I < 4; I++) {
+    auto AI = MakeAllocInfo(0x20000 + I * 0x100, 0x40);
+    EXPECT_TRUE(Q.put(nullptr, AI).empty());
+  }
+}
+
+TEST(Quarantine, LargeAllocationIsKept) {
+  Quarantine Q(0x400);
+  auto Small = MakeAllocInfo(0x1000, 0x40);
+  auto Large = MakeAllocInfo(0x2000, 0x800);
+  EXPECT_TRUE(Q.put(nullptr, Small).empty());
+
+  auto Evicted = Q.put(nullptr, Large);
+  ASSERT_EQ(Evicted.size(), 1u);
+  EXPECT_EQ(Evicted[0], Small);
+
+  // Until the next allocation is quarantined
+  auto Next = MakeAllocInfo(0x3000, 0x40);
+  Evicted = Q.put(nullptr, Next);
+  ASSERT_EQ(Evicted.size(), 1u);
+  EXPECT_EQ(Evicted[0], Large);
+}
+
+TEST(Quarantine, DevicesAreSeparate) {
+  Quarantine Q(0x100);
+  auto AI0 = MakeAllocInfo(0x1000, 0x100);
+  auto AI1 = MakeAllocInfo(0x2000, 0x100);
+  EXPECT_TRUE(Q.put(MakeDevice(1), AI0).empty());
+  EXPECT_TRUE(Q.put(MakeDevice(2), AI1).empty());
+
+  auto AI2 = MakeAllocInfo(0x3000, 0x100);
+  auto Evicted = Q.put(MakeDevice(2), AI2);
+  ASSERT_EQ(Evicted.size(), 1u);
+  EXPECT_EQ(Evicted[0], AI1);
+}
+
+TEST(Quarantine, Concurrent) {
+  constexpr uptr NumThreads = 8;
+  constexpr uptr NumAllocations = 1000;
+
+  Quarantine Q(0x1000);
+  std::vector<std::vector<std::shared_ptr<AllocInfo>>> Evicted(NumThreads);
+  std::vector<std::thread> Threads;
+  for (uptr T = 0; T < NumThreads; T++) {
+    Threads.emplace_back([&Q, &Evicted, T] {
+      for (uptr I = 0; I < NumAllocations; I++) {
+        auto AI = MakeAllocInfo((T << 32) + I * 0x100, 0x40);
+        for (auto &EvictedAI : Q.put(MakeDevice(T % 2), AI)) {
+          Evicted[T].push_back(std::move(EvictedAI));
+        }
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  // Each allocation is evicted at most once, and most of them are
+  std::set<uptr> EvictedBegins;
+  for (const auto &List : Evicted) {
+    for (const auto &AI : List) {
+      EXPECT_TRUE(EvictedBegins.insert(AI->AllocBegin).second);
+    }
+  }
+  EXPECT_LE(EvictedBegins.size(), NumThreads * NumAllocations);
+  EXPECT_GE(EvictedBegins.size(), NumThreads * NumAllocations / 2);
+}
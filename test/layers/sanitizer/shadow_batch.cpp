@@ -0,0 +1,165 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file shadow_batch.cpp
+ *
+ */
+
+// RUN: shadow_batch-test
+// REQUIRES: sanitizer
+
+#include "sanitizer_shadow_batch.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace ur_sanitizer_layer;
+
+namespace {
+
+constexpr int8_t kZero = 0;
+constexpr int8_t kRedzone = (int8_t)0x81;
+constexpr int8_t kReleased = (int8_t)0x84;
+
+// Poisons the shadow of an allocation the way the ASan interceptor does, with
+// a zeroed user range, a partial granule and redzones on both sides.
+void PoisonAllocation(ShadowPoisonBatch &Batch, uptr Begin, uptr LeftRZ,
+                      uptr User, uptr RightRZ) {
+  Batch.Poison(Begin, Begin + LeftRZ + User + RightRZ, kZero);
+  Batch.Poison(Begin + LeftRZ + User - 1, Begin + LeftRZ + User, 3);
+  Batch.Poison(Begin, Begin + LeftRZ, kRedzone);
+  Batch.Poison(Begin + LeftRZ + User, Begin + LeftRZ + User + RightRZ,
+               kRedzone);
+}
+
+std::vector<int8_t> Repeat(std::vector<int8_t> Bytes, int8_t Value,
+                           size_t Count) {
+  Bytes.insert(Bytes.end(), Count, Value);
+  return Bytes;
+}
+
+} // namespace
+
+TEST(ShadowPoisonBatch, Empty) {
+  ShadowPoisonBatch Batch;
+  EXPECT_TRUE(Batch.Empty());
+  Batch.Poison(0x1000, 0x1000, kRedzone);
+  EXPECT_TRUE(Batch.Empty());
+  EXPECT_TRUE(Batch.GetWrites().empty());
+}
+
+TEST(ShadowPoisonBatch, SingleRangeIsFill) {
+  ShadowPoisonBatch Batch;
+  Batch.Poison(0x1000, 0x1010, kReleased);
+
+  auto Writes = Batch.GetWrites();
+  ASSERT_EQ(Writes.size(), 1u);
+  EXPECT_TRUE(Writes[0].IsFill());
+  EXPECT_EQ(Writes[0].ShadowPtr, 0x1000u);
+  EXPECT_EQ(Writes[0].Size, 0x10u);
+  EXPECT_EQ(Writes[0].Value, kReleased);
+}
+
+TEST(ShadowPoisonBatch, AllocationIsOneWrite) {
+  ShadowPoisonBatch Batch;
+  PoisonAllocation(Batch, 0x1000, 2, 4, 2);
+
+  auto Writes = Batch.GetWrites();
+  ASSERT_EQ(Writes.size(), 1u);
+  EXPECT_FALSE(Writes[0].IsFill());
+  EXPECT_EQ(Writes[0].ShadowPtr, 0x1000u);
+  EXPECT_EQ(Writes[0].Size, 8u);
+  EXPECT_EQ(Writes[0].Bytes, (std::vector<int8_t>{kRedzone, kRedzone, kZero,
+                                                  kZero, kZero, 3, kRedzone,
+                                                  kRedzone}));
+}
+
+TEST(ShadowPoisonBatch, LaterRangesOverride) {
+  ShadowPoisonBatch Batch;
+  Batch.Poison(0x1000, 0x1008, kRedzone);
+  Batch.Poison(0x1002, 0x1004, kZero);
+  Batch.Poison(0x1003, 0x1006, kReleased);
+  Batch.Poison(0x1000, 0x1001, kZero);
+
+  auto Writes = Batch.GetWrites();
+  ASSERT_EQ(Writes.size(), 1u);
+  EXPECT_EQ(Writes[0].Bytes,
+            (std::vector<int8_t>{kZero, kRedzone, kZero, kReleased, kReleased,
+                                 kReleased, kRedzone, kRedzone}));
+
+  // A range covering all the others wins over them
+  Batch.Poison(0x0fff, 0x1009, kReleased);
+  Writes = Batch.GetWrites();
+  ASSERT_EQ(Writes.size(), 1u);
+  EXPECT_TRUE(Writes[0].IsFill());
+  EXPECT_EQ(Writes[0].ShadowPtr, 0x0fffu);
+  EXPECT_EQ(Writes[0].Size, 10u);
+  EXPECT_EQ(Writes[0].Value, kReleased);
+}
+
+TEST(ShadowPoisonBatch, AdjacentAllocationsShareWrites) {
+  constexpr size_t NumAllocations = 64;
+
+  ShadowPoisonBatch Batch;
+  for (size_t I = 0; I < NumAllocations; I++) {
+    PoisonAllocation(Batch, 0x1000 + I * 8, 2, 4, 2);
+  }
+
+  auto Writes = Batch.GetWrites();
+  ASSERT_EQ(Writes.size(), 1u);
+  EXPECT_EQ(Writes[0].Size, NumAllocations * 8);
+}
+
+TEST(ShadowPoisonBatch, DisjointAllocationsAreSeparate) {
+  ShadowPoisonBatch Batch;
+  PoisonAllocation(Batch, 0x3000, 2, 4, 2);
+  PoisonAllocation(Batch, 0x1000, 2, 4, 2);
+  Batch.Poison(0x2000, 0x2010, kReleased);
+
+  auto Writes = Batch.GetWrites();
+  ASSERT_EQ(Writes.size(), 3u);
+  EXPECT_EQ(Writes[0].ShadowPtr, 0x1000u);
+  EXPECT_FALSE(Writes[0].IsFill());
+  EXPECT_EQ(Writes[1].ShadowPtr, 0x2000u);
+  EXPECT_TRUE(Writes[1].IsFill());
+  EXPECT_EQ(Writes[2].ShadowPtr, 0x3000u);
+  EXPECT_FALSE(Writes[2].IsFill());
+}
+
+TEST(ShadowPoisonBatch, LongSpansAreFills) {
+  constexpr uptr Long = ShadowPoisonBatch::MinFillSize;
+
+  ShadowPoisonBatch Batch;
+  Batch.Poison(0x1000, 0x1002, kRedzone);
+  Batch.Poison(0x1002, 0x1002 + Long, kZero);
+  Batch.Poison(0x1002 + Long, 0x1003 + Long, 3);
+  Batch.Poison(0x1003 + Long, 0x1005 + Long, kRedzone);
+
+  auto Writes = Batch.GetWrites();
+  ASSERT_EQ(Writes.size(), 3u);
+  EXPECT_TRUE(Writes[0].IsFill());
+  EXPECT_EQ(Writes[0].Size, 2u);
+  EXPECT_EQ(Writes[0].Value, kRedzone);
+  EXPECT_TRUE(Writes[1].IsFill());
+  EXPECT_EQ(Writes[1].ShadowPtr, 0x1002u);
+  EXPECT_EQ(Writes[1].Size, Long);
+  EXPECT_EQ(Writes[1].Value, kZero);
+  EXPECT_FALSE(Writes[2].IsFill());
+  EXPECT_EQ(Writes[2].ShadowPtr, 0x1002 + Long);
+  EXPECT_EQ(Writes[2].Bytes, Repeat({3}, kRedzone, 2));
+}
+
+TEST(ShadowPoisonBatch, EqualNeighboursMerge) {
+  ShadowPoisonBatch Batch;
+  Batch.Poison(0x1000, 0x1004, kReleased);
+  Batch.Poison(0x1004, 0x1008, kReleased);
+  Batch.Poison(0x1008, 0x100c, kZero);
+
+  auto Writes = Batch.GetWrites();
+  ASSERT_EQ(Writes.size(), 1u);
+  EXPECT_EQ(Writes[0].Bytes, Repeat(Repeat({}, kReleased, 8), kZero, 4));
+}
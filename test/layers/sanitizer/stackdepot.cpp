@@ -0,0 +1,101 @@
+/*
+ *
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file stackdepot.cpp
+ *
+ */
+
+// RUN: stackdepot-test
+// REQUIRES: sanitizer
+
+#include "sanitizer_stackdepot.hpp"
+
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace ur_sanitizer_layer;
+
+namespace {
+
+StackTrace MakeStack(uptr Seed, size_t Size) {
+  StackTrace Stack;
+  for (size_t I = 0; I < Size; I++) {
+    Stack.stack.push_back((BacktraceFrame)(Seed * 0x1000 + I * 0x10));
+  }
+  return Stack;
+}
+
+} // namespace
+
+TEST(StackDepot, PutAndGet) {
+  auto Stack = MakeStack(1, 8);
+  uint32_t Id = StackDepotPut(Stack);
+  EXPECT_NE(Id, 0u);
+  EXPECT_EQ(StackDepotGet(Id).stack, Stack.stack);
+}
+
+TEST(StackDepot, SameStackSameId) {
+  auto Stack = MakeStack(2, 8);
+  uint32_t Id = StackDepotPut(Stack);
+  EXPECT_EQ(StackDepotPut(MakeStack(2, 8)), Id);
+  EXPECT_EQ(StackDepotPut(Stack.stack.data(), Stack.stack.size()), Id);
+}
+
+TEST(StackDepot, DifferentStacksDifferentIds) {
+  uint32_t Id = StackDepotPut(MakeStack(3, 8));
+  // A prefix, a longer stack and a different frame are all different stacks
+  EXPECT_NE(StackDepotPut(MakeStack(3, 7)), Id);
+  EXPECT_NE(StackDepotPut(MakeStack(3, 9)), Id);
+  EXPECT_NE(StackDepotPut(MakeStack(4, 8)), Id);
+  EXPECT_EQ(StackDepotGet(Id).stack, MakeStack(3, 8).stack);
+}
+
+TEST(StackDepot, EmptyStack) {
+  uint32_t Id = StackDepotPut(StackTrace());
+  EXPECT_NE(Id, 0u);
+  EXPECT_EQ(StackDepotPut(StackTrace()), Id);
+  EXPECT_TRUE(StackDepotGet(Id).stack.empty());
+}
+
+TEST(StackDepot, UnknownId) {
+  EXPECT_TRUE(StackDepotGet(0).stack.empty());
+  EXPECT_TRUE(StackDepotGet(0xffffffff).stack.empty());
+}
+
+TEST(StackDepot, CurrentBacktrace) {
+  uint32_t Id = GetCurrentBacktraceId();
+  EXPECT_NE(Id, 0u);
+  EXPECT_FALSE(StackDepotGet(Id).stack.empty());
+}
+
+TEST(StackDepot, Concurrent) {
+  constexpr size_t NumThreads = 8;
+  constexpr size_t NumStacks = 1000;
+
+  // Every thread saves the same stacks, which must get the same ids
+  std::vector<std::vector<uint32_t>> Ids(NumThreads);
+  std::vector<std::thread> Threads;
+  for (size_t T = 0; T < NumThreads; T++) {
+    Threads.emplace_back([&Ids, T] {
+      for (size_t I = 0; I < NumStacks; I++) {
+        Ids[T].push_back(StackDepotPut(MakeStack(0x100 + I, 1 + I % 16)));
+      }
+    });
+  }
+  for (auto &Thread : Threads) {
+    Thread.join();
+  }
+
+  for (size_t T = 1; T < NumThreads; T++) {
+    EXPECT_EQ(Ids[T], Ids[0]);
+  }
+  for (size_t I = 0; I < NumStacks; I++) {
+    EXPECT_EQ(StackDepotGet(Ids[0][I]).stack,
+              MakeStack(0x100 + I, 1 + I % 16).stack);
+  }
+}
@@ -0,0 +1,85 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Prints how long creating and releasing a handle of the mock adapter takes,
+// without layers and with leak checking, from one and from several threads.
+// Takes the number of handles each thread creates as an optional argument.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include <unified-runtime/ur_api.h>
+
+#define CHECK(call)                                                            \
+  if ((call) != UR_RESULT_SUCCESS) {                                           \
+    std::fprintf(stderr, "%s failed\n", #call);                                \
+    std::exit(1);                                                              \
+  }
+
+static double nsPerHandle(const char *layer, size_t count, size_t threads) {
+  ur_loader_config_handle_t config;
+  CHECK(urLoaderConfigCreate(&config));
+  CHECK(urLoaderConfigSetMockingEnabled(config, true));
+  if (layer) {
+    CHECK(urLoaderConfigEnableLayer(config, layer));
+  }
+  CHECK(urLoaderInit(0, config));
+
+  ur_adapter_handle_t adapter;
+  CHECK(urAdapterGet(1, &adapter, nullptr));
+  ur_platform_handle_t platform;
+  CHECK(urPlatformGet(adapter, 1, &platform, nullptr));
+  ur_device_handle_t device;
+  CHECK(urDeviceGet(platform, UR_DEVICE_TYPE_ALL, 1, &device, nullptr));
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; t++) {
+    workers.emplace_back([&] {
+      for (size_t i = 0; i < count; i++) {
+        ur_context_handle_t context;
+        CHECK(urContextCreate(1, &device, nullptr, &context));
+        CHECK(urContextRetain(context));
+        CHECK(urContextRelease(context));
+        CHECK(urContextRelease(context));
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  CHECK(urAdapterRelease(adapter));
+  CHECK(urLoaderConfigRelease(config));
+  CHECK(urLoaderTearDown());
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         (count * threads);
+}
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  if (count == 0) {
+    std::fprintf(stderr, "usage: %s [handle count]\n", argv[0]);
+    return 1;
+  }
+  const size_t threads = std::max(2u, std::thread::hardware_concurrency());
+
+  std::printf("no layers, 1 thread: %.1f ns/handle\n",
+              nsPerHandle(nullptr, count, 1));
+  std::printf("leak checking, 1 thread: %.1f ns/handle\n",
+              nsPerHandle("UR_LAYER_LEAK_CHECKING", count, 1));
+  std::printf("no layers, %zu threads: %.1f ns/handle\n", threads,
+              nsPerHandle(nullptr, count, threads));
+  std::printf("leak checking, %zu threads: %.1f ns/handle\n", threads,
+              nsPerHandle("UR_LAYER_LEAK_CHECKING", count, threads));
+
+  return 0;
+}
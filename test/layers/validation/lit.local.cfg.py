@@ -7,6 +7,7 @@ SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 """
 
 config.suffixes = [".cpp"]
+config.excludes.add("leaks_benchmark.cpp")
 
 config.substitutions.append(
     (
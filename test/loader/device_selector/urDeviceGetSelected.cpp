@@ -0,0 +1,171 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cstdlib>
+#include <vector>
+
+#include "unified-runtime/ur_api.h"
+#include <gtest/gtest.h>
+#include <ur_mock_helpers.hpp>
+
+#ifndef ASSERT_SUCCESS
+#define ASSERT_SUCCESS(ACTUAL) ASSERT_EQ(UR_RESULT_SUCCESS, ACTUAL)
+#endif
+
+static void setEnv(const char *name, const char *value) {
+#ifdef _WIN32
+  _putenv_s(name, value ? value : "");
+#else
+  if (value) {
+    setenv(name, value, 1);
+  } else {
+    unsetenv(name);
+  }
+#endif
+}
+
+// The mock platform is an OpenCL platform with two root devices, each of
+// which is partitioned into two new sub-devices every time. The calls listing
+// and partitioning the devices are counted.
+struct DeviceSelectorTest : ::testing::Test {
+  void SetUp() override {
+    for (auto &device : rootDevices) {
+      device = mock::createDummyHandle<ur_device_handle_t>();
+    }
+    deviceGetCount = 0;
+    devicePartitionCount = 0;
+    mock::getCallbacks().set_replace_callback("urPlatformGetInfo",
+                                              &replaceUrPlatformGetInfo);
+    mock::getCallbacks().set_replace_callback("urDeviceGet",
+                                              &replaceUrDeviceGet);
+    mock::getCallbacks().set_replace_callback("urDevicePartition",
+                                              &replaceUrDevicePartition);
+
+    ASSERT_SUCCESS(urLoaderInit(0, nullptr));
+    ASSERT_SUCCESS(urAdapterGet(1, &adapter, nullptr));
+    ASSERT_SUCCESS(urPlatformGet(adapter, 1, &platform, nullptr));
+  }
+
+  void TearDown() override {
+    setEnv("ONEAPI_DEVICE_SELECTOR", nullptr);
+    urAdapterRelease(adapter);
+    urLoaderTearDown();
+    mock::getCallbacks().set_replace_callback("urPlatformGetInfo", nullptr);
+    mock::getCallbacks().set_replace_callback("urDeviceGet", nullptr);
+    mock::getCallbacks().set_replace_callback("urDevicePartition", nullptr);
+    for (auto device : subDevices) {
+      mock::releaseDummyHandle(device);
+    }
+    subDevices.clear();
+    for (auto device : rootDevices) {
+      mock::releaseDummyHandle(device);
+    }
+  }
+
+  static ur_result_t replaceUrPlatformGetInfo(void *pParams) {
+    auto &params = *static_cast<ur_platform_get_info_params_t *>(pParams);
+    if (*params.ppropName == UR_PLATFORM_INFO_BACKEND && *params.ppPropValue) {
+      *static_cast<ur_backend_t *>(*params.ppPropValue) = UR_BACKEND_OPENCL;
+    }
+    return UR_RESULT_SUCCESS;
+  }
+
+  static ur_result_t replaceUrDeviceGet(void *pParams) {
+    auto &params = *static_cast<ur_device_get_params_t *>(pParams);
+    deviceGetCount++;
+    for (uint32_t i = 0; i < *params.pNumEntries && i < 2; i++) {
+      (*params.pphDevices)[i] = rootDevices[i];
+    }
+    if (*params.ppNumDevices) {
+      **params.ppNumDevices = 2;
+    }
+    return UR_RESULT_SUCCESS;
+  }
+
+  static ur_result_t replaceUrDevicePartition(void *pParams) {
+    auto &params = *static_cast<ur_device_partition_params_t *>(pParams);
+    devicePartitionCount++;
+    for (uint32_t i = 0; i < *params.pNumDevices && i < 2; i++) {
+      auto device = mock::createDummyHandle<ur_device_handle_t>();
+      subDevices.push_back(device);
+      (*params.pphSubDevices)[i] = device;
+    }
+    if (*params.ppNumDevicesRet) {
+      **params.ppNumDevicesRet = 2;
+    }
+    return UR_RESULT_SUCCESS;
+  }
+
+  // Selects the devices like an application would.
+  static std::vector<ur_device_handle_t>
+  getSelected(ur_platform_handle_t platform) {
+    uint32_t count = 0;
+    EXPECT_EQ(urDeviceGetSelected(platform, UR_DEVICE_TYPE_ALL, 0, nullptr,
+                                  &count),
+              UR_RESULT_SUCCESS);
+    std::vector<ur_device_handle_t> devices(count);
+    if (count > 0) {
+      EXPECT_EQ(urDeviceGetSelected(platform, UR_DEVICE_TYPE_ALL, count,
+                                    devices.data(), nullptr),
+                UR_RESULT_SUCCESS);
+    }
+    return devices;
+  }
+
+  static inline ur_device_handle_t rootDevices[2];
+  static inline std::vector<ur_device_handle_t> subDevices;
+  static inline uint32_t deviceGetCount;
+  static inline uint32_t devicePartitionCount;
+
+  ur_adapter_handle_t adapter = nullptr;
+  ur_platform_handle_t platform = nullptr;
+};
+
+TEST_F(DeviceSelectorTest, RootSelectionIsRemembered) {
+  setEnv("ONEAPI_DEVICE_SELECTOR", "opencl:1");
+  auto devices = getSelected(platform);
+  ASSERT_EQ(devices, std::vector<ur_device_handle_t>{rootDevices[1]});
+  auto count = deviceGetCount;
+  ASSERT_GT(count, 0);
+
+  ASSERT_EQ(getSelected(platform), devices);
+  ASSERT_EQ(getSelected(platform), devices);
+  ASSERT_EQ(deviceGetCount, count);
+  ASSERT_EQ(devicePartitionCount, 0);
+}
+
+TEST_F(DeviceSelectorTest, SubDeviceSelectionIsNotRemembered) {
+  setEnv("ONEAPI_DEVICE_SELECTOR", "opencl:0.*");
+  auto devices = getSelected(platform);
+  ASSERT_EQ(devices.size(), 2);
+  auto count = deviceGetCount;
+  auto partitionCount = devicePartitionCount;
+  ASSERT_GT(partitionCount, 0);
+
+  // Partitioning again gives new sub-devices.
+  auto newDevices = getSelected(platform);
+  ASSERT_EQ(newDevices.size(), 2);
+  ASSERT_NE(newDevices, devices);
+  ASSERT_GT(deviceGetCount, count);
+  ASSERT_GT(devicePartitionCount, partitionCount);
+}
+
+TEST_F(DeviceSelectorTest, SelectorChangeIsPickedUp) {
+  setEnv("ONEAPI_DEVICE_SELECTOR", "opencl:0");
+  ASSERT_EQ(getSelected(platform),
+            std::vector<ur_device_handle_t>{rootDevices[0]});
+  auto count = deviceGetCount;
+
+  setEnv("ONEAPI_DEVICE_SELECTOR", "opencl:1");
+  ASSERT_EQ(getSelected(platform),
+            std::vector<ur_device_handle_t>{rootDevices[1]});
+  ASSERT_GT(deviceGetCount, count);
+
+  setEnv("ONEAPI_DEVICE_SELECTOR", "level_zero:*");
+  ASSERT_TRUE(getSelected(platform).empty());
+
+  setEnv("ONEAPI_DEVICE_SELECTOR", nullptr);
+  ASSERT_EQ(getSelected(platform).size(), 2);
+}
@@ -0,0 +1,134 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: discovery_cache-test
+
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <unified-runtime/ur_api.h>
+
+#include "ur_filesystem_resolved.hpp"
+
+namespace fs = filesystem;
+
+static void setEnv(const char *name, const char *value) {
+#ifdef _WIN32
+  _putenv_s(name, value ? value : "");
+#else
+  if (value) {
+    setenv(name, value, 1);
+  } else {
+    unsetenv(name);
+  }
+#endif
+}
+
+// Loads the mock adapter, which has a platform, and a fake adapter, which has
+// none.
+struct discoveryCacheTest : ::testing::Test {
+  void SetUp() override {
+    fs::remove(cachePath);
+    setEnv("UR_ADAPTERS_FORCE_LOAD", MOCK_ADAPTER_PATH "," FAKE_ADAPTER_PATH);
+    setEnv("UR_LOADER_DISCOVERY_CACHE", cachePath.string().c_str());
+    setEnv("CUDA_VISIBLE_DEVICES", nullptr);
+  }
+
+  void TearDown() override {
+    setEnv("UR_LOADER_DISCOVERY_CACHE", nullptr);
+    setEnv("UR_ADAPTERS_FORCE_LOAD", nullptr);
+    fs::remove(cachePath);
+  }
+
+  // Starts up like an application and returns the number of adapters.
+  static uint32_t startUp(bool queryPlatforms = true) {
+    EXPECT_EQ(urLoaderInit(0, nullptr), UR_RESULT_SUCCESS);
+
+    uint32_t adapterCount = 0;
+    EXPECT_EQ(urAdapterGet(0, nullptr, &adapterCount), UR_RESULT_SUCCESS);
+    std::vector<ur_adapter_handle_t> adapters(adapterCount);
+    EXPECT_EQ(urAdapterGet(adapterCount, adapters.data(), nullptr),
+              UR_RESULT_SUCCESS);
+    for (auto adapter : adapters) {
+      uint32_t platformCount = 0;
+      if (queryPlatforms) {
+        EXPECT_EQ(urPlatformGet(adapter, 0, nullptr, &platformCount),
+                  UR_RESULT_SUCCESS);
+      }
+    }
+    // The mock adapter can't be released through the loader when there are
+    // several adapters, so the result isn't checked.
+    for (auto adapter : adapters) {
+      urAdapterRelease(adapter);
+    }
+
+    EXPECT_EQ(urLoaderTearDown(), UR_RESULT_SUCCESS);
+    return adapterCount;
+  }
+
+  // Makes the file look updated, and restores its modification time when
+  // destroyed.
+  struct touch {
+    touch(fs::path path)
+        : path(std::move(path)), time(fs::last_write_time(this->path)) {
+      fs::last_write_time(this->path, time + std::chrono::hours(1));
+    }
+    ~touch() { fs::last_write_time(path, time); }
+
+    fs::path path;
+    fs::file_time_type time;
+  };
+
+  const fs::path cachePath = "discovery_cache_test.cache";
+};
+
+TEST_F(discoveryCacheTest, SkippedWhenCached) {
+  ASSERT_EQ(startUp(), 2);
+  ASSERT_TRUE(fs::exists(cachePath));
+  ASSERT_EQ(startUp(), 1);
+  ASSERT_EQ(startUp(), 1);
+}
+
+TEST_F(discoveryCacheTest, NotRecordedWithoutPlatformQuery) {
+  ASSERT_EQ(startUp(false), 2);
+  ASSERT_FALSE(fs::exists(cachePath));
+  ASSERT_EQ(startUp(), 2);
+}
+
+TEST_F(discoveryCacheTest, NotUsedWhenDisabled) {
+  ASSERT_EQ(startUp(), 2);
+  setEnv("UR_LOADER_DISCOVERY_CACHE", nullptr);
+  ASSERT_EQ(startUp(), 2);
+}
+
+TEST_F(discoveryCacheTest, InvalidatedByVisibleDevices) {
+  ASSERT_EQ(startUp(), 2);
+  setEnv("CUDA_VISIBLE_DEVICES", "0");
+  ASSERT_EQ(startUp(false), 2);
+  setEnv("CUDA_VISIBLE_DEVICES", nullptr);
+  ASSERT_EQ(startUp(), 1);
+}
+
+TEST_F(discoveryCacheTest, InvalidatedByAdapterUpdate) {
+  ASSERT_EQ(startUp(), 2);
+  {
+    touch adapter(FAKE_ADAPTER_PATH);
+    ASSERT_EQ(startUp(false), 2);
+  }
+  ASSERT_EQ(startUp(), 1);
+}
+
+#ifndef _WIN32
+TEST_F(discoveryCacheTest, InvalidatedByDriverUpdate) {
+  ASSERT_EQ(startUp(), 2);
+  {
+    touch driver(FAKE_DRIVER_PATH);
+    ASSERT_EQ(startUp(false), 2);
+  }
+  ASSERT_EQ(startUp(), 1);
+}
+#endif
@@ -0,0 +1,127 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// An adapter that takes a while to initialize and has a platform per device
+// of its driver, like an adapter whose driver is installed without any
+// device. Fails to initialize if FAKE_ADAPTER_GET_ERROR is set.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <unified-runtime/ur_api.h>
+#include <unified-runtime/ur_ddi.h>
+
+#ifdef _WIN32
+extern "C" __declspec(dllimport) uint32_t fakeDriverGetDeviceCount();
+#else
+extern "C" uint32_t fakeDriverGetDeviceCount();
+#endif
+
+static ur_dditable_t ddiTable;
+
+struct ur_adapter_handle_t_ {
+  ur_dditable_t *ddiTable = &::ddiTable;
+  std::atomic<uint32_t> refCount = 0;
+};
+
+struct ur_platform_handle_t_ {
+  ur_dditable_t *ddiTable = &::ddiTable;
+};
+
+static ur_adapter_handle_t_ adapter;
+static ur_platform_handle_t_ platform;
+// The number of times the adapter was initialized.
+static std::atomic<uint32_t> initCount = 0;
+
+static ur_result_t UR_APICALL adapterGet(uint32_t NumEntries,
+                                         ur_adapter_handle_t *phAdapters,
+                                         uint32_t *pNumAdapters) {
+  if (NumEntries > 0 && phAdapters) {
+    if (std::getenv("FAKE_ADAPTER_GET_ERROR")) {
+      return UR_RESULT_ERROR_OUT_OF_RESOURCES;
+    }
+    if (adapter.refCount++ == 0) {
+      initCount++;
+      std::this_thread::sleep_for(
+          std::chrono::milliseconds(FAKE_ADAPTER_INIT_MS));
+    }
+    *phAdapters = &adapter;
+  }
+  if (pNumAdapters) {
+    *pNumAdapters = 1;
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t UR_APICALL adapterRetain(ur_adapter_handle_t) {
+  adapter.refCount++;
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t UR_APICALL adapterRelease(ur_adapter_handle_t) {
+  adapter.refCount--;
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t UR_APICALL platformGet(ur_adapter_handle_t,
+                                          uint32_t NumEntries,
+                                          ur_platform_handle_t *phPlatforms,
+                                          uint32_t *pNumPlatforms) {
+  // All the devices are in the same platform.
+  const uint32_t platformCount = fakeDriverGetDeviceCount() > 0 ? 1 : 0;
+  if (phPlatforms && NumEntries > 0 && platformCount > 0) {
+    *phPlatforms = &platform;
+  }
+  if (pNumPlatforms) {
+    *pNumPlatforms = platformCount;
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+static ur_result_t UR_APICALL platformGetInfo(ur_platform_handle_t,
+                                              ur_platform_info_t propName,
+                                              size_t propSize, void *pPropValue,
+                                              size_t *pPropSizeRet) {
+  if (propName != UR_PLATFORM_INFO_ADAPTER) {
+    return UR_RESULT_ERROR_UNSUPPORTED_ENUMERATION;
+  }
+  ur_adapter_handle_t value = &adapter;
+  if (pPropValue) {
+    if (propSize < sizeof(value)) {
+      return UR_RESULT_ERROR_INVALID_SIZE;
+    }
+    std::memcpy(pPropValue, &value, sizeof(value));
+  }
+  if (pPropSizeRet) {
+    *pPropSizeRet = sizeof(value);
+  }
+  return UR_RESULT_SUCCESS;
+}
+
+extern "C" {
+
+UR_DLLEXPORT uint32_t fakeAdapterGetInitCount() { return initCount; }
+
+UR_DLLEXPORT ur_result_t UR_APICALL urGetAdapterProcAddrTable(
+    ur_api_version_t, ur_adapter_dditable_t *pDdiTable) {
+  pDdiTable->pfnGet = adapterGet;
+  pDdiTable->pfnRetain = adapterRetain;
+  pDdiTable->pfnRelease = adapterRelease;
+  ddiTable.Adapter = *pDdiTable;
+  return UR_RESULT_SUCCESS;
+}
+
+UR_DLLEXPORT ur_result_t UR_APICALL urGetPlatformProcAddrTable(
+    ur_api_version_t, ur_platform_dditable_t *pDdiTable) {
+  pDdiTable->pfnGet = platformGet;
+  pDdiTable->pfnGetInfo = platformGetInfo;
+  ddiTable.Platform = *pDdiTable;
+  return UR_RESULT_SUCCESS;
+}
+
+} // extern "C"
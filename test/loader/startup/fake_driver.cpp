@@ -0,0 +1,17 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// The driver the fake adapters depend on, which finds no device unless
+// FAKE_DRIVER_DEVICE_COUNT says otherwise.
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <unified-runtime/ur_api.h>
+
+extern "C" UR_DLLEXPORT uint32_t fakeDriverGetDeviceCount() {
+  const char *count = std::getenv("FAKE_DRIVER_DEVICE_COUNT");
+  return count ? static_cast<uint32_t>(std::atoi(count)) : 0;
+}
@@ -0,0 +1,156 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// RUN: lazy_adapters-test
+
+#include <cstdlib>
+
+#include <gtest/gtest.h>
+#include <unified-runtime/ur_api.h>
+
+#include "ur_lib_loader.hpp"
+
+static void setEnv(const char *name, const char *value) {
+#ifdef _WIN32
+  _putenv_s(name, value ? value : "");
+#else
+  if (value) {
+    setenv(name, value, 1);
+  } else {
+    unsetenv(name);
+  }
+#endif
+}
+
+// Loads a fake adapter with a platform, whose initializations are counted.
+struct lazyAdaptersTest : ::testing::Test {
+  void SetUp() override {
+    setEnv("UR_ADAPTERS_FORCE_LOAD", FAKE_ADAPTER_PATH);
+    setEnv("UR_LOADER_LAZY_ADAPTERS", "1");
+    setEnv("FAKE_DRIVER_DEVICE_COUNT", "1");
+
+    fakeAdapter = ur_loader::LibLoader::loadAdapterLibrary(FAKE_ADAPTER_PATH);
+    ASSERT_NE(fakeAdapter.get(), nullptr);
+    getInitCount = reinterpret_cast<uint32_t (*)()>(
+        ur_loader::LibLoader::getFunctionPtr(fakeAdapter.get(),
+                                             "fakeAdapterGetInitCount"));
+    ASSERT_NE(getInitCount, nullptr);
+  }
+
+  void TearDown() override {
+    if (initialized) {
+      ASSERT_EQ(urLoaderTearDown(), UR_RESULT_SUCCESS);
+    }
+    setEnv("UR_ADAPTERS_FORCE_LOAD", nullptr);
+    setEnv("UR_LOADER_LAZY_ADAPTERS", nullptr);
+    setEnv("FAKE_DRIVER_DEVICE_COUNT", nullptr);
+    setEnv("FAKE_ADAPTER_GET_ERROR", nullptr);
+    setEnv("UR_ENABLE_LAYERS", nullptr);
+  }
+
+  // Initializes the loader and returns the adapter.
+  ur_adapter_handle_t getAdapter() {
+    EXPECT_EQ(urLoaderInit(0, nullptr), UR_RESULT_SUCCESS);
+    initialized = true;
+    initCount = getInitCount();
+
+    uint32_t adapterCount = 0;
+    EXPECT_EQ(urAdapterGet(0, nullptr, &adapterCount), UR_RESULT_SUCCESS);
+    EXPECT_EQ(adapterCount, 1);
+    ur_adapter_handle_t adapter = nullptr;
+    EXPECT_EQ(urAdapterGet(1, &adapter, nullptr), UR_RESULT_SUCCESS);
+    return adapter;
+  }
+
+  // The number of times the fake adapter was initialized since getAdapter.
+  uint32_t getNewInitCount() { return getInitCount() - initCount; }
+
+  ur_loader::LibLoader::Lib fakeAdapter;
+  uint32_t (*getInitCount)() = nullptr;
+  uint32_t initCount = 0;
+  bool initialized = false;
+};
+
+TEST_F(lazyAdaptersTest, InitializedOnFirstUse) {
+  auto adapter = getAdapter();
+  ASSERT_NE(adapter, nullptr);
+  ASSERT_EQ(getNewInitCount(), 0);
+
+  uint32_t refCount = 0;
+  ASSERT_EQ(urAdapterGetInfo(adapter, UR_ADAPTER_INFO_REFERENCE_COUNT,
+                             sizeof(refCount), &refCount, nullptr),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(refCount, 1);
+  ASSERT_EQ(getNewInitCount(), 0);
+
+  ur_platform_handle_t platform = nullptr;
+  ASSERT_EQ(urPlatformGet(adapter, 1, &platform, nullptr), UR_RESULT_SUCCESS);
+  ASSERT_NE(platform, nullptr);
+  ASSERT_EQ(getNewInitCount(), 1);
+
+  // The platform refers to the adapter the application knows.
+  ur_adapter_handle_t platformAdapter = nullptr;
+  ASSERT_EQ(urPlatformGetInfo(platform, UR_PLATFORM_INFO_ADAPTER,
+                              sizeof(platformAdapter), &platformAdapter,
+                              nullptr),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(platformAdapter, adapter);
+
+  ASSERT_EQ(urPlatformGet(adapter, 1, &platform, nullptr), UR_RESULT_SUCCESS);
+  ASSERT_EQ(getNewInitCount(), 1);
+  ASSERT_EQ(urAdapterRelease(adapter), UR_RESULT_SUCCESS);
+}
+
+TEST_F(lazyAdaptersTest, InitializedByAdapterGetWhenDisabled) {
+  setEnv("UR_LOADER_LAZY_ADAPTERS", nullptr);
+  auto adapter = getAdapter();
+  ASSERT_NE(adapter, nullptr);
+  ASSERT_EQ(getNewInitCount(), 1);
+  ASSERT_EQ(urAdapterRelease(adapter), UR_RESULT_SUCCESS);
+}
+
+TEST_F(lazyAdaptersTest, CallsGoThroughLayers) {
+  setEnv("UR_ENABLE_LAYERS", "UR_LAYER_PARAMETER_VALIDATION");
+  auto adapter = getAdapter();
+  ASSERT_NE(adapter, nullptr);
+
+  // Rejected by the validation layer before the adapter is initialized.
+  ur_platform_handle_t platform = nullptr;
+  ASSERT_EQ(urPlatformGet(adapter, 0, &platform, nullptr),
+            UR_RESULT_ERROR_INVALID_SIZE);
+  ASSERT_EQ(urPlatformGet(nullptr, 1, &platform, nullptr),
+            UR_RESULT_ERROR_INVALID_NULL_HANDLE);
+  ASSERT_EQ(getNewInitCount(), 0);
+
+  ASSERT_EQ(urPlatformGet(adapter, 1, &platform, nullptr), UR_RESULT_SUCCESS);
+  ASSERT_EQ(getNewInitCount(), 1);
+  ASSERT_EQ(urAdapterRelease(adapter), UR_RESULT_SUCCESS);
+}
+
+TEST_F(lazyAdaptersTest, FailedInitializationReported) {
+  setEnv("FAKE_ADAPTER_GET_ERROR", "1");
+  auto adapter = getAdapter();
+  ASSERT_NE(adapter, nullptr);
+
+  // The error is reported by every call that needs the adapter.
+  uint32_t platformCount = 0;
+  ASSERT_EQ(urPlatformGet(adapter, 0, nullptr, &platformCount),
+            UR_RESULT_ERROR_OUT_OF_RESOURCES);
+  ASSERT_EQ(urPlatformGet(adapter, 0, nullptr, &platformCount),
+            UR_RESULT_ERROR_OUT_OF_RESOURCES);
+  ur_backend_t backend;
+  ASSERT_EQ(urAdapterGetInfo(adapter, UR_ADAPTER_INFO_BACKEND,
+                             sizeof(backend), &backend, nullptr),
+            UR_RESULT_ERROR_OUT_OF_RESOURCES);
+  ASSERT_EQ(getNewInitCount(), 0);
+
+  // The adapter is initialized once the error is gone.
+  setEnv("FAKE_ADAPTER_GET_ERROR", nullptr);
+  ASSERT_EQ(urPlatformGet(adapter, 0, nullptr, &platformCount),
+            UR_RESULT_SUCCESS);
+  ASSERT_EQ(platformCount, 1);
+  ASSERT_EQ(getNewInitCount(), 1);
+  ASSERT_EQ(urAdapterRelease(adapter), UR_RESULT_SUCCESS);
+}
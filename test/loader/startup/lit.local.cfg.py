@@ -0,0 +1,9 @@
+"""
+
+Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+See https://llvm.org/LICENSE.txt for license information.
+SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+"""
+
+config.suffixes = [".cpp", ".test"]
@@ -0,0 +1,96 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Prints how long it takes to start up with the mock adapter and adapters
+// without platforms that are slow to initialize, without the adapter discovery
+// cache, with an empty cache and with a filled cache. Takes the number of
+// start ups to average as an optional argument.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unified-runtime/ur_api.h>
+
+#include "ur_filesystem_resolved.hpp"
+
+#define CHECK(call)                                                            \
+  if ((call) != UR_RESULT_SUCCESS) {                                           \
+    std::fprintf(stderr, "%s failed\n", #call);                                \
+    std::exit(1);                                                              \
+  }
+
+static void setEnv(const char *name, const char *value) {
+#ifdef _WIN32
+  _putenv_s(name, value ? value : "");
+#else
+  if (value) {
+    setenv(name, value, 1);
+  } else {
+    unsetenv(name);
+  }
+#endif
+}
+
+// Starts up like an application listing the platforms of every adapter.
+static void startUp() {
+  CHECK(urLoaderInit(0, nullptr));
+
+  uint32_t adapterCount = 0;
+  CHECK(urAdapterGet(0, nullptr, &adapterCount));
+  std::vector<ur_adapter_handle_t> adapters(adapterCount);
+  CHECK(urAdapterGet(adapterCount, adapters.data(), nullptr));
+  for (auto adapter : adapters) {
+    uint32_t platformCount = 0;
+    CHECK(urPlatformGet(adapter, 0, nullptr, &platformCount));
+  }
+  // The mock adapter can't be released through the loader when there are
+  // several adapters, so the result isn't checked.
+  for (auto adapter : adapters) {
+    urAdapterRelease(adapter);
+  }
+
+  CHECK(urLoaderTearDown());
+}
+
+static double msPerStartUp(size_t count) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; i++) {
+    startUp();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         count;
+}
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10;
+  if (count == 0) {
+    std::fprintf(stderr, "usage: %s [start up count]\n", argv[0]);
+    return 1;
+  }
+
+  std::string adapters = MOCK_ADAPTER_PATH;
+  for (auto path : FAKE_ADAPTER_PATHS) {
+    adapters += ",";
+    adapters += path;
+  }
+  setEnv("UR_ADAPTERS_FORCE_LOAD", adapters.c_str());
+
+  const filesystem::path cachePath = "ur_loader_startup_benchmark.cache";
+  filesystem::remove(cachePath);
+
+  setEnv("UR_LOADER_DISCOVERY_CACHE", nullptr);
+  std::printf("no cache: %.1f ms/start up\n", msPerStartUp(count));
+
+  setEnv("UR_LOADER_DISCOVERY_CACHE", cachePath.string().c_str());
+  std::printf("empty cache: %.1f ms/start up\n", msPerStartUp(1));
+  std::printf("filled cache: %.1f ms/start up\n", msPerStartUp(count));
+
+  filesystem::remove(cachePath);
+  return 0;
+}
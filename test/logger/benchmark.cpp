@@ -0,0 +1,62 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+// Prints how long logging a message takes, when its level is enabled and when
+// it is filtered out. Takes the number of messages to log as an optional
+// argument.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "logger/ur_logger.hpp"
+
+template <typename F> static double nsPerMessage(size_t count, F &&log) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; i++) {
+    log(i);
+    // Keeps the compiler from hoisting the level checks out of the loop.
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         count;
+}
+
+int main(int argc, char **argv) {
+  const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  if (count == 0) {
+    std::fprintf(stderr, "usage: %s [message count]\n", argv[0]);
+    return 1;
+  }
+
+  const filesystem::path file_path = "ur_logger_benchmark.log";
+  {
+    auto logger = logger::Logger(
+        UR_LOGGER_LEVEL_INFO,
+        std::make_unique<logger::FileSink>("benchmark", file_path));
+
+    std::printf("enabled:  %.1f ns/message\n",
+                nsPerMessage(count, [&](size_t i) {
+                  UR_LOG_L(logger, INFO, "Message {} of {}: {}", i, count,
+                           "success");
+                }));
+    std::printf("enabled, runtime format: %.1f ns/message\n",
+                nsPerMessage(count, [&](size_t i) {
+                  logger.log(UR_LOGGER_LEVEL_INFO, __FILE__,
+                             UR_STR_(__LINE__), "Message {} of {}: {}", i,
+                             count, "success");
+                }));
+    std::printf("disabled: %.1f ns/message\n",
+                nsPerMessage(count, [&](size_t i) {
+                  UR_LOG_L(logger, DEBUG, "Message {} of {}: {}", i, count,
+                           "success");
+                }));
+  }
+  filesystem::remove(file_path);
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM
+// Exceptions. See https://llvm.org/LICENSE.txt for license information.
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+
+#define LATENCY_LOG_PATH "latency-test.log"
+
+// The tracker reads its options when it's initialized, which is after this
+// definition as it comes first in the file.
+static inline const bool latencyOptionsSet = []() {
+  setenv("UR_LOG_LATENCY",
+         "level:info;flush:info;output:file," LATENCY_LOG_PATH, 1);
+  setenv("UR_LATENCY_HISTOGRAM_OPTIONS",
+         ("dump_signal:" + std::to_string(SIGUSR2)).c_str(), 1);
+  return true;
+}();
+
+#include <gtest/gtest.h>
+
+#include "latency_tracker.hpp"
+
+static std::string readLog() {
+  std::ifstream file(LATENCY_LOG_PATH);
+  std::stringstream log;
+  log << file.rdbuf();
+  return log.str();
+}
+
+static std::atomic<int> testSignalCount{0};
+static void testSignalHandler(int) { testSignalCount++; }
+
+TEST(LatencyTracker, DumpedOnSignal) {
+  ASSERT_TRUE(trackLatency);
+  latency_printer printer;
+  latency_histogram histogram("dumped_scope", printer);
+  for (int i = 0; i < 10; i++) {
+    latency_tracker tracker(histogram);
+  }
+  ASSERT_EQ(readLog().find("dumped_scope,"), std::string::npos);
+
+  // The histograms are printed by the next tracked scope that ends.
+  std::raise(SIGUSR2);
+  ASSERT_EQ(readLog().find("dumped_scope,"), std::string::npos);
+  { latency_tracker tracker(histogram); }
+  auto log = readLog();
+  ASSERT_NE(log.find("Latency histogram:"), std::string::npos);
+  ASSERT_NE(log.find("dumped_scope,"), std::string::npos);
+  ASSERT_NE(log.find(",11,"), std::string::npos);
+
+  // Only once per signal.
+  { latency_tracker tracker(histogram); }
+  ASSERT_EQ(readLog(), log);
+}
+
+TEST(LatencyTracker, SignalHandlerChainedAndRestored) {
+  auto originalHandler = std::signal(SIGUSR2, testSignalHandler);
+  testSignalCount = 0;
+  {
+    latency_printer printer;
+    std::raise(SIGUSR2);
+    ASSERT_EQ(testSignalCount, 1);
+    ASSERT_TRUE(latencyDumpRequested.exchange(false));
+  }
+  ASSERT_EQ(std::signal(SIGUSR2, originalHandler), testSignalHandler);
+
+  // The next printer installs the handler again.
+  {
+    latency_printer printer;
+    std::raise(SIGUSR2);
+    ASSERT_EQ(testSignalCount, 1);
+    ASSERT_TRUE(latencyDumpRequested.exchange(false));
+  }
+  ASSERT_EQ(std::signal(SIGUSR2, SIG_DFL), originalHandler);
+}
+
+#endif // _WIN32
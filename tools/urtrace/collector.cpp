@@ -12,8 +12,11 @@
  * function execution time.
  */
 
+#include <atomic>
+#include <bitset>
 #include <cassert>
 #include <chrono>
+#include <cstring>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -27,9 +30,12 @@
 #include <vector>
 
 #include "logger/ur_logger.hpp"
+#include "ring_file.hpp"
+#include "trace_file.hpp"
 #include "unified-runtime/ur_api.h"
 #include "unified-runtime/ur_print.hpp"
 #include "ur_util.hpp"
+#include "urtrace_params.hpp"
 #include "xpti/xpti_trace_framework.h"
 
 constexpr uint16_t TRACE_FN_BEGIN =
@@ -42,64 +48,18 @@ static logger::Logger out = logger::create_logger("collector", true);
 
 constexpr const char *ARGS_ENV = "UR_COLLECTOR_ARGS";
 
-enum time_unit {
-  TIME_UNIT_AUTO,
-  TIME_UNIT_NS,
-  TIME_UNIT_US,
-  TIME_UNIT_MS,
-  TIME_UNIT_S,
-  MAX_TIME_UNIT,
-};
-
-const char *time_unit_str[MAX_TIME_UNIT] = {"auto", "ns", "us", "ms", "s"};
-
-std::string time_to_str(std::chrono::nanoseconds dur, enum time_unit unit) {
-  std::ostringstream ostr;
-
-  switch (unit) {
-  case TIME_UNIT_AUTO: {
-    if (dur.count() < 1000) {
-      return time_to_str(dur, TIME_UNIT_NS);
-    }
-    if (dur.count() < 1000 * 1000) {
-      return time_to_str(dur, TIME_UNIT_US);
-    }
-    if (dur.count() < 1000 * 1000 * 1000) {
-      return time_to_str(dur, TIME_UNIT_MS);
-    }
-    return time_to_str(dur, TIME_UNIT_S);
-  } break;
-  case TIME_UNIT_NS: {
-    ostr << dur.count() << "ns";
-  } break;
-  case TIME_UNIT_US: {
-    std::chrono::duration<double, std::micro> d = dur;
-    ostr << d.count() << "us";
-  } break;
-  case TIME_UNIT_MS: {
-    std::chrono::duration<double, std::milli> d = dur;
-    ostr << d.count() << "ms";
-  } break;
-  case TIME_UNIT_S: {
-    std::chrono::duration<double, std::ratio<1>> d = dur;
-    ostr << d.count() << "s";
-  } break;
-  default: {
-    UR_LOG_L(out, ERR, "invalid time unit {}", unit);
-    break;
-  }
-  }
-
-  return ostr.str();
-}
-
 enum output_format {
   OUTPUT_HUMAN_READABLE,
   OUTPUT_JSON,
+  OUTPUT_BINARY,
   MAX_OUTPUT_FORMAT,
 };
 
-const char *output_format_str[MAX_OUTPUT_FORMAT] = {"human readable", "json"};
+const char *output_format_str[MAX_OUTPUT_FORMAT] = {"human readable", "json",
+                                                    "binary"};
+
+// The number of records of a ring file, unless set by "ring_size".
+constexpr uint64_t DEFAULT_RING_SIZE = 64 * 1024;
 
 /*
  * Since this is a library that gets loaded alongside the traced program, it
@@ -113,6 +73,8 @@ const char *output_format_str[MAX_OUTPUT_FORMAT] = {"human readable", "json"};
  * - "time_unit:<auto,ns, ...>"
  * - "filter:<regex>"
  * - "json"
+ * - "binary:<directory>"
+ * - "ring_size:<records>"
  */
 static class cli_args {
   std::optional<std::string>
@@ -128,15 +90,27 @@ static class cli_args {
     return arg_values.at(0);
   }
 
+  // Matches the regex against the name of every function once, so that the
+  // callbacks only have to look up the function id.
+  void set_filter(const std::regex &regex) {
+    filter.emplace();
+    for (size_t id = 0; id < urtrace::FUNCTION_ID_LIMIT; ++id) {
+      auto name = urtrace::getFunctionName(static_cast<ur_function_t>(id));
+      filter->set(id, name != nullptr && std::regex_match(name, regex));
+    }
+  }
+
 public:
   cli_args() {
     print_begin = false;
     profiling = false;
-    time_unit = TIME_UNIT_AUTO;
+    time_unit = urtrace::TIME_UNIT_AUTO;
     no_args = false;
     filter = std::nullopt;
     filter_str = std::nullopt;
     output_format = OUTPUT_HUMAN_READABLE;
+    binary_dir = std::nullopt;
+    ring_size = DEFAULT_RING_SIZE;
     if (auto args = getenv_to_map(ARGS_ENV, false)) {
       for (auto [arg_name, arg_values] : *args) {
         if (arg_name == "print_begin") {
@@ -149,65 +123,102 @@ public:
           no_args = true;
         } else if (auto unit =
                        arg_with_value("time_unit", arg_name, arg_values)) {
-          for (int i = 0; i < MAX_TIME_UNIT; ++i) {
-            if (time_unit_str[i] == unit) {
-              time_unit = (enum time_unit)i;
+          for (int i = 0; i < urtrace::MAX_TIME_UNIT; ++i) {
+            if (urtrace::time_unit_str[i] == unit) {
+              time_unit = (enum urtrace::time_unit)i;
               break;
             }
           }
-        } else if (auto filter_str =
-                       arg_with_value("filter", arg_name, arg_values)) {
+        } else if (auto str = arg_with_value("filter", arg_name, arg_values)) {
           try {
-            filter = filter_str;
+            set_filter(std::regex(*str));
+            filter_str = str;
           } catch (const std::regex_error &err) {
-            UR_LOG_L(out, WARN, "invalid filter regex {} {}", *filter_str,
+            UR_LOG_L(out, WARN, "invalid filter regex {} {}", *str,
                      err.what());
           }
+        } else if (auto dir = arg_with_value("binary", arg_name, arg_values)) {
+          binary_dir = dir;
+        } else if (auto size =
+                       arg_with_value("ring_size", arg_name, arg_values)) {
+          try {
+            ring_size = std::stoull(*size);
+            if (ring_size == 0) {
+              throw std::invalid_argument("ring size is 0");
+            }
+          } catch (const std::exception &err) {
+            UR_LOG_L(out, WARN, "invalid ring size {} {}", *size, err.what());
+            ring_size = DEFAULT_RING_SIZE;
+          }
         } else {
           UR_LOG_L(out, WARN, "unknown {} argument {}.", ARGS_ENV, arg_name);
         }
       }
     }
+    if (binary_dir) {
+      output_format = OUTPUT_BINARY;
+    }
     UR_LOG_L(out, DEBUG,
              "collector args (.print_begin = {}, .profiling = {}, "
              ".time_unit = {}, .filter = {}, .output_format = {})",
-             print_begin, profiling, time_unit_str[time_unit],
+             print_begin, profiling, urtrace::time_unit_str[time_unit],
              filter_str.has_value() ? *filter_str : "none",
              output_format_str[output_format]);
   }
 
-  enum time_unit time_unit;
+  bool traced(uint32_t function_id) const {
+    if (!filter) {
+      return true;
+    }
+    return function_id < filter->size() && filter->test(function_id);
+  }
+
+  enum urtrace::time_unit time_unit;
   bool print_begin;
   bool profiling;
   bool no_args;
   enum output_format output_format;
   std::optional<std::string>
       filter_str; // the filter_str is kept primarily for printing.
-  std::optional<std::regex> filter;
+  std::optional<std::bitset<urtrace::FUNCTION_ID_LIMIT>> filter;
+  std::optional<std::string> binary_dir;
+  uint64_t ring_size;
 } cli_args;
 
 typedef std::chrono::steady_clock Clock;
 typedef std::chrono::time_point<Clock> Timepoint;
 
+// Formats the arguments of a call. Writers only do it for the calls they
+// print, since it is by far the most expensive part of tracing a call.
+static std::string args_to_str(const xpti::function_with_args_t *args) {
+  if (cli_args.no_args) {
+    return "...";
+  }
+  std::ostringstream args_str;
+  ur::extras::printFunctionParams(
+      args_str, (enum ur_function_t)args->function_id, args->args_data);
+  return args_str.str();
+}
+
 class TraceWriter {
 public:
   virtual ~TraceWriter() {}
   virtual void prologue() {}
   virtual void epilogue() {}
-  virtual void begin(uint64_t id, const char *fname, std::string args) = 0;
-  virtual void end(uint64_t id, const char *fname, std::string args,
-                   Timepoint tp, Timepoint start_tp,
-                   const ur_result_t *resultp) = 0;
+  virtual void begin(uint64_t id, const xpti::function_with_args_t *args) = 0;
+  virtual void end(uint64_t id, const xpti::function_with_args_t *args,
+                   Timepoint tp, Timepoint start_tp) = 0;
 };
 
 class HumanReadable : public TraceWriter {
-  void begin(uint64_t id, const char *fname, std::string args) override {
+  void begin(uint64_t id, const xpti::function_with_args_t *args) override {
     if (cli_args.print_begin) {
-      UR_LOG_L(out, INFO, "begin({}) - {}({});", id, fname, args);
+      UR_LOG_L(out, INFO, "begin({}) - {}({});", id, args->function_name,
+               args_to_str(args));
     }
   }
-  void end(uint64_t id, const char *fname, std::string args, Timepoint tp,
-           Timepoint start_tp, const ur_result_t *resultp) override {
+  void end(uint64_t id, const xpti::function_with_args_t *args, Timepoint tp,
+           Timepoint start_tp) override {
     std::ostringstream prefix_str;
     if (cli_args.print_begin) {
       prefix_str << "end(" << id << ") - ";
@@ -217,10 +228,13 @@ class HumanReadable : public TraceWriter {
     if (cli_args.profiling) {
       auto dur =
           std::chrono::duration_cast<std::chrono::nanoseconds>(tp - start_tp);
-      profile_str << " (" << time_to_str(dur, cli_args.time_unit) << ")";
+      profile_str << " (" << urtrace::time_to_str(dur, cli_args.time_unit)
+                  << ")";
     }
-    UR_LOG_L(out, INFO, "{}{}({}) -> {};{}", prefix_str.str(), fname, args,
-             *resultp, profile_str.str());
+    auto resultp = static_cast<const ur_result_t *>(args->ret_data);
+    UR_LOG_L(out, INFO, "{}{}({}) -> {};{}", prefix_str.str(),
+             args->function_name, args_to_str(args), *resultp,
+             profile_str.str());
   }
 };
 
@@ -246,10 +260,10 @@ public:
              "\"tid\": \"\", \"ts\": \"\"}}");
     UR_LOG_L(out, INFO, "]\n}}");
   }
-  void begin(uint64_t, const char *, std::string) override {}
+  void begin(uint64_t, const xpti::function_with_args_t *) override {}
 
-  void end(uint64_t, const char *fname, std::string args, Timepoint tp,
-           Timepoint start_tp, const ur_result_t *) override {
+  void end(uint64_t, const xpti::function_with_args_t *args, Timepoint tp,
+           Timepoint start_tp) override {
     auto dur = tp - start_tp;
     auto ts_us = std::chrono::duration_cast<std::chrono::microseconds>(
                      tp.time_since_epoch())
@@ -266,8 +280,90 @@ public:
             \"name\": \"{}\",\
             \"args\": \"({})\"\
         }},",
-             ur_getpid(), std::this_thread::get_id(), ts_us, dur_us, fname,
-             args);
+             ur_getpid(), std::this_thread::get_id(), ts_us, dur_us,
+             args->function_name, args_to_str(args));
+  }
+};
+
+// Writes the calls into per-thread ring files, to be decoded by
+// urtrace_decode. Instead of formatting the arguments, it copies their values
+// into the records, which keeps the overhead of tracing a call low enough not
+// to distort the profile.
+class BinaryWriter : public TraceWriter {
+public:
+  void prologue() override {
+    UR_LOG_L(out, DEBUG, "Writing ring files of {} records to {}.",
+             cli_args.ring_size, *cli_args.binary_dir);
+  }
+  void begin(uint64_t, const xpti::function_with_args_t *) override {}
+
+  void end(uint64_t id, const xpti::function_with_args_t *args, Timepoint tp,
+           Timepoint start_tp) override {
+    auto file = thread_ring_file();
+    if (!file) {
+      return;
+    }
+    auto &record = file->next();
+    record.function_id = args->function_id;
+    record.result = *static_cast<const ur_result_t *>(args->ret_data);
+    record.instance = id;
+    record.begin = to_ns(start_tp);
+    record.end = to_ns(tp);
+    record.params_size = 0;
+    record.flags = 0;
+    if (cli_args.no_args) {
+      record.flags |= urtrace::RECORD_NO_PARAMS;
+    } else {
+      store_params(record, args);
+    }
+    file->commit();
+  }
+
+private:
+  static uint64_t to_ns(Timepoint tp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               tp.time_since_epoch())
+        .count();
+  }
+
+  static void store_params(urtrace::ring_record &record,
+                           const xpti::function_with_args_t *args) {
+    size_t size = 0;
+    bool known = urtrace::visitFunctionParams(
+        (enum ur_function_t)args->function_id, [&](const char *, auto member) {
+          using param = urtrace::param_member<decltype(member)>;
+          auto params =
+              static_cast<const typename param::params_t *>(args->args_data);
+          const auto &value = *(params->*member);
+          if ((record.flags & urtrace::RECORD_PARAMS_TRUNCATED) ||
+              size + sizeof(value) > sizeof(record.params)) {
+            record.flags |= urtrace::RECORD_PARAMS_TRUNCATED;
+            return;
+          }
+          std::memcpy(record.params + size, &value, sizeof(value));
+          size += sizeof(value);
+        });
+    if (!known) {
+      record.flags |= urtrace::RECORD_NO_PARAMS;
+    }
+    record.params_size = static_cast<uint16_t>(size);
+  }
+
+  static std::unique_ptr<urtrace::ring_file> create_ring_file(uint32_t tid) {
+    uint32_t pid = static_cast<uint32_t>(ur_getpid());
+    auto path = *cli_args.binary_dir + "/" + urtrace::ring_file_name(pid, tid);
+    auto file = urtrace::ring_file::create(path, cli_args.ring_size, pid, tid);
+    if (!file) {
+      UR_LOG_L(out, ERR, "Unable to create ring file {}.", path);
+    }
+    return file;
+  }
+
+  static urtrace::ring_file *thread_ring_file() {
+    static std::atomic<uint32_t> next_tid = 1;
+    static thread_local std::unique_ptr<urtrace::ring_file> file =
+        create_ring_file(next_tid++);
+    return file.get();
   }
 };
 
@@ -277,6 +373,8 @@ std::unique_ptr<TraceWriter> create_writer() {
     return std::make_unique<HumanReadable>();
   case OUTPUT_JSON:
     return std::make_unique<JsonWriter>();
+  case OUTPUT_BINARY:
+    return std::make_unique<BinaryWriter>();
   default:
     ur::unreachable();
   }
@@ -320,28 +418,18 @@ XPTI_CALLBACK_API void trace_cb(uint16_t trace_type, xpti::trace_event_data_t *,
   auto time_for_end = Clock::now();
   auto *args = static_cast<const xpti::function_with_args_t *>(user_data);
 
-  if (auto regex = cli_args.filter) {
-    if (!std::regex_match(args->function_name, *regex)) {
-      UR_LOG_L(out, DEBUG,
-               "function {} does not match regex filter, skipping...",
-               args->function_name);
-      return;
-    }
-  }
-
-  std::ostringstream args_str;
-  if (cli_args.no_args) {
-    args_str << "...";
-  } else {
-    ur::extras::printFunctionParams(
-        args_str, (enum ur_function_t)args->function_id, args->args_data);
+  if (!cli_args.traced(args->function_id)) {
+    UR_LOG_L(out, DEBUG, "function {} does not match regex filter, skipping...",
+             args->function_name);
+    return;
   }
 
   if (trace_type == TRACE_FN_BEGIN) {
     auto ctx = push_instance_data(instance);
-    ctx->start = std::optional(Clock::now());
+    writer()->begin(instance, args);
 
-    writer()->begin(instance, args->function_name, args_str.str());
+    // start the clock once the writer is done, so that it isn't profiled
+    ctx->start = std::optional(Clock::now());
   } else if (trace_type == TRACE_FN_END) {
     auto ctx = pop_instance_data(instance);
     if (!ctx) {
@@ -351,10 +439,8 @@ XPTI_CALLBACK_API void trace_cb(uint16_t trace_type, xpti::trace_event_data_t *,
                instance);
       return;
     }
-    auto resultp = static_cast<const ur_result_t *>(args->ret_data);
 
-    writer()->end(instance, args->function_name, args_str.str(), time_for_end,
-                  *ctx->start, resultp);
+    writer()->end(instance, args, time_for_end, *ctx->start);
   } else {
     UR_LOG_L(out, WARN, "unsupported trace type");
   }
@@ -0,0 +1,300 @@
+/*
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file decoder.cpp
+ *
+ * This file contains the implementation of the urtrace_decode tool, which
+ * prints the ring files written by the UR collector in binary mode, in the
+ * same formats the collector prints the calls in otherwise.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "trace_file.hpp"
+#include "unified-runtime/ur_api.h"
+#include "unified-runtime/ur_print.hpp"
+#include "ur_filesystem_resolved.hpp"
+#include "urtrace_params.hpp"
+
+namespace urtrace {
+
+// Prints the value of a parameter. The memory the pointers point to is not
+// in the ring files, so only their values are printed.
+template <typename T> void print_param(std::ostream &os, const T &value) {
+  if constexpr (std::is_pointer_v<T>) {
+    if (value == nullptr) {
+      os << "nullptr";
+    } else {
+      os << reinterpret_cast<const void *>(reinterpret_cast<uintptr_t>(value));
+    }
+  } else if constexpr (std::is_same_v<T, int8_t>) {
+    os << static_cast<int>(value);
+  } else {
+    os << value;
+  }
+}
+
+struct ring {
+  ring_header header;
+  // The records in the order they were written.
+  std::vector<ring_record> records;
+};
+
+struct event {
+  uint64_t ts;
+  bool begin;
+  const ring_header *header;
+  const ring_record *record;
+};
+
+struct app {
+  bool json = false;
+  bool print_begin = false;
+  bool profiling = false;
+  bool no_args = false;
+  enum time_unit time_unit = TIME_UNIT_AUTO;
+  std::vector<ring> rings;
+
+  app(int argc, const char **argv) {
+    auto paths = parseArgs(argc, argv);
+    for (auto &path : paths) {
+      load(path);
+    }
+  }
+
+  std::vector<filesystem::path> parseArgs(int argc, const char **argv) {
+    static const char *usage = R"(usage: %s [-h] [options] path [path ...]
+
+This tool prints the ring files written by the urtrace collector in binary
+mode. The paths are ring files, or directories whose ring files are printed.
+
+options:
+  -h, --help            show this help message and exit
+  --json                print in the JSON Trace Event Format
+  --print-begin         print on function begin
+  --profiling           print function execution time
+  --time-unit {ns,us,ms,s,auto}
+                        use a specific unit of time for profiling
+  --no-args             don't print function arguments
+)";
+    std::vector<filesystem::path> paths;
+    for (int argi = 1; argi < argc; argi++) {
+      std::string_view arg{argv[argi]};
+      if (arg == "-h" || arg == "--help") {
+        std::printf(usage, argv[0]);
+        std::exit(0);
+      } else if (arg == "--json") {
+        json = true;
+      } else if (arg == "--print-begin") {
+        print_begin = true;
+      } else if (arg == "--profiling") {
+        profiling = true;
+      } else if (arg == "--no-args") {
+        no_args = true;
+      } else if (arg == "--time-unit" && argi + 1 < argc) {
+        std::string_view unit{argv[++argi]};
+        int i = 0;
+        while (i < MAX_TIME_UNIT && time_unit_str[i] != unit) {
+          i++;
+        }
+        if (i == MAX_TIME_UNIT) {
+          std::fprintf(stderr, "error: invalid time unit: %s\n", argv[argi]);
+          std::exit(1);
+        }
+        time_unit = (enum time_unit)i;
+      } else if (arg.substr(0, 1) != "-") {
+        paths.emplace_back(argv[argi]);
+      } else {
+        std::fprintf(stderr, "error: invalid argument: %s\n", argv[argi]);
+        std::fprintf(stderr, usage, argv[0]);
+        std::exit(1);
+      }
+    }
+    if (paths.empty()) {
+      std::fprintf(stderr, usage, argv[0]);
+      std::exit(1);
+    }
+    return paths;
+  }
+
+  void load(const filesystem::path &path) {
+    if (!filesystem::is_directory(path)) {
+      loadFile(path);
+      return;
+    }
+    std::vector<filesystem::path> files;
+    for (auto &entry : filesystem::directory_iterator(path)) {
+      auto name = entry.path().filename().string();
+      if (name.rfind("urtrace.", 0) == 0 &&
+          entry.path().extension() == ".bin") {
+        files.push_back(entry.path());
+      }
+    }
+    std::sort(files.begin(), files.end());
+    for (auto &file : files) {
+      loadFile(file);
+    }
+  }
+
+  void loadFile(const filesystem::path &path) {
+    std::ifstream file(path, std::ios::binary);
+    ring ring{};
+    if (!file.read(reinterpret_cast<char *>(&ring.header),
+                   sizeof(ring.header))) {
+      throw std::runtime_error("unable to read " + path.string());
+    }
+    auto &header = ring.header;
+    if (std::memcmp(header.magic, RING_MAGIC, sizeof(RING_MAGIC)) != 0 ||
+        header.version != RING_VERSION || header.record_size != RECORD_SIZE ||
+        header.capacity == 0) {
+      throw std::runtime_error(path.string() + " is not a ring file");
+    }
+    if (header.api_version != UR_API_VERSION_CURRENT) {
+      throw std::runtime_error(path.string() +
+                               " was written by a collector for another "
+                               "version of the API");
+    }
+
+    uint64_t count = std::min(header.written, header.capacity);
+    ring.records.resize(count);
+    for (uint64_t i = header.written - count; i < header.written; i++) {
+      auto &record = ring.records[i - (header.written - count)];
+      file.seekg((i % header.capacity + 1) * RECORD_SIZE);
+      if (!file.read(reinterpret_cast<char *>(&record), sizeof(record))) {
+        throw std::runtime_error("unable to read " + path.string());
+      }
+      record.params_size = std::min<uint16_t>(record.params_size,
+                                              sizeof(record.params));
+    }
+    rings.push_back(std::move(ring));
+  }
+
+  std::string args_to_str(const ring_record &record) {
+    if (no_args || (record.flags & RECORD_NO_PARAMS)) {
+      return "...";
+    }
+    std::ostringstream args_str;
+    size_t offset = 0;
+    bool first = true;
+    visitFunctionParams(
+        (enum ur_function_t)record.function_id,
+        [&](const char *name, auto member) {
+          using value_t = typename param_member<decltype(member)>::value_t;
+          if (!first) {
+            args_str << ", ";
+          }
+          first = false;
+          args_str << "." << name << " = ";
+          if (offset + sizeof(value_t) > record.params_size) {
+            args_str << "...";
+            return;
+          }
+          std::remove_cv_t<value_t> value{};
+          std::memcpy(&value, record.params + offset, sizeof(value));
+          offset += sizeof(value);
+          print_param(args_str, value);
+        });
+    return args_str.str();
+  }
+
+  static std::string function_name(const ring_record &record) {
+    auto name = getFunctionName((enum ur_function_t)record.function_id);
+    if (name == nullptr) {
+      return "unknown(" + std::to_string(record.function_id) + ")";
+    }
+    return name;
+  }
+
+  // Merges the records of all the rings, in the order the collector would
+  // have printed them.
+  std::vector<event> events() {
+    std::vector<event> events;
+    for (auto &ring : rings) {
+      for (auto &record : ring.records) {
+        if (print_begin && !json) {
+          events.push_back(event{record.begin, true, &ring.header, &record});
+        }
+        events.push_back(event{record.end, false, &ring.header, &record});
+      }
+    }
+    std::stable_sort(
+        events.begin(), events.end(),
+        [](const event &a, const event &b) { return a.ts < b.ts; });
+    return events;
+  }
+
+  void printHumanReadable() {
+    for (auto &event : events()) {
+      auto &record = *event.record;
+      if (event.begin) {
+        std::cout << "begin(" << record.instance << ") - "
+                  << function_name(record) << "(" << args_to_str(record)
+                  << ");\n";
+        continue;
+      }
+      if (print_begin) {
+        std::cout << "end(" << record.instance << ") - ";
+      }
+      std::cout << function_name(record) << "(" << args_to_str(record)
+                << ") -> " << static_cast<ur_result_t>(record.result) << ";";
+      if (profiling) {
+        std::chrono::nanoseconds dur(record.end - record.begin);
+        std::cout << " (" << time_to_str(dur, time_unit) << ")";
+      }
+      std::cout << "\n";
+    }
+  }
+
+  void printJson() {
+    std::cout << "{\n \"traceEvents\": [\n";
+    for (auto &event : events()) {
+      auto &record = *event.record;
+      std::cout << "{\"cat\": \"UR\", \"ph\": \"X\", \"pid\": "
+                << event.header->pid << ", \"tid\": " << event.header->tid
+                << ", \"ts\": " << record.end / 1000
+                << ", \"dur\": " << (record.end - record.begin) / 1000
+                << ", \"name\": \"" << function_name(record)
+                << "\", \"args\": \"(" << args_to_str(record) << ")\"},\n";
+    }
+    // Empty trace to avoid ending in a comma, like the collector does.
+    std::cout << "{\"name\": \"\", \"cat\": \"\", \"ph\": \"\", \"pid\": "
+                 "\"\", \"tid\": \"\", \"ts\": \"\"}\n";
+    std::cout << "]\n}\n";
+  }
+};
+} // namespace urtrace
+
+int main(int argc, const char **argv) {
+  try {
+    auto app = urtrace::app{argc, argv};
+    if (app.json) {
+      app.printJson();
+    } else {
+      app.printHumanReadable();
+    }
+    return 0;
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "error: %s\n", e.what());
+  } catch (...) {
+    std::fprintf(stderr, "error: unknown exception\n");
+  }
+  return 1;
+}
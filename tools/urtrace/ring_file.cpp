@@ -0,0 +1,97 @@
+/*
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file ring_file.cpp
+ *
+ */
+
+#include <cstring>
+
+#include "ring_file.hpp"
+#include "unified-runtime/ur_api.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace urtrace {
+
+#ifdef _WIN32
+static void *map_file(const std::string &path, size_t size) {
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                            FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingA(
+      file, nullptr, PAGE_READWRITE, static_cast<DWORD>(uint64_t(size) >> 32),
+      static_cast<DWORD>(size & 0xffffffff), nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  void *map = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  CloseHandle(mapping);
+  return map;
+}
+
+static void unmap_file(void *map, size_t) { UnmapViewOfFile(map); }
+#else
+static void *map_file(const std::string &path, size_t size) {
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return nullptr;
+  }
+  void *map = nullptr;
+  if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+    map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+      map = nullptr;
+    }
+  }
+  close(fd);
+  return map;
+}
+
+static void unmap_file(void *map, size_t size) { munmap(map, size); }
+#endif
+
+std::unique_ptr<ring_file> ring_file::create(const std::string &path,
+                                             uint64_t capacity, uint32_t pid,
+                                             uint32_t tid) {
+  size_t size = ring_file_size(capacity);
+  void *map = map_file(path, size);
+  if (map == nullptr) {
+    return nullptr;
+  }
+
+  // The mapping of a new file is zeroed.
+  auto header = static_cast<ring_header *>(map);
+  std::memcpy(header->magic, RING_MAGIC, sizeof(RING_MAGIC));
+  header->version = RING_VERSION;
+  header->api_version = UR_API_VERSION_CURRENT;
+  header->record_size = RECORD_SIZE;
+  header->pid = pid;
+  header->tid = tid;
+  header->capacity = capacity;
+
+  return std::unique_ptr<ring_file>(new ring_file(map, size));
+}
+
+ring_file::ring_file(void *map, size_t size)
+    : map(map), size(size), header(static_cast<ring_header *>(map)),
+      records(reinterpret_cast<ring_record *>(static_cast<char *>(map) +
+                                              RECORD_SIZE)) {}
+
+ring_file::~ring_file() { unmap_file(map, size); }
+
+} // namespace urtrace
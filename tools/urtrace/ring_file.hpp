@@ -0,0 +1,54 @@
+/*
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file ring_file.hpp
+ *
+ */
+
+#ifndef URTRACE_RING_FILE_HPP
+#define URTRACE_RING_FILE_HPP 1
+
+#include <memory>
+#include <string>
+
+#include "trace_file.hpp"
+
+namespace urtrace {
+
+// A ring file mapped in memory, written by a single thread.
+class ring_file {
+public:
+  // Creates the file at path, or returns nullptr if it cannot be created.
+  static std::unique_ptr<ring_file> create(const std::string &path,
+                                           uint64_t capacity, uint32_t pid,
+                                           uint32_t tid);
+  ~ring_file();
+
+  ring_file(const ring_file &) = delete;
+  ring_file &operator=(const ring_file &) = delete;
+
+  // The record the next call goes in, which overwrites the oldest one once
+  // the ring is full.
+  ring_record &next() {
+    return records[header->written % header->capacity];
+  }
+
+  // Publishes the record returned by next().
+  void commit() { header->written++; }
+
+private:
+  ring_file(void *map, size_t size);
+
+  void *map;
+  size_t size;
+  ring_header *header;
+  ring_record *records;
+};
+
+} // namespace urtrace
+
+#endif /* URTRACE_RING_FILE_HPP */
@@ -0,0 +1,150 @@
+/*
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions. See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file trace_file.hpp
+ *
+ * This file contains the definitions shared by the UR collector library and
+ * the urtrace_decode tool: the time units of the profiling output and the
+ * layout of the binary trace files.
+ */
+
+#ifndef URTRACE_TRACE_FILE_HPP
+#define URTRACE_TRACE_FILE_HPP 1
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+namespace urtrace {
+
+enum time_unit {
+  TIME_UNIT_AUTO,
+  TIME_UNIT_NS,
+  TIME_UNIT_US,
+  TIME_UNIT_MS,
+  TIME_UNIT_S,
+  MAX_TIME_UNIT,
+};
+
+inline const char *time_unit_str[MAX_TIME_UNIT] = {"auto", "ns", "us", "ms",
+                                                   "s"};
+
+inline std::string time_to_str(std::chrono::nanoseconds dur,
+                               enum time_unit unit) {
+  std::ostringstream ostr;
+
+  switch (unit) {
+  case TIME_UNIT_AUTO: {
+    if (dur.count() < 1000) {
+      return time_to_str(dur, TIME_UNIT_NS);
+    }
+    if (dur.count() < 1000 * 1000) {
+      return time_to_str(dur, TIME_UNIT_US);
+    }
+    if (dur.count() < 1000 * 1000 * 1000) {
+      return time_to_str(dur, TIME_UNIT_MS);
+    }
+    return time_to_str(dur, TIME_UNIT_S);
+  } break;
+  case TIME_UNIT_NS: {
+    ostr << dur.count() << "ns";
+  } break;
+  case TIME_UNIT_US: {
+    std::chrono::duration<double, std::micro> d = dur;
+    ostr << d.count() << "us";
+  } break;
+  case TIME_UNIT_MS: {
+    std::chrono::duration<double, std::milli> d = dur;
+    ostr << d.count() << "ms";
+  } break;
+  case TIME_UNIT_S: {
+    std::chrono::duration<double, std::ratio<1>> d = dur;
+    ostr << d.count() << "s";
+  } break;
+  default:
+    break;
+  }
+
+  return ostr.str();
+}
+
+/*
+ * In binary mode, every thread of the traced process writes the calls it
+ * makes into its own ring file, named ring_file_name(pid, tid). A ring file
+ * is a ring_header followed by ring_header::capacity records, each
+ * RECORD_SIZE bytes long, holding the last calls made by the thread. The
+ * files are mapped in memory, so they are complete even if the process
+ * crashes.
+ */
+constexpr char RING_MAGIC[8] = {'U', 'R', 'T', 'R', 'A', 'C', 'E', '\0'};
+constexpr uint32_t RING_VERSION = 1;
+constexpr size_t RECORD_SIZE = 256;
+
+inline std::string ring_file_name(uint32_t pid, uint32_t tid) {
+  return "urtrace." + std::to_string(pid) + "." + std::to_string(tid) +
+         ".bin";
+}
+
+struct ring_header {
+  char magic[8];
+  uint32_t version;
+  // UR_API_VERSION_CURRENT of the collector, the layout of the params of a
+  // record depends on it.
+  uint32_t api_version;
+  uint32_t record_size;
+  uint32_t pid;
+  // The index of the thread in the process, starting from 1.
+  uint32_t tid;
+  uint32_t reserved;
+  uint64_t capacity;
+  // The number of records written so far, the last capacity ones of which
+  // are in the ring.
+  uint64_t written;
+};
+
+// The params of the call could not all be stored in the record.
+constexpr uint8_t RECORD_PARAMS_TRUNCATED = 1 << 0;
+// The params of the call were not recorded.
+constexpr uint8_t RECORD_NO_PARAMS = 1 << 1;
+
+struct ring_record {
+  uint32_t function_id;
+  int32_t result;
+  uint64_t instance;
+  // The time of the beginning and of the end of the call, in nanoseconds of
+  // the steady clock.
+  uint64_t begin;
+  uint64_t end;
+  uint16_t params_size;
+  uint8_t flags;
+  uint8_t reserved;
+  // The values of the parameters of the call, copied one after the other in
+  // the order of visitFunctionParams.
+  uint8_t params[RECORD_SIZE - 36];
+};
+
+static_assert(sizeof(ring_record) == RECORD_SIZE);
+static_assert(sizeof(ring_header) <= RECORD_SIZE);
+
+// The records of a ring file start at RECORD_SIZE, after the header.
+inline size_t ring_file_size(uint64_t capacity) {
+  return (capacity + 1) * RECORD_SIZE;
+}
+
+// Gives the params struct and the parameter type of the member pointers
+// passed by visitFunctionParams.
+template <typename M> struct param_member;
+template <typename P, typename T> struct param_member<T *P::*> {
+  using params_t = P;
+  using value_t = T;
+};
+
+} // namespace urtrace
+
+#endif /* URTRACE_TRACE_FILE_HPP */
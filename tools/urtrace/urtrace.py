@@ -44,7 +44,9 @@ parser = argparse.ArgumentParser(
 
     %(prog)s ./myapp --myapp-arg
     %(prog)s --mock --profiling --filter ".*(Device|Platform).*" ./hello_world
-    %(prog)s --adapter libur_adapter_cuda.so --begin ./sycl_app""",
+    %(prog)s --adapter libur_adapter_cuda.so --begin ./sycl_app
+    %(prog)s --binary trace_dir ./sycl_app
+    %(prog)s --decode trace_dir --profiling --json""",
     formatter_class=argparse.RawDescriptionHelpFormatter,
 )
 parser.add_argument(
@@ -77,6 +79,25 @@ group.add_argument(
     help="Write trace output to stdout instead of stderr.",
     action="store_true",
 )
+parser.add_argument(
+    "--binary",
+    metavar="DIR",
+    help="""Record function calls into per-thread ring files in the given
+    directory instead of printing them, which adds much less overhead to the
+    calls. Only the values of the arguments are recorded, not the memory
+    pointers point to. Use --decode to print the files.""",
+)
+parser.add_argument(
+    "--ring-size",
+    type=int,
+    default=65536,
+    help="Number of function calls kept per thread with --binary.",
+)
+parser.add_argument(
+    "--decode",
+    metavar="DIR",
+    help="Print the ring files recorded with --binary in the given directory.",
+)
 parser.add_argument(
     "--no-args",
     help="Don't pretty print traced functions arguments.",
@@ -113,8 +134,42 @@ args = parser.parse_args()
 config = vars(args)
 if args.debug:
     print(config)
+if args.binary and args.json:
+    parser.error("--json only applies when decoding --binary traces")
 env = os.environ.copy()
 
+
+def decode(directory):
+    decoder = os.path.join(
+        os.path.dirname(os.path.realpath(__file__)),
+        "urtrace_decode.exe" if sys.platform == "win32" else "urtrace_decode",
+    )
+    if not os.path.isfile(decoder):
+        sys.exit("unable to find the decoder - " + decoder)
+    decoder_args = [decoder, "--time-unit", args.time_unit]
+    if args.json:
+        decoder_args.append("--json")
+    if args.print_begin:
+        decoder_args.append("--print-begin")
+    if args.profiling:
+        decoder_args.append("--profiling")
+    if args.no_args:
+        decoder_args.append("--no-args")
+    decoder_args.append(directory)
+    if args.debug:
+        print(decoder_args)
+    # The decoder only reads the files of the given directory.
+    if args.file:
+        with open(args.file, "w") as output:
+            result = subprocess.run(decoder_args, stdout=output)  # nosec B603
+    else:
+        result = subprocess.run(decoder_args)  # nosec B603
+    exit(result.returncode)
+
+
+if args.decode:
+    decode(args.decode)
+
 collector_args = ""
 if args.print_begin:
     collector_args += "print_begin;"
@@ -128,6 +183,10 @@ if args.no_args:
     collector_args += "no_args;"
 if args.json:
     collector_args += "json;"
+if args.binary:
+    os.makedirs(args.binary, exist_ok=True)
+    collector_args += "binary:'" + os.path.abspath(args.binary) + "';"
+    collector_args += "ring_size:" + str(args.ring_size) + ";"
 env["UR_COLLECTOR_ARGS"] = collector_args
 
 log_collector = ""
@@ -0,0 +1,2498 @@
+/*
+ *
+ * Part of the LLVM Project, under the Apache License v2.0 with LLVM
+ * Exceptions.
+ * See https://llvm.org/LICENSE.txt for license information.
+ *
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ * @file urtrace_params.hpp
+ *
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <unified-runtime/ur_api.h>
+
+namespace urtrace {
+
+/// @brief One past the highest ur_function_t value.
+constexpr size_t FUNCTION_ID_LIMIT = 327;
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Returns the name of a function, or nullptr if it is unknown.
+inline const char *getFunctionName(ur_function_t function) {
+  switch (function) {
+  case UR_FUNCTION_ADAPTER_GET:
+    return "urAdapterGet";
+  case UR_FUNCTION_ADAPTER_RELEASE:
+    return "urAdapterRelease";
+  case UR_FUNCTION_ADAPTER_RETAIN:
+    return "urAdapterRetain";
+  case UR_FUNCTION_ADAPTER_GET_LAST_ERROR:
+    return "urAdapterGetLastError";
+  case UR_FUNCTION_ADAPTER_GET_INFO:
+    return "urAdapterGetInfo";
+  case UR_FUNCTION_ADAPTER_SET_LOGGER_CALLBACK:
+    return "urAdapterSetLoggerCallback";
+  case UR_FUNCTION_ADAPTER_SET_LOGGER_CALLBACK_LEVEL:
+    return "urAdapterSetLoggerCallbackLevel";
+  case UR_FUNCTION_BINDLESS_IMAGES_UNSAMPLED_IMAGE_HANDLE_DESTROY_EXP:
+    return "urBindlessImagesUnsampledImageHandleDestroyExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_SAMPLED_IMAGE_HANDLE_DESTROY_EXP:
+    return "urBindlessImagesSampledImageHandleDestroyExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_IMAGE_ALLOCATE_EXP:
+    return "urBindlessImagesImageAllocateExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_IMAGE_FREE_EXP:
+    return "urBindlessImagesImageFreeExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_UNSAMPLED_IMAGE_CREATE_EXP:
+    return "urBindlessImagesUnsampledImageCreateExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_SAMPLED_IMAGE_CREATE_EXP:
+    return "urBindlessImagesSampledImageCreateExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_IMAGE_COPY_EXP:
+    return "urBindlessImagesImageCopyExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_IMAGE_GET_INFO_EXP:
+    return "urBindlessImagesImageGetInfoExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_GET_IMAGE_MEMORY_HANDLE_TYPE_SUPPORT_EXP:
+    return "urBindlessImagesGetImageMemoryHandleTypeSupportExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_GET_IMAGE_UNSAMPLED_HANDLE_SUPPORT_EXP:
+    return "urBindlessImagesGetImageUnsampledHandleSupportExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_GET_IMAGE_SAMPLED_HANDLE_SUPPORT_EXP:
+    return "urBindlessImagesGetImageSampledHandleSupportExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_MIPMAP_GET_LEVEL_EXP:
+    return "urBindlessImagesMipmapGetLevelExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_MIPMAP_FREE_EXP:
+    return "urBindlessImagesMipmapFreeExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_IMPORT_EXTERNAL_MEMORY_EXP:
+    return "urBindlessImagesImportExternalMemoryExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_MAP_EXTERNAL_ARRAY_EXP:
+    return "urBindlessImagesMapExternalArrayExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_MAP_EXTERNAL_LINEAR_MEMORY_EXP:
+    return "urBindlessImagesMapExternalLinearMemoryExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_RELEASE_EXTERNAL_MEMORY_EXP:
+    return "urBindlessImagesReleaseExternalMemoryExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_FREE_MAPPED_LINEAR_MEMORY_EXP:
+    return "urBindlessImagesFreeMappedLinearMemoryExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_SUPPORTS_IMPORTING_HANDLE_TYPE_EXP:
+    return "urBindlessImagesSupportsImportingHandleTypeExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_IMPORT_EXTERNAL_SEMAPHORE_EXP:
+    return "urBindlessImagesImportExternalSemaphoreExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_RELEASE_EXTERNAL_SEMAPHORE_EXP:
+    return "urBindlessImagesReleaseExternalSemaphoreExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_WAIT_EXTERNAL_SEMAPHORE_EXP:
+    return "urBindlessImagesWaitExternalSemaphoreExp";
+  case UR_FUNCTION_BINDLESS_IMAGES_SIGNAL_EXTERNAL_SEMAPHORE_EXP:
+    return "urBindlessImagesSignalExternalSemaphoreExp";
+  case UR_FUNCTION_COMMAND_BUFFER_CREATE_EXP:
+    return "urCommandBufferCreateExp";
+  case UR_FUNCTION_COMMAND_BUFFER_RETAIN_EXP:
+    return "urCommandBufferRetainExp";
+  case UR_FUNCTION_COMMAND_BUFFER_RELEASE_EXP:
+    return "urCommandBufferReleaseExp";
+  case UR_FUNCTION_COMMAND_BUFFER_FINALIZE_EXP:
+    return "urCommandBufferFinalizeExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_KERNEL_LAUNCH_EXP:
+    return "urCommandBufferAppendKernelLaunchExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_KERNEL_LAUNCH_WITH_ARGS_EXP:
+    return "urCommandBufferAppendKernelLaunchWithArgsExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_USM_MEMCPY_EXP:
+    return "urCommandBufferAppendUSMMemcpyExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_USM_FILL_EXP:
+    return "urCommandBufferAppendUSMFillExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_COPY_EXP:
+    return "urCommandBufferAppendMemBufferCopyExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_WRITE_EXP:
+    return "urCommandBufferAppendMemBufferWriteExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_READ_EXP:
+    return "urCommandBufferAppendMemBufferReadExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_COPY_RECT_EXP:
+    return "urCommandBufferAppendMemBufferCopyRectExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_WRITE_RECT_EXP:
+    return "urCommandBufferAppendMemBufferWriteRectExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_READ_RECT_EXP:
+    return "urCommandBufferAppendMemBufferReadRectExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_FILL_EXP:
+    return "urCommandBufferAppendMemBufferFillExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_USM_PREFETCH_EXP:
+    return "urCommandBufferAppendUSMPrefetchExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_USM_ADVISE_EXP:
+    return "urCommandBufferAppendUSMAdviseExp";
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_NATIVE_COMMAND_EXP:
+    return "urCommandBufferAppendNativeCommandExp";
+  case UR_FUNCTION_COMMAND_BUFFER_UPDATE_KERNEL_LAUNCH_EXP:
+    return "urCommandBufferUpdateKernelLaunchExp";
+  case UR_FUNCTION_COMMAND_BUFFER_UPDATE_SIGNAL_EVENT_EXP:
+    return "urCommandBufferUpdateSignalEventExp";
+  case UR_FUNCTION_COMMAND_BUFFER_UPDATE_WAIT_EVENTS_EXP:
+    return "urCommandBufferUpdateWaitEventsExp";
+  case UR_FUNCTION_COMMAND_BUFFER_GET_INFO_EXP:
+    return "urCommandBufferGetInfoExp";
+  case UR_FUNCTION_COMMAND_BUFFER_GET_NATIVE_HANDLE_EXP:
+    return "urCommandBufferGetNativeHandleExp";
+  case UR_FUNCTION_CONTEXT_CREATE:
+    return "urContextCreate";
+  case UR_FUNCTION_CONTEXT_RETAIN:
+    return "urContextRetain";
+  case UR_FUNCTION_CONTEXT_RELEASE:
+    return "urContextRelease";
+  case UR_FUNCTION_CONTEXT_GET_INFO:
+    return "urContextGetInfo";
+  case UR_FUNCTION_CONTEXT_GET_NATIVE_HANDLE:
+    return "urContextGetNativeHandle";
+  case UR_FUNCTION_CONTEXT_CREATE_WITH_NATIVE_HANDLE:
+    return "urContextCreateWithNativeHandle";
+  case UR_FUNCTION_CONTEXT_SET_EXTENDED_DELETER:
+    return "urContextSetExtendedDeleter";
+  case UR_FUNCTION_ENQUEUE_EVENTS_WAIT:
+    return "urEnqueueEventsWait";
+  case UR_FUNCTION_ENQUEUE_EVENTS_WAIT_WITH_BARRIER:
+    return "urEnqueueEventsWaitWithBarrier";
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_READ:
+    return "urEnqueueMemBufferRead";
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_WRITE:
+    return "urEnqueueMemBufferWrite";
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_READ_RECT:
+    return "urEnqueueMemBufferReadRect";
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_WRITE_RECT:
+    return "urEnqueueMemBufferWriteRect";
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_COPY:
+    return "urEnqueueMemBufferCopy";
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_COPY_RECT:
+    return "urEnqueueMemBufferCopyRect";
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_FILL:
+    return "urEnqueueMemBufferFill";
+  case UR_FUNCTION_ENQUEUE_MEM_IMAGE_READ:
+    return "urEnqueueMemImageRead";
+  case UR_FUNCTION_ENQUEUE_MEM_IMAGE_WRITE:
+    return "urEnqueueMemImageWrite";
+  case UR_FUNCTION_ENQUEUE_MEM_IMAGE_COPY:
+    return "urEnqueueMemImageCopy";
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_MAP:
+    return "urEnqueueMemBufferMap";
+  case UR_FUNCTION_ENQUEUE_MEM_UNMAP:
+    return "urEnqueueMemUnmap";
+  case UR_FUNCTION_ENQUEUE_USM_FILL:
+    return "urEnqueueUSMFill";
+  case UR_FUNCTION_ENQUEUE_USM_MEMCPY:
+    return "urEnqueueUSMMemcpy";
+  case UR_FUNCTION_ENQUEUE_USM_PREFETCH:
+    return "urEnqueueUSMPrefetch";
+  case UR_FUNCTION_ENQUEUE_USM_ADVISE:
+    return "urEnqueueUSMAdvise";
+  case UR_FUNCTION_ENQUEUE_USM_FILL_2D:
+    return "urEnqueueUSMFill2D";
+  case UR_FUNCTION_ENQUEUE_USM_MEMCPY_2D:
+    return "urEnqueueUSMMemcpy2D";
+  case UR_FUNCTION_ENQUEUE_DEVICE_GLOBAL_VARIABLE_WRITE:
+    return "urEnqueueDeviceGlobalVariableWrite";
+  case UR_FUNCTION_ENQUEUE_DEVICE_GLOBAL_VARIABLE_READ:
+    return "urEnqueueDeviceGlobalVariableRead";
+  case UR_FUNCTION_ENQUEUE_READ_HOST_PIPE:
+    return "urEnqueueReadHostPipe";
+  case UR_FUNCTION_ENQUEUE_WRITE_HOST_PIPE:
+    return "urEnqueueWriteHostPipe";
+  case UR_FUNCTION_ENQUEUE_KERNEL_LAUNCH_WITH_ARGS_EXP:
+    return "urEnqueueKernelLaunchWithArgsExp";
+  case UR_FUNCTION_ENQUEUE_EVENTS_WAIT_WITH_BARRIER_EXT:
+    return "urEnqueueEventsWaitWithBarrierExt";
+  case UR_FUNCTION_ENQUEUE_USM_DEVICE_ALLOC_EXP:
+    return "urEnqueueUSMDeviceAllocExp";
+  case UR_FUNCTION_ENQUEUE_USM_SHARED_ALLOC_EXP:
+    return "urEnqueueUSMSharedAllocExp";
+  case UR_FUNCTION_ENQUEUE_USM_HOST_ALLOC_EXP:
+    return "urEnqueueUSMHostAllocExp";
+  case UR_FUNCTION_ENQUEUE_USM_FREE_EXP:
+    return "urEnqueueUSMFreeExp";
+  case UR_FUNCTION_ENQUEUE_TIMESTAMP_RECORDING_EXP:
+    return "urEnqueueTimestampRecordingExp";
+  case UR_FUNCTION_ENQUEUE_COMMAND_BUFFER_EXP:
+    return "urEnqueueCommandBufferExp";
+  case UR_FUNCTION_ENQUEUE_HOST_TASK_EXP:
+    return "urEnqueueHostTaskExp";
+  case UR_FUNCTION_ENQUEUE_NATIVE_COMMAND_EXP:
+    return "urEnqueueNativeCommandExp";
+  case UR_FUNCTION_ENQUEUE_GRAPH_EXP:
+    return "urEnqueueGraphExp";
+  case UR_FUNCTION_EVENT_GET_INFO:
+    return "urEventGetInfo";
+  case UR_FUNCTION_EVENT_GET_PROFILING_INFO:
+    return "urEventGetProfilingInfo";
+  case UR_FUNCTION_EVENT_WAIT:
+    return "urEventWait";
+  case UR_FUNCTION_EVENT_RETAIN:
+    return "urEventRetain";
+  case UR_FUNCTION_EVENT_RELEASE:
+    return "urEventRelease";
+  case UR_FUNCTION_EVENT_GET_NATIVE_HANDLE:
+    return "urEventGetNativeHandle";
+  case UR_FUNCTION_EVENT_CREATE_WITH_NATIVE_HANDLE:
+    return "urEventCreateWithNativeHandle";
+  case UR_FUNCTION_EVENT_SET_CALLBACK:
+    return "urEventSetCallback";
+  case UR_FUNCTION_EVENT_CREATE_EXP:
+    return "urEventCreateExp";
+  case UR_FUNCTION_GRAPH_CREATE_EXP:
+    return "urGraphCreateExp";
+  case UR_FUNCTION_GRAPH_INSTANTIATE_GRAPH_EXP:
+    return "urGraphInstantiateGraphExp";
+  case UR_FUNCTION_GRAPH_DESTROY_EXP:
+    return "urGraphDestroyExp";
+  case UR_FUNCTION_GRAPH_EXECUTABLE_GRAPH_DESTROY_EXP:
+    return "urGraphExecutableGraphDestroyExp";
+  case UR_FUNCTION_GRAPH_IS_EMPTY_EXP:
+    return "urGraphIsEmptyExp";
+  case UR_FUNCTION_GRAPH_GET_ID_EXP:
+    return "urGraphGetIdExp";
+  case UR_FUNCTION_GRAPH_SET_DESTRUCTION_CALLBACK_EXP:
+    return "urGraphSetDestructionCallbackExp";
+  case UR_FUNCTION_GRAPH_DUMP_CONTENTS_EXP:
+    return "urGraphDumpContentsExp";
+  case UR_FUNCTION_GRAPH_GET_NATIVE_HANDLE_EXP:
+    return "urGraphGetNativeHandleExp";
+  case UR_FUNCTION_GRAPH_EXECUTABLE_GRAPH_GET_NATIVE_HANDLE_EXP:
+    return "urGraphExecutableGraphGetNativeHandleExp";
+  case UR_FUNCTION_IPC_GET_MEM_HANDLE_EXP:
+    return "urIPCGetMemHandleExp";
+  case UR_FUNCTION_IPC_PUT_MEM_HANDLE_EXP:
+    return "urIPCPutMemHandleExp";
+  case UR_FUNCTION_IPC_OPEN_MEM_HANDLE_EXP:
+    return "urIPCOpenMemHandleExp";
+  case UR_FUNCTION_IPC_CLOSE_MEM_HANDLE_EXP:
+    return "urIPCCloseMemHandleExp";
+  case UR_FUNCTION_IPC_GET_PHYS_MEM_HANDLE_EXP:
+    return "urIPCGetPhysMemHandleExp";
+  case UR_FUNCTION_IPC_PUT_PHYS_MEM_HANDLE_EXP:
+    return "urIPCPutPhysMemHandleExp";
+  case UR_FUNCTION_IPC_OPEN_PHYS_MEM_HANDLE_EXP:
+    return "urIPCOpenPhysMemHandleExp";
+  case UR_FUNCTION_IPC_CLOSE_PHYS_MEM_HANDLE_EXP:
+    return "urIPCClosePhysMemHandleExp";
+  case UR_FUNCTION_IPC_GET_EVENT_HANDLE_EXP:
+    return "urIPCGetEventHandleExp";
+  case UR_FUNCTION_IPC_PUT_EVENT_HANDLE_EXP:
+    return "urIPCPutEventHandleExp";
+  case UR_FUNCTION_IPC_OPEN_EVENT_HANDLE_EXP:
+    return "urIPCOpenEventHandleExp";
+  case UR_FUNCTION_KERNEL_CREATE:
+    return "urKernelCreate";
+  case UR_FUNCTION_KERNEL_GET_INFO:
+    return "urKernelGetInfo";
+  case UR_FUNCTION_KERNEL_GET_GROUP_INFO:
+    return "urKernelGetGroupInfo";
+  case UR_FUNCTION_KERNEL_GET_SUB_GROUP_INFO:
+    return "urKernelGetSubGroupInfo";
+  case UR_FUNCTION_KERNEL_RETAIN:
+    return "urKernelRetain";
+  case UR_FUNCTION_KERNEL_RELEASE:
+    return "urKernelRelease";
+  case UR_FUNCTION_KERNEL_GET_NATIVE_HANDLE:
+    return "urKernelGetNativeHandle";
+  case UR_FUNCTION_KERNEL_CREATE_WITH_NATIVE_HANDLE:
+    return "urKernelCreateWithNativeHandle";
+  case UR_FUNCTION_KERNEL_GET_SUGGESTED_LOCAL_WORK_SIZE:
+    return "urKernelGetSuggestedLocalWorkSize";
+  case UR_FUNCTION_KERNEL_GET_SUGGESTED_LOCAL_WORK_SIZE_WITH_ARGS:
+    return "urKernelGetSuggestedLocalWorkSizeWithArgs";
+  case UR_FUNCTION_KERNEL_SET_EXEC_INFO:
+    return "urKernelSetExecInfo";
+  case UR_FUNCTION_KERNEL_SET_SPECIALIZATION_CONSTANTS:
+    return "urKernelSetSpecializationConstants";
+  case UR_FUNCTION_KERNEL_SUGGEST_MAX_COOPERATIVE_GROUP_COUNT:
+    return "urKernelSuggestMaxCooperativeGroupCount";
+  case UR_FUNCTION_LOADER_INIT:
+    return "urLoaderInit";
+  case UR_FUNCTION_LOADER_TEAR_DOWN:
+    return "urLoaderTearDown";
+  case UR_FUNCTION_LOADER_CONFIG_CREATE:
+    return "urLoaderConfigCreate";
+  case UR_FUNCTION_LOADER_CONFIG_RETAIN:
+    return "urLoaderConfigRetain";
+  case UR_FUNCTION_LOADER_CONFIG_RELEASE:
+    return "urLoaderConfigRelease";
+  case UR_FUNCTION_LOADER_CONFIG_GET_INFO:
+    return "urLoaderConfigGetInfo";
+  case UR_FUNCTION_LOADER_CONFIG_ENABLE_LAYER:
+    return "urLoaderConfigEnableLayer";
+  case UR_FUNCTION_LOADER_CONFIG_SET_CODE_LOCATION_CALLBACK:
+    return "urLoaderConfigSetCodeLocationCallback";
+  case UR_FUNCTION_LOADER_CONFIG_SET_MOCKING_ENABLED:
+    return "urLoaderConfigSetMockingEnabled";
+  case UR_FUNCTION_MEM_IMAGE_CREATE:
+    return "urMemImageCreate";
+  case UR_FUNCTION_MEM_BUFFER_CREATE:
+    return "urMemBufferCreate";
+  case UR_FUNCTION_MEM_RETAIN:
+    return "urMemRetain";
+  case UR_FUNCTION_MEM_RELEASE:
+    return "urMemRelease";
+  case UR_FUNCTION_MEM_BUFFER_PARTITION:
+    return "urMemBufferPartition";
+  case UR_FUNCTION_MEM_GET_NATIVE_HANDLE:
+    return "urMemGetNativeHandle";
+  case UR_FUNCTION_MEM_BUFFER_CREATE_WITH_NATIVE_HANDLE:
+    return "urMemBufferCreateWithNativeHandle";
+  case UR_FUNCTION_MEM_IMAGE_CREATE_WITH_NATIVE_HANDLE:
+    return "urMemImageCreateWithNativeHandle";
+  case UR_FUNCTION_MEM_GET_INFO:
+    return "urMemGetInfo";
+  case UR_FUNCTION_MEM_IMAGE_GET_INFO:
+    return "urMemImageGetInfo";
+  case UR_FUNCTION_MEMORY_EXPORT_ALLOC_EXPORTABLE_MEMORY_EXP:
+    return "urMemoryExportAllocExportableMemoryExp";
+  case UR_FUNCTION_MEMORY_EXPORT_FREE_EXPORTABLE_MEMORY_EXP:
+    return "urMemoryExportFreeExportableMemoryExp";
+  case UR_FUNCTION_MEMORY_EXPORT_EXPORT_MEMORY_HANDLE_EXP:
+    return "urMemoryExportExportMemoryHandleExp";
+  case UR_FUNCTION_PHYSICAL_MEM_CREATE:
+    return "urPhysicalMemCreate";
+  case UR_FUNCTION_PHYSICAL_MEM_RETAIN:
+    return "urPhysicalMemRetain";
+  case UR_FUNCTION_PHYSICAL_MEM_RELEASE:
+    return "urPhysicalMemRelease";
+  case UR_FUNCTION_PHYSICAL_MEM_GET_INFO:
+    return "urPhysicalMemGetInfo";
+  case UR_FUNCTION_PLATFORM_GET:
+    return "urPlatformGet";
+  case UR_FUNCTION_PLATFORM_GET_INFO:
+    return "urPlatformGetInfo";
+  case UR_FUNCTION_PLATFORM_GET_NATIVE_HANDLE:
+    return "urPlatformGetNativeHandle";
+  case UR_FUNCTION_PLATFORM_CREATE_WITH_NATIVE_HANDLE:
+    return "urPlatformCreateWithNativeHandle";
+  case UR_FUNCTION_PLATFORM_GET_API_VERSION:
+    return "urPlatformGetApiVersion";
+  case UR_FUNCTION_PLATFORM_GET_BACKEND_OPTION:
+    return "urPlatformGetBackendOption";
+  case UR_FUNCTION_PROGRAM_CREATE_WITH_IL:
+    return "urProgramCreateWithIL";
+  case UR_FUNCTION_PROGRAM_CREATE_WITH_BINARY:
+    return "urProgramCreateWithBinary";
+  case UR_FUNCTION_PROGRAM_BUILD:
+    return "urProgramBuild";
+  case UR_FUNCTION_PROGRAM_DYNAMIC_LINK_EXP:
+    return "urProgramDynamicLinkExp";
+  case UR_FUNCTION_PROGRAM_BUILD_EXP:
+    return "urProgramBuildExp";
+  case UR_FUNCTION_PROGRAM_COMPILE:
+    return "urProgramCompile";
+  case UR_FUNCTION_PROGRAM_COMPILE_EXP:
+    return "urProgramCompileExp";
+  case UR_FUNCTION_PROGRAM_LINK:
+    return "urProgramLink";
+  case UR_FUNCTION_PROGRAM_LINK_EXP:
+    return "urProgramLinkExp";
+  case UR_FUNCTION_PROGRAM_RETAIN:
+    return "urProgramRetain";
+  case UR_FUNCTION_PROGRAM_RELEASE:
+    return "urProgramRelease";
+  case UR_FUNCTION_PROGRAM_GET_FUNCTION_POINTER:
+    return "urProgramGetFunctionPointer";
+  case UR_FUNCTION_PROGRAM_GET_GLOBAL_VARIABLE_POINTER:
+    return "urProgramGetGlobalVariablePointer";
+  case UR_FUNCTION_PROGRAM_GET_INFO:
+    return "urProgramGetInfo";
+  case UR_FUNCTION_PROGRAM_GET_BUILD_INFO:
+    return "urProgramGetBuildInfo";
+  case UR_FUNCTION_PROGRAM_SET_SPECIALIZATION_CONSTANTS:
+    return "urProgramSetSpecializationConstants";
+  case UR_FUNCTION_PROGRAM_GET_NATIVE_HANDLE:
+    return "urProgramGetNativeHandle";
+  case UR_FUNCTION_PROGRAM_CREATE_WITH_NATIVE_HANDLE:
+    return "urProgramCreateWithNativeHandle";
+  case UR_FUNCTION_QUEUE_GET_INFO:
+    return "urQueueGetInfo";
+  case UR_FUNCTION_QUEUE_CREATE:
+    return "urQueueCreate";
+  case UR_FUNCTION_QUEUE_RETAIN:
+    return "urQueueRetain";
+  case UR_FUNCTION_QUEUE_RELEASE:
+    return "urQueueRelease";
+  case UR_FUNCTION_QUEUE_GET_NATIVE_HANDLE:
+    return "urQueueGetNativeHandle";
+  case UR_FUNCTION_QUEUE_CREATE_WITH_NATIVE_HANDLE:
+    return "urQueueCreateWithNativeHandle";
+  case UR_FUNCTION_QUEUE_FINISH:
+    return "urQueueFinish";
+  case UR_FUNCTION_QUEUE_FLUSH:
+    return "urQueueFlush";
+  case UR_FUNCTION_QUEUE_BEGIN_GRAPH_CAPTURE_EXP:
+    return "urQueueBeginGraphCaptureExp";
+  case UR_FUNCTION_QUEUE_BEGIN_CAPTURE_INTO_GRAPH_EXP:
+    return "urQueueBeginCaptureIntoGraphExp";
+  case UR_FUNCTION_QUEUE_END_GRAPH_CAPTURE_EXP:
+    return "urQueueEndGraphCaptureExp";
+  case UR_FUNCTION_QUEUE_IS_GRAPH_CAPTURE_ENABLED_EXP:
+    return "urQueueIsGraphCaptureEnabledExp";
+  case UR_FUNCTION_QUEUE_GET_GRAPH_EXP:
+    return "urQueueGetGraphExp";
+  case UR_FUNCTION_SAMPLER_CREATE:
+    return "urSamplerCreate";
+  case UR_FUNCTION_SAMPLER_RETAIN:
+    return "urSamplerRetain";
+  case UR_FUNCTION_SAMPLER_RELEASE:
+    return "urSamplerRelease";
+  case UR_FUNCTION_SAMPLER_GET_INFO:
+    return "urSamplerGetInfo";
+  case UR_FUNCTION_SAMPLER_GET_NATIVE_HANDLE:
+    return "urSamplerGetNativeHandle";
+  case UR_FUNCTION_SAMPLER_CREATE_WITH_NATIVE_HANDLE:
+    return "urSamplerCreateWithNativeHandle";
+  case UR_FUNCTION_USM_HOST_ALLOC:
+    return "urUSMHostAlloc";
+  case UR_FUNCTION_USM_DEVICE_ALLOC:
+    return "urUSMDeviceAlloc";
+  case UR_FUNCTION_USM_SHARED_ALLOC:
+    return "urUSMSharedAlloc";
+  case UR_FUNCTION_USM_FREE:
+    return "urUSMFree";
+  case UR_FUNCTION_USM_GET_MEM_ALLOC_INFO:
+    return "urUSMGetMemAllocInfo";
+  case UR_FUNCTION_USM_POOL_CREATE:
+    return "urUSMPoolCreate";
+  case UR_FUNCTION_USM_POOL_RETAIN:
+    return "urUSMPoolRetain";
+  case UR_FUNCTION_USM_POOL_RELEASE:
+    return "urUSMPoolRelease";
+  case UR_FUNCTION_USM_POOL_GET_INFO:
+    return "urUSMPoolGetInfo";
+  case UR_FUNCTION_USM_POOL_CREATE_EXP:
+    return "urUSMPoolCreateExp";
+  case UR_FUNCTION_USM_POOL_DESTROY_EXP:
+    return "urUSMPoolDestroyExp";
+  case UR_FUNCTION_USM_POOL_GET_DEFAULT_DEVICE_POOL_EXP:
+    return "urUSMPoolGetDefaultDevicePoolExp";
+  case UR_FUNCTION_USM_POOL_GET_INFO_EXP:
+    return "urUSMPoolGetInfoExp";
+  case UR_FUNCTION_USM_POOL_SET_INFO_EXP:
+    return "urUSMPoolSetInfoExp";
+  case UR_FUNCTION_USM_POOL_SET_DEVICE_POOL_EXP:
+    return "urUSMPoolSetDevicePoolExp";
+  case UR_FUNCTION_USM_POOL_GET_DEVICE_POOL_EXP:
+    return "urUSMPoolGetDevicePoolExp";
+  case UR_FUNCTION_USM_POOL_TRIM_TO_EXP:
+    return "urUSMPoolTrimToExp";
+  case UR_FUNCTION_USM_PITCHED_ALLOC_EXP:
+    return "urUSMPitchedAllocExp";
+  case UR_FUNCTION_USM_CONTEXT_MEMCPY_EXP:
+    return "urUSMContextMemcpyExp";
+  case UR_FUNCTION_USM_HOST_ALLOC_UNREGISTER_EXP:
+    return "urUSMHostAllocUnregisterExp";
+  case UR_FUNCTION_USM_HOST_ALLOC_REGISTER_EXP:
+    return "urUSMHostAllocRegisterExp";
+  case UR_FUNCTION_USM_IMPORT_EXP:
+    return "urUSMImportExp";
+  case UR_FUNCTION_USM_RELEASE_EXP:
+    return "urUSMReleaseExp";
+  case UR_FUNCTION_USM_P2P_ENABLE_PEER_ACCESS_EXP:
+    return "urUsmP2PEnablePeerAccessExp";
+  case UR_FUNCTION_USM_P2P_DISABLE_PEER_ACCESS_EXP:
+    return "urUsmP2PDisablePeerAccessExp";
+  case UR_FUNCTION_USM_P2P_PEER_ACCESS_GET_INFO_EXP:
+    return "urUsmP2PPeerAccessGetInfoExp";
+  case UR_FUNCTION_VIRTUAL_MEM_GRANULARITY_GET_INFO:
+    return "urVirtualMemGranularityGetInfo";
+  case UR_FUNCTION_VIRTUAL_MEM_RESERVE:
+    return "urVirtualMemReserve";
+  case UR_FUNCTION_VIRTUAL_MEM_FREE:
+    return "urVirtualMemFree";
+  case UR_FUNCTION_VIRTUAL_MEM_MAP:
+    return "urVirtualMemMap";
+  case UR_FUNCTION_VIRTUAL_MEM_UNMAP:
+    return "urVirtualMemUnmap";
+  case UR_FUNCTION_VIRTUAL_MEM_SET_ACCESS:
+    return "urVirtualMemSetAccess";
+  case UR_FUNCTION_VIRTUAL_MEM_GET_INFO:
+    return "urVirtualMemGetInfo";
+  case UR_FUNCTION_DEVICE_GET:
+    return "urDeviceGet";
+  case UR_FUNCTION_DEVICE_GET_SELECTED:
+    return "urDeviceGetSelected";
+  case UR_FUNCTION_DEVICE_GET_INFO:
+    return "urDeviceGetInfo";
+  case UR_FUNCTION_DEVICE_RETAIN:
+    return "urDeviceRetain";
+  case UR_FUNCTION_DEVICE_RELEASE:
+    return "urDeviceRelease";
+  case UR_FUNCTION_DEVICE_PARTITION:
+    return "urDevicePartition";
+  case UR_FUNCTION_DEVICE_SELECT_BINARY:
+    return "urDeviceSelectBinary";
+  case UR_FUNCTION_DEVICE_GET_NATIVE_HANDLE:
+    return "urDeviceGetNativeHandle";
+  case UR_FUNCTION_DEVICE_CREATE_WITH_NATIVE_HANDLE:
+    return "urDeviceCreateWithNativeHandle";
+  case UR_FUNCTION_DEVICE_GET_GLOBAL_TIMESTAMPS:
+    return "urDeviceGetGlobalTimestamps";
+  case UR_FUNCTION_DEVICE_WAIT_EXP:
+    return "urDeviceWaitExp";
+  default:
+    return nullptr;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+/// @brief Calls visitor(name, member) for each parameter of a function, in
+///        order, where member is the pointer to the member of the params
+///        struct of the function that points to the parameter.
+/// @returns false if the function is unknown.
+template <typename V>
+inline bool visitFunctionParams(ur_function_t function, V &&visitor) {
+  switch (function) {
+  case UR_FUNCTION_ADAPTER_GET: {
+    using P = ur_adapter_get_params_t;
+    visitor("NumEntries", &P::pNumEntries);
+    visitor("phAdapters", &P::pphAdapters);
+    visitor("pNumAdapters", &P::ppNumAdapters);
+  } break;
+  case UR_FUNCTION_ADAPTER_RELEASE: {
+    using P = ur_adapter_release_params_t;
+    visitor("hAdapter", &P::phAdapter);
+  } break;
+  case UR_FUNCTION_ADAPTER_RETAIN: {
+    using P = ur_adapter_retain_params_t;
+    visitor("hAdapter", &P::phAdapter);
+  } break;
+  case UR_FUNCTION_ADAPTER_GET_LAST_ERROR: {
+    using P = ur_adapter_get_last_error_params_t;
+    visitor("hAdapter", &P::phAdapter);
+    visitor("ppMessage", &P::pppMessage);
+    visitor("pError", &P::ppError);
+  } break;
+  case UR_FUNCTION_ADAPTER_GET_INFO: {
+    using P = ur_adapter_get_info_params_t;
+    visitor("hAdapter", &P::phAdapter);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_ADAPTER_SET_LOGGER_CALLBACK: {
+    using P = ur_adapter_set_logger_callback_params_t;
+    visitor("hAdapter", &P::phAdapter);
+    visitor("pfnLoggerCallback", &P::ppfnLoggerCallback);
+    visitor("pUserData", &P::ppUserData);
+    visitor("level", &P::plevel);
+  } break;
+  case UR_FUNCTION_ADAPTER_SET_LOGGER_CALLBACK_LEVEL: {
+    using P = ur_adapter_set_logger_callback_level_params_t;
+    visitor("hAdapter", &P::phAdapter);
+    visitor("level", &P::plevel);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_UNSAMPLED_IMAGE_HANDLE_DESTROY_EXP: {
+    using P = ur_bindless_images_unsampled_image_handle_destroy_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hImage", &P::phImage);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_SAMPLED_IMAGE_HANDLE_DESTROY_EXP: {
+    using P = ur_bindless_images_sampled_image_handle_destroy_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hImage", &P::phImage);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_IMAGE_ALLOCATE_EXP: {
+    using P = ur_bindless_images_image_allocate_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("phImageMem", &P::pphImageMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_IMAGE_FREE_EXP: {
+    using P = ur_bindless_images_image_free_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hImageMem", &P::phImageMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_UNSAMPLED_IMAGE_CREATE_EXP: {
+    using P = ur_bindless_images_unsampled_image_create_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hImageMem", &P::phImageMem);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("phImage", &P::pphImage);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_SAMPLED_IMAGE_CREATE_EXP: {
+    using P = ur_bindless_images_sampled_image_create_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hImageMem", &P::phImageMem);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("pSamplerDesc", &P::ppSamplerDesc);
+    visitor("phImage", &P::pphImage);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_IMAGE_COPY_EXP: {
+    using P = ur_bindless_images_image_copy_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pSrc", &P::ppSrc);
+    visitor("pDst", &P::ppDst);
+    visitor("pSrcImageDesc", &P::ppSrcImageDesc);
+    visitor("pDstImageDesc", &P::ppDstImageDesc);
+    visitor("pSrcImageFormat", &P::ppSrcImageFormat);
+    visitor("pDstImageFormat", &P::ppDstImageFormat);
+    visitor("pCopyRegion", &P::ppCopyRegion);
+    visitor("imageCopyFlags", &P::pimageCopyFlags);
+    visitor("imageCopyInputTypes", &P::pimageCopyInputTypes);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_IMAGE_GET_INFO_EXP: {
+    using P = ur_bindless_images_image_get_info_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hImageMem", &P::phImageMem);
+    visitor("propName", &P::ppropName);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_GET_IMAGE_MEMORY_HANDLE_TYPE_SUPPORT_EXP: {
+    using P =
+        ur_bindless_images_get_image_memory_handle_type_support_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("imageMemHandleType", &P::pimageMemHandleType);
+    visitor("pSupportedRet", &P::ppSupportedRet);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_GET_IMAGE_UNSAMPLED_HANDLE_SUPPORT_EXP: {
+    using P =
+        ur_bindless_images_get_image_unsampled_handle_support_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("imageMemHandleType", &P::pimageMemHandleType);
+    visitor("pSupportedRet", &P::ppSupportedRet);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_GET_IMAGE_SAMPLED_HANDLE_SUPPORT_EXP: {
+    using P = ur_bindless_images_get_image_sampled_handle_support_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("imageMemHandleType", &P::pimageMemHandleType);
+    visitor("pSupportedRet", &P::ppSupportedRet);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_MIPMAP_GET_LEVEL_EXP: {
+    using P = ur_bindless_images_mipmap_get_level_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hImageMem", &P::phImageMem);
+    visitor("mipmapLevel", &P::pmipmapLevel);
+    visitor("phImageMem", &P::pphImageMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_MIPMAP_FREE_EXP: {
+    using P = ur_bindless_images_mipmap_free_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hMem", &P::phMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_IMPORT_EXTERNAL_MEMORY_EXP: {
+    using P = ur_bindless_images_import_external_memory_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("size", &P::psize);
+    visitor("memHandleType", &P::pmemHandleType);
+    visitor("pExternalMemDesc", &P::ppExternalMemDesc);
+    visitor("phExternalMem", &P::pphExternalMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_MAP_EXTERNAL_ARRAY_EXP: {
+    using P = ur_bindless_images_map_external_array_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("hExternalMem", &P::phExternalMem);
+    visitor("phImageMem", &P::pphImageMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_MAP_EXTERNAL_LINEAR_MEMORY_EXP: {
+    using P = ur_bindless_images_map_external_linear_memory_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("offset", &P::poffset);
+    visitor("size", &P::psize);
+    visitor("hExternalMem", &P::phExternalMem);
+    visitor("ppRetMem", &P::pppRetMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_RELEASE_EXTERNAL_MEMORY_EXP: {
+    using P = ur_bindless_images_release_external_memory_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hExternalMem", &P::phExternalMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_FREE_MAPPED_LINEAR_MEMORY_EXP: {
+    using P = ur_bindless_images_free_mapped_linear_memory_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pMem", &P::ppMem);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_SUPPORTS_IMPORTING_HANDLE_TYPE_EXP: {
+    using P = ur_bindless_images_supports_importing_handle_type_exp_params_t;
+    visitor("hDevice", &P::phDevice);
+    visitor("memHandleType", &P::pmemHandleType);
+    visitor("pSupportedRet", &P::ppSupportedRet);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_IMPORT_EXTERNAL_SEMAPHORE_EXP: {
+    using P = ur_bindless_images_import_external_semaphore_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("semHandleType", &P::psemHandleType);
+    visitor("pExternalSemaphoreDesc", &P::ppExternalSemaphoreDesc);
+    visitor("phExternalSemaphore", &P::pphExternalSemaphore);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_RELEASE_EXTERNAL_SEMAPHORE_EXP: {
+    using P = ur_bindless_images_release_external_semaphore_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hExternalSemaphore", &P::phExternalSemaphore);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_WAIT_EXTERNAL_SEMAPHORE_EXP: {
+    using P = ur_bindless_images_wait_external_semaphore_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hSemaphore", &P::phSemaphore);
+    visitor("hasWaitValue", &P::phasWaitValue);
+    visitor("waitValue", &P::pwaitValue);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_BINDLESS_IMAGES_SIGNAL_EXTERNAL_SEMAPHORE_EXP: {
+    using P = ur_bindless_images_signal_external_semaphore_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hSemaphore", &P::phSemaphore);
+    visitor("hasSignalValue", &P::phasSignalValue);
+    visitor("signalValue", &P::psignalValue);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_CREATE_EXP: {
+    using P = ur_command_buffer_create_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pCommandBufferDesc", &P::ppCommandBufferDesc);
+    visitor("phCommandBuffer", &P::pphCommandBuffer);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_RETAIN_EXP: {
+    using P = ur_command_buffer_retain_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_RELEASE_EXP: {
+    using P = ur_command_buffer_release_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_FINALIZE_EXP: {
+    using P = ur_command_buffer_finalize_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_KERNEL_LAUNCH_EXP: {
+    using P = ur_command_buffer_append_kernel_launch_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hKernel", &P::phKernel);
+    visitor("workDim", &P::pworkDim);
+    visitor("pGlobalWorkOffset", &P::ppGlobalWorkOffset);
+    visitor("pGlobalWorkSize", &P::ppGlobalWorkSize);
+    visitor("pLocalWorkSize", &P::ppLocalWorkSize);
+    visitor("numKernelAlternatives", &P::pnumKernelAlternatives);
+    visitor("phKernelAlternatives", &P::pphKernelAlternatives);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_KERNEL_LAUNCH_WITH_ARGS_EXP: {
+    using P = ur_command_buffer_append_kernel_launch_with_args_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hKernel", &P::phKernel);
+    visitor("workDim", &P::pworkDim);
+    visitor("pGlobalWorkOffset", &P::ppGlobalWorkOffset);
+    visitor("pGlobalWorkSize", &P::ppGlobalWorkSize);
+    visitor("pLocalWorkSize", &P::ppLocalWorkSize);
+    visitor("numArgs", &P::pnumArgs);
+    visitor("pArgs", &P::ppArgs);
+    visitor("numKernelAlternatives", &P::pnumKernelAlternatives);
+    visitor("phKernelAlternatives", &P::pphKernelAlternatives);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_USM_MEMCPY_EXP: {
+    using P = ur_command_buffer_append_usm_memcpy_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("pDst", &P::ppDst);
+    visitor("pSrc", &P::ppSrc);
+    visitor("size", &P::psize);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_USM_FILL_EXP: {
+    using P = ur_command_buffer_append_usm_fill_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("pMemory", &P::ppMemory);
+    visitor("pPattern", &P::ppPattern);
+    visitor("patternSize", &P::ppatternSize);
+    visitor("size", &P::psize);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_COPY_EXP: {
+    using P = ur_command_buffer_append_mem_buffer_copy_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hSrcMem", &P::phSrcMem);
+    visitor("hDstMem", &P::phDstMem);
+    visitor("srcOffset", &P::psrcOffset);
+    visitor("dstOffset", &P::pdstOffset);
+    visitor("size", &P::psize);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_WRITE_EXP: {
+    using P = ur_command_buffer_append_mem_buffer_write_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("offset", &P::poffset);
+    visitor("size", &P::psize);
+    visitor("pSrc", &P::ppSrc);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_READ_EXP: {
+    using P = ur_command_buffer_append_mem_buffer_read_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("offset", &P::poffset);
+    visitor("size", &P::psize);
+    visitor("pDst", &P::ppDst);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_COPY_RECT_EXP: {
+    using P = ur_command_buffer_append_mem_buffer_copy_rect_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hSrcMem", &P::phSrcMem);
+    visitor("hDstMem", &P::phDstMem);
+    visitor("srcOrigin", &P::psrcOrigin);
+    visitor("dstOrigin", &P::pdstOrigin);
+    visitor("region", &P::pregion);
+    visitor("srcRowPitch", &P::psrcRowPitch);
+    visitor("srcSlicePitch", &P::psrcSlicePitch);
+    visitor("dstRowPitch", &P::pdstRowPitch);
+    visitor("dstSlicePitch", &P::pdstSlicePitch);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_WRITE_RECT_EXP: {
+    using P = ur_command_buffer_append_mem_buffer_write_rect_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("bufferOffset", &P::pbufferOffset);
+    visitor("hostOffset", &P::phostOffset);
+    visitor("region", &P::pregion);
+    visitor("bufferRowPitch", &P::pbufferRowPitch);
+    visitor("bufferSlicePitch", &P::pbufferSlicePitch);
+    visitor("hostRowPitch", &P::phostRowPitch);
+    visitor("hostSlicePitch", &P::phostSlicePitch);
+    visitor("pSrc", &P::ppSrc);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_READ_RECT_EXP: {
+    using P = ur_command_buffer_append_mem_buffer_read_rect_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("bufferOffset", &P::pbufferOffset);
+    visitor("hostOffset", &P::phostOffset);
+    visitor("region", &P::pregion);
+    visitor("bufferRowPitch", &P::pbufferRowPitch);
+    visitor("bufferSlicePitch", &P::pbufferSlicePitch);
+    visitor("hostRowPitch", &P::phostRowPitch);
+    visitor("hostSlicePitch", &P::phostSlicePitch);
+    visitor("pDst", &P::ppDst);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_MEM_BUFFER_FILL_EXP: {
+    using P = ur_command_buffer_append_mem_buffer_fill_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("pPattern", &P::ppPattern);
+    visitor("patternSize", &P::ppatternSize);
+    visitor("offset", &P::poffset);
+    visitor("size", &P::psize);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_USM_PREFETCH_EXP: {
+    using P = ur_command_buffer_append_usm_prefetch_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("pMemory", &P::ppMemory);
+    visitor("size", &P::psize);
+    visitor("flags", &P::pflags);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_USM_ADVISE_EXP: {
+    using P = ur_command_buffer_append_usm_advise_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("pMemory", &P::ppMemory);
+    visitor("size", &P::psize);
+    visitor("advice", &P::padvice);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+    visitor("phEvent", &P::pphEvent);
+    visitor("phCommand", &P::pphCommand);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_APPEND_NATIVE_COMMAND_EXP: {
+    using P = ur_command_buffer_append_native_command_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("pfnNativeCommand", &P::ppfnNativeCommand);
+    visitor("pData", &P::ppData);
+    visitor("hChildCommandBuffer", &P::phChildCommandBuffer);
+    visitor("numSyncPointsInWaitList", &P::pnumSyncPointsInWaitList);
+    visitor("pSyncPointWaitList", &P::ppSyncPointWaitList);
+    visitor("pSyncPoint", &P::ppSyncPoint);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_UPDATE_KERNEL_LAUNCH_EXP: {
+    using P = ur_command_buffer_update_kernel_launch_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("numKernelUpdates", &P::pnumKernelUpdates);
+    visitor("pUpdateKernelLaunch", &P::ppUpdateKernelLaunch);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_UPDATE_SIGNAL_EVENT_EXP: {
+    using P = ur_command_buffer_update_signal_event_exp_params_t;
+    visitor("hCommand", &P::phCommand);
+    visitor("phSignalEvent", &P::pphSignalEvent);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_UPDATE_WAIT_EVENTS_EXP: {
+    using P = ur_command_buffer_update_wait_events_exp_params_t;
+    visitor("hCommand", &P::phCommand);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_GET_INFO_EXP: {
+    using P = ur_command_buffer_get_info_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_COMMAND_BUFFER_GET_NATIVE_HANDLE_EXP: {
+    using P = ur_command_buffer_get_native_handle_exp_params_t;
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("phNativeCommandBuffer", &P::pphNativeCommandBuffer);
+  } break;
+  case UR_FUNCTION_CONTEXT_CREATE: {
+    using P = ur_context_create_params_t;
+    visitor("DeviceCount", &P::pDeviceCount);
+    visitor("phDevices", &P::pphDevices);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phContext", &P::pphContext);
+  } break;
+  case UR_FUNCTION_CONTEXT_RETAIN: {
+    using P = ur_context_retain_params_t;
+    visitor("hContext", &P::phContext);
+  } break;
+  case UR_FUNCTION_CONTEXT_RELEASE: {
+    using P = ur_context_release_params_t;
+    visitor("hContext", &P::phContext);
+  } break;
+  case UR_FUNCTION_CONTEXT_GET_INFO: {
+    using P = ur_context_get_info_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_CONTEXT_GET_NATIVE_HANDLE: {
+    using P = ur_context_get_native_handle_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("phNativeContext", &P::pphNativeContext);
+  } break;
+  case UR_FUNCTION_CONTEXT_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_context_create_with_native_handle_params_t;
+    visitor("hNativeContext", &P::phNativeContext);
+    visitor("hAdapter", &P::phAdapter);
+    visitor("numDevices", &P::pnumDevices);
+    visitor("phDevices", &P::pphDevices);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phContext", &P::pphContext);
+  } break;
+  case UR_FUNCTION_CONTEXT_SET_EXTENDED_DELETER: {
+    using P = ur_context_set_extended_deleter_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pfnDeleter", &P::ppfnDeleter);
+    visitor("pUserData", &P::ppUserData);
+  } break;
+  case UR_FUNCTION_ENQUEUE_EVENTS_WAIT: {
+    using P = ur_enqueue_events_wait_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_EVENTS_WAIT_WITH_BARRIER: {
+    using P = ur_enqueue_events_wait_with_barrier_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_READ: {
+    using P = ur_enqueue_mem_buffer_read_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("blockingRead", &P::pblockingRead);
+    visitor("offset", &P::poffset);
+    visitor("size", &P::psize);
+    visitor("pDst", &P::ppDst);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_WRITE: {
+    using P = ur_enqueue_mem_buffer_write_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("blockingWrite", &P::pblockingWrite);
+    visitor("offset", &P::poffset);
+    visitor("size", &P::psize);
+    visitor("pSrc", &P::ppSrc);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_READ_RECT: {
+    using P = ur_enqueue_mem_buffer_read_rect_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("blockingRead", &P::pblockingRead);
+    visitor("bufferOrigin", &P::pbufferOrigin);
+    visitor("hostOrigin", &P::phostOrigin);
+    visitor("region", &P::pregion);
+    visitor("bufferRowPitch", &P::pbufferRowPitch);
+    visitor("bufferSlicePitch", &P::pbufferSlicePitch);
+    visitor("hostRowPitch", &P::phostRowPitch);
+    visitor("hostSlicePitch", &P::phostSlicePitch);
+    visitor("pDst", &P::ppDst);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_WRITE_RECT: {
+    using P = ur_enqueue_mem_buffer_write_rect_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("blockingWrite", &P::pblockingWrite);
+    visitor("bufferOrigin", &P::pbufferOrigin);
+    visitor("hostOrigin", &P::phostOrigin);
+    visitor("region", &P::pregion);
+    visitor("bufferRowPitch", &P::pbufferRowPitch);
+    visitor("bufferSlicePitch", &P::pbufferSlicePitch);
+    visitor("hostRowPitch", &P::phostRowPitch);
+    visitor("hostSlicePitch", &P::phostSlicePitch);
+    visitor("pSrc", &P::ppSrc);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_COPY: {
+    using P = ur_enqueue_mem_buffer_copy_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hBufferSrc", &P::phBufferSrc);
+    visitor("hBufferDst", &P::phBufferDst);
+    visitor("srcOffset", &P::psrcOffset);
+    visitor("dstOffset", &P::pdstOffset);
+    visitor("size", &P::psize);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_COPY_RECT: {
+    using P = ur_enqueue_mem_buffer_copy_rect_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hBufferSrc", &P::phBufferSrc);
+    visitor("hBufferDst", &P::phBufferDst);
+    visitor("srcOrigin", &P::psrcOrigin);
+    visitor("dstOrigin", &P::pdstOrigin);
+    visitor("region", &P::pregion);
+    visitor("srcRowPitch", &P::psrcRowPitch);
+    visitor("srcSlicePitch", &P::psrcSlicePitch);
+    visitor("dstRowPitch", &P::pdstRowPitch);
+    visitor("dstSlicePitch", &P::pdstSlicePitch);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_FILL: {
+    using P = ur_enqueue_mem_buffer_fill_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("pPattern", &P::ppPattern);
+    visitor("patternSize", &P::ppatternSize);
+    visitor("offset", &P::poffset);
+    visitor("size", &P::psize);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_IMAGE_READ: {
+    using P = ur_enqueue_mem_image_read_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hImage", &P::phImage);
+    visitor("blockingRead", &P::pblockingRead);
+    visitor("origin", &P::porigin);
+    visitor("region", &P::pregion);
+    visitor("rowPitch", &P::prowPitch);
+    visitor("slicePitch", &P::pslicePitch);
+    visitor("pDst", &P::ppDst);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_IMAGE_WRITE: {
+    using P = ur_enqueue_mem_image_write_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hImage", &P::phImage);
+    visitor("blockingWrite", &P::pblockingWrite);
+    visitor("origin", &P::porigin);
+    visitor("region", &P::pregion);
+    visitor("rowPitch", &P::prowPitch);
+    visitor("slicePitch", &P::pslicePitch);
+    visitor("pSrc", &P::ppSrc);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_IMAGE_COPY: {
+    using P = ur_enqueue_mem_image_copy_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hImageSrc", &P::phImageSrc);
+    visitor("hImageDst", &P::phImageDst);
+    visitor("srcOrigin", &P::psrcOrigin);
+    visitor("dstOrigin", &P::pdstOrigin);
+    visitor("region", &P::pregion);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_BUFFER_MAP: {
+    using P = ur_enqueue_mem_buffer_map_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hBuffer", &P::phBuffer);
+    visitor("blockingMap", &P::pblockingMap);
+    visitor("mapFlags", &P::pmapFlags);
+    visitor("offset", &P::poffset);
+    visitor("size", &P::psize);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+    visitor("ppRetMap", &P::pppRetMap);
+  } break;
+  case UR_FUNCTION_ENQUEUE_MEM_UNMAP: {
+    using P = ur_enqueue_mem_unmap_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hMem", &P::phMem);
+    visitor("pMappedPtr", &P::ppMappedPtr);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_FILL: {
+    using P = ur_enqueue_usm_fill_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pMem", &P::ppMem);
+    visitor("patternSize", &P::ppatternSize);
+    visitor("pPattern", &P::ppPattern);
+    visitor("size", &P::psize);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_MEMCPY: {
+    using P = ur_enqueue_usm_memcpy_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("blocking", &P::pblocking);
+    visitor("pDst", &P::ppDst);
+    visitor("pSrc", &P::ppSrc);
+    visitor("size", &P::psize);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_PREFETCH: {
+    using P = ur_enqueue_usm_prefetch_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pMem", &P::ppMem);
+    visitor("size", &P::psize);
+    visitor("flags", &P::pflags);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_ADVISE: {
+    using P = ur_enqueue_usm_advise_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pMem", &P::ppMem);
+    visitor("size", &P::psize);
+    visitor("advice", &P::padvice);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_FILL_2D: {
+    using P = ur_enqueue_usm_fill_2d_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pMem", &P::ppMem);
+    visitor("pitch", &P::ppitch);
+    visitor("patternSize", &P::ppatternSize);
+    visitor("pPattern", &P::ppPattern);
+    visitor("width", &P::pwidth);
+    visitor("height", &P::pheight);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_MEMCPY_2D: {
+    using P = ur_enqueue_usm_memcpy_2d_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("blocking", &P::pblocking);
+    visitor("pDst", &P::ppDst);
+    visitor("dstPitch", &P::pdstPitch);
+    visitor("pSrc", &P::ppSrc);
+    visitor("srcPitch", &P::psrcPitch);
+    visitor("width", &P::pwidth);
+    visitor("height", &P::pheight);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_DEVICE_GLOBAL_VARIABLE_WRITE: {
+    using P = ur_enqueue_device_global_variable_write_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hProgram", &P::phProgram);
+    visitor("name", &P::pname);
+    visitor("blockingWrite", &P::pblockingWrite);
+    visitor("count", &P::pcount);
+    visitor("offset", &P::poffset);
+    visitor("pSrc", &P::ppSrc);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_DEVICE_GLOBAL_VARIABLE_READ: {
+    using P = ur_enqueue_device_global_variable_read_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hProgram", &P::phProgram);
+    visitor("name", &P::pname);
+    visitor("blockingRead", &P::pblockingRead);
+    visitor("count", &P::pcount);
+    visitor("offset", &P::poffset);
+    visitor("pDst", &P::ppDst);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_READ_HOST_PIPE: {
+    using P = ur_enqueue_read_host_pipe_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hProgram", &P::phProgram);
+    visitor("pipe_symbol", &P::ppipe_symbol);
+    visitor("blocking", &P::pblocking);
+    visitor("pDst", &P::ppDst);
+    visitor("size", &P::psize);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_WRITE_HOST_PIPE: {
+    using P = ur_enqueue_write_host_pipe_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hProgram", &P::phProgram);
+    visitor("pipe_symbol", &P::ppipe_symbol);
+    visitor("blocking", &P::pblocking);
+    visitor("pSrc", &P::ppSrc);
+    visitor("size", &P::psize);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_KERNEL_LAUNCH_WITH_ARGS_EXP: {
+    using P = ur_enqueue_kernel_launch_with_args_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hKernel", &P::phKernel);
+    visitor("workDim", &P::pworkDim);
+    visitor("pGlobalWorkOffset", &P::ppGlobalWorkOffset);
+    visitor("pGlobalWorkSize", &P::ppGlobalWorkSize);
+    visitor("pLocalWorkSize", &P::ppLocalWorkSize);
+    visitor("numArgs", &P::pnumArgs);
+    visitor("pArgs", &P::ppArgs);
+    visitor("launchPropList", &P::plaunchPropList);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_EVENTS_WAIT_WITH_BARRIER_EXT: {
+    using P = ur_enqueue_events_wait_with_barrier_ext_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pProperties", &P::ppProperties);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_DEVICE_ALLOC_EXP: {
+    using P = ur_enqueue_usm_device_alloc_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pPool", &P::ppPool);
+    visitor("size", &P::psize);
+    visitor("pProperties", &P::ppProperties);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("ppMem", &P::pppMem);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_SHARED_ALLOC_EXP: {
+    using P = ur_enqueue_usm_shared_alloc_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pPool", &P::ppPool);
+    visitor("size", &P::psize);
+    visitor("pProperties", &P::ppProperties);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("ppMem", &P::pppMem);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_HOST_ALLOC_EXP: {
+    using P = ur_enqueue_usm_host_alloc_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pPool", &P::ppPool);
+    visitor("size", &P::psize);
+    visitor("pProperties", &P::ppProperties);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("ppMem", &P::pppMem);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_USM_FREE_EXP: {
+    using P = ur_enqueue_usm_free_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pPool", &P::ppPool);
+    visitor("pMem", &P::ppMem);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_TIMESTAMP_RECORDING_EXP: {
+    using P = ur_enqueue_timestamp_recording_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("blocking", &P::pblocking);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_COMMAND_BUFFER_EXP: {
+    using P = ur_enqueue_command_buffer_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hCommandBuffer", &P::phCommandBuffer);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_HOST_TASK_EXP: {
+    using P = ur_enqueue_host_task_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pfnHostTask", &P::ppfnHostTask);
+    visitor("data", &P::pdata);
+    visitor("pProperties", &P::ppProperties);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_NATIVE_COMMAND_EXP: {
+    using P = ur_enqueue_native_command_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pfnNativeEnqueue", &P::ppfnNativeEnqueue);
+    visitor("data", &P::pdata);
+    visitor("numMemsInMemList", &P::pnumMemsInMemList);
+    visitor("phMemList", &P::pphMemList);
+    visitor("pProperties", &P::ppProperties);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_ENQUEUE_GRAPH_EXP: {
+    using P = ur_enqueue_graph_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hGraph", &P::phGraph);
+    visitor("numEventsInWaitList", &P::pnumEventsInWaitList);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_EVENT_GET_INFO: {
+    using P = ur_event_get_info_params_t;
+    visitor("hEvent", &P::phEvent);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_EVENT_GET_PROFILING_INFO: {
+    using P = ur_event_get_profiling_info_params_t;
+    visitor("hEvent", &P::phEvent);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_EVENT_WAIT: {
+    using P = ur_event_wait_params_t;
+    visitor("numEvents", &P::pnumEvents);
+    visitor("phEventWaitList", &P::pphEventWaitList);
+  } break;
+  case UR_FUNCTION_EVENT_RETAIN: {
+    using P = ur_event_retain_params_t;
+    visitor("hEvent", &P::phEvent);
+  } break;
+  case UR_FUNCTION_EVENT_RELEASE: {
+    using P = ur_event_release_params_t;
+    visitor("hEvent", &P::phEvent);
+  } break;
+  case UR_FUNCTION_EVENT_GET_NATIVE_HANDLE: {
+    using P = ur_event_get_native_handle_params_t;
+    visitor("hEvent", &P::phEvent);
+    visitor("phNativeEvent", &P::pphNativeEvent);
+  } break;
+  case UR_FUNCTION_EVENT_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_event_create_with_native_handle_params_t;
+    visitor("hNativeEvent", &P::phNativeEvent);
+    visitor("hContext", &P::phContext);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_EVENT_SET_CALLBACK: {
+    using P = ur_event_set_callback_params_t;
+    visitor("hEvent", &P::phEvent);
+    visitor("execStatus", &P::pexecStatus);
+    visitor("pfnNotify", &P::ppfnNotify);
+    visitor("pUserData", &P::ppUserData);
+  } break;
+  case UR_FUNCTION_EVENT_CREATE_EXP: {
+    using P = ur_event_create_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pEventDesc", &P::ppEventDesc);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_GRAPH_CREATE_EXP: {
+    using P = ur_graph_create_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("phGraph", &P::pphGraph);
+  } break;
+  case UR_FUNCTION_GRAPH_INSTANTIATE_GRAPH_EXP: {
+    using P = ur_graph_instantiate_graph_exp_params_t;
+    visitor("hGraph", &P::phGraph);
+    visitor("phExecGraph", &P::pphExecGraph);
+  } break;
+  case UR_FUNCTION_GRAPH_DESTROY_EXP: {
+    using P = ur_graph_destroy_exp_params_t;
+    visitor("hGraph", &P::phGraph);
+  } break;
+  case UR_FUNCTION_GRAPH_EXECUTABLE_GRAPH_DESTROY_EXP: {
+    using P = ur_graph_executable_graph_destroy_exp_params_t;
+    visitor("hExecutableGraph", &P::phExecutableGraph);
+  } break;
+  case UR_FUNCTION_GRAPH_IS_EMPTY_EXP: {
+    using P = ur_graph_is_empty_exp_params_t;
+    visitor("hGraph", &P::phGraph);
+    visitor("pResult", &P::ppResult);
+  } break;
+  case UR_FUNCTION_GRAPH_GET_ID_EXP: {
+    using P = ur_graph_get_id_exp_params_t;
+    visitor("hGraph", &P::phGraph);
+    visitor("pGraphId", &P::ppGraphId);
+  } break;
+  case UR_FUNCTION_GRAPH_SET_DESTRUCTION_CALLBACK_EXP: {
+    using P = ur_graph_set_destruction_callback_exp_params_t;
+    visitor("hGraph", &P::phGraph);
+    visitor("pfnCallback", &P::ppfnCallback);
+    visitor("pUserData", &P::ppUserData);
+  } break;
+  case UR_FUNCTION_GRAPH_DUMP_CONTENTS_EXP: {
+    using P = ur_graph_dump_contents_exp_params_t;
+    visitor("hGraph", &P::phGraph);
+    visitor("filePath", &P::pfilePath);
+  } break;
+  case UR_FUNCTION_GRAPH_GET_NATIVE_HANDLE_EXP: {
+    using P = ur_graph_get_native_handle_exp_params_t;
+    visitor("hGraph", &P::phGraph);
+    visitor("phNativeGraph", &P::pphNativeGraph);
+  } break;
+  case UR_FUNCTION_GRAPH_EXECUTABLE_GRAPH_GET_NATIVE_HANDLE_EXP: {
+    using P = ur_graph_executable_graph_get_native_handle_exp_params_t;
+    visitor("hExecutableGraph", &P::phExecutableGraph);
+    visitor("phNativeExecutableGraph", &P::pphNativeExecutableGraph);
+  } break;
+  case UR_FUNCTION_IPC_GET_MEM_HANDLE_EXP: {
+    using P = ur_ipc_get_mem_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pMem", &P::ppMem);
+    visitor("ppIPCMemHandleData", &P::pppIPCMemHandleData);
+    visitor("pIPCMemHandleDataSizeRet", &P::ppIPCMemHandleDataSizeRet);
+  } break;
+  case UR_FUNCTION_IPC_PUT_MEM_HANDLE_EXP: {
+    using P = ur_ipc_put_mem_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pIPCMemHandleData", &P::ppIPCMemHandleData);
+  } break;
+  case UR_FUNCTION_IPC_OPEN_MEM_HANDLE_EXP: {
+    using P = ur_ipc_open_mem_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pIPCMemHandleData", &P::ppIPCMemHandleData);
+    visitor("ipcMemHandleDataSize", &P::pipcMemHandleDataSize);
+    visitor("ppMem", &P::pppMem);
+  } break;
+  case UR_FUNCTION_IPC_CLOSE_MEM_HANDLE_EXP: {
+    using P = ur_ipc_close_mem_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pMem", &P::ppMem);
+  } break;
+  case UR_FUNCTION_IPC_GET_PHYS_MEM_HANDLE_EXP: {
+    using P = ur_ipc_get_phys_mem_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hPhysMem", &P::phPhysMem);
+    visitor("ppIPCPhysMemHandleData", &P::pppIPCPhysMemHandleData);
+    visitor("pIPCPhysMemHandleDataSizeRet", &P::ppIPCPhysMemHandleDataSizeRet);
+  } break;
+  case UR_FUNCTION_IPC_PUT_PHYS_MEM_HANDLE_EXP: {
+    using P = ur_ipc_put_phys_mem_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pIPCPhysMemHandleData", &P::ppIPCPhysMemHandleData);
+  } break;
+  case UR_FUNCTION_IPC_OPEN_PHYS_MEM_HANDLE_EXP: {
+    using P = ur_ipc_open_phys_mem_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pIPCPhysMemHandleData", &P::ppIPCPhysMemHandleData);
+    visitor("ipcPhysMemHandleDataSize", &P::pipcPhysMemHandleDataSize);
+    visitor("phPhysMem", &P::pphPhysMem);
+  } break;
+  case UR_FUNCTION_IPC_CLOSE_PHYS_MEM_HANDLE_EXP: {
+    using P = ur_ipc_close_phys_mem_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hPhysMem", &P::phPhysMem);
+  } break;
+  case UR_FUNCTION_IPC_GET_EVENT_HANDLE_EXP: {
+    using P = ur_ipc_get_event_handle_exp_params_t;
+    visitor("hEvent", &P::phEvent);
+    visitor("ppIPCEventHandleData", &P::pppIPCEventHandleData);
+    visitor("pIPCEventHandleDataSizeRet", &P::ppIPCEventHandleDataSizeRet);
+  } break;
+  case UR_FUNCTION_IPC_PUT_EVENT_HANDLE_EXP: {
+    using P = ur_ipc_put_event_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pIPCEventHandleData", &P::ppIPCEventHandleData);
+  } break;
+  case UR_FUNCTION_IPC_OPEN_EVENT_HANDLE_EXP: {
+    using P = ur_ipc_open_event_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pIPCEventHandleData", &P::ppIPCEventHandleData);
+    visitor("ipcEventHandleDataSize", &P::pipcEventHandleDataSize);
+    visitor("phEvent", &P::pphEvent);
+  } break;
+  case UR_FUNCTION_KERNEL_CREATE: {
+    using P = ur_kernel_create_params_t;
+    visitor("hProgram", &P::phProgram);
+    visitor("pKernelName", &P::ppKernelName);
+    visitor("phKernel", &P::pphKernel);
+  } break;
+  case UR_FUNCTION_KERNEL_GET_INFO: {
+    using P = ur_kernel_get_info_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_KERNEL_GET_GROUP_INFO: {
+    using P = ur_kernel_get_group_info_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("hDevice", &P::phDevice);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_KERNEL_GET_SUB_GROUP_INFO: {
+    using P = ur_kernel_get_sub_group_info_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("hDevice", &P::phDevice);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_KERNEL_RETAIN: {
+    using P = ur_kernel_retain_params_t;
+    visitor("hKernel", &P::phKernel);
+  } break;
+  case UR_FUNCTION_KERNEL_RELEASE: {
+    using P = ur_kernel_release_params_t;
+    visitor("hKernel", &P::phKernel);
+  } break;
+  case UR_FUNCTION_KERNEL_GET_NATIVE_HANDLE: {
+    using P = ur_kernel_get_native_handle_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("phNativeKernel", &P::pphNativeKernel);
+  } break;
+  case UR_FUNCTION_KERNEL_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_kernel_create_with_native_handle_params_t;
+    visitor("hNativeKernel", &P::phNativeKernel);
+    visitor("hContext", &P::phContext);
+    visitor("hProgram", &P::phProgram);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phKernel", &P::pphKernel);
+  } break;
+  case UR_FUNCTION_KERNEL_GET_SUGGESTED_LOCAL_WORK_SIZE: {
+    using P = ur_kernel_get_suggested_local_work_size_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("hQueue", &P::phQueue);
+    visitor("numWorkDim", &P::pnumWorkDim);
+    visitor("pGlobalWorkOffset", &P::ppGlobalWorkOffset);
+    visitor("pGlobalWorkSize", &P::ppGlobalWorkSize);
+    visitor("pSuggestedLocalWorkSize", &P::ppSuggestedLocalWorkSize);
+  } break;
+  case UR_FUNCTION_KERNEL_GET_SUGGESTED_LOCAL_WORK_SIZE_WITH_ARGS: {
+    using P = ur_kernel_get_suggested_local_work_size_with_args_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("hQueue", &P::phQueue);
+    visitor("numWorkDim", &P::pnumWorkDim);
+    visitor("pGlobalWorkOffset", &P::ppGlobalWorkOffset);
+    visitor("pGlobalWorkSize", &P::ppGlobalWorkSize);
+    visitor("numArgs", &P::pnumArgs);
+    visitor("pArgs", &P::ppArgs);
+    visitor("pSuggestedLocalWorkSize", &P::ppSuggestedLocalWorkSize);
+  } break;
+  case UR_FUNCTION_KERNEL_SET_EXEC_INFO: {
+    using P = ur_kernel_set_exec_info_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pProperties", &P::ppProperties);
+    visitor("pPropValue", &P::ppPropValue);
+  } break;
+  case UR_FUNCTION_KERNEL_SET_SPECIALIZATION_CONSTANTS: {
+    using P = ur_kernel_set_specialization_constants_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("count", &P::pcount);
+    visitor("pSpecConstants", &P::ppSpecConstants);
+  } break;
+  case UR_FUNCTION_KERNEL_SUGGEST_MAX_COOPERATIVE_GROUP_COUNT: {
+    using P = ur_kernel_suggest_max_cooperative_group_count_params_t;
+    visitor("hKernel", &P::phKernel);
+    visitor("hDevice", &P::phDevice);
+    visitor("workDim", &P::pworkDim);
+    visitor("pLocalWorkSize", &P::ppLocalWorkSize);
+    visitor("dynamicSharedMemorySize", &P::pdynamicSharedMemorySize);
+    visitor("pGroupCountRet", &P::ppGroupCountRet);
+  } break;
+  case UR_FUNCTION_LOADER_INIT: {
+    using P = ur_loader_init_params_t;
+    visitor("device_flags", &P::pdevice_flags);
+    visitor("hLoaderConfig", &P::phLoaderConfig);
+  } break;
+  case UR_FUNCTION_LOADER_TEAR_DOWN: {
+  } break;
+  case UR_FUNCTION_LOADER_CONFIG_CREATE: {
+    using P = ur_loader_config_create_params_t;
+    visitor("phLoaderConfig", &P::pphLoaderConfig);
+  } break;
+  case UR_FUNCTION_LOADER_CONFIG_RETAIN: {
+    using P = ur_loader_config_retain_params_t;
+    visitor("hLoaderConfig", &P::phLoaderConfig);
+  } break;
+  case UR_FUNCTION_LOADER_CONFIG_RELEASE: {
+    using P = ur_loader_config_release_params_t;
+    visitor("hLoaderConfig", &P::phLoaderConfig);
+  } break;
+  case UR_FUNCTION_LOADER_CONFIG_GET_INFO: {
+    using P = ur_loader_config_get_info_params_t;
+    visitor("hLoaderConfig", &P::phLoaderConfig);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_LOADER_CONFIG_ENABLE_LAYER: {
+    using P = ur_loader_config_enable_layer_params_t;
+    visitor("hLoaderConfig", &P::phLoaderConfig);
+    visitor("pLayerName", &P::ppLayerName);
+  } break;
+  case UR_FUNCTION_LOADER_CONFIG_SET_CODE_LOCATION_CALLBACK: {
+    using P = ur_loader_config_set_code_location_callback_params_t;
+    visitor("hLoaderConfig", &P::phLoaderConfig);
+    visitor("pfnCodeloc", &P::ppfnCodeloc);
+    visitor("pUserData", &P::ppUserData);
+  } break;
+  case UR_FUNCTION_LOADER_CONFIG_SET_MOCKING_ENABLED: {
+    using P = ur_loader_config_set_mocking_enabled_params_t;
+    visitor("hLoaderConfig", &P::phLoaderConfig);
+    visitor("enable", &P::penable);
+  } break;
+  case UR_FUNCTION_MEM_IMAGE_CREATE: {
+    using P = ur_mem_image_create_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("flags", &P::pflags);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("pHost", &P::ppHost);
+    visitor("phMem", &P::pphMem);
+  } break;
+  case UR_FUNCTION_MEM_BUFFER_CREATE: {
+    using P = ur_mem_buffer_create_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("flags", &P::pflags);
+    visitor("size", &P::psize);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phBuffer", &P::pphBuffer);
+  } break;
+  case UR_FUNCTION_MEM_RETAIN: {
+    using P = ur_mem_retain_params_t;
+    visitor("hMem", &P::phMem);
+  } break;
+  case UR_FUNCTION_MEM_RELEASE: {
+    using P = ur_mem_release_params_t;
+    visitor("hMem", &P::phMem);
+  } break;
+  case UR_FUNCTION_MEM_BUFFER_PARTITION: {
+    using P = ur_mem_buffer_partition_params_t;
+    visitor("hBuffer", &P::phBuffer);
+    visitor("flags", &P::pflags);
+    visitor("bufferCreateType", &P::pbufferCreateType);
+    visitor("pRegion", &P::ppRegion);
+    visitor("phMem", &P::pphMem);
+  } break;
+  case UR_FUNCTION_MEM_GET_NATIVE_HANDLE: {
+    using P = ur_mem_get_native_handle_params_t;
+    visitor("hMem", &P::phMem);
+    visitor("hDevice", &P::phDevice);
+    visitor("phNativeMem", &P::pphNativeMem);
+  } break;
+  case UR_FUNCTION_MEM_BUFFER_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_mem_buffer_create_with_native_handle_params_t;
+    visitor("hNativeMem", &P::phNativeMem);
+    visitor("hContext", &P::phContext);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phMem", &P::pphMem);
+  } break;
+  case UR_FUNCTION_MEM_IMAGE_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_mem_image_create_with_native_handle_params_t;
+    visitor("hNativeMem", &P::phNativeMem);
+    visitor("hContext", &P::phContext);
+    visitor("pImageFormat", &P::ppImageFormat);
+    visitor("pImageDesc", &P::ppImageDesc);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phMem", &P::pphMem);
+  } break;
+  case UR_FUNCTION_MEM_GET_INFO: {
+    using P = ur_mem_get_info_params_t;
+    visitor("hMemory", &P::phMemory);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_MEM_IMAGE_GET_INFO: {
+    using P = ur_mem_image_get_info_params_t;
+    visitor("hMemory", &P::phMemory);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_MEMORY_EXPORT_ALLOC_EXPORTABLE_MEMORY_EXP: {
+    using P = ur_memory_export_alloc_exportable_memory_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("alignment", &P::palignment);
+    visitor("size", &P::psize);
+    visitor("handleTypeToExport", &P::phandleTypeToExport);
+    visitor("ppMem", &P::pppMem);
+  } break;
+  case UR_FUNCTION_MEMORY_EXPORT_FREE_EXPORTABLE_MEMORY_EXP: {
+    using P = ur_memory_export_free_exportable_memory_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pMem", &P::ppMem);
+  } break;
+  case UR_FUNCTION_MEMORY_EXPORT_EXPORT_MEMORY_HANDLE_EXP: {
+    using P = ur_memory_export_export_memory_handle_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("handleTypeToExport", &P::phandleTypeToExport);
+    visitor("pMem", &P::ppMem);
+    visitor("pMemHandleRet", &P::ppMemHandleRet);
+  } break;
+  case UR_FUNCTION_PHYSICAL_MEM_CREATE: {
+    using P = ur_physical_mem_create_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("size", &P::psize);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phPhysicalMem", &P::pphPhysicalMem);
+  } break;
+  case UR_FUNCTION_PHYSICAL_MEM_RETAIN: {
+    using P = ur_physical_mem_retain_params_t;
+    visitor("hPhysicalMem", &P::phPhysicalMem);
+  } break;
+  case UR_FUNCTION_PHYSICAL_MEM_RELEASE: {
+    using P = ur_physical_mem_release_params_t;
+    visitor("hPhysicalMem", &P::phPhysicalMem);
+  } break;
+  case UR_FUNCTION_PHYSICAL_MEM_GET_INFO: {
+    using P = ur_physical_mem_get_info_params_t;
+    visitor("hPhysicalMem", &P::phPhysicalMem);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_PLATFORM_GET: {
+    using P = ur_platform_get_params_t;
+    visitor("hAdapter", &P::phAdapter);
+    visitor("NumEntries", &P::pNumEntries);
+    visitor("phPlatforms", &P::pphPlatforms);
+    visitor("pNumPlatforms", &P::ppNumPlatforms);
+  } break;
+  case UR_FUNCTION_PLATFORM_GET_INFO: {
+    using P = ur_platform_get_info_params_t;
+    visitor("hPlatform", &P::phPlatform);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_PLATFORM_GET_NATIVE_HANDLE: {
+    using P = ur_platform_get_native_handle_params_t;
+    visitor("hPlatform", &P::phPlatform);
+    visitor("phNativePlatform", &P::pphNativePlatform);
+  } break;
+  case UR_FUNCTION_PLATFORM_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_platform_create_with_native_handle_params_t;
+    visitor("hNativePlatform", &P::phNativePlatform);
+    visitor("hAdapter", &P::phAdapter);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phPlatform", &P::pphPlatform);
+  } break;
+  case UR_FUNCTION_PLATFORM_GET_API_VERSION: {
+    using P = ur_platform_get_api_version_params_t;
+    visitor("hPlatform", &P::phPlatform);
+    visitor("pVersion", &P::ppVersion);
+  } break;
+  case UR_FUNCTION_PLATFORM_GET_BACKEND_OPTION: {
+    using P = ur_platform_get_backend_option_params_t;
+    visitor("hPlatform", &P::phPlatform);
+    visitor("pFrontendOption", &P::ppFrontendOption);
+    visitor("ppPlatformOption", &P::pppPlatformOption);
+  } break;
+  case UR_FUNCTION_PROGRAM_CREATE_WITH_IL: {
+    using P = ur_program_create_with_il_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pIL", &P::ppIL);
+    visitor("length", &P::plength);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phProgram", &P::pphProgram);
+  } break;
+  case UR_FUNCTION_PROGRAM_CREATE_WITH_BINARY: {
+    using P = ur_program_create_with_binary_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("numDevices", &P::pnumDevices);
+    visitor("phDevices", &P::pphDevices);
+    visitor("pLengths", &P::ppLengths);
+    visitor("ppBinaries", &P::pppBinaries);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phProgram", &P::pphProgram);
+  } break;
+  case UR_FUNCTION_PROGRAM_BUILD: {
+    using P = ur_program_build_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hProgram", &P::phProgram);
+    visitor("pOptions", &P::ppOptions);
+  } break;
+  case UR_FUNCTION_PROGRAM_DYNAMIC_LINK_EXP: {
+    using P = ur_program_dynamic_link_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("count", &P::pcount);
+    visitor("phPrograms", &P::pphPrograms);
+  } break;
+  case UR_FUNCTION_PROGRAM_BUILD_EXP: {
+    using P = ur_program_build_exp_params_t;
+    visitor("hProgram", &P::phProgram);
+    visitor("numDevices", &P::pnumDevices);
+    visitor("phDevices", &P::pphDevices);
+    visitor("flags", &P::pflags);
+    visitor("pOptions", &P::ppOptions);
+  } break;
+  case UR_FUNCTION_PROGRAM_COMPILE: {
+    using P = ur_program_compile_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hProgram", &P::phProgram);
+    visitor("pOptions", &P::ppOptions);
+  } break;
+  case UR_FUNCTION_PROGRAM_COMPILE_EXP: {
+    using P = ur_program_compile_exp_params_t;
+    visitor("hProgram", &P::phProgram);
+    visitor("numDevices", &P::pnumDevices);
+    visitor("phDevices", &P::pphDevices);
+    visitor("flags", &P::pflags);
+    visitor("pOptions", &P::ppOptions);
+  } break;
+  case UR_FUNCTION_PROGRAM_LINK: {
+    using P = ur_program_link_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("count", &P::pcount);
+    visitor("phPrograms", &P::pphPrograms);
+    visitor("pOptions", &P::ppOptions);
+    visitor("phProgram", &P::pphProgram);
+  } break;
+  case UR_FUNCTION_PROGRAM_LINK_EXP: {
+    using P = ur_program_link_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("numDevices", &P::pnumDevices);
+    visitor("phDevices", &P::pphDevices);
+    visitor("flags", &P::pflags);
+    visitor("count", &P::pcount);
+    visitor("phPrograms", &P::pphPrograms);
+    visitor("pOptions", &P::ppOptions);
+    visitor("phProgram", &P::pphProgram);
+  } break;
+  case UR_FUNCTION_PROGRAM_RETAIN: {
+    using P = ur_program_retain_params_t;
+    visitor("hProgram", &P::phProgram);
+  } break;
+  case UR_FUNCTION_PROGRAM_RELEASE: {
+    using P = ur_program_release_params_t;
+    visitor("hProgram", &P::phProgram);
+  } break;
+  case UR_FUNCTION_PROGRAM_GET_FUNCTION_POINTER: {
+    using P = ur_program_get_function_pointer_params_t;
+    visitor("hDevice", &P::phDevice);
+    visitor("hProgram", &P::phProgram);
+    visitor("pFunctionName", &P::ppFunctionName);
+    visitor("ppFunctionPointer", &P::pppFunctionPointer);
+  } break;
+  case UR_FUNCTION_PROGRAM_GET_GLOBAL_VARIABLE_POINTER: {
+    using P = ur_program_get_global_variable_pointer_params_t;
+    visitor("hDevice", &P::phDevice);
+    visitor("hProgram", &P::phProgram);
+    visitor("pGlobalVariableName", &P::ppGlobalVariableName);
+    visitor("pGlobalVariableSizeRet", &P::ppGlobalVariableSizeRet);
+    visitor("ppGlobalVariablePointerRet", &P::pppGlobalVariablePointerRet);
+  } break;
+  case UR_FUNCTION_PROGRAM_GET_INFO: {
+    using P = ur_program_get_info_params_t;
+    visitor("hProgram", &P::phProgram);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_PROGRAM_GET_BUILD_INFO: {
+    using P = ur_program_get_build_info_params_t;
+    visitor("hProgram", &P::phProgram);
+    visitor("hDevice", &P::phDevice);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_PROGRAM_SET_SPECIALIZATION_CONSTANTS: {
+    using P = ur_program_set_specialization_constants_params_t;
+    visitor("hProgram", &P::phProgram);
+    visitor("count", &P::pcount);
+    visitor("pSpecConstants", &P::ppSpecConstants);
+  } break;
+  case UR_FUNCTION_PROGRAM_GET_NATIVE_HANDLE: {
+    using P = ur_program_get_native_handle_params_t;
+    visitor("hProgram", &P::phProgram);
+    visitor("phNativeProgram", &P::pphNativeProgram);
+  } break;
+  case UR_FUNCTION_PROGRAM_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_program_create_with_native_handle_params_t;
+    visitor("hNativeProgram", &P::phNativeProgram);
+    visitor("hContext", &P::phContext);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phProgram", &P::pphProgram);
+  } break;
+  case UR_FUNCTION_QUEUE_GET_INFO: {
+    using P = ur_queue_get_info_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_QUEUE_CREATE: {
+    using P = ur_queue_create_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phQueue", &P::pphQueue);
+  } break;
+  case UR_FUNCTION_QUEUE_RETAIN: {
+    using P = ur_queue_retain_params_t;
+    visitor("hQueue", &P::phQueue);
+  } break;
+  case UR_FUNCTION_QUEUE_RELEASE: {
+    using P = ur_queue_release_params_t;
+    visitor("hQueue", &P::phQueue);
+  } break;
+  case UR_FUNCTION_QUEUE_GET_NATIVE_HANDLE: {
+    using P = ur_queue_get_native_handle_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pDesc", &P::ppDesc);
+    visitor("phNativeQueue", &P::pphNativeQueue);
+  } break;
+  case UR_FUNCTION_QUEUE_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_queue_create_with_native_handle_params_t;
+    visitor("hNativeQueue", &P::phNativeQueue);
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phQueue", &P::pphQueue);
+  } break;
+  case UR_FUNCTION_QUEUE_FINISH: {
+    using P = ur_queue_finish_params_t;
+    visitor("hQueue", &P::phQueue);
+  } break;
+  case UR_FUNCTION_QUEUE_FLUSH: {
+    using P = ur_queue_flush_params_t;
+    visitor("hQueue", &P::phQueue);
+  } break;
+  case UR_FUNCTION_QUEUE_BEGIN_GRAPH_CAPTURE_EXP: {
+    using P = ur_queue_begin_graph_capture_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+  } break;
+  case UR_FUNCTION_QUEUE_BEGIN_CAPTURE_INTO_GRAPH_EXP: {
+    using P = ur_queue_begin_capture_into_graph_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("hGraph", &P::phGraph);
+  } break;
+  case UR_FUNCTION_QUEUE_END_GRAPH_CAPTURE_EXP: {
+    using P = ur_queue_end_graph_capture_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("phGraph", &P::pphGraph);
+  } break;
+  case UR_FUNCTION_QUEUE_IS_GRAPH_CAPTURE_ENABLED_EXP: {
+    using P = ur_queue_is_graph_capture_enabled_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("pResult", &P::ppResult);
+  } break;
+  case UR_FUNCTION_QUEUE_GET_GRAPH_EXP: {
+    using P = ur_queue_get_graph_exp_params_t;
+    visitor("hQueue", &P::phQueue);
+    visitor("phGraph", &P::pphGraph);
+  } break;
+  case UR_FUNCTION_SAMPLER_CREATE: {
+    using P = ur_sampler_create_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pDesc", &P::ppDesc);
+    visitor("phSampler", &P::pphSampler);
+  } break;
+  case UR_FUNCTION_SAMPLER_RETAIN: {
+    using P = ur_sampler_retain_params_t;
+    visitor("hSampler", &P::phSampler);
+  } break;
+  case UR_FUNCTION_SAMPLER_RELEASE: {
+    using P = ur_sampler_release_params_t;
+    visitor("hSampler", &P::phSampler);
+  } break;
+  case UR_FUNCTION_SAMPLER_GET_INFO: {
+    using P = ur_sampler_get_info_params_t;
+    visitor("hSampler", &P::phSampler);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_SAMPLER_GET_NATIVE_HANDLE: {
+    using P = ur_sampler_get_native_handle_params_t;
+    visitor("hSampler", &P::phSampler);
+    visitor("phNativeSampler", &P::pphNativeSampler);
+  } break;
+  case UR_FUNCTION_SAMPLER_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_sampler_create_with_native_handle_params_t;
+    visitor("hNativeSampler", &P::phNativeSampler);
+    visitor("hContext", &P::phContext);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phSampler", &P::pphSampler);
+  } break;
+  case UR_FUNCTION_USM_HOST_ALLOC: {
+    using P = ur_usm_host_alloc_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pUSMDesc", &P::ppUSMDesc);
+    visitor("pool", &P::ppool);
+    visitor("size", &P::psize);
+    visitor("ppMem", &P::pppMem);
+  } break;
+  case UR_FUNCTION_USM_DEVICE_ALLOC: {
+    using P = ur_usm_device_alloc_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pUSMDesc", &P::ppUSMDesc);
+    visitor("pool", &P::ppool);
+    visitor("size", &P::psize);
+    visitor("ppMem", &P::pppMem);
+  } break;
+  case UR_FUNCTION_USM_SHARED_ALLOC: {
+    using P = ur_usm_shared_alloc_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pUSMDesc", &P::ppUSMDesc);
+    visitor("pool", &P::ppool);
+    visitor("size", &P::psize);
+    visitor("ppMem", &P::pppMem);
+  } break;
+  case UR_FUNCTION_USM_FREE: {
+    using P = ur_usm_free_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pMem", &P::ppMem);
+  } break;
+  case UR_FUNCTION_USM_GET_MEM_ALLOC_INFO: {
+    using P = ur_usm_get_mem_alloc_info_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pMem", &P::ppMem);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_USM_POOL_CREATE: {
+    using P = ur_usm_pool_create_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pPoolDesc", &P::ppPoolDesc);
+    visitor("ppPool", &P::pppPool);
+  } break;
+  case UR_FUNCTION_USM_POOL_RETAIN: {
+    using P = ur_usm_pool_retain_params_t;
+    visitor("pPool", &P::ppPool);
+  } break;
+  case UR_FUNCTION_USM_POOL_RELEASE: {
+    using P = ur_usm_pool_release_params_t;
+    visitor("pPool", &P::ppPool);
+  } break;
+  case UR_FUNCTION_USM_POOL_GET_INFO: {
+    using P = ur_usm_pool_get_info_params_t;
+    visitor("hPool", &P::phPool);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_USM_POOL_CREATE_EXP: {
+    using P = ur_usm_pool_create_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pPoolDesc", &P::ppPoolDesc);
+    visitor("pPool", &P::ppPool);
+  } break;
+  case UR_FUNCTION_USM_POOL_DESTROY_EXP: {
+    using P = ur_usm_pool_destroy_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hPool", &P::phPool);
+  } break;
+  case UR_FUNCTION_USM_POOL_GET_DEFAULT_DEVICE_POOL_EXP: {
+    using P = ur_usm_pool_get_default_device_pool_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pPool", &P::ppPool);
+  } break;
+  case UR_FUNCTION_USM_POOL_GET_INFO_EXP: {
+    using P = ur_usm_pool_get_info_exp_params_t;
+    visitor("hPool", &P::phPool);
+    visitor("propName", &P::ppropName);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_USM_POOL_SET_INFO_EXP: {
+    using P = ur_usm_pool_set_info_exp_params_t;
+    visitor("hPool", &P::phPool);
+    visitor("propName", &P::ppropName);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("propSize", &P::ppropSize);
+  } break;
+  case UR_FUNCTION_USM_POOL_SET_DEVICE_POOL_EXP: {
+    using P = ur_usm_pool_set_device_pool_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hPool", &P::phPool);
+  } break;
+  case UR_FUNCTION_USM_POOL_GET_DEVICE_POOL_EXP: {
+    using P = ur_usm_pool_get_device_pool_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pPool", &P::ppPool);
+  } break;
+  case UR_FUNCTION_USM_POOL_TRIM_TO_EXP: {
+    using P = ur_usm_pool_trim_to_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("hPool", &P::phPool);
+    visitor("minBytesToKeep", &P::pminBytesToKeep);
+  } break;
+  case UR_FUNCTION_USM_PITCHED_ALLOC_EXP: {
+    using P = ur_usm_pitched_alloc_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("pUSMDesc", &P::ppUSMDesc);
+    visitor("pool", &P::ppool);
+    visitor("widthInBytes", &P::pwidthInBytes);
+    visitor("height", &P::pheight);
+    visitor("elementSizeBytes", &P::pelementSizeBytes);
+    visitor("ppMem", &P::pppMem);
+    visitor("pResultPitch", &P::ppResultPitch);
+  } break;
+  case UR_FUNCTION_USM_CONTEXT_MEMCPY_EXP: {
+    using P = ur_usm_context_memcpy_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pDst", &P::ppDst);
+    visitor("pSrc", &P::ppSrc);
+    visitor("size", &P::psize);
+  } break;
+  case UR_FUNCTION_USM_HOST_ALLOC_UNREGISTER_EXP: {
+    using P = ur_usm_host_alloc_unregister_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pHostMem", &P::ppHostMem);
+  } break;
+  case UR_FUNCTION_USM_HOST_ALLOC_REGISTER_EXP: {
+    using P = ur_usm_host_alloc_register_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pHostMem", &P::ppHostMem);
+    visitor("size", &P::psize);
+    visitor("pProperties", &P::ppProperties);
+  } break;
+  case UR_FUNCTION_USM_IMPORT_EXP: {
+    using P = ur_usm_import_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pMem", &P::ppMem);
+    visitor("size", &P::psize);
+  } break;
+  case UR_FUNCTION_USM_RELEASE_EXP: {
+    using P = ur_usm_release_exp_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pMem", &P::ppMem);
+  } break;
+  case UR_FUNCTION_USM_P2P_ENABLE_PEER_ACCESS_EXP: {
+    using P = ur_usm_p2p_enable_peer_access_exp_params_t;
+    visitor("commandDevice", &P::pcommandDevice);
+    visitor("peerDevice", &P::ppeerDevice);
+  } break;
+  case UR_FUNCTION_USM_P2P_DISABLE_PEER_ACCESS_EXP: {
+    using P = ur_usm_p2p_disable_peer_access_exp_params_t;
+    visitor("commandDevice", &P::pcommandDevice);
+    visitor("peerDevice", &P::ppeerDevice);
+  } break;
+  case UR_FUNCTION_USM_P2P_PEER_ACCESS_GET_INFO_EXP: {
+    using P = ur_usm_p2p_peer_access_get_info_exp_params_t;
+    visitor("commandDevice", &P::pcommandDevice);
+    visitor("peerDevice", &P::ppeerDevice);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_VIRTUAL_MEM_GRANULARITY_GET_INFO: {
+    using P = ur_virtual_mem_granularity_get_info_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("hDevice", &P::phDevice);
+    visitor("allocationSize", &P::pallocationSize);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_VIRTUAL_MEM_RESERVE: {
+    using P = ur_virtual_mem_reserve_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pStart", &P::ppStart);
+    visitor("size", &P::psize);
+    visitor("ppStart", &P::pppStart);
+  } break;
+  case UR_FUNCTION_VIRTUAL_MEM_FREE: {
+    using P = ur_virtual_mem_free_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pStart", &P::ppStart);
+    visitor("size", &P::psize);
+  } break;
+  case UR_FUNCTION_VIRTUAL_MEM_MAP: {
+    using P = ur_virtual_mem_map_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pStart", &P::ppStart);
+    visitor("size", &P::psize);
+    visitor("hPhysicalMem", &P::phPhysicalMem);
+    visitor("offset", &P::poffset);
+    visitor("flags", &P::pflags);
+  } break;
+  case UR_FUNCTION_VIRTUAL_MEM_UNMAP: {
+    using P = ur_virtual_mem_unmap_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pStart", &P::ppStart);
+    visitor("size", &P::psize);
+  } break;
+  case UR_FUNCTION_VIRTUAL_MEM_SET_ACCESS: {
+    using P = ur_virtual_mem_set_access_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pStart", &P::ppStart);
+    visitor("size", &P::psize);
+    visitor("flags", &P::pflags);
+  } break;
+  case UR_FUNCTION_VIRTUAL_MEM_GET_INFO: {
+    using P = ur_virtual_mem_get_info_params_t;
+    visitor("hContext", &P::phContext);
+    visitor("pStart", &P::ppStart);
+    visitor("size", &P::psize);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_DEVICE_GET: {
+    using P = ur_device_get_params_t;
+    visitor("hPlatform", &P::phPlatform);
+    visitor("DeviceType", &P::pDeviceType);
+    visitor("NumEntries", &P::pNumEntries);
+    visitor("phDevices", &P::pphDevices);
+    visitor("pNumDevices", &P::ppNumDevices);
+  } break;
+  case UR_FUNCTION_DEVICE_GET_SELECTED: {
+    using P = ur_device_get_selected_params_t;
+    visitor("hPlatform", &P::phPlatform);
+    visitor("DeviceType", &P::pDeviceType);
+    visitor("NumEntries", &P::pNumEntries);
+    visitor("phDevices", &P::pphDevices);
+    visitor("pNumDevices", &P::ppNumDevices);
+  } break;
+  case UR_FUNCTION_DEVICE_GET_INFO: {
+    using P = ur_device_get_info_params_t;
+    visitor("hDevice", &P::phDevice);
+    visitor("propName", &P::ppropName);
+    visitor("propSize", &P::ppropSize);
+    visitor("pPropValue", &P::ppPropValue);
+    visitor("pPropSizeRet", &P::ppPropSizeRet);
+  } break;
+  case UR_FUNCTION_DEVICE_RETAIN: {
+    using P = ur_device_retain_params_t;
+    visitor("hDevice", &P::phDevice);
+  } break;
+  case UR_FUNCTION_DEVICE_RELEASE: {
+    using P = ur_device_release_params_t;
+    visitor("hDevice", &P::phDevice);
+  } break;
+  case UR_FUNCTION_DEVICE_PARTITION: {
+    using P = ur_device_partition_params_t;
+    visitor("hDevice", &P::phDevice);
+    visitor("pProperties", &P::ppProperties);
+    visitor("NumDevices", &P::pNumDevices);
+    visitor("phSubDevices", &P::pphSubDevices);
+    visitor("pNumDevicesRet", &P::ppNumDevicesRet);
+  } break;
+  case UR_FUNCTION_DEVICE_SELECT_BINARY: {
+    using P = ur_device_select_binary_params_t;
+    visitor("hDevice", &P::phDevice);
+    visitor("pBinaries", &P::ppBinaries);
+    visitor("NumBinaries", &P::pNumBinaries);
+    visitor("pSelectedBinary", &P::ppSelectedBinary);
+  } break;
+  case UR_FUNCTION_DEVICE_GET_NATIVE_HANDLE: {
+    using P = ur_device_get_native_handle_params_t;
+    visitor("hDevice", &P::phDevice);
+    visitor("phNativeDevice", &P::pphNativeDevice);
+  } break;
+  case UR_FUNCTION_DEVICE_CREATE_WITH_NATIVE_HANDLE: {
+    using P = ur_device_create_with_native_handle_params_t;
+    visitor("hNativeDevice", &P::phNativeDevice);
+    visitor("hAdapter", &P::phAdapter);
+    visitor("pProperties", &P::ppProperties);
+    visitor("phDevice", &P::pphDevice);
+  } break;
+  case UR_FUNCTION_DEVICE_GET_GLOBAL_TIMESTAMPS: {
+    using P = ur_device_get_global_timestamps_params_t;
+    visitor("hDevice", &P::phDevice);
+    visitor("pDeviceTimestamp", &P::ppDeviceTimestamp);
+    visitor("pHostTimestamp", &P::ppHostTimestamp);
+  } break;
+  case UR_FUNCTION_DEVICE_WAIT_EXP: {
+    using P = ur_device_wait_exp_params_t;
+    visitor("hDevice", &P::phDevice);
+  } break;
+  default:
+    return false;
+  }
+  return true;
+}
+
+} // namespace urtrace